@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include <csics/csics.hpp>
+#include <random>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::checksum;
+using namespace csics::io::encdec;
+
+namespace {
+
+std::vector<uint8_t> random_bytes(std::size_t size) {
+    std::vector<uint8_t> out(size);
+    std::mt19937 rng(1);
+    for (auto& b : out) {
+        b = static_cast<uint8_t>(rng());
+    }
+    return out;
+}
+
+void BM_Checksum(benchmark::State& state, ChecksumType type) {
+    auto input = random_bytes(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(checksum(type, BufferView(input)));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void BM_Crc32cPortable(benchmark::State& state) {
+    auto input = random_bytes(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc32c_portable(BufferView(input)));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+// Encodes the whole input, then checksums it in a second pass. Past the
+// size of the caches the second pass reads it from memory again.
+void BM_Base64ThenChecksum(benchmark::State& state, ChecksumType type) {
+    auto input = random_bytes(static_cast<std::size_t>(state.range(0)));
+    std::vector<uint8_t> output(4 * ((input.size() + 2) / 3));
+    Base64Encoder encoder;
+    for (auto _ : state) {
+        auto r = encoder.finish(BufferView(input), BufferView(output));
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(checksum(type, BufferView(input)));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void BM_Base64Checksummed(benchmark::State& state, ChecksumType type) {
+    auto input = random_bytes(static_cast<std::size_t>(state.range(0)));
+    std::vector<uint8_t> output(4 * ((input.size() + 2) / 3));
+    ChecksumCodec codec(std::make_unique<Base64Encoder>(), type);
+    for (auto _ : state) {
+        auto r = codec.finish(BufferView(input), BufferView(output));
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(codec.digest());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+#ifdef CSICS_USE_ZLIB
+using io::compression::CompressorType;
+using io::compression::ICompressor;
+
+std::vector<uint8_t> json_bytes(std::size_t size) {
+    std::string text;
+    for (std::size_t i = 0; text.size() < size; i++) {
+        text += "{\"seq\":" + std::to_string(i) + ",\"rssi\":-" +
+                std::to_string(40 + i % 17) + ",\"freq\":915000000},";
+    }
+    return std::vector<uint8_t>(text.begin(), text.begin() + size);
+}
+
+// Compression costs far more than the checksum, so fusing saves little.
+// With libdeflate the separate pass wins outright: a whole finish() takes
+// the one-shot path, the fused slices stream through zlib.
+void BM_CompressThenChecksum(benchmark::State& state) {
+    auto input = json_bytes(static_cast<std::size_t>(state.range(0)));
+    std::vector<uint8_t> output(input.size() + 1024);
+    CompressorCodec codec(ICompressor::create(CompressorType::ZLIB));
+    for (auto _ : state) {
+        auto r = codec.finish(BufferView(input), BufferView(output));
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(crc32c(BufferView(input)));
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void BM_CompressChecksummed(benchmark::State& state) {
+    auto input = json_bytes(static_cast<std::size_t>(state.range(0)));
+    std::vector<uint8_t> output(input.size() + 1024);
+    ChecksumCodec codec(std::make_unique<CompressorCodec>(
+        ICompressor::create(CompressorType::ZLIB)));
+    for (auto _ : state) {
+        auto r = codec.finish(BufferView(input), BufferView(output));
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(codec.digest());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+#endif
+
+};  // namespace
+
+BENCHMARK_CAPTURE(BM_Checksum, crc32c, ChecksumType::CRC32C)
+    ->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK(BM_Crc32cPortable)->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Base64ThenChecksum, crc32c, ChecksumType::CRC32C)
+    ->Arg(1 << 20)->Arg(1 << 26);
+BENCHMARK_CAPTURE(BM_Base64Checksummed, crc32c, ChecksumType::CRC32C)
+    ->Arg(1 << 20)->Arg(1 << 26);
+#ifdef CSICS_USE_XXHASH
+BENCHMARK_CAPTURE(BM_Checksum, xxh3, ChecksumType::XXH3)
+    ->Arg(1 << 12)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_Base64ThenChecksum, xxh3, ChecksumType::XXH3)
+    ->Arg(1 << 20)->Arg(1 << 26);
+BENCHMARK_CAPTURE(BM_Base64Checksummed, xxh3, ChecksumType::XXH3)
+    ->Arg(1 << 20)->Arg(1 << 26);
+#endif
+#ifdef CSICS_USE_ZLIB
+BENCHMARK(BM_CompressThenChecksum)->Arg(1 << 22);
+BENCHMARK(BM_CompressChecksummed)->Arg(1 << 22);
+#endif
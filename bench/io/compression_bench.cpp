@@ -0,0 +1,341 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <csics/csics.hpp>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::compression;
+
+namespace {
+
+constexpr std::size_t kInputSize = 64 << 20;
+
+// SC16 tone in noise, about what a capture at moderate SNR looks like.
+const std::vector<char>& iq_data() {
+    static const std::vector<char> data = [] {
+        std::vector<char> out(kInputSize);
+        auto* samples = reinterpret_cast<int16_t*>(out.data());
+        std::mt19937 rng(1);
+        std::normal_distribution<float> noise(0.0f, 200.0f);
+        for (std::size_t i = 0; i < kInputSize / 4; i++) {
+            float phase = 0.01f * static_cast<float>(i);
+            samples[2 * i] =
+                static_cast<int16_t>(4000.0f * std::cos(phase) + noise(rng));
+            samples[2 * i + 1] =
+                static_cast<int16_t>(4000.0f * std::sin(phase) + noise(rng));
+        }
+        return out;
+    }();
+    return data;
+}
+
+// Telemetry records as published over MQTT.
+const std::vector<char>& json_data() {
+    static const std::vector<char> data = [] {
+        std::vector<char> out;
+        out.reserve(kInputSize);
+        std::mt19937 rng(2);
+        std::uniform_real_distribution<double> value(-90.0, 90.0);
+        uint64_t ts = 1700000000000000000ull;
+        while (out.size() < kInputSize) {
+            std::string rec =
+                "{\"timestamp_ns\":" + std::to_string(ts) +
+                ",\"center_freq\":915000000.0,\"sample_rate\":2000000.0,"
+                "\"rssi\":" +
+                std::to_string(value(rng)) +
+                ",\"lat\":" + std::to_string(value(rng)) +
+                ",\"lon\":" + std::to_string(value(rng)) + "}\n";
+            out.insert(out.end(), rec.begin(), rec.end());
+            ts += 1000000;
+        }
+        out.resize(kInputSize);
+        return out;
+    }();
+    return data;
+}
+
+void compress_all(benchmark::State& state, ICompressor& compressor,
+                  const std::vector<char>& input) {
+    std::vector<char> output(input.size() + input.size() / 8 + (1 << 20));
+    std::vector<char> in_copy = input;
+    std::size_t compressed = 0;
+    for (auto _ : state) {
+        compressor.reset();
+        auto r = compressor.finish(BufferView(in_copy), BufferView(output));
+        if (r.status != CompressionStatus::InputBufferFinished) {
+            state.SkipWithError("compression failed");
+            return;
+        }
+        compressed = r.compressed;
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+    state.counters["ratio"] =
+        static_cast<double>(input.size()) / static_cast<double>(compressed);
+}
+
+CompressionOptions with_level(std::optional<int> level) {
+    CompressionOptions options{};
+    options.level = level;
+    return options;
+}
+
+CompressionOptions with_filter(IQFilter filter) {
+    CompressionOptions options{};
+    options.filter = filter;
+    return options;
+}
+
+CompressionOptions with_zlib(ZLIBFormat format, ZLIBStrategy strategy) {
+    CompressionOptions options{};
+    options.zlib_format = format;
+    options.zlib_strategy = strategy;
+    return options;
+}
+
+// One stream on the calling thread, comparable across backends.
+void BM_Compress(benchmark::State& state, CompressorType type,
+                 const std::vector<char>& (*data)(),
+                 CompressionOptions options) {
+    auto compressor = ICompressor::create(type, options);
+    compress_all(state, *compressor, data());
+}
+
+// Independent 1 MiB frames, one worker per core.
+void BM_ParallelFrames(benchmark::State& state, CompressorType type,
+                       const std::vector<char>& (*data)()) {
+    ParallelCompressor::Config config{};
+    config.type = type;
+    config.workers = static_cast<std::size_t>(state.range(0));
+    ParallelCompressor compressor(config);
+    compress_all(state, compressor, data());
+}
+
+// Single-threaded decoding of a stream written by ICompressor.
+void BM_Decompress(benchmark::State& state, CompressorType type,
+                   const std::vector<char>& (*data)()) {
+    const auto& input = data();
+    std::vector<char> in_copy = input;
+    std::vector<char> compressed(input.size() + input.size() / 8 + (1 << 20));
+    auto compressor = ICompressor::create(type);
+    auto c = compressor->finish(BufferView(in_copy), BufferView(compressed));
+    if (c.status != CompressionStatus::InputBufferFinished) {
+        state.SkipWithError("compression failed");
+        return;
+    }
+    compressed.resize(c.compressed);
+
+    auto decompressor = io::decompression::IDecompressor::create(type);
+    std::vector<char> output(input.size());
+    for (auto _ : state) {
+        auto r = decompressor->finish(BufferView(compressed),
+                                      BufferView(output));
+        if (r.status != CompressionStatus::InputBufferFinished) {
+            state.SkipWithError("decompression failed");
+            return;
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+// A 1 KiB message per stream, with a fresh or a pooled compressor.
+void BM_PerMessage(benchmark::State& state, CompressorType type,
+                   bool pooled) {
+    std::vector<char> msg(json_data().begin(), json_data().begin() + 1024);
+    std::vector<char> out(4096);
+    CompressorPool pool(type);
+    for (auto _ : state) {
+        auto r = [&] {
+            if (pooled) {
+                auto compressor = pool.acquire();
+                return compressor->finish(BufferView(msg), BufferView(out));
+            }
+            auto compressor = ICompressor::create(type);
+            return compressor->finish(BufferView(msg), BufferView(out));
+        }();
+        benchmark::DoNotOptimize(r);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// 4 MiB at random offsets of a seekable container of 1 MiB frames, the
+// argument is the number of worker threads.
+void BM_SeekableRead(benchmark::State& state, CompressorType type) {
+    const auto& input = iq_data();
+    std::vector<char> in_copy = input;
+    std::vector<char> container(input.size() + input.size() / 8 + (1 << 20));
+    SeekableWriter::Config config{};
+    config.type = type;
+    SeekableWriter writer(config);
+    auto c = writer.finish(BufferView(in_copy), BufferView(container));
+    if (c.status != CompressionStatus::InputBufferFinished) {
+        state.SkipWithError("compression failed");
+        return;
+    }
+    container.resize(c.compressed);
+
+    io::decompression::SeekableReader::Config reader_config{};
+    reader_config.workers = static_cast<std::size_t>(state.range(0));
+    io::decompression::SeekableReader reader(BufferView(container),
+                                             reader_config);
+    std::vector<char> output(4 << 20);
+    std::mt19937_64 rng(4);
+    for (auto _ : state) {
+        uint64_t offset = rng() % (input.size() - output.size());
+        auto r = reader.read(offset, BufferView(output));
+        if (r.status != CompressionStatus::InputBufferFinished) {
+            state.SkipWithError("decompression failed");
+            return;
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * output.size());
+}
+
+#ifdef CSICS_USE_ZSTD
+// One frame split by libzstd's own workers, 0 runs on the calling thread.
+void BM_ZSTDWorkers(benchmark::State& state,
+                    const std::vector<char>& (*data)()) {
+    CompressionOptions options{};
+    options.workers = static_cast<unsigned>(state.range(0));
+    std::unique_ptr<ICompressor> compressor;
+    try {
+        compressor = ICompressor::create(CompressorType::ZSTD, options);
+    } catch (const std::invalid_argument&) {
+        state.SkipWithError("libzstd built without multithreading");
+        return;
+    }
+    compress_all(state, *compressor, data());
+}
+#endif
+
+};  // namespace
+
+// The transform alone, block by block.
+void BM_IQFilter(benchmark::State& state, IQFilter filter, bool decode) {
+    const auto& input = iq_data();
+    std::vector<char> in_copy = input;
+    std::vector<char> output(input.size());
+    for (auto _ : state) {
+        for (std::size_t off = 0; off < input.size();
+             off += kIQFilterBlockSize) {
+            BufferView in(in_copy.data() + off, kIQFilterBlockSize);
+            BufferView out(output.data() + off, kIQFilterBlockSize);
+            if (decode) {
+                iq_filter_decode(filter, in, out);
+            } else {
+                iq_filter_encode(filter, in, out);
+            }
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+#define CORES_ARGS ->RangeMultiplier(2)->Range(1, 16)->UseRealTime()
+
+BENCHMARK_CAPTURE(BM_IQFilter, shuf_encode, IQFilter::Shuffle, false);
+BENCHMARK_CAPTURE(BM_IQFilter, shuf_decode, IQFilter::Shuffle, true);
+BENCHMARK_CAPTURE(BM_IQFilter, dshuf_encode, IQFilter::DeltaShuffle, false);
+BENCHMARK_CAPTURE(BM_IQFilter, dshuf_decode, IQFilter::DeltaShuffle, true);
+BENCHMARK_CAPTURE(BM_IQFilter, dbitshuf_encode, IQFilter::DeltaBitShuffle,
+                  false);
+BENCHMARK_CAPTURE(BM_IQFilter, dbitshuf_decode, IQFilter::DeltaBitShuffle,
+                  true);
+
+#ifdef CSICS_USE_ZSTD
+BENCHMARK_CAPTURE(BM_Compress, zstd_iq, CompressorType::ZSTD, iq_data,
+                  with_level(std::nullopt));
+BENCHMARK_CAPTURE(BM_Compress, zstd_json, CompressorType::ZSTD, json_data,
+                  with_level(std::nullopt));
+BENCHMARK_CAPTURE(BM_Compress, zstd1_iq, CompressorType::ZSTD, iq_data,
+                  with_level(1));
+BENCHMARK_CAPTURE(BM_Compress, zstd1_json, CompressorType::ZSTD, json_data,
+                  with_level(1));
+BENCHMARK_CAPTURE(BM_Compress, zstd_shuf_iq, CompressorType::ZSTD,
+                  iq_data, with_filter(IQFilter::Shuffle));
+BENCHMARK_CAPTURE(BM_Compress, zstd_dshuf_iq, CompressorType::ZSTD,
+                  iq_data, with_filter(IQFilter::DeltaShuffle));
+BENCHMARK_CAPTURE(BM_Compress, zstd_dbitshuf_iq, CompressorType::ZSTD,
+                  iq_data, with_filter(IQFilter::DeltaBitShuffle));
+BENCHMARK_CAPTURE(BM_ParallelFrames, zstd_iq, CompressorType::ZSTD, iq_data)
+CORES_ARGS;
+BENCHMARK_CAPTURE(BM_ParallelFrames, zstd_json, CompressorType::ZSTD,
+                  json_data) CORES_ARGS;
+BENCHMARK_CAPTURE(BM_ZSTDWorkers, iq, iq_data)->Arg(0) CORES_ARGS;
+BENCHMARK_CAPTURE(BM_ZSTDWorkers, json, json_data)->Arg(0) CORES_ARGS;
+BENCHMARK_CAPTURE(BM_Decompress, zstd_iq, CompressorType::ZSTD, iq_data);
+BENCHMARK_CAPTURE(BM_Decompress, zstd_json, CompressorType::ZSTD, json_data);
+BENCHMARK_CAPTURE(BM_PerMessage, zstd_create, CompressorType::ZSTD, false);
+BENCHMARK_CAPTURE(BM_PerMessage, zstd_pooled, CompressorType::ZSTD, true);
+BENCHMARK_CAPTURE(BM_SeekableRead, zstd_iq, CompressorType::ZSTD)
+    ->Arg(0) CORES_ARGS;
+#endif
+
+#ifdef CSICS_USE_ZLIB
+BENCHMARK_CAPTURE(BM_Compress, zlib_iq, CompressorType::ZLIB, iq_data,
+                  with_level(std::nullopt));
+BENCHMARK_CAPTURE(BM_Compress, zlib_json, CompressorType::ZLIB, json_data,
+                  with_level(std::nullopt));
+BENCHMARK_CAPTURE(BM_Compress, zlib1_iq, CompressorType::ZLIB, iq_data,
+                  with_level(1));
+BENCHMARK_CAPTURE(BM_Compress, zlib1_json, CompressorType::ZLIB, json_data,
+                  with_level(1));
+BENCHMARK_CAPTURE(BM_Compress, zlib_shuf_iq, CompressorType::ZLIB,
+                  iq_data, with_filter(IQFilter::Shuffle));
+BENCHMARK_CAPTURE(BM_Compress, zlib_dshuf_iq, CompressorType::ZLIB,
+                  iq_data, with_filter(IQFilter::DeltaShuffle));
+BENCHMARK_CAPTURE(BM_Compress, zlib_dbitshuf_iq, CompressorType::ZLIB,
+                  iq_data, with_filter(IQFilter::DeltaBitShuffle));
+BENCHMARK_CAPTURE(BM_Compress, zlib_gzip_json, CompressorType::ZLIB,
+                  json_data,
+                  with_zlib(ZLIBFormat::Gzip, ZLIBStrategy::Default));
+BENCHMARK_CAPTURE(BM_Compress, zlib_rle_iq, CompressorType::ZLIB, iq_data,
+                  with_zlib(ZLIBFormat::Zlib, ZLIBStrategy::RLE));
+BENCHMARK_CAPTURE(BM_ParallelFrames, zlib_iq, CompressorType::ZLIB, iq_data)
+CORES_ARGS;
+BENCHMARK_CAPTURE(BM_ParallelFrames, zlib_json, CompressorType::ZLIB,
+                  json_data) CORES_ARGS;
+BENCHMARK_CAPTURE(BM_Decompress, zlib_iq, CompressorType::ZLIB, iq_data);
+BENCHMARK_CAPTURE(BM_Decompress, zlib_json, CompressorType::ZLIB, json_data);
+BENCHMARK_CAPTURE(BM_PerMessage, zlib_create, CompressorType::ZLIB, false);
+BENCHMARK_CAPTURE(BM_PerMessage, zlib_pooled, CompressorType::ZLIB, true);
+BENCHMARK_CAPTURE(BM_SeekableRead, zlib_iq, CompressorType::ZLIB)
+    ->Arg(0) CORES_ARGS;
+#endif
+
+#ifdef CSICS_USE_LZ4
+BENCHMARK_CAPTURE(BM_Compress, lz4_iq, CompressorType::LZ4, iq_data,
+                  with_level(std::nullopt));
+BENCHMARK_CAPTURE(BM_Compress, lz4_json, CompressorType::LZ4, json_data,
+                  with_level(std::nullopt));
+BENCHMARK_CAPTURE(BM_Compress, lz4_fast8_iq, CompressorType::LZ4, iq_data,
+                  with_level(-8));
+BENCHMARK_CAPTURE(BM_Compress, lz4_fast8_json, CompressorType::LZ4, json_data,
+                  with_level(-8));
+BENCHMARK_CAPTURE(BM_Compress, lz4hc_iq, CompressorType::LZ4, iq_data,
+                  with_level(9));
+BENCHMARK_CAPTURE(BM_Compress, lz4hc_json, CompressorType::LZ4, json_data,
+                  with_level(9));
+BENCHMARK_CAPTURE(BM_Compress, lz4_shuf_iq, CompressorType::LZ4,
+                  iq_data, with_filter(IQFilter::Shuffle));
+BENCHMARK_CAPTURE(BM_Compress, lz4_dshuf_iq, CompressorType::LZ4,
+                  iq_data, with_filter(IQFilter::DeltaShuffle));
+BENCHMARK_CAPTURE(BM_Compress, lz4_dbitshuf_iq, CompressorType::LZ4,
+                  iq_data, with_filter(IQFilter::DeltaBitShuffle));
+BENCHMARK_CAPTURE(BM_ParallelFrames, lz4_iq, CompressorType::LZ4, iq_data)
+CORES_ARGS;
+BENCHMARK_CAPTURE(BM_ParallelFrames, lz4_json, CompressorType::LZ4, json_data)
+CORES_ARGS;
+BENCHMARK_CAPTURE(BM_Decompress, lz4_iq, CompressorType::LZ4, iq_data);
+BENCHMARK_CAPTURE(BM_Decompress, lz4_json, CompressorType::LZ4, json_data);
+BENCHMARK_CAPTURE(BM_PerMessage, lz4_create, CompressorType::LZ4, false);
+BENCHMARK_CAPTURE(BM_PerMessage, lz4_pooled, CompressorType::LZ4, true);
+BENCHMARK_CAPTURE(BM_SeekableRead, lz4_iq, CompressorType::LZ4)
+    ->Arg(0) CORES_ARGS;
+#endif
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <csics/csics.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+namespace {
+
+constexpr std::size_t kMessages = 4096;
+
+// MQTT telemetry payloads, a few hundred bytes each.
+std::vector<std::string> make_messages(std::size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> value(-120, 120);
+    std::vector<std::string> msgs;
+    msgs.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        msgs.push_back(
+            "{\"type\":\"telemetry\",\"sensor_id\":\"node-" +
+            std::to_string(value(rng) & 15) + "\",\"timestamp_ns\":" +
+            std::to_string(1700000000000000000ull + i * 1000003) +
+            ",\"center_freq_hz\":915000000,\"sample_rate_hz\":2000000,"
+            "\"gain_db\":" +
+            std::to_string(value(rng) & 63) +
+            ",\"rssi_dbm\":" + std::to_string(value(rng)) +
+            ",\"noise_floor_dbm\":" + std::to_string(value(rng)) +
+            ",\"position\":{\"lat\":" + std::to_string(value(rng) * 0.7) +
+            ",\"lon\":" + std::to_string(value(rng) * 1.3) + "}}");
+    }
+    return msgs;
+}
+
+const std::vector<std::string>& messages() {
+    static const auto msgs = make_messages(kMessages, 1);
+    return msgs;
+}
+
+std::shared_ptr<const Dictionary> dictionary() {
+    static const auto dict = [] {
+        auto training = make_messages(4 * kMessages, 2);
+        std::vector<BufferView> samples;
+        for (auto& m : training) {
+            samples.emplace_back(m.data(), m.size());
+        }
+        return Dictionary::train(samples, 16 * 1024, 50000);
+    }();
+    return dict;
+}
+
+// One frame per message on a reused context, as a publisher would.
+void BM_SmallMessages(benchmark::State& state, bool use_dictionary) {
+    CompressionOptions options{};
+    if (use_dictionary) {
+        options.dictionary = dictionary();
+    }
+    auto compressor = ICompressor::create(CompressorType::ZSTD, options);
+    auto msgs = messages();
+    std::vector<char> out(4096);
+    std::size_t in_bytes = 0;
+    std::size_t out_bytes = 0;
+    for (auto _ : state) {
+        for (auto& m : msgs) {
+            auto r = compressor->finish(BufferView(m.data(), m.size()),
+                                        BufferView(out));
+            benchmark::DoNotOptimize(out.data());
+            in_bytes += m.size();
+            out_bytes += r.compressed;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * msgs.size());
+    state.SetBytesProcessed(in_bytes);
+    state.counters["ratio"] =
+        static_cast<double>(in_bytes) / static_cast<double>(out_bytes);
+}
+
+void BM_SmallMessagesDecompress(benchmark::State& state,
+                                bool use_dictionary) {
+    CompressionOptions options{};
+    DecompressionOptions doptions{};
+    if (use_dictionary) {
+        options.dictionary = dictionary();
+        doptions.dictionaries = {dictionary()};
+    }
+    auto compressor = ICompressor::create(CompressorType::ZSTD, options);
+    auto msgs = messages();
+    std::vector<std::vector<char>> frames;
+    for (auto& m : msgs) {
+        std::vector<char> out(4096);
+        auto r = compressor->finish(BufferView(m.data(), m.size()),
+                                    BufferView(out));
+        out.resize(r.compressed);
+        frames.push_back(std::move(out));
+    }
+
+    auto decompressor = IDecompressor::create(CompressorType::ZSTD, doptions);
+    std::vector<char> out(4096);
+    for (auto _ : state) {
+        for (auto& f : frames) {
+            auto r = decompressor->finish(BufferView(f), BufferView(out));
+            benchmark::DoNotOptimize(r);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * frames.size());
+}
+
+};  // namespace
+
+BENCHMARK_CAPTURE(BM_SmallMessages, plain, false);
+BENCHMARK_CAPTURE(BM_SmallMessages, dictionary, true);
+BENCHMARK_CAPTURE(BM_SmallMessagesDecompress, plain, false);
+BENCHMARK_CAPTURE(BM_SmallMessagesDecompress, dictionary, true);
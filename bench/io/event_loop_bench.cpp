@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <csics/csics.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::net;
+
+namespace {
+
+// A loopback server on its own loop thread. Each accepted connection is
+// handed to `on_accept`, which may keep it or let it close.
+class LoopbackServer {
+   public:
+    template <typename OnAccept>
+    explicit LoopbackServer(OnAccept on_accept) {
+        listener_.listen(SockAddr::localhost(0), 1024);
+        loop_.add(listener_, IoEvent::Readable, [this, on_accept](IoEvent) {
+            for (;;) {
+                auto c = std::make_unique<TCPEndpoint>();
+                if (listener_.accept(*c) != NetStatus::Success) {
+                    return;
+                }
+                on_accept(*this, std::move(c));
+            }
+        });
+        thread_ = std::thread([this] { loop_.run(); });
+    }
+
+    ~LoopbackServer() {
+        loop_.stop();
+        thread_.join();
+    }
+
+    SockAddr address() const {
+        return SockAddr::localhost(listener_.local_address().port());
+    }
+
+    // Echoes small messages back, on the loop thread.
+    static void echo(LoopbackServer& server, std::unique_ptr<TCPEndpoint> c) {
+        TCPEndpoint* raw = c.get();
+        server.loop_.add(*raw, IoEvent::Readable, [raw](IoEvent) {
+            char buffer[4096];
+            for (;;) {
+                auto r = raw->recv(BufferView(buffer, sizeof(buffer)));
+                if (r.status != NetStatus::Success) {
+                    return;
+                }
+                raw->send(BufferView(buffer, r.bytes_transferred));
+            }
+        });
+        server.connections_.push_back(std::move(c));
+    }
+
+   private:
+    EventLoop loop_;
+    TCPEndpoint listener_;
+    std::vector<std::unique_ptr<TCPEndpoint>> connections_;
+    std::thread thread_;
+};
+
+// A whole connection: connect, the loop accepts and closes it, the client
+// sees the close.
+void BM_LoopbackConnect(benchmark::State& state) {
+    LoopbackServer server([](LoopbackServer&, std::unique_ptr<TCPEndpoint>) {
+    });
+    char byte;
+    for (auto _ : state) {
+        TCPEndpoint client;
+        if (client.connect(server.address()) != NetStatus::Success ||
+            client.recv(BufferView(&byte, 1)).status !=
+                NetStatus::Disconnected) {
+            state.SkipWithError("connection failed");
+            return;
+        }
+    }
+    state.counters["connections/s"] =
+        benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// Round trip of a 64 byte frame, with range(0) idle connections on the
+// same loop.
+void BM_LoopbackRoundTrip(benchmark::State& state) {
+    LoopbackServer server(LoopbackServer::echo);
+    std::vector<TCPEndpoint> idle(static_cast<std::size_t>(state.range(0)));
+    for (auto& c : idle) {
+        c.connect(server.address());
+    }
+    TCPEndpoint client;
+    if (client.connect(server.address()) != NetStatus::Success) {
+        state.SkipWithError("connection failed");
+        return;
+    }
+    char frame[64] = {};
+    char reply[64];
+    for (auto _ : state) {
+        client.send(BufferView(frame, sizeof(frame)));
+        std::size_t got = 0;
+        while (got < sizeof(reply)) {
+            auto r = client.recv(
+                BufferView(reply + got, sizeof(reply) - got));
+            if (r.status != NetStatus::Success) {
+                state.SkipWithError("echo failed");
+                return;
+            }
+            got += r.bytes_transferred;
+        }
+    }
+    state.counters["messages/s"] =
+        benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+};  // namespace
+
+BENCHMARK(BM_LoopbackConnect)->UseRealTime();
+BENCHMARK(BM_LoopbackRoundTrip)->Arg(0)->Arg(256)->UseRealTime();
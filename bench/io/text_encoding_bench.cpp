@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <csics/csics.hpp>
+#include <random>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::encdec;
+
+// Counted as in base64_bench.cpp, plain bytes for encoders and encoded ones
+// for decoders, at the same sizes, so the rates compare directly with
+// BM_Base64Encode and BM_Base64Decode.
+namespace {
+
+std::vector<uint8_t> random_bytes(std::size_t size) {
+    std::vector<uint8_t> out(size);
+    std::mt19937 rng(1);
+    for (auto& b : out) {
+        b = static_cast<uint8_t>(rng());
+    }
+    return out;
+}
+
+void BM_Encode(benchmark::State& state, ICodec& encoder, std::size_t ratio) {
+    auto input = random_bytes(static_cast<std::size_t>(state.range(0)));
+    std::vector<uint8_t> output(ratio * input.size() + 16);
+    for (auto _ : state) {
+        auto r = encoder.finish(BufferView(input), BufferView(output));
+        benchmark::DoNotOptimize(r);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void BM_Decode(benchmark::State& state, ICodec& encoder, ICodec& decoder,
+               std::size_t ratio) {
+    auto plain = random_bytes(static_cast<std::size_t>(state.range(0)));
+    std::vector<uint8_t> input(ratio * plain.size() + 16);
+    auto e = encoder.finish(BufferView(plain), BufferView(input));
+    input.resize(e.output);
+    std::vector<uint8_t> output(plain.size());
+    for (auto _ : state) {
+        auto r = decoder.finish(BufferView(input), BufferView(output));
+        if (r.status != EncodingStatus::Ok) {
+            state.SkipWithError("decoding failed");
+            return;
+        }
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+void BM_HexEncode(benchmark::State& state, Base64Isa isa) {
+    if (!base64_isa_supported(isa)) {
+        state.SkipWithError("ISA not supported");
+        return;
+    }
+    HexEncoder encoder(isa);
+    BM_Encode(state, encoder, 2);
+}
+
+void BM_HexDecode(benchmark::State& state, Base64Isa isa) {
+    if (!base64_isa_supported(isa)) {
+        state.SkipWithError("ISA not supported");
+        return;
+    }
+    HexEncoder encoder(isa);
+    HexDecoder decoder(isa);
+    BM_Decode(state, encoder, decoder, 2);
+}
+
+void BM_Base32Encode(benchmark::State& state) {
+    Base32Encoder encoder;
+    BM_Encode(state, encoder, 2);
+}
+
+void BM_Base32Decode(benchmark::State& state) {
+    Base32Encoder encoder;
+    Base32Decoder decoder;
+    BM_Decode(state, encoder, decoder, 2);
+}
+
+void BM_Z85Encode(benchmark::State& state) {
+    Z85Encoder encoder;
+    BM_Encode(state, encoder, 2);
+}
+
+void BM_Z85Decode(benchmark::State& state) {
+    Z85Encoder encoder;
+    Z85Decoder decoder;
+    BM_Decode(state, encoder, decoder, 2);
+}
+
+};  // namespace
+
+BENCHMARK_CAPTURE(BM_HexEncode, scalar, Base64Isa::Scalar)
+    ->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_HexEncode, ssse3, Base64Isa::SSSE3)
+    ->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_HexEncode, avx2, Base64Isa::AVX2)
+    ->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_HexDecode, scalar, Base64Isa::Scalar)
+    ->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_HexDecode, ssse3, Base64Isa::SSSE3)
+    ->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK_CAPTURE(BM_HexDecode, avx2, Base64Isa::AVX2)
+    ->Arg(1 << 10)->Arg(1 << 20);
+// Z85 streams must be a multiple of 4 bytes long, as these sizes are.
+BENCHMARK(BM_Base32Encode)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_Base32Decode)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_Z85Encode)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_Z85Decode)->Arg(1 << 10)->Arg(1 << 20);
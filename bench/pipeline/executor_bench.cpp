@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <csics/csics.hpp>
+#include <cstring>
+#include <thread>
+
+using namespace csics;
+using namespace csics::pipeline;
+using BlockHeader = radio::IRadioRx::BlockHeader;
+
+namespace {
+
+constexpr std::size_t kBlockLen = 4096;
+constexpr std::size_t kNumBlocks = 512;
+constexpr std::size_t kTaps = 64;
+
+// Direct-form FIR over every block, heavy enough that one worker is the
+// bottleneck of the chain.
+struct FirStage : IStage {
+    float taps[kTaps];
+
+    FirStage() {
+        for (std::size_t i = 0; i < kTaps; i++) {
+            taps[i] = 1.0f / static_cast<float>(kTaps);
+        }
+    }
+
+    std::size_t output_block_size(std::size_t in) const noexcept override {
+        return in;
+    }
+
+    StageResult process(BufferView in, BufferView out) noexcept override {
+        std::memcpy(out.data(), in.data(), sizeof(BlockHeader));
+        auto* src = reinterpret_cast<const radio::SDRRawSample*>(
+            in.data() + sizeof(BlockHeader));
+        auto* dst = reinterpret_cast<radio::SDRRawSample*>(
+            out.data() + sizeof(BlockHeader));
+        std::size_t n = (in.size() - sizeof(BlockHeader)) /
+                        sizeof(radio::SDRRawSample);
+        for (std::size_t i = 0; i < n; i++) {
+            float re = 0;
+            float im = 0;
+            std::size_t taps_used = std::min(i + 1, kTaps);
+            for (std::size_t k = 0; k < taps_used; k++) {
+                re += taps[k] * src[i - k].real();
+                im += taps[k] * src[i - k].imag();
+            }
+            dst[i] = radio::SDRRawSample(static_cast<int16_t>(re),
+                                         static_cast<int16_t>(im));
+        }
+        return {in.size(), StageStatus::Ok};
+    }
+};
+
+};  // namespace
+
+static void run_chain(benchmark::State& state, std::size_t workers) {
+    std::unique_ptr<WorkStealingExecutor> executor;
+    if (workers > 0) {
+        executor = std::make_unique<WorkStealingExecutor>(workers);
+    }
+    for (auto _ : state) {
+        PipelineGraph graph;
+        SyntheticSource::Config cfg;
+        cfg.block_len = kBlockLen;
+        cfg.num_blocks = kNumBlocks;
+        graph.add_source(std::make_unique<SyntheticSource>(cfg));
+        if (executor) {
+            graph.add_parallel_stage(std::make_unique<FirStage>(), *executor);
+        } else {
+            graph.add_stage(std::make_unique<FirStage>());
+        }
+        auto sink = [](BufferView in) {
+            benchmark::DoNotOptimize(in.data());
+            return StageStatus::Ok;
+        };
+        graph.add_stage(std::make_unique<SinkStage<decltype(sink)>>(sink));
+        graph.start();
+        graph.wait();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumBlocks);
+    state.SetBytesProcessed(state.iterations() * kNumBlocks * kBlockLen *
+                            sizeof(radio::SDRRawSample));
+}
+
+// Baseline: the FIR stage on its own pipeline thread.
+static void BM_FirSerialStage(benchmark::State& state) { run_chain(state, 0); }
+BENCHMARK(BM_FirSerialStage)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Scaling curve of the same chain from 1 to N executor workers.
+static void BM_FirParallelStage(benchmark::State& state) {
+    run_chain(state, static_cast<std::size_t>(state.range(0)));
+}
+BENCHMARK(BM_FirParallelStage)
+    ->Apply([](benchmark::internal::Benchmark* b) {
+        int n = static_cast<int>(
+            std::max(1u, std::thread::hardware_concurrency()));
+        for (int w = 1; w <= n; w *= 2) {
+            b->Arg(w);
+        }
+        if ((n & (n - 1)) != 0) {
+            b->Arg(n);
+        }
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -9,3 +9,7 @@ if (CSICS_BUILD_GEO AND NOT CSICS_BUILD_LINALG )
     message(FATAL_ERROR "Geo component requires Linalg component. Please enable CSICS_BUILD_LINALG.")
 endif()
 
+
+if (CSICS_BUILD_PIPELINE AND NOT CSICS_BUILD_RADIO)
+    message(FATAL_ERROR "Pipeline component requires Radio component. Please enable CSICS_BUILD_RADIO.")
+endif()
@@ -62,6 +62,51 @@ if (CSICS_USE_ZSTD)
     endif()
 endif()
 
+# LZ4 ships no CMake package. The definition is only added once it is found,
+# so a missing library disables the backend instead of breaking the build.
+if (CSICS_USE_LZ4)
+    find_path(LZ4_INCLUDE_DIRS lz4frame.h)
+    find_library(LZ4_LIBRARIES lz4)
+    if (LZ4_INCLUDE_DIRS AND LZ4_LIBRARIES)
+        add_library(lz4 INTERFACE)
+        target_include_directories(lz4 INTERFACE ${LZ4_INCLUDE_DIRS})
+        target_link_libraries(lz4 INTERFACE ${LZ4_LIBRARIES})
+        message(STATUS "Using LZ4 compression support.")
+        list(APPEND CSICS_COMPILE_DEFINITIONS CSICS_USE_LZ4)
+    else()
+        message(WARNING "LZ4 library not found but CSICS_USE_LZ4 is ON.")
+        set(CSICS_USE_LZ4 OFF)
+    endif()
+endif()
+
+# Only speeds up ZLIB, so a missing library just keeps zlib doing the work.
+if (CSICS_USE_LIBDEFLATE AND ZLIB_FOUND)
+    find_path(LIBDEFLATE_INCLUDE_DIRS libdeflate.h)
+    find_library(LIBDEFLATE_LIBRARIES deflate)
+    if (LIBDEFLATE_INCLUDE_DIRS AND LIBDEFLATE_LIBRARIES)
+        message(STATUS "Using libdeflate for one-shot ZLIB compression.")
+        list(APPEND CSICS_COMPILE_DEFINITIONS CSICS_USE_LIBDEFLATE)
+    else()
+        message(STATUS "libdeflate not found, ZLIB compresses with zlib only.")
+        set(CSICS_USE_LIBDEFLATE OFF)
+    endif()
+else()
+    set(CSICS_USE_LIBDEFLATE OFF)
+endif()
+
+# CRC32C is built in, a missing library only leaves out XXH3.
+if (CSICS_USE_XXHASH)
+    find_path(XXHASH_INCLUDE_DIRS xxhash.h)
+    find_library(XXHASH_LIBRARIES xxhash)
+    if (XXHASH_INCLUDE_DIRS AND XXHASH_LIBRARIES)
+        message(STATUS "Using libxxhash for XXH3 checksums.")
+        list(APPEND CSICS_COMPILE_DEFINITIONS CSICS_USE_XXHASH)
+    else()
+        message(STATUS "libxxhash not found, checksums are CRC32C only.")
+        set(CSICS_USE_XXHASH OFF)
+    endif()
+endif()
+
 if (CSICS_BUILD_GEO)
     find_package(GeographicLib)
     if (NOT GeographicLib_FOUND)
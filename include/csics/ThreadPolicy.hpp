@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace csics {
+
+enum class ThreadPolicyError : uint8_t {
+    None,
+    InvalidArgument,   // Core out of range or priority outside SCHED_FIFO's.
+    PermissionDenied,  // Needs CAP_SYS_NICE/CAP_IPC_LOCK or a higher rlimit.
+    NotIsolated,       // Applied, but a core is not isolated by the kernel.
+    Unsupported,       // Not available on this platform.
+    SystemError,
+};
+
+/** @brief Scheduling setup for a latency sensitive thread.
+ * A default constructed policy leaves the thread untouched.
+ */
+struct ThreadPolicy {
+    // Cores the thread may run on, empty keeps the inherited mask.
+    std::vector<int> cpus;
+    // SCHED_FIFO priority (1-99), 0 keeps the default time-sharing policy.
+    int fifo_priority = 0;
+    // Locks current and future pages of the whole process into RAM, so the
+    // thread never takes a page fault on its buffers.
+    bool lock_memory = false;
+    // The cores in `cpus` are expected to be kept free of other tasks
+    // (isolcpus= or nohz_full=). Only checked, reported as NotIsolated.
+    bool expect_isolated = false;
+    // Shown by top and perf, truncated to 15 characters.
+    std::string name;
+};
+
+struct ThreadPolicyResult {
+    ThreadPolicyError affinity = ThreadPolicyError::None;
+    ThreadPolicyError scheduling = ThreadPolicyError::None;
+    ThreadPolicyError memory = ThreadPolicyError::None;
+
+    // NotIsolated is only a hint and does not count as a failure.
+    operator bool() const noexcept {
+        return (affinity == ThreadPolicyError::None ||
+                affinity == ThreadPolicyError::NotIsolated) &&
+               scheduling == ThreadPolicyError::None &&
+               memory == ThreadPolicyError::None;
+    }
+};
+
+struct ThreadStats {
+    int tid = -1;  // Kernel thread id, -1 if unknown.
+    int last_cpu = -1;
+    uint64_t voluntary_switches = 0;
+    // Preemptions. A steadily rising count on a receive thread usually
+    // precedes overflows.
+    uint64_t involuntary_switches = 0;
+};
+
+/**
+ * @brief Applies a policy to the calling thread.
+ * Every part is attempted even if an earlier one fails.
+ */
+ThreadPolicyResult apply_thread_policy(const ThreadPolicy& policy) noexcept;
+
+// Applies a policy to another thread of this process.
+ThreadPolicyResult apply_thread_policy(std::thread& thread,
+                                       const ThreadPolicy& policy) noexcept;
+
+// Unsupported for every part the policy requests, for threads or platforms
+// that cannot apply it.
+ThreadPolicyResult unsupported_thread_policy(
+    const ThreadPolicy& policy) noexcept;
+
+// Kernel id of the calling thread, -1 where unsupported.
+int current_thread_id() noexcept;
+
+/**
+ * @brief Context switch counters of a live thread of this process.
+ * @return tid of -1 if the thread has exited or on unsupported platforms.
+ */
+ThreadStats thread_stats(int tid) noexcept;
+
+ThreadStats current_thread_stats() noexcept;
+
+// Cores the kernel isolates from general scheduling, empty if none.
+std::vector<int> isolated_cpus();
+
+};  // namespace csics
@@ -1,11 +1,16 @@
 #include <csics/Buffer.hpp>
+#include <csics/ThreadPolicy.hpp>
 
 #ifdef CSICS_BUILD_QUEUE
 #include <csics/queue/queue.hpp>
 #endif
 
 #ifdef CSICS_BUILD_RADIO
-#include <csics/radio/radio.hpp>
+#include <csics/radio/DeviceCache.hpp>
+#include <csics/radio/Radio.hpp>
+#include <csics/radio/RadioAggregator.hpp>
+#include <csics/radio/RadioRx.hpp>
+#include <csics/radio/RadioTx.hpp>
 #endif
 
 #ifdef CSICS_BUILD_IO
@@ -13,7 +18,8 @@
 #endif
 
 #ifdef CSICS_BUILD_SERIALIZATION
-#include <csics/serialization/serialization.hpp>
+#include <csics/serialization/Serialization.hpp>
+#include <csics/serialization/JSONSerializer.hpp>
 #endif
 
 #ifdef CSICS_BUILD_LINALG
@@ -23,3 +29,7 @@
 #ifdef CSICS_BUILD_GEO
 #include <csics/geo/geo.hpp>
 #endif
+
+#ifdef CSICS_BUILD_PIPELINE
+#include <csics/pipeline/pipeline.hpp>
+#endif
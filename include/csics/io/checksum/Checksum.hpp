@@ -0,0 +1,59 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <cstdint>
+namespace csics::io::checksum {
+
+enum class ChecksumType : uint8_t {
+    // Castagnoli CRC, as in iSCSI, ext4 and SCTP. SSE4.2 computes it in
+    // hardware.
+    CRC32C,
+#ifdef CSICS_USE_XXHASH
+    // 64 bit XXH3, not a CRC but faster still without hardware support.
+    XXH3,
+#endif
+};
+
+// True when crc32c() uses the SSE4.2 instruction.
+bool crc32c_hardware() noexcept;
+
+// Extends `crc`, the CRC32C of the data before `data`. 0 starts a new one.
+uint32_t crc32c(BufferView data, uint32_t crc = 0) noexcept;
+
+// The table driven fallback crc32c() uses without SSE4.2.
+uint32_t crc32c_portable(BufferView data, uint32_t crc = 0) noexcept;
+
+/**
+ * @brief An incremental checksum of any ChecksumType. Feeding the data in
+ * pieces gives the same digest as one update() with all of it, so it can
+ * run alongside a streaming call while each piece is still in cache; see
+ * encdec::ChecksumCodec.
+ */
+class Checksum {
+   public:
+    // Throws std::invalid_argument if `type` is unknown, std::bad_alloc
+    // if the XXH3 state cannot be allocated.
+    explicit Checksum(ChecksumType type = ChecksumType::CRC32C);
+    ~Checksum();
+    Checksum(Checksum&& other) noexcept;
+    Checksum& operator=(Checksum&& other) noexcept;
+    Checksum(const Checksum&) = delete;
+    Checksum& operator=(const Checksum&) = delete;
+
+    void update(BufferView data) noexcept;
+    // Of everything since construction or the last reset(), zero extended
+    // for CRC32C.
+    uint64_t digest() const noexcept;
+    void reset() noexcept;
+    ChecksumType type() const noexcept { return type_; }
+
+   private:
+    ChecksumType type_;
+    uint32_t crc_ = 0;
+    // XXH3_state_t, kept out of this header.
+    void* xxh3_ = nullptr;
+};
+
+// One-shot digest of `data`, as Checksum would give.
+uint64_t checksum(ChecksumType type, BufferView data);
+
+};  // namespace csics::io::checksum
@@ -0,0 +1,163 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <csics/ThreadPolicy.hpp>
+#include <csics/io/compression/Compressor.hpp>
+#include <csics/io/compression/LevelController.hpp>
+#include <csics/queue/SPSCQueue.hpp>
+#include <memory>
+#include <optional>
+#include <thread>
+
+namespace csics::io::compression {
+
+/** @brief Header of every block CompressionStage writes, followed by the
+ * next bytes of the compressed stream.
+ */
+struct CompressedBlockHeader {
+    enum class Flags : uint32_t {
+        NONE = 0,
+        // First block of a frame, decoding can start here.
+        FRAME_START = 1u << 0,
+        // Last block of a frame.
+        FRAME_END = 1u << 1,
+        // The frame holds the input as is, it was not compressed.
+        STORED = 1u << 2,
+    };
+
+    // Uncompressed stream offset the frame starts at.
+    uint64_t frame_offset;
+    // Frame number, counted from 0.
+    uint32_t frame;
+    Flags flags;
+
+    bool has(Flags flag) const noexcept {
+        return (static_cast<uint32_t>(flags) &
+                static_cast<uint32_t>(flag)) != 0;
+    }
+};
+
+/** @brief Compresses the blocks of one queue into another on its own
+ * thread.
+ * Input blocks are read from the ReadHandle and compressed as one stream
+ * straight into WriteSlots of the output queue, each a
+ * CompressedBlockHeader and up to output_block_size bytes. A block is
+ * committed once full, at the end of a frame, or when the input runs dry so
+ * the consumer is never far behind.
+ *
+ * Every blocks_per_frame input blocks the frame is finished and a new one
+ * begins in a new output block. Frames decode on their own, so a reader
+ * can seek to any block flagged FRAME_START.
+ *
+ * With adaptive_level set, a LevelController picks the level of each frame
+ * from the input queue fill and the output rate, storing frames when even
+ * the lowest level falls behind.
+ */
+class CompressionStage {
+   public:
+    struct Config {
+        CompressorType type;
+        CompressionOptions options;
+        // Input blocks per frame, 0 keeps one frame for the whole stream.
+        std::size_t blocks_per_frame = 0;
+        // Largest compressed payload of an output block. The output queue
+        // must fit at least one, see SPSCQueue::capacity_for.
+        std::size_t output_block_size = 64 * 1024;
+        ThreadPolicy thread_policy;
+        // Needs blocks_per_frame. Starts at options.level, or at max_level
+        // if unset.
+        std::optional<LevelController::Config> adaptive_level;
+    };
+
+    struct Stats {
+        uint64_t blocks_in = 0;
+        uint64_t bytes_in = 0;
+        uint64_t blocks_out = 0;
+        // Compressed bytes, without the block headers.
+        uint64_t bytes_out = 0;
+        uint64_t frames = 0;
+        uint64_t stored_frames = 0;
+        // Times a block was ready but the output queue was full.
+        uint64_t output_stalls = 0;
+        // Level of the current frame.
+        int level = 0;
+    };
+
+    // Throws std::invalid_argument for an unsupported backend or options,
+    // or an adaptive level range the backend does not support.
+    CompressionStage(queue::SPSCQueue::ReadHandle in,
+                     queue::SPSCQueue::WriteHandle out, const Config& config);
+    // Stops the stage, see stop().
+    ~CompressionStage();
+
+    CompressionStage(const CompressionStage&) = delete;
+    CompressionStage& operator=(const CompressionStage&) = delete;
+
+    // Starts the stage thread. Returns the outcome of the thread policy.
+    ThreadPolicyResult start();
+
+    /**
+     * @brief Ends the stream once every block committed to the input so
+     * far is compressed, finishing the last frame, and joins the thread.
+     * Needs the output queue to keep draining.
+     * @return InputBufferFinished, or FatalError if the backend failed or
+     * an output block did not fit the queue.
+     */
+    CompressionStatus stop();
+
+    // Set once the last block is committed. May be called from any thread.
+    bool done() const noexcept {
+        return done_.load(std::memory_order_acquire);
+    }
+
+    bool failed() const noexcept {
+        return failed_.load(std::memory_order_acquire);
+    }
+
+    // May be called from any thread.
+    Stats stats() const noexcept;
+
+   private:
+    void run() noexcept;
+    bool compress_block(BufferView in) noexcept;
+    bool end_frame() noexcept;
+    // Lets the controller pick the settings of the next frame.
+    void adapt() noexcept;
+    // Acquires an output block unless one is open, waiting for room.
+    bool open_block() noexcept;
+    // Free space in the open output block.
+    BufferView space() noexcept;
+    // Commits the open output block if it holds data or `flags` are set.
+    void publish(CompressedBlockHeader::Flags flags) noexcept;
+
+    queue::SPSCQueue::ReadHandle in_;
+    queue::SPSCQueue::WriteHandle out_;
+    Config config_;
+    std::unique_ptr<ICompressor> compressor_;
+    std::optional<LevelController> controller_;
+    std::thread thread_;
+
+    // Stage thread only.
+    queue::SPSCQueue::WriteSlot slot_;
+    std::size_t slot_used_ = 0;
+    std::size_t frame_blocks_ = 0;
+    uint64_t frame_offset_ = 0;
+    bool frame_started_ = false;
+    bool store_ = false;
+    std::chrono::steady_clock::time_point frame_start_;
+    uint64_t frame_start_bytes_out_ = 0;
+
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> done_{false};
+    std::atomic<bool> failed_{false};
+    std::atomic<uint64_t> blocks_in_{0};
+    std::atomic<uint64_t> bytes_in_{0};
+    std::atomic<uint64_t> blocks_out_{0};
+    std::atomic<uint64_t> bytes_out_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> stored_frames_{0};
+    std::atomic<int> level_{0};
+    std::atomic<uint64_t> output_stalls_{0};
+};
+
+};  // namespace csics::io::compression
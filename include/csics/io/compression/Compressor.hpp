@@ -1,7 +1,9 @@
 #pragma once
 #include <csics/Buffer.hpp>
+#include <csics/io/compression/IQFilter.hpp>
 #include <cstddef>
 #include <memory>
+#include <optional>
 
 namespace csics::io::compression {
 enum class CompressionStatus : uint8_t {
@@ -22,6 +24,9 @@ enum class CompressorType : uint8_t {
 #ifdef CSICS_USE_ZSTD
     ZSTD,
 #endif
+#ifdef CSICS_USE_LZ4
+    LZ4,
+#endif
 };
 
 struct CompressionResult {
@@ -32,6 +37,52 @@ struct CompressionResult {
     CompressionStatus status;
 };
 
+class Dictionary;
+
+// Framing of a ZLIB stream.
+enum class ZLIBFormat : uint8_t {
+    // RFC 1950, a 2 byte header and an Adler-32 trailer.
+    Zlib,
+    // RFC 1952, as HTTP and .gz consumers expect.
+    Gzip,
+    // Bare RFC 1951 deflate, for containers doing their own framing.
+    Raw,
+};
+
+// Match search of ZLIB, see deflateInit2.
+enum class ZLIBStrategy : uint8_t {
+    Default,
+    Filtered,
+    HuffmanOnly,
+    RLE,
+    Fixed,
+};
+
+/** @brief Tuning shared by the backends, unset fields keep the backend's
+ * default.
+ */
+struct CompressionOptions {
+    // For LZ4, negative levels accelerate and 3 to 12 select LZ4HC.
+    std::optional<int> level;
+    // Log2 of the match window. For ZSTD larger windows need the same
+    // limit on the decompressor, ZLIB takes 9 to 15.
+    int window_log = 0;
+    // Finds repeats far back in the window, e.g. in periodic signals.
+    // ZSTD only.
+    bool long_distance_matching = false;
+    // Threads compressing a single frame, 0 compresses on the calling
+    // thread. ZSTD only, needs a multithreaded libzstd.
+    unsigned workers = 0;
+    // Compresses with a trained dictionary at its own level, which
+    // supersedes `level` and `window_log`. ZSTD only.
+    std::shared_ptr<const Dictionary> dictionary;
+    // Pre-filter for SC16 input, the decompressor needs the same one.
+    IQFilter filter = IQFilter::None;
+    // ZLIB only.
+    ZLIBFormat zlib_format = ZLIBFormat::Zlib;
+    ZLIBStrategy zlib_strategy = ZLIBStrategy::Default;
+};
+
 class ICompressor {
    public:
     virtual ~ICompressor() = default;
@@ -40,8 +91,20 @@ class ICompressor {
     virtual CompressionResult compress_buffer(BufferView in,
                                               BufferView out) = 0;
     virtual CompressionResult finish(BufferView in, BufferView out) = 0;
+    // Drops any partial stream and starts a new one with the same options,
+    // reusing the context's memory.
+    virtual void reset() = 0;
+    // Level of the streams started after the next reset(), in the ranges
+    // of CompressionOptions::level. Returns false, keeping the current
+    // level, if the backend does not support it.
+    virtual bool set_level(int level) {
+        (void)level;
+        return false;
+    }
 
-    static std::unique_ptr<ICompressor> create(CompressorType type);
+    // Throws std::invalid_argument for unsupported types or options.
+    static std::unique_ptr<ICompressor> create(
+        CompressorType type, const CompressionOptions& options = {});
 };
 
 };  // namespace csics::io::compression
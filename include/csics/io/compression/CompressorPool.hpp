@@ -0,0 +1,54 @@
+#pragma once
+#include <csics/io/compression/Compressor.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace csics::io::compression {
+
+/** @brief Thread-safe pool of compressors sharing one configuration.
+ * Creating a compressor allocates its context (hundreds of KB for ZLIB and
+ * ZSTD). Borrowing one from the pool instead keeps that off the per-message
+ * path: contexts are reset and reused once warm.
+ */
+class CompressorPool {
+   public:
+    struct Release {
+        CompressorPool* pool;
+        void operator()(ICompressor* compressor) const noexcept;
+    };
+    // Returns the compressor to the pool when destroyed. Must not outlive
+    // the pool.
+    using Handle = std::unique_ptr<ICompressor, Release>;
+
+    /**
+     * @param prewarm Compressors created up front, at least one is.
+     * @param max_idle Compressors kept for reuse, extra ones returned are
+     * destroyed.
+     * Throws std::invalid_argument for an unsupported backend or options.
+     */
+    CompressorPool(CompressorType type, const CompressionOptions& options = {},
+                   std::size_t prewarm = 0, std::size_t max_idle = 64);
+
+    CompressorPool(const CompressorPool&) = delete;
+    CompressorPool& operator=(const CompressorPool&) = delete;
+
+    /**
+     * @brief Borrows a compressor at the start of a stream, creating one if
+     * none is idle. Throws like ICompressor::create.
+     */
+    Handle acquire();
+
+    std::size_t idle() const;
+
+   private:
+    void release(ICompressor* compressor) noexcept;
+
+    CompressorType type_;
+    CompressionOptions options_;
+    std::size_t max_idle_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ICompressor>> idle_;
+};
+
+};  // namespace csics::io::compression
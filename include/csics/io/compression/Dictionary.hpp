@@ -0,0 +1,58 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace csics::io::compression {
+
+/** @brief A ZSTD dictionary, digested once for compression and decompression
+ * and shared by any number of compressors and decompressors.
+ * Small messages of similar content compress much better with a dictionary
+ * trained on samples of them. Frames record the dictionary ID, which
+ * decompressors use to pick it among the dictionaries they know.
+ */
+class Dictionary {
+   public:
+    /**
+     * @brief Loads a dictionary saved from data().
+     * @param level Compression level of frames written with the dictionary.
+     * Throws std::invalid_argument if `data` is not a dictionary.
+     */
+    explicit Dictionary(BufferView data, int level = 3);
+    ~Dictionary();
+
+    Dictionary(const Dictionary&) = delete;
+    Dictionary& operator=(const Dictionary&) = delete;
+
+    /**
+     * @brief Trains a dictionary of at most `max_size` bytes.
+     * A few thousand samples totalling about 100 times `max_size` work
+     * best. Throws std::runtime_error if training fails, e.g. with too few
+     * or identical samples.
+     * @param id Recorded in frames, 0 picks a random one. IDs up to 32767
+     * and from 2^31 are reserved by the format for public dictionaries.
+     */
+    static std::shared_ptr<const Dictionary> train(
+        std::span<const BufferView> samples, std::size_t max_size = 16 * 1024,
+        uint32_t id = 0, int level = 3);
+
+    uint32_t id() const noexcept { return id_; }
+    int level() const noexcept { return level_; }
+    // Serialized dictionary, for storage and distribution to readers.
+    const std::vector<char>& data() const noexcept { return data_; }
+
+    // ZSTD_CDict* and ZSTD_DDict*.
+    const void* cdict() const noexcept { return cdict_; }
+    const void* ddict() const noexcept { return ddict_; }
+
+   private:
+    std::vector<char> data_;
+    uint32_t id_;
+    int level_;
+    void* cdict_;
+    void* ddict_;
+};
+
+};  // namespace csics::io::compression
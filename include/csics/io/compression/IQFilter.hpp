@@ -0,0 +1,40 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace csics::io::compression {
+
+/** @brief Invertible transforms of SC16 samples that make them easier to
+ * compress, in the spirit of Blosc's filters. Applied per block, so each
+ * block decodes on its own.
+ * - Shuffle: low bytes of every I and Q value, then the high bytes.
+ * - BitShuffle: like Shuffle, then each byte plane split into its 8 bit
+ *   planes, so the noisy low bits stop diluting the stable high ones.
+ * - Delta*: each value minus the previous value of the same channel,
+ *   zigzag encoded, before shuffling. Slowly varying signals become small
+ *   numbers with mostly zero high bytes.
+ */
+enum class IQFilter : uint8_t {
+    None,
+    Shuffle,
+    BitShuffle,
+    DeltaShuffle,
+    DeltaBitShuffle,
+};
+
+// Filter block size in bytes, a whole number of samples. The compressor
+// and the decompressor have to agree on it.
+inline constexpr std::size_t kIQFilterBlockSize = 64 * 1024;
+
+/**
+ * @brief Transforms a block of interleaved little-endian int16 I/Q pairs.
+ * `out` must hold in.size() bytes. Trailing bytes short of a whole sample
+ * are copied as is.
+ */
+void iq_filter_encode(IQFilter filter, BufferView in, BufferView out) noexcept;
+
+// Inverse of iq_filter_encode for a block of the same size.
+void iq_filter_decode(IQFilter filter, BufferView in, BufferView out) noexcept;
+
+};  // namespace csics::io::compression
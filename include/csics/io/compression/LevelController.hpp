@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace csics::io::compression {
+
+/** @brief Picks the compression level of each frame from how well the
+ * compressor keeps up with its input.
+ * A filling input queue means the compressor is too slow: the level backs
+ * off by half its distance to min_level, and past store_water frames are
+ * stored uncompressed until the queue drains below high_water. While the
+ * queue stays low there is CPU to spare, and the level climbs one step per
+ * frame towards max_level, as it does while the output exceeds its budget.
+ * Each change is held for hold_frames so its effect shows in the queue
+ * before the next one.
+ */
+class LevelController {
+   public:
+    struct Config {
+        // Levels of the backend, see CompressionOptions::level.
+        int min_level = 1;
+        int max_level = 9;
+        // Input queue fill, from 0 to 1.
+        double low_water = 0.1;
+        double high_water = 0.5;
+        // Above 1 frames are never stored.
+        double store_water = 0.9;
+        // Output rate the level is raised to stay under, e.g. the disk or
+        // link bandwidth, in bytes per second. 0 for none.
+        double max_output_bps = 0.0;
+        std::size_t hold_frames = 1;
+    };
+
+    struct Sample {
+        // Fraction of the input queue in use.
+        double fill;
+        // Compressed bytes per second over the last frame.
+        double output_bps;
+    };
+
+    struct Decision {
+        // Store the next frame uncompressed, `level` is kept for later.
+        bool store;
+        int level;
+    };
+
+    // Throws std::invalid_argument for empty or unordered ranges.
+    LevelController(const Config& config, int initial_level);
+
+    // Called after each frame, returns the settings of the next one.
+    Decision update(const Sample& sample) noexcept;
+
+    Decision current() const noexcept { return {store_, level_}; }
+
+   private:
+    Config config_;
+    int level_;
+    bool store_ = false;
+    std::size_t hold_ = 0;
+};
+
+};  // namespace csics::io::compression
@@ -0,0 +1,99 @@
+#pragma once
+#include <condition_variable>
+#include <csics/io/compression/Compressor.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace csics::io::compression {
+
+/** @brief Compresses fixed-size chunks as independent frames on a pool of
+ * worker threads.
+ * Output is written in input order, so it can be streamed as it completes.
+ * Each chunk becomes one complete frame of the backend: for ZSTD the result
+ * is a standard multi-frame stream, for ZLIB a sequence of zlib streams the
+ * reader inflates one after another. Frames can also be decompressed
+ * independently, given their offsets.
+ *
+ * Unlike CompressionOptions::workers, which splits a single frame, this
+ * scales with any backend at a small cost in ratio at chunk boundaries.
+ */
+class ParallelCompressor : public ICompressor {
+   public:
+    struct Config {
+        CompressorType type;
+        CompressionOptions options;
+        // Uncompressed size of each frame.
+        std::size_t chunk_size = 1 << 20;
+        // 0 uses one thread per core.
+        std::size_t workers = 0;
+        // Frames filling, compressing or waiting to be written, 0 for
+        // twice the workers. Bounds memory to about 2 * chunk_size each.
+        std::size_t max_in_flight = 0;
+    };
+
+    // Throws std::invalid_argument for an unsupported backend or options.
+    explicit ParallelCompressor(const Config& config);
+    ~ParallelCompressor() override;
+
+    ParallelCompressor(const ParallelCompressor&) = delete;
+    ParallelCompressor& operator=(const ParallelCompressor&) = delete;
+
+    /**
+     * @brief Consumes all of `in` unless `out` fills up, blocking while every
+     * frame is in flight. Completed frames are written to `out` as they
+     * become available.
+     */
+    CompressionResult compress_partial(BufferView in, BufferView out) override;
+    CompressionResult compress_buffer(BufferView in, BufferView out) override;
+    /**
+     * @brief Compresses the remaining input as a last frame and waits for
+     * every frame to be written. Call again with new output space while it
+     * returns OutputBufferFull. InputBufferFinished ends the stream, the
+     * compressor can then start the next one.
+     */
+    CompressionResult finish(BufferView in, BufferView out) override;
+    // Discards the current stream, waiting for frames being compressed.
+    void reset() override;
+
+    std::size_t num_workers() const noexcept { return threads_.size(); }
+
+   private:
+    struct Frame {
+        enum class State : uint8_t { Filling, Queued, Done, Failed };
+        State state = State::Filling;
+        std::vector<char> input;
+        std::size_t input_size = 0;
+        std::vector<char> output;
+        std::size_t output_size = 0;
+        // Bytes of output already written.
+        std::size_t written = 0;
+    };
+
+    void worker_loop(ICompressor& compressor) noexcept;
+    static bool compress_frame(ICompressor& compressor, Frame& frame) noexcept;
+    void submit();
+    // Copies completed frames to `out` in order. Waits for the oldest frame
+    // if `wait` is set. Returns false if a frame failed.
+    bool drain(BufferView& out, std::size_t& written, bool wait);
+
+    Config config_;
+    std::vector<Frame> frames_;
+    // One per worker, reset for every frame.
+    std::vector<std::unique_ptr<ICompressor>> compressors_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable queued_cv_;
+    std::condition_variable done_cv_;
+    // Frame counters, frames_[n % frames_.size()] holds frame n.
+    std::size_t submitted_ = 0;  // Next frame to fill.
+    std::size_t started_ = 0;    // Next frame a worker takes.
+    std::size_t drained_ = 0;    // Oldest frame not fully written.
+    // First frame of the current stream.
+    std::size_t stream_begin_ = 0;
+    bool finishing_ = false;
+    bool stop_ = false;
+};
+
+};  // namespace csics::io::compression
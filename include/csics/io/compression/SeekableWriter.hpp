@@ -0,0 +1,123 @@
+#pragma once
+#include <bit>
+#include <csics/io/compression/Compressor.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace csics::io::compression {
+
+/** @brief On-disk layout of a seekable container.
+ * [frame 0] ... [frame n - 1] [index entry 0] ... [index entry n - 1]
+ * [footer]
+ * Every frame is a complete stream of the backend holding frame_size
+ * uncompressed bytes, the last one possibly fewer. Frame i starts at
+ * uncompressed offset i * frame_size. All fields are little-endian.
+ */
+namespace seekable {
+
+inline constexpr uint64_t kMagic = 0x314B535343495343ull;  // "CSICSSK1"
+inline constexpr uint8_t kVersion = 1;
+
+struct IndexEntry {
+    uint64_t compressed_offset;
+    uint64_t compressed_size;
+    // Time of the frame's first byte, 0 if never given.
+    uint64_t timestamp_ns;
+};
+
+struct Footer {
+    uint64_t index_offset;
+    uint64_t uncompressed_size;
+    uint64_t frame_count;
+    uint32_t frame_size;
+    // Backend, stable across builds unlike CompressorType.
+    uint8_t codec;
+    IQFilter filter;
+    uint8_t version;
+    uint8_t reserved;
+    uint64_t magic;
+};
+
+static_assert(sizeof(IndexEntry) == 24 && sizeof(Footer) == 40);
+// Both are copied to and from the file as they are in memory.
+static_assert(std::endian::native == std::endian::little,
+              "The seekable container layout assumes a little-endian host");
+
+// Codec ids stored in Footer::codec.
+uint8_t codec_id(CompressorType type) noexcept;
+// Returns false for a codec this build does not support.
+bool codec_type(uint8_t codec, CompressorType& type) noexcept;
+
+};  // namespace seekable
+
+/** @brief Writes a seekable container: independent frames of a fixed
+ * uncompressed size followed by an index, so readers can decompress any
+ * range without the frames before it.
+ * Frames are compressed as the input streams through, straight into the
+ * output. finish() ends the last frame and appends the index and footer.
+ */
+class SeekableWriter : public ICompressor {
+   public:
+    struct Config {
+        CompressorType type;
+        CompressionOptions options;
+        // Uncompressed bytes per frame. Smaller frames seek faster at some
+        // cost in ratio.
+        std::size_t frame_size = 1 << 20;
+        // Used to timestamp frames that start inside an input after
+        // set_timestamp(). 0 gives them the last timestamp set.
+        double sample_rate = 0.0;
+        std::size_t bytes_per_sample = 4;
+    };
+
+    // Throws std::invalid_argument for an unsupported backend or options.
+    explicit SeekableWriter(const Config& config);
+
+    /**
+     * @brief Sets the time of the next input byte, e.g. from a radio block
+     * header. Frames starting later are timestamped from it.
+     */
+    void set_timestamp(uint64_t timestamp_ns) noexcept;
+
+    CompressionResult compress_partial(BufferView in, BufferView out) override;
+    CompressionResult compress_buffer(BufferView in, BufferView out) override;
+    /**
+     * @brief Ends the last frame and writes the index. Call again with new
+     * output space while it returns OutputBufferFull. InputBufferFinished
+     * ends the container, the writer can then start the next one.
+     */
+    CompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+    // Applies from the next frame.
+    bool set_level(int level) override {
+        return compressor_->set_level(level);
+    }
+
+   private:
+    // Finishes the current frame into `out`. Returns OutputBufferFull until
+    // it is complete.
+    CompressionStatus end_frame(BufferView& out, std::size_t& written);
+    uint64_t timestamp_at(uint64_t offset) const noexcept;
+
+    Config config_;
+    std::unique_ptr<ICompressor> compressor_;
+    std::vector<seekable::IndexEntry> index_;
+    // Serialized index and footer, written by finish().
+    std::vector<char> tail_;
+    std::size_t tail_written_ = 0;
+
+    uint64_t compressed_ = 0;
+    uint64_t consumed_ = 0;
+    // Uncompressed bytes in the current frame.
+    std::size_t frame_fill_ = 0;
+    bool frame_open_ = false;
+    bool ending_frame_ = false;
+    bool finishing_ = false;
+
+    bool has_timestamp_ = false;
+    uint64_t timestamp_ns_ = 0;
+    uint64_t timestamp_offset_ = 0;
+};
+
+};  // namespace csics::io::compression
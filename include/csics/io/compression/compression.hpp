@@ -1 +1,12 @@
+#ifdef CSICS_BUILD_QUEUE
+#include <csics/io/compression/CompressionStage.hpp>
+#endif
 #include <csics/io/compression/Compressor.hpp>
+#include <csics/io/compression/CompressorPool.hpp>
+#ifdef CSICS_USE_ZSTD
+#include <csics/io/compression/Dictionary.hpp>
+#endif
+#include <csics/io/compression/IQFilter.hpp>
+#include <csics/io/compression/LevelController.hpp>
+#include <csics/io/compression/ParallelCompressor.hpp>
+#include <csics/io/compression/SeekableWriter.hpp>
@@ -0,0 +1,67 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <csics/io/compression/Compressor.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace csics::io::decompression {
+
+using compression::CompressionStatus;
+using compression::CompressorType;
+
+struct DecompressionOptions {
+    // Dictionaries frames may reference, selected by the ID each frame
+    // records. ZSTD only.
+    std::vector<std::shared_ptr<const compression::Dictionary>> dictionaries;
+    // Filter the stream was compressed with.
+    compression::IQFilter filter = compression::IQFilter::None;
+    // ZLIB only. Zlib and Gzip streams are told apart by their header, Raw
+    // ones must be asked for.
+    compression::ZLIBFormat zlib_format = compression::ZLIBFormat::Zlib;
+};
+
+/**
+ * @brief Status is one of:
+ * - NeedsInput: the input was consumed inside a frame.
+ * - OutputBufferFull: call again with more output space.
+ * - InputBufferFinished: a frame ended, with no input left if returned by
+ *   decompress_buffer or finish.
+ * - FatalError: corrupt or truncated data, or an unknown dictionary. The
+ *   partial frame is dropped.
+ */
+struct DecompressionResult {
+    std::size_t
+        decompressed;  // How many bytes were put into the output buffer
+    std::size_t
+        input_consumed;  // How many bytes were consumed from the input buffer
+    CompressionStatus status;
+};
+
+/** @brief Inverse of ICompressor, reads the frames the matching backend
+ * writes. Contexts are kept across frames and streams, so one instance can
+ * decode any number of messages without allocating.
+ */
+class IDecompressor {
+   public:
+    virtual ~IDecompressor() = default;
+
+    // Decompresses at most up to the end of the current frame.
+    virtual DecompressionResult decompress_partial(BufferView in,
+                                                   BufferView out) = 0;
+    // Decompresses until the input is consumed or the output is full,
+    // continuing over concatenated frames.
+    virtual DecompressionResult decompress_buffer(BufferView in,
+                                                  BufferView out) = 0;
+    // Like decompress_buffer, but the input must end with a complete frame.
+    // A truncated frame is a FatalError.
+    virtual DecompressionResult finish(BufferView in, BufferView out) = 0;
+    // Drops any partial frame, ready for a new stream.
+    virtual void reset() = 0;
+
+    // Throws std::invalid_argument for unsupported types or options.
+    static std::unique_ptr<IDecompressor> create(
+        CompressorType type, const DecompressionOptions& options = {});
+};
+
+};  // namespace csics::io::decompression
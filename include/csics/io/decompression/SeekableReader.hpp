@@ -0,0 +1,89 @@
+#pragma once
+#include <condition_variable>
+#include <csics/io/compression/SeekableWriter.hpp>
+#include <csics/io/decompression/Decompressor.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace csics::io::decompression {
+
+/** @brief Random access to a container written by SeekableWriter.
+ * Only the frames overlapping a read are decompressed, spread over a pool
+ * of worker threads. The container is read in place, mapping the file
+ * keeps untouched frames off the disk.
+ */
+class SeekableReader {
+   public:
+    struct Config {
+        // Threads decoding frames next to the caller, 0 uses one per core.
+        std::size_t workers = 0;
+        DecompressionOptions options;
+    };
+
+    /**
+     * @brief Parses the footer and index of `container`, which must outlive
+     * the reader. Throws std::invalid_argument if it is malformed or its
+     * backend is not built in.
+     */
+    SeekableReader(BufferView container, const Config& config);
+    explicit SeekableReader(BufferView container);
+    ~SeekableReader();
+
+    SeekableReader(const SeekableReader&) = delete;
+    SeekableReader& operator=(const SeekableReader&) = delete;
+
+    // Uncompressed size of the whole stream.
+    uint64_t size() const noexcept { return footer_.uncompressed_size; }
+    std::size_t frame_count() const noexcept { return index_.size(); }
+    std::size_t frame_size() const noexcept { return footer_.frame_size; }
+    const compression::seekable::IndexEntry& frame(
+        std::size_t i) const noexcept {
+        return index_[i];
+    }
+
+    // Uncompressed offset of the last frame starting at or before
+    // `timestamp_ns`, 0 if none does.
+    uint64_t offset_at(uint64_t timestamp_ns) const noexcept;
+
+    /**
+     * @brief Decompresses [offset, offset + out.size()) into `out`, clamped
+     * to the end of the stream. Not thread safe, one read at a time.
+     * @return InputBufferFinished with the bytes read, or FatalError for a
+     * corrupt frame.
+     */
+    DecompressionResult read(uint64_t offset, BufferView out);
+
+   private:
+    struct Worker {
+        std::unique_ptr<IDecompressor> decompressor;
+        // Frames only partly inside the read are decoded here first.
+        std::vector<char> scratch;
+    };
+
+    void worker_loop(Worker& worker) noexcept;
+    // Decodes frames of the current read until none are left.
+    void decode_frames(Worker& worker) noexcept;
+    bool decode_frame(Worker& worker, std::size_t i) noexcept;
+
+    BufferView container_;
+    compression::seekable::Footer footer_;
+    std::vector<compression::seekable::IndexEntry> index_;
+    // The last one belongs to the calling thread.
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    // Current read, frames [next_frame_, end_frame_) are left to start.
+    uint64_t read_offset_ = 0;
+    BufferView read_out_;
+    std::size_t next_frame_ = 0;
+    std::size_t end_frame_ = 0;
+    std::size_t pending_ = 0;
+    bool read_failed_ = false;
+    bool stop_ = false;
+};
+
+};  // namespace csics::io::decompression
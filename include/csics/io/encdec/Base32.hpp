@@ -0,0 +1,56 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <csics/io/encdec/EncDec.hpp>
+namespace csics::io::encdec {
+
+// RFC 4648 Base32, 5 bytes to 8 characters of A-Z and 2-7, padded with '='.
+class Base32Encoder : public ICodec {
+   public:
+    // Encodes whole groups of 5 bytes, holding the rest over to the next
+    // call.
+    EncodingResult encode(BufferView in, BufferView out);
+    // Encodes the rest with padding and starts a new stream.
+    EncodingResult finish(BufferView in, BufferView out) override;
+    EncodingResult process(BufferView in, BufferView out) override {
+        return encode(in, out);
+    }
+    void reset() override { held_ = 0; }
+
+   private:
+    uint8_t holdover_[5] = {};
+    uint8_t held_ = 0;
+};
+
+/**
+ * @brief Strict inverse of Base32Encoder. Padding is required and ends the
+ * stream, the bits it pads must be zero, and anything else, including
+ * lowercase, is InvalidInput. `out` may alias `in` when no group is held
+ * over from an earlier call.
+ */
+class Base32Decoder : public ICodec {
+   public:
+    // Decodes whole groups of 8 characters, holding the rest over to the
+    // next call.
+    EncodingResult decode(BufferView in, BufferView out);
+    // Decodes the rest, InvalidInput if it ends inside a group, and starts
+    // a new stream unless the output is full.
+    EncodingResult finish(BufferView in, BufferView out) override;
+    EncodingResult process(BufferView in, BufferView out) override {
+        return decode(in, out);
+    }
+    void reset() override {
+        held_ = 0;
+        ended_ = false;
+    }
+
+   private:
+    // Decodes a possibly padded group into the output.
+    EncodingStatus emit(const uint8_t* group, BufferView out,
+                        std::size_t& written);
+
+    uint8_t holdover_[8] = {};
+    uint8_t held_ = 0;
+    // Padding was seen.
+    bool ended_ = false;
+};
+};  // namespace csics::io::encdec
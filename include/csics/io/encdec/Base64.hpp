@@ -1,16 +1,99 @@
-
 #pragma once
 #include <csics/Buffer.hpp>
 #include <csics/io/encdec/EncDec.hpp>
 namespace csics::io::encdec {
 
-class Base64Encoder {
+namespace detail {
+struct Base64Kernels;
+};  // namespace detail
+
+// Instruction sets the Base64 kernels are built for.
+enum class Base64Isa : uint8_t {
+    Scalar,
+    SSSE3,
+    AVX2,
+};
+
+bool base64_isa_supported(Base64Isa isa) noexcept;
+// The fastest one this CPU supports, checked once.
+Base64Isa base64_best_isa() noexcept;
+
+// RFC 4648 alphabets, UrlSafe uses '-' and '_' for '+' and '/'.
+enum class Base64Alphabet : uint8_t {
+    Standard,
+    UrlSafe,
+};
+
+class Base64Encoder : public ICodec {
    public:
-    Base64Encoder();
+    // Throws std::invalid_argument if the CPU does not support `isa`.
+    explicit Base64Encoder(Base64Isa isa = base64_best_isa(),
+                           Base64Alphabet alphabet = Base64Alphabet::Standard);
+    // Encodes whole groups of 3 bytes, holding the rest over to the next
+    // call.
     EncodingResult encode(BufferView in, BufferView out);
-    EncodingResult finish(BufferView in, BufferView out);
+    // Encodes the rest with padding and starts a new stream.
+    EncodingResult finish(BufferView in, BufferView out) override;
+    EncodingResult process(BufferView in, BufferView out) override {
+        return encode(in, out);
+    }
+    void reset() override { held_ = 0; }
 
    private:
-    uint8_t holdover_[3]; // 0: number of bytes held over, 1: first byte, 2: second byte
+    const detail::Base64Kernels* kernels_;
+    const uint8_t* chars_;
+    uint8_t holdover_[3];
+    uint8_t held_ = 0;
+};
+
+/**
+ * @brief Streaming decoder, the inverse of Base64Encoder.
+ *
+ * Strict mode accepts only what the encoder emits: padding is required and
+ * ends the stream, the bits it pads must be zero, and anything else is
+ * InvalidInput. Lenient mode also skips whitespace and lets finish() decode
+ * an unpadded last group. Whole runs of groups go through the SIMD kernel,
+ * the rest is decoded one group at a time. `out` may alias `in` when no
+ * group is held over from an earlier call, e.g. a message decoded in one
+ * call; a held group would be written over input not yet read.
+ */
+class Base64Decoder : public ICodec {
+   public:
+    struct Config {
+        Base64Alphabet alphabet = Base64Alphabet::Standard;
+        bool lenient = false;
+        Base64Isa isa = base64_best_isa();
+    };
+
+    Base64Decoder();
+    // Throws std::invalid_argument if the CPU does not support the ISA.
+    explicit Base64Decoder(const Config& config);
+    // Decodes whole groups of 4 characters, holding the rest over to the
+    // next call.
+    EncodingResult decode(BufferView in, BufferView out);
+    // Decodes the rest, InvalidInput if it ends inside a group that strict
+    // mode cannot complete, and starts a new stream unless the output is
+    // full.
+    EncodingResult finish(BufferView in, BufferView out) override;
+    EncodingResult process(BufferView in, BufferView out) override {
+        return decode(in, out);
+    }
+    void reset() override {
+        held_ = 0;
+        ended_ = false;
+    }
+
+   private:
+    // Decodes a possibly padded group into the output.
+    EncodingStatus emit(const uint8_t* group, BufferView out,
+                        std::size_t& written);
+
+    const detail::Base64Kernels* kernels_;
+    const uint8_t* values_;
+    bool lenient_;
+    uint8_t holdover_[4];
+    uint8_t held_ = 0;
+    // Padding was seen.
+    bool ended_ = false;
 };
 };  // namespace csics::io::encdec
@@ -0,0 +1,114 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <csics/io/checksum/Checksum.hpp>
+#include <csics/io/compression/Compressor.hpp>
+#include <csics/io/decompression/Decompressor.hpp>
+#include <csics/io/encdec/EncDec.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace csics::io::encdec {
+
+// Runs an ICompressor as a codec, its finish() ends a frame.
+class CompressorCodec : public ICodec {
+   public:
+    // Throws std::invalid_argument if `compressor` is null.
+    explicit CompressorCodec(
+        std::unique_ptr<compression::ICompressor> compressor);
+    EncodingResult process(BufferView in, BufferView out) override;
+    EncodingResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+   private:
+    std::unique_ptr<compression::ICompressor> compressor_;
+};
+
+// Runs an IDecompressor as a codec. Corrupt or truncated data is
+// InvalidInput.
+class DecompressorCodec : public ICodec {
+   public:
+    // Throws std::invalid_argument if `decompressor` is null.
+    explicit DecompressorCodec(
+        std::unique_ptr<decompression::IDecompressor> decompressor);
+    EncodingResult process(BufferView in, BufferView out) override;
+    EncodingResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+   private:
+    std::unique_ptr<decompression::IDecompressor> decompressor_;
+};
+
+/**
+ * @brief Feeds each stage's output to the next one through a small buffer,
+ * e.g. compress then Base64, without staging the whole intermediate
+ * stream. The buffers are sized to stay in cache; each call moves data down
+ * the chain until the input is consumed or `out` is full.
+ */
+class CodecChain : public ICodec {
+   public:
+    static constexpr std::size_t kDefaultChunkSize = 16 * 1024;
+
+    // Throws std::invalid_argument if `stages` is empty or holds a null
+    // stage, or if `chunk_size` is 0.
+    explicit CodecChain(std::vector<std::unique_ptr<ICodec>> stages,
+                        std::size_t chunk_size = kDefaultChunkSize);
+    EncodingResult process(BufferView in, BufferView out) override;
+    EncodingResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+   private:
+    struct Stage {
+        std::unique_ptr<ICodec> codec;
+        // Output waiting for the next stage, unused by the last one.
+        std::vector<uint8_t> buffer;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        // finish() returned Ok for the current stream.
+        bool finished = false;
+    };
+
+    EncodingResult run(BufferView in, BufferView out, bool finishing);
+
+    std::vector<Stage> stages_;
+};
+
+/**
+ * @brief Checksums what goes into or comes out of `inner` as it streams.
+ * The input is fed to `inner` in slices of `slice_size`, each hashed right
+ * after `inner` has touched it, so the data is read from memory once.
+ * Wrap the stages of a CodecChain to check each step of it. With
+ * Side::Input `inner` must not decode in place, as the slice is hashed
+ * after it is overwritten. Slicing keeps a compressor off its one-shot
+ * path, so ZLIB with libdeflate is faster hashed in a separate pass.
+ */
+class ChecksumCodec : public ICodec {
+   public:
+    enum class Side : uint8_t { Input, Output };
+    static constexpr std::size_t kDefaultSliceSize = 16 * 1024;
+
+    // Throws std::invalid_argument if `inner` is null, `type` unknown or
+    // `slice_size` 0.
+    explicit ChecksumCodec(
+        std::unique_ptr<ICodec> inner,
+        checksum::ChecksumType type = checksum::ChecksumType::CRC32C,
+        Side side = Side::Input, std::size_t slice_size = kDefaultSliceSize);
+    EncodingResult process(BufferView in, BufferView out) override;
+    EncodingResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+    // Of the current stream so far, or once finish() returns Ok of the
+    // finished one, until the next call starts another.
+    uint64_t digest() const noexcept;
+
+   private:
+    EncodingResult run(BufferView in, BufferView out, bool finishing);
+
+    std::unique_ptr<ICodec> inner_;
+    checksum::Checksum sum_;
+    Side side_;
+    std::size_t slice_size_;
+    uint64_t finished_digest_ = 0;
+    bool finished_ = false;
+};
+};  // namespace csics::io::encdec
@@ -2,6 +2,7 @@
 #ifndef CSICS_BUILD_IO
 #error "IO support is not enabled. Please define CSICS_BUILD_IO to use encoding/decoding features."
 #endif
+#include <csics/Buffer.hpp>
 #include <cstddef>
 #include <cstdint>
 namespace csics::io::encdec {
@@ -19,4 +20,24 @@ namespace csics::io::encdec {
         std::size_t output;    // How many bytes were written to the output buffer
         EncodingStatus status;
     };
+
+    /**
+     * @brief A streaming transform, common to the encoders and, through
+     * the adapters in Codec.hpp, the compressors. Status is one of:
+     * - Ok: process() consumed all of `in`, or finish() ended the stream
+     *   and the codec is ready for a new one.
+     * - OutputBufferFull: call again with the rest of `in` and more space.
+     * - InvalidInput, FatalError: the stream is broken, reset() before
+     *   reuse.
+     */
+    class ICodec {
+       public:
+        virtual ~ICodec() = default;
+        // Transforms as much of `in` as fits, holding back what it must.
+        virtual EncodingResult process(BufferView in, BufferView out) = 0;
+        // Transforms the rest of `in` and flushes what was held back.
+        virtual EncodingResult finish(BufferView in, BufferView out) = 0;
+        // Drops any partial stream.
+        virtual void reset() = 0;
+    };
 };
@@ -0,0 +1,56 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <csics/io/encdec/Base64.hpp>
+#include <csics/io/encdec/EncDec.hpp>
+namespace csics::io::encdec {
+
+namespace detail {
+struct HexKernels;
+};  // namespace detail
+
+// Two digits per byte, high nibble first. The kernels are selected from
+// the same instruction sets as Base64's.
+class HexEncoder : public ICodec {
+   public:
+    // Throws std::invalid_argument if the CPU does not support `isa`.
+    explicit HexEncoder(Base64Isa isa = base64_best_isa(),
+                        bool uppercase = false);
+    // Encodes the bytes whose digits fit.
+    EncodingResult encode(BufferView in, BufferView out);
+    EncodingResult finish(BufferView in, BufferView out) override {
+        return encode(in, out);
+    }
+    EncodingResult process(BufferView in, BufferView out) override {
+        return encode(in, out);
+    }
+    void reset() override {}
+
+   private:
+    const detail::HexKernels* kernels_;
+    const uint8_t* digits_;
+};
+
+/**
+ * @brief Inverse of HexEncoder, accepting either case. Anything but a digit
+ * is InvalidInput, as is an odd number of digits at finish(). `out` may
+ * alias `in`.
+ */
+class HexDecoder : public ICodec {
+   public:
+    // Throws std::invalid_argument if the CPU does not support `isa`.
+    explicit HexDecoder(Base64Isa isa = base64_best_isa());
+    // Decodes whole pairs of digits, holding an odd one over to the next
+    // call.
+    EncodingResult decode(BufferView in, BufferView out);
+    EncodingResult finish(BufferView in, BufferView out) override;
+    EncodingResult process(BufferView in, BufferView out) override {
+        return decode(in, out);
+    }
+    void reset() override { held_ = false; }
+
+   private:
+    const detail::HexKernels* kernels_;
+    uint8_t holdover_ = 0;
+    bool held_ = false;
+};
+};  // namespace csics::io::encdec
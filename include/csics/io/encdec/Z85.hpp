@@ -0,0 +1,45 @@
+#pragma once
+#include <csics/Buffer.hpp>
+#include <csics/io/encdec/EncDec.hpp>
+namespace csics::io::encdec {
+
+/**
+ * @brief ZeroMQ's Z85 (RFC 32), 4 bytes to 5 printable characters that
+ * need no escaping in JSON strings. There is no padding, so a stream must
+ * be a multiple of 4 bytes long; finish() returns InvalidInput otherwise.
+ */
+class Z85Encoder : public ICodec {
+   public:
+    // Encodes whole groups of 4 bytes, holding the rest over to the next
+    // call.
+    EncodingResult encode(BufferView in, BufferView out);
+    EncodingResult finish(BufferView in, BufferView out) override;
+    EncodingResult process(BufferView in, BufferView out) override {
+        return encode(in, out);
+    }
+    void reset() override { held_ = 0; }
+
+   private:
+    uint8_t holdover_[4] = {};
+    uint8_t held_ = 0;
+};
+
+// Inverse of Z85Encoder. Characters outside the alphabet, groups above
+// 2^32 - 1 and streams ending inside a group are InvalidInput. `out` may
+// alias `in` when no group is held over from an earlier call.
+class Z85Decoder : public ICodec {
+   public:
+    // Decodes whole groups of 5 characters, holding the rest over to the
+    // next call.
+    EncodingResult decode(BufferView in, BufferView out);
+    EncodingResult finish(BufferView in, BufferView out) override;
+    EncodingResult process(BufferView in, BufferView out) override {
+        return decode(in, out);
+    }
+    void reset() override { held_ = 0; }
+
+   private:
+    uint8_t holdover_[5] = {};
+    uint8_t held_ = 0;
+};
+};  // namespace csics::io::encdec
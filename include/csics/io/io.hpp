@@ -2,6 +2,14 @@
 #ifndef CSICS_BUILD_IO
 #error "IO support is not enabled. Please define CSICS_BUILD_IO to use IO features."
 #endif
+#include <csics/io/checksum/Checksum.hpp>
 #include <csics/io/compression/compression.hpp>
-#include <csics/io/encdec/encdec.hpp>
+#include <csics/io/decompression/Decompressor.hpp>
+#include <csics/io/decompression/SeekableReader.hpp>
+#include <csics/io/encdec/EncDec.hpp>
+#include <csics/io/encdec/Base32.hpp>
+#include <csics/io/encdec/Base64.hpp>
+#include <csics/io/encdec/Codec.hpp>
+#include <csics/io/encdec/Hex.hpp>
+#include <csics/io/encdec/Z85.hpp>
 #include <csics/io/net/net.hpp>
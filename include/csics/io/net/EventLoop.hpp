@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <csics/io/net/NetTypes.hpp>
+#include <csics/io/net/TCPEndpoint.hpp>
+#include <csics/io/net/UDPEndpoint.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace csics::io::net {
+
+// Readiness of an endpoint, a bit set.
+enum class IoEvent : uint8_t {
+    None = 0,
+    Readable = 1 << 0,
+    Writable = 1 << 1,
+    // The peer closed, what it sent before is still readable.
+    Hangup = 1 << 2,
+    Error = 1 << 3,
+};
+
+constexpr IoEvent operator|(IoEvent a, IoEvent b) noexcept {
+    return static_cast<IoEvent>(static_cast<uint8_t>(a) |
+                                static_cast<uint8_t>(b));
+}
+constexpr IoEvent operator&(IoEvent a, IoEvent b) noexcept {
+    return static_cast<IoEvent>(static_cast<uint8_t>(a) &
+                                static_cast<uint8_t>(b));
+}
+constexpr bool any(IoEvent e) noexcept { return e != IoEvent::None; }
+
+/**
+ * @brief A single-threaded reactor over epoll, servicing many
+ * non-blocking endpoints and timers from one thread.
+ *
+ * Readiness is edge triggered: a handler runs when an endpoint becomes
+ * readable or writable, not while it stays so, and must recv() or send()
+ * until Empty before it is called again. Handlers and timer callbacks run
+ * on the thread calling run() or run_once(), and may add, modify and
+ * remove registrations and timers, their own included. Only post() and
+ * stop() may be called from other threads.
+ */
+class EventLoop {
+   public:
+    using Clock = std::chrono::steady_clock;
+    using Handler = std::function<void(IoEvent events)>;
+    using TimerId = uint64_t;
+
+    // Throws std::runtime_error if the epoll instance cannot be created.
+    EventLoop();
+    ~EventLoop();
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // Watches `endpoint` for `interest` (Readable, Writable or both;
+    // Hangup and Error are always reported), switching it to non-blocking.
+    // The endpoint must stay open and in place until removed. Error if it
+    // has no socket yet or is already registered.
+    NetStatus add(TCPEndpoint& endpoint, IoEvent interest, Handler handler);
+    NetStatus add(UDPEndpoint& endpoint, IoEvent interest, Handler handler);
+    NetStatus modify(const TCPEndpoint& endpoint, IoEvent interest);
+    NetStatus modify(const UDPEndpoint& endpoint, IoEvent interest);
+    // Call before closing the endpoint.
+    NetStatus remove(const TCPEndpoint& endpoint);
+    NetStatus remove(const UDPEndpoint& endpoint);
+
+    // Runs `callback` once after `delay`, or every `delay` if `repeat`.
+    TimerId add_timer(Clock::duration delay, std::function<void()> callback,
+                      bool repeat = false);
+    // False if `id` already fired for good or was cancelled.
+    bool cancel_timer(TimerId id);
+
+    // Runs `fn` on the loop thread at its next wake up.
+    void post(std::function<void()> fn);
+
+    // Waits up to `timeout` for the first event or timer, dispatches all
+    // that are due, and returns how many handlers and callbacks ran. A
+    // negative timeout waits until something happens.
+    std::size_t run_once(std::chrono::milliseconds timeout);
+    // Dispatches until stop().
+    void run();
+    // Makes run() return after the current dispatch.
+    void stop();
+
+    // Endpoints registered.
+    std::size_t size() const noexcept;
+
+   private:
+    struct Internal;
+    Internal* internal_;
+
+    NetStatus add_(int fd, IoEvent interest, Handler handler);
+    NetStatus modify_(int fd, IoEvent interest);
+    NetStatus remove_(int fd);
+};
+};  // namespace csics::io::net
@@ -71,6 +71,12 @@ class IPAddress {
     constexpr static IPAddress localhost() noexcept {
         return IPAddress(uint32_t{0x7F000001});
     }
+    constexpr static IPAddress any() noexcept { return IPAddress(); }
+
+    // The IPv4 address, in network byte order.
+    constexpr std::array<uint8_t, 4> v4() const noexcept {
+        return {bytes_[0], bytes_[1], bytes_[2], bytes_[3]};
+    }
 
    private:
     uint8_t bytes_[6];  // enough to hold IPv4 and IPv6
@@ -92,6 +98,9 @@ class SockAddr {
         return SockAddr(IPAddress::localhost(), port);
     }
 
+    constexpr const IPAddress& address() const noexcept { return address_; }
+    constexpr Port port() const noexcept { return port_; }
+
    private:
     IPAddress address_;
     Port port_;
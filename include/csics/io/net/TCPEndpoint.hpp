@@ -2,8 +2,15 @@
 
 #include <csics/io/net/NetTypes.hpp>
 #include <csics/Buffer.hpp>
+#include <vector>
 
 namespace csics::io::net {
+/**
+ * @brief A TCP connection, or a listening socket handing them out through
+ * accept(). Blocking unless set_nonblocking(), in which case send() and
+ * recv() return Empty instead of waiting; see EventLoop for waiting on
+ * many at once.
+ */
 class TCPEndpoint {
    public:
     using ConnectionParams = SockAddr;
@@ -16,7 +23,10 @@ class TCPEndpoint {
     TCPEndpoint& operator=(TCPEndpoint&& other) noexcept;
 
     NetResult send(BufferView data);
+    // Disconnected once the peer has closed and everything before was read.
     NetResult recv(BufferView buffer);
+    // Non-blocking, Empty means the connection is under way: it is
+    // established once the endpoint is writable.
     template <typename T>
     NetStatus connect(T&& addr) {
         static_assert(std::is_convertible_v<T, SockAddr>,
@@ -25,8 +35,28 @@ class TCPEndpoint {
         return connect_(static_cast<SockAddr>(addr));
     }
 
+    // Binds to `addr` and listens on it; port 0 picks a free one, see
+    // local_address().
+    NetStatus listen(const SockAddr& addr, int backlog = 128);
+    // Takes the next pending connection of a listening endpoint into
+    // `connection`, which inherits its blocking mode. Empty when
+    // non-blocking and none is pending.
+    NetStatus accept(TCPEndpoint& connection);
+
+    // Applies now, or to the socket connect() or listen() creates.
+    NetStatus set_nonblocking(bool nonblocking);
+    SockAddr local_address() const;
+    // The socket descriptor, -1 before connect() or listen().
+    int native_handle() const noexcept;
+    // Closes the socket, the endpoint can connect or listen again.
+    void close();
+
+    // Waits up to `timeoutMs` for `endpoint` to be readable: Ready, or
+    // Timeout, Disconnected or Error. A negative timeout waits forever.
     static PollStatus poll(const TCPEndpoint* endpoint, int timeoutMs);
 
+    // As above for each endpoint, those not ready are Empty. All are
+    // Timeout if none became ready.
     static std::vector<PollStatus> poll(const std::vector<TCPEndpoint*>& endpoints, int timeoutMs);
 
    private:
@@ -3,6 +3,9 @@
 #include <csics/io/net/NetTypes.hpp>
 #include <csics/Buffer.hpp>
 namespace csics::io::net {
+    // A UDP socket, created by the first bind(), connect() or send().
+    // Blocking unless set_nonblocking(), then recv() returns Empty with no
+    // datagram waiting.
     class UDPEndpoint {
     public:
         using ConnectionParams = SockAddr;
@@ -15,6 +18,7 @@ namespace csics::io::net {
         UDPEndpoint& operator=(UDPEndpoint&& other) noexcept;
 
         NetResult send(BufferView data, const SockAddr& dest);
+        // One datagram, truncated to `buffer`.
         NetResult recv(BufferView buffer, SockAddr& src);
         template <typename T>
         NetResult connect(T&& addr) {
@@ -23,6 +27,14 @@ namespace csics::io::net {
                           "UDPEndpoint connection");
             return connect_(static_cast<SockAddr>(addr));
         }
+
+        // Port 0 picks a free one, see local_address().
+        NetStatus bind(const SockAddr& addr);
+        // Applies now, or to the socket created later.
+        NetStatus set_nonblocking(bool nonblocking);
+        SockAddr local_address() const;
+        // The socket descriptor, -1 until one is created.
+        int native_handle() const noexcept;
     private:
         struct Internal;
         Internal* internal_;
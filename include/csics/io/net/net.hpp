@@ -2,4 +2,9 @@
 #include <csics/io/net/NetTypes.hpp>
 #include <csics/io/net/TCPEndpoint.hpp>
 #include <csics/io/net/UDPEndpoint.hpp>
+#ifdef __linux__
+#include <csics/io/net/EventLoop.hpp>
+#endif
+#ifdef CSICS_USE_MQTT
 #include <csics/io/net/MQTTEndpoint.hpp>
+#endif
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <csics/pipeline/Stage.hpp>
+#include <csics/pipeline/WorkStealingExecutor.hpp>
+#include <csics/radio/RadioRx.hpp>
+#include <memory>
+#include <vector>
+
+namespace csics::pipeline {
+
+enum class PipelineStatus : uint8_t {
+    Ok,
+    AlreadyRunning,
+    InvalidGraph,  // Empty, missing a source or not terminated by a sink.
+    RadioFailure,  // The radio source refused to start streaming.
+};
+
+/** @brief A chain of stages connected by SPSCQueues.
+ * The first stage is a source, either an IStage or an IRadioRx whose stream
+ * queue is consumed directly. Every other stage runs on its own thread and
+ * reads the output queue of the stage before it. The last stage must be a
+ * sink.
+ *
+ * Queues are sized from the block sizes reported by each stage, so a full
+ * queue blocks the producer instead of dropping data (backpressure). If a
+ * stage finishes early or fails, its upstream stages stop as well.
+ */
+class PipelineGraph {
+   public:
+    using StageId = std::size_t;
+
+    PipelineGraph();
+    ~PipelineGraph();
+    PipelineGraph(const PipelineGraph&) = delete;
+    PipelineGraph& operator=(const PipelineGraph&) = delete;
+
+    /**
+     * @brief Adds the source of the chain. Must be the first stage added.
+     * @throws std::logic_error if the chain already has a source.
+     */
+    StageId add_source(std::unique_ptr<IStage> stage,
+                       const StageOptions& options = {});
+
+    /**
+     * @brief Uses a radio as the source of the chain.
+     * The stream is started by start() and stopped by stop(). No thread or
+     * copy is added, the next stage reads the radio queue directly.
+     * The radio must outlive the pipeline.
+     * @throws std::logic_error if the chain already has a source.
+     */
+    StageId add_source(radio::IRadioRx& radio,
+                       const radio::StreamConfiguration& stream_config);
+
+    /**
+     * @brief Appends a transform or sink after the last added stage.
+     * @throws std::logic_error if the chain has no source yet.
+     */
+    StageId add_stage(std::unique_ptr<IStage> stage,
+                      const StageOptions& options = {});
+
+    /**
+     * @brief Appends a stage whose blocks are processed concurrently on
+     * `executor`, for heavy stages that are independent across blocks.
+     * process() is called from several workers at once and must be safe to
+     * do so. Outputs are still forwarded in input order. Each block is copied
+     * in and out of a reorder slot, options.in_flight bounds the slot count.
+     * The executor must outlive the pipeline.
+     * @throws std::logic_error if the chain has no source yet.
+     */
+    StageId add_parallel_stage(std::unique_ptr<IStage> stage,
+                               WorkStealingExecutor& executor,
+                               const StageOptions& options = {});
+
+    /**
+     * @brief Sizes the queues and starts one thread per stage.
+     * Can be called again after stop() or wait() returned.
+     */
+    PipelineStatus start();
+
+    /**
+     * @brief Stops the source and waits for the downstream stages to drain
+     * every block already produced.
+     */
+    void stop() noexcept;
+
+    /**
+     * @brief Waits for the source to finish on its own and the pipeline to
+     * drain. Never returns for sources that run forever, use stop().
+     */
+    void wait() noexcept;
+
+    bool is_running() const noexcept;
+
+    // True if any stage reported StageStatus::Error during the last run.
+    bool failed() const noexcept;
+
+    std::size_t size() const noexcept;
+
+    StageStats stats(StageId id) const noexcept;
+
+    // Capacity in bytes of the queue between `id` and the next stage.
+    std::size_t queue_capacity(StageId id) const noexcept;
+
+   private:
+    struct Node;
+    std::vector<std::unique_ptr<Node>> nodes_;
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<bool> failed_{false};
+    bool running_ = false;
+
+    void run_source(Node& node, Node* downstream) noexcept;
+    void run_stage(Node& node, Node& upstream, Node* downstream) noexcept;
+    void run_parallel_stage(Node& node, Node& upstream,
+                            Node* downstream) noexcept;
+    bool acquire_output(Node& node, Node* downstream,
+                        queue::SPSCQueue::WriteSlot& slot,
+                        bool is_source) noexcept;
+    void join() noexcept;
+};
+
+};  // namespace csics::pipeline
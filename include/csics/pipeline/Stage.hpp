@@ -0,0 +1,104 @@
+#pragma once
+
+#include <chrono>
+#include <csics/Buffer.hpp>
+#include <csics/ThreadPolicy.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace csics::pipeline {
+
+enum class StageStatus : uint8_t {
+    Ok,        // Input consumed, `output` bytes were written.
+    Idle,      // Nothing to do right now (sources only), retry later.
+    Finished,  // End of stream, the stage will not be called again.
+    Error,     // Unrecoverable failure, the pipeline is torn down.
+};
+
+struct StageResult {
+    std::size_t output;  // How many bytes were written to the output block
+    StageStatus status;
+};
+
+/** @brief A single processing step in a PipelineGraph.
+ * Each stage runs on its own thread and is handed one block at a time.
+ * Sources receive an empty input view, sinks receive an empty output view.
+ * A stage added with add_stage() only ever sees blocks from its own thread
+ * and does not need to be thread safe. A stage added with
+ * add_parallel_stage() has process() called from several executor workers
+ * at once, so it must be safe to call concurrently.
+ */
+class IStage {
+   public:
+    virtual ~IStage() = default;
+
+    /**
+     * @brief Upper bound on the bytes written by one call to process().
+     * @param input_block_size Largest block the upstream stage produces, 0
+     * for sources.
+     * @return Output block size in bytes, 0 for sinks.
+     * Used to size the queue between this stage and the next one.
+     */
+    virtual std::size_t output_block_size(
+        std::size_t input_block_size) const noexcept = 0;
+
+    /**
+     * @brief Processes one block.
+     * @param in The upstream block. Only valid for the duration of the call.
+     * @param out Space for one output block of output_block_size() bytes.
+     * Only the first StageResult::output bytes are forwarded downstream.
+     */
+    virtual StageResult process(BufferView in, BufferView out) noexcept = 0;
+
+    // Called on the stage thread before the first and after the last block.
+    virtual void on_start() noexcept {}
+    virtual void on_stop() noexcept {}
+};
+
+struct StageOptions {
+    // Affinity and priority of the stage thread, or of the dispatcher thread
+    // for parallel stages. The default leaves scheduling to the OS.
+    ThreadPolicy thread_policy;
+    // Number of output blocks that can be in flight towards the next stage.
+    std::size_t queue_depth = 4;
+    // Blocks a parallel stage processes at once, 0 uses two per worker.
+    std::size_t in_flight = 0;
+};
+
+/** @brief Snapshot of the counters kept for every stage. */
+struct StageStats {
+    uint64_t blocks_in = 0;
+    uint64_t blocks_out = 0;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    // Time spent inside process(), summed over all blocks.
+    uint64_t busy_ns = 0;
+    // Longest single process() call.
+    uint64_t max_latency_ns = 0;
+    // Times the stage had a block ready but the output queue was full.
+    uint64_t output_stalls = 0;
+    // Times the stage polled its input queue and found it empty.
+    uint64_t input_starved = 0;
+    // Wall time since the stage thread started.
+    std::chrono::nanoseconds elapsed{0};
+    // Outcome of applying StageOptions::thread_policy.
+    ThreadPolicyResult thread_policy;
+    // Times the stage thread was preempted.
+    uint64_t involuntary_switches = 0;
+
+    // Sources have no input, so their rates are taken from the output side.
+    double mean_latency_ns() const noexcept {
+        uint64_t blocks = blocks_in != 0 ? blocks_in : blocks_out;
+        return blocks == 0 ? 0.0 : static_cast<double>(busy_ns) / blocks;
+    }
+
+    // Bytes per second of wall time.
+    double throughput_bps() const noexcept {
+        uint64_t bytes = bytes_in != 0 ? bytes_in : bytes_out;
+        return elapsed.count() == 0
+                   ? 0.0
+                   : static_cast<double>(bytes) * 1e9 / elapsed.count();
+    }
+};
+
+};  // namespace csics::pipeline
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <csics/pipeline/Stage.hpp>
+#include <csics/radio/RadioRx.hpp>
+#include <utility>
+
+namespace csics::pipeline {
+
+/** @brief Source producing IRadioRx-formatted blocks without hardware.
+ * Each block is an IRadioRx::BlockHeader followed by SC16 samples of a
+ * complex tone. Timestamps advance by exactly one block duration so the
+ * stream is indistinguishable from a radio that never drops samples.
+ */
+class SyntheticSource : public IStage {
+   public:
+    struct Config {
+        double sample_rate = 1e6;
+        // Tone frequency relative to the center frequency, in Hz.
+        double tone_frequency = 10e3;
+        // Peak amplitude in SC16 units.
+        double amplitude = 8192.0;
+        std::size_t block_len = 1024;
+        // Number of blocks to produce before finishing, 0 runs forever.
+        std::size_t num_blocks = 0;
+    };
+
+    explicit SyntheticSource(const Config& config);
+
+    std::size_t output_block_size(std::size_t) const noexcept override;
+    StageResult process(BufferView in, BufferView out) noexcept override;
+    void on_start() noexcept override;
+
+   private:
+    Config config_;
+    std::size_t produced_;
+    double phase_;
+    uint64_t start_ns_;
+};
+
+/** @brief Wraps a callable as a transform stage.
+ * The callable has the signature StageResult(BufferView in, BufferView out).
+ * Output blocks are sized as `input * num / den + extra` bytes.
+ */
+template <typename F>
+class TransformStage : public IStage {
+   public:
+    explicit TransformStage(F fn, std::size_t num = 1, std::size_t den = 1,
+                            std::size_t extra = 0)
+        : fn_(std::move(fn)), num_(num), den_(den), extra_(extra) {}
+
+    std::size_t output_block_size(
+        std::size_t input_block_size) const noexcept override {
+        return (input_block_size * num_ + den_ - 1) / den_ + extra_;
+    }
+
+    StageResult process(BufferView in, BufferView out) noexcept override {
+        return fn_(in, out);
+    }
+
+   private:
+    F fn_;
+    std::size_t num_;
+    std::size_t den_;
+    std::size_t extra_;
+};
+
+/** @brief Wraps a callable as a sink stage.
+ * The callable has the signature StageStatus(BufferView in).
+ */
+template <typename F>
+class SinkStage : public IStage {
+   public:
+    explicit SinkStage(F fn) : fn_(std::move(fn)) {}
+
+    std::size_t output_block_size(std::size_t) const noexcept override {
+        return 0;
+    }
+
+    StageResult process(BufferView in, BufferView) noexcept override {
+        return {0, fn_(in)};
+    }
+
+   private:
+    F fn_;
+};
+
+};  // namespace csics::pipeline
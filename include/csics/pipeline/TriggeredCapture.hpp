@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <csics/pipeline/Stage.hpp>
+#include <csics/radio/RadioRx.hpp>
+#include <vector>
+
+namespace csics::pipeline {
+
+/** @brief Header of a window emitted by TriggeredCapture, followed by
+ * `num_samples` SC16 samples.
+ */
+struct CaptureHeader {
+    enum class Source : uint32_t {
+        POWER,     // A sample reached the amplitude threshold.
+        EXTERNAL,  // TriggeredCapture::trigger_at().
+    };
+
+    // Time of the first sample.
+    radio::Timestamp timestamp_ns;
+    uint64_t num_samples;
+    // Index of the first sample, counted from the start of the stream.
+    uint64_t first_index;
+    // Offset of the trigger sample within the window.
+    uint64_t trigger_offset;
+    // ZERO_FILLED: holds zero-filled samples the radio lost. PARTIAL: less
+    // history than pre_trigger was available.
+    radio::IRadioRx::BlockFlags flags;
+    Source source;
+};
+
+/** @brief Captures a window of samples around trigger events.
+ * Consumes IRadioRx-formatted blocks and keeps the last pre_trigger samples
+ * in a ring. On a trigger the window [trigger - pre_trigger,
+ * trigger + post_trigger) is emitted as one block once complete, nothing is
+ * forwarded otherwise. Triggers during a window are ignored.
+ *
+ * Positions are exact sample indices: the first block's timestamp anchors
+ * the stream, samples are counted from there and receiver gap markers are
+ * zero-filled. A gap that runs past a pending window completes it with
+ * zeros before the rest of the gap is applied.
+ */
+class TriggeredCapture : public IStage {
+   public:
+    struct Config {
+        double sample_rate = 1e6;
+        std::size_t pre_trigger = 1024;
+        // Includes the trigger sample, at least 1.
+        std::size_t post_trigger = 4096;
+        // Triggers on the first sample with |IQ| at or above this, in SC16
+        // units. 0 disables the power trigger.
+        double amplitude_threshold = 0.0;
+    };
+
+    /**
+     * @throws std::invalid_argument if post_trigger is 0.
+     */
+    explicit TriggeredCapture(const Config& config);
+
+    /**
+     * @brief Triggers on the sample at `timestamp_ns`, e.g. from an
+     * external event. May be called from any thread. Only one external
+     * trigger is pending at a time, a newer one replaces it.
+     * Times older than the history or inside a window already captured
+     * are dropped.
+     */
+    void trigger_at(radio::Timestamp timestamp_ns) noexcept;
+
+    // Windows emitted so far. May be called from any thread.
+    uint64_t captures() const noexcept {
+        return captures_.load(std::memory_order_relaxed);
+    }
+
+    // Windows triggered but not emitted, because the output block was too
+    // small or the samples had left the history. May be called from any
+    // thread.
+    uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    std::size_t output_block_size(
+        std::size_t input_block_size) const noexcept override;
+    StageResult process(BufferView in, BufferView out) noexcept override;
+    void on_start() noexcept override;
+
+   private:
+    int64_t index_of(uint64_t timestamp_ns) const noexcept;
+    // Oldest sample index still in the ring.
+    int64_t history_begin() const noexcept;
+    bool ingest(BufferView in) noexcept;
+    // Appends `lost` zero samples for a receiver gap.
+    void zero_fill(int64_t lost) noexcept;
+    void scan() noexcept;
+    std::size_t emit(BufferView out) noexcept;
+
+    Config config_;
+    std::vector<radio::SDRRawSample> ring_;
+    std::size_t mask_;
+    int64_t threshold_sq_;
+
+    bool anchored_;
+    uint64_t base_ns_;
+    // Index of the next input sample.
+    int64_t next_index_;
+    // Power trigger scan position.
+    int64_t scan_index_;
+    // End of the last window, triggers before it are ignored.
+    int64_t holdoff_index_;
+    // Zero-filled samples, gaps within the history are merged.
+    int64_t gap_begin_;
+    int64_t gap_end_;
+    // Rest of a gap held back until the pending window was emitted.
+    int64_t deferred_zeros_;
+
+    bool pending_;
+    int64_t trigger_index_;
+    CaptureHeader::Source source_;
+
+    // Requested trigger time, 0 if none.
+    std::atomic<uint64_t> external_ns_{0};
+    std::atomic<uint64_t> captures_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+};  // namespace csics::pipeline
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <csics/ThreadPolicy.hpp>
+#include <csics/queue/ChaseLevDeque.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace csics::pipeline {
+
+/** @brief Fixed-size pool of worker threads with per-worker Chase-Lev
+ * deques.
+ *
+ * Work enters through a Submitter, a deque owned by one producer thread
+ * that the workers steal from oldest-first. Tasks running on a worker may
+ * spawn() follow-up tasks onto that worker's own deque, which idle workers
+ * steal from. Idle workers park on an atomic wait after a short spin.
+ *
+ * Tasks are intrusive: embed a Task in your own structure and keep it alive
+ * until it has run. The executor never allocates after construction.
+ */
+class WorkStealingExecutor {
+   public:
+    struct Task {
+        void (*run)(Task& task, std::size_t worker) noexcept = nullptr;
+    };
+
+    struct WorkerStats {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+        uint64_t parked = 0;
+        uint64_t involuntary_switches = 0;
+        ThreadPolicyResult thread_policy;
+    };
+
+    /** @brief Submission deque for a single producer thread.
+     * Obtained from make_submitter(), must not outlive the executor.
+     */
+    class Submitter {
+       public:
+        ~Submitter();
+        Submitter(const Submitter&) = delete;
+        Submitter& operator=(const Submitter&) = delete;
+
+        // Producer thread only. Full means `capacity` tasks are pending.
+        [[nodiscard]]
+        queue::DequeError submit(Task& task) noexcept;
+
+       private:
+        Submitter(WorkStealingExecutor& executor, std::size_t slot,
+                  std::size_t capacity);
+
+        WorkStealingExecutor& executor_;
+        std::size_t slot_;
+        queue::ChaseLevDeque<Task*> deque_;
+
+        friend class WorkStealingExecutor;
+    };
+
+    static constexpr std::size_t kMaxSubmitters = 16;
+
+    /**
+     * @param num_workers Number of worker threads, 0 uses one per hardware
+     * thread.
+     * @param deque_capacity Capacity of each worker deque for spawn().
+     * @param policy Applied to every worker, except that worker i is pinned
+     * to the single core policy.cpus[i % policy.cpus.size()].
+     */
+    explicit WorkStealingExecutor(std::size_t num_workers = 0,
+                                  std::size_t deque_capacity = 1024,
+                                  const ThreadPolicy& policy = {});
+    ~WorkStealingExecutor();
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    /**
+     * @brief Registers a new submission deque.
+     * @return nullptr if kMaxSubmitters are already registered.
+     */
+    std::unique_ptr<Submitter> make_submitter(std::size_t capacity);
+
+    /**
+     * @brief Pushes a task onto the calling worker's own deque.
+     * Only valid from inside a task running on this executor, returns
+     * DequeError::Full otherwise or when the deque is full.
+     */
+    [[nodiscard]]
+    queue::DequeError spawn(Task& task) noexcept;
+
+    std::size_t num_workers() const noexcept { return workers_.size(); }
+
+    WorkerStats stats(std::size_t worker) const noexcept;
+
+   private:
+    struct Worker;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::array<std::atomic<Submitter*>, kMaxSubmitters> submitters_;
+    // Threads currently stealing from each submitter slot.
+    std::array<std::atomic<uint32_t>, kMaxSubmitters> slot_users_;
+    std::array<std::atomic<bool>, kMaxSubmitters> claimed_;
+    std::atomic<bool> stop_;
+    alignas(queue::kCacheLineSize) std::atomic<uint32_t> epoch_;
+    std::atomic<uint32_t> sleepers_;
+
+    void worker_loop(std::size_t id) noexcept;
+    bool find_task(std::size_t id, Task*& task) noexcept;
+    void wake() noexcept;
+};
+
+};  // namespace csics::pipeline
@@ -0,0 +1,9 @@
+#pragma once
+#ifndef CSICS_BUILD_PIPELINE
+#error "Pipeline support is not enabled. Please define CSICS_BUILD_PIPELINE to use pipelines."
+#endif
+#include <csics/pipeline/Stage.hpp>
+#include <csics/pipeline/Stages.hpp>
+#include <csics/pipeline/TriggeredCapture.hpp>
+#include <csics/pipeline/WorkStealingExecutor.hpp>
+#include <csics/pipeline/PipelineGraph.hpp>
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <csics/queue/SPSCQueue.hpp>
+#include <memory>
+#include <type_traits>
+
+namespace csics::queue {
+
+enum class DequeError {
+    None,
+    Full,
+    Empty,
+    Contended,  // Lost a race against another thief or the owner, retry.
+};
+
+// Chase-Lev work-stealing deque with a fixed capacity.
+// The owning thread pushes and pops at the bottom (LIFO), any number of
+// thieves steal from the top (FIFO). Follows Le et al., "Correct and
+// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013), without the
+// resizing step so push() never allocates.
+// Elements are stored by value, use pointers or indices for larger tasks.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class ChaseLevDeque {
+   public:
+    explicit ChaseLevDeque(std::size_t capacity)
+        : capacity_(std::bit_ceil(capacity < 2 ? 2 : capacity)),
+          mask_(capacity_ - 1),
+          buffer_(std::make_unique<std::atomic<T>[]>(capacity_)),
+          top_(0),
+          bottom_(0) {}
+
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Owner only.
+    [[nodiscard]]
+    DequeError push(const T& value) noexcept {
+        const int64_t b = bottom_.load(std::memory_order_relaxed);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t >= static_cast<int64_t>(capacity_)) {
+            return DequeError::Full;
+        }
+        buffer_[b & mask_].store(value, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return DequeError::None;
+    }
+
+    // Owner only. Takes the most recently pushed element.
+    [[nodiscard]]
+    DequeError pop(T& value) noexcept {
+        const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return DequeError::Empty;
+        }
+
+        value = buffer_[b & mask_].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last element, race the thieves for it.
+            bool won = top_.compare_exchange_strong(
+                t, t + 1, std::memory_order_seq_cst,
+                std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won ? DequeError::None : DequeError::Empty;
+        }
+        return DequeError::None;
+    }
+
+    // Any thread. Takes the oldest element.
+    [[nodiscard]]
+    DequeError steal(T& value) noexcept {
+        int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t >= b) {
+            return DequeError::Empty;
+        }
+
+        value = buffer_[t & mask_].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return DequeError::Contended;
+        }
+        return DequeError::None;
+    }
+
+    // Approximate when called concurrently with the owner or thieves.
+    inline std::size_t size() const noexcept {
+        const int64_t b = bottom_.load(std::memory_order_acquire);
+        const int64_t t = top_.load(std::memory_order_acquire);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    inline bool empty() const noexcept { return size() == 0; }
+
+    inline std::size_t capacity() const noexcept { return capacity_; }
+
+   private:
+    std::size_t capacity_;
+    std::size_t mask_;
+    std::unique_ptr<std::atomic<T>[]> buffer_;
+
+    alignas(kCacheLineSize) std::atomic<int64_t> top_;
+    alignas(kCacheLineSize) std::atomic<int64_t> bottom_;
+};
+
+};  // namespace csics::queue
@@ -57,11 +57,34 @@ class SPSCQueue {
     [[nodiscard]]
     SPSCError acquire_write(WriteSlot& slot, std::size_t size) noexcept;
 
-    // Release a previously acquired write slot.
+    // Release a previously acquired write slot. slot.size may be lowered
+    // first to publish only part of it.
     void commit_write(WriteSlot&& slot) noexcept;
 
     inline std::size_t capacity() const noexcept { return capacity_; }
 
+    // Bytes of the ring in use, slot headers and padding included. Only a
+    // snapshot while the other side is active.
+    inline std::size_t used_bytes() const noexcept {
+        const std::size_t read_index =
+            read_index_.load(std::memory_order_acquire);
+        return write_index_.load(std::memory_order_acquire) - read_index;
+    }
+
+    // Bytes one committed slot of the given payload size occupies in the
+    // ring, including the slot header and cache line rounding.
+    static constexpr std::size_t slot_footprint(std::size_t size) noexcept {
+        return (size + sizeof(QueueSlotHeader) + kCacheLineSize - 1) &
+               ~(kCacheLineSize - 1);
+    }
+
+    // Capacity needed to hold `blocks` in-flight slots of up to `block_size`
+    // bytes each. One extra slot is reserved for wrap-around padding.
+    static constexpr std::size_t capacity_for(std::size_t block_size,
+                                              std::size_t blocks) noexcept {
+        return slot_footprint(block_size) * (blocks + 1) + 1;
+    }
+
     inline bool has_pending_data() const noexcept {
         return read_index_.load(std::memory_order_acquire) <
                write_index_.load(std::memory_order_acquire);
@@ -110,6 +133,14 @@ class SPSCQueue {
                 queue_.commit_read(std::move(slot));
             }
 
+            inline std::size_t used_bytes() const noexcept {
+                return queue_.used_bytes();
+            }
+
+            inline std::size_t capacity() const noexcept {
+                return queue_.capacity();
+            }
+
             ReadHandle(const ReadHandle&) = delete;
             ReadHandle& operator=(const ReadHandle&) = delete;
             ReadHandle(ReadHandle&&) = default;
@@ -135,6 +166,14 @@ class SPSCQueue {
                 queue_.commit_write(std::move(slot));
             }
 
+            inline std::size_t used_bytes() const noexcept {
+                return queue_.used_bytes();
+            }
+
+            inline std::size_t capacity() const noexcept {
+                return queue_.capacity();
+            }
+
             WriteHandle(const WriteHandle&) = delete;
             WriteHandle& operator=(const WriteHandle&) = delete;
             WriteHandle(WriteHandle&&) = default;
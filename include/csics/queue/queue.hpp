@@ -1,3 +1,4 @@
 #pragma once
 #include <csics/queue/SPSCQueue.hpp>
 #include <csics/queue/SPSCMessageQueue.hpp>
+#include <csics/queue/ChaseLevDeque.hpp>
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <chrono>
+#include <csics/radio/Radio.hpp>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace csics::radio {
+
+/** @brief Capabilities of one device, queried once and then reused. */
+struct DeviceProfile {
+    std::string serial;
+    std::string product;
+    RadioDeviceInfo rx_info{};
+    RadioDeviceInfo tx_info{};
+    // Master clock rates the device supports, the current one if unknown.
+    std::vector<double> master_clocks;
+};
+
+/** @brief Caches device discovery and capability profiles.
+ * Discovery results are kept in memory only, since devices come and go.
+ * Profiles are keyed by serial and persisted to a file, so a process opening
+ * a known device skips the capability queries entirely.
+ * All methods are thread safe. IO errors are never fatal, the cache then
+ * behaves as if empty.
+ */
+class DeviceCache {
+   public:
+    // How long discovery results are trusted by default.
+    static constexpr std::chrono::seconds kDiscoveryMaxAge{30};
+
+    // Empty path keeps profiles in memory only.
+    explicit DeviceCache(std::string path);
+
+    DeviceCache(const DeviceCache&) = delete;
+    DeviceCache& operator=(const DeviceCache&) = delete;
+
+    /**
+     * @brief Process wide cache, persisted at default_path().
+     */
+    static DeviceCache& instance();
+
+    /**
+     * @brief Profile file location. $CSICS_DEVICE_CACHE if set, otherwise
+     * csics/devices under $XDG_CACHE_HOME or ~/.cache. Empty if none exist.
+     */
+    static std::string default_path();
+
+    /**
+     * @brief Addresses found for a discovery hint, if looked up within
+     * max_age.
+     */
+    std::optional<std::vector<std::string>> discovered(
+        const std::string& hint,
+        std::chrono::milliseconds max_age = kDiscoveryMaxAge) const;
+
+    void store_discovery(const std::string& hint,
+                         std::vector<std::string> addresses);
+
+    // Forgets all discovery results, e.g. after a device failed to open.
+    void invalidate_discovery();
+
+    std::optional<DeviceProfile> profile(const std::string& serial) const;
+
+    /**
+     * @brief Adds or replaces a profile and rewrites the file.
+     * @return false if the file could not be written, the profile is kept
+     * in memory regardless.
+     */
+    bool store_profile(const DeviceProfile& profile);
+
+   private:
+    using Clock = std::chrono::steady_clock;
+    struct Discovery {
+        Clock::time_point time;
+        std::vector<std::string> addresses;
+    };
+
+    // Adds the profiles in the file that are not known yet.
+    void load();
+    // Merges the file first, so profiles other processes stored survive.
+    bool save();
+
+    const std::string path_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Discovery> discoveries_;
+    std::map<std::string, DeviceProfile> profiles_;
+};
+
+};  // namespace csics::radio
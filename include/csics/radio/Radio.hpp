@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <variant>
 #include <complex>
 
@@ -31,6 +32,7 @@ struct RadioDeviceInfo {
 
 enum class DeviceType {
     DEFAULT,
+    NULL_DEVICE,  // Transmit only, discards samples. For offline testing.
 #ifdef CSICS_USE_UHD
     USRP,
 #endif
@@ -38,6 +40,15 @@ enum class DeviceType {
 
 struct RadioDeviceArgs;
 
+struct NullDeviceArgs {
+    // Consume samples at the configured sample rate like real hardware,
+    // otherwise as fast as they are queued.
+    bool paced = true;
+    NullDeviceArgs() = default;
+    NullDeviceArgs(bool paced) : paced(paced) {}
+    operator RadioDeviceArgs() const;
+};
+
 #ifdef CSICS_USE_UHD
 struct UsrpArgs {
     const char* device_args = "";
@@ -53,7 +64,7 @@ struct RadioDeviceArgs {
 #ifdef CSICS_USE_UHD
         UsrpArgs,
 #endif
-        std::monostate>
+        NullDeviceArgs, std::monostate>
         args;
     RadioDeviceArgs();
 };
@@ -65,6 +76,17 @@ enum class StreamDataType {
     SC16,  // 16-bit signed integer complex, IQ interleaved
 };
 
+/**
+ * @brief Sample format between device and host. Converted to the host data
+ * type by the driver, narrower formats halve the link bandwidth at the cost
+ * of dynamic range.
+ */
+enum class OtwFormat : uint8_t {
+    AUTO,  // SC16 when the link carries it at the sample rate, else SC8.
+    SC16,
+    SC8,
+};
+
 struct SampleLength {
     enum class Type {
         NUM_SAMPLES,
@@ -128,9 +150,60 @@ struct Timestamp {
     }
 };
 
+/** @brief Clock that block timestamps of several radios are aligned to. */
+enum class TimeSource : uint8_t {
+    HOST,  // Device time set from the host clock, within milliseconds.
+    PPS,   // External 10 MHz reference and PPS, sample accurate.
+};
+
+/** @brief How a receive stream recovers from sample loss and stream errors.
+ */
+struct RxRecoveryConfig {
+    // Delay before the first restart attempt, doubled on every consecutive
+    // failure up to max_restart_delay.
+    std::chrono::microseconds restart_delay{1000};
+    std::chrono::microseconds max_restart_delay{100000};
+    // Consecutive restarts without receiving samples before the stream is
+    // given up. 0 retries forever.
+    uint32_t max_restarts = 16;
+    // Consecutive receive timeouts treated as a stalled stream and restarted.
+    uint32_t max_timeouts = 10;
+};
+
+/** @brief Cumulative receive counters, kept across restarts. */
+struct RxStats {
+    uint64_t blocks = 0;
+    uint64_t samples = 0;
+    uint64_t overflows = 0;
+    uint64_t timeouts = 0;
+    // Late commands, broken chains, misaligned or bad packets.
+    uint64_t stream_errors = 0;
+    uint64_t restarts = 0;
+    // Gap markers emitted, and the samples they account for.
+    uint64_t gaps = 0;
+    uint64_t lost_samples = 0;
+    // The stream was given up, no more samples will be produced.
+    bool failed = false;
+};
+
+/** @brief Cumulative transmit counters. */
+struct TxStats {
+    uint64_t blocks = 0;
+    uint64_t samples = 0;
+    uint64_t bursts = 0;
+    // The device ran out of samples in the middle of a burst.
+    uint64_t underflows = 0;
+    // Timed bursts that reached the device after their start time.
+    uint64_t late_bursts = 0;
+    // Packets lost or reordered between host and device.
+    uint64_t sequence_errors = 0;
+};
+
 struct StreamConfiguration {
     StreamDataType data_type = StreamDataType::SC16;
     SampleLength sample_length = {SampleLength::Type::NUM_SAMPLES, 1024};
+    OtwFormat otw_format = OtwFormat::AUTO;
+    RxRecoveryConfig recovery;
 };
 template <typename T>
 concept RadioDeviceArgsConvertible =
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <csics/ThreadPolicy.hpp>
+#include <csics/queue/SPSCQueue.hpp>
+#include <csics/radio/RadioRx.hpp>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace csics::radio {
+
+/** @brief Merges the streams of several receivers into time-aligned blocks.
+ * All radios must run at the same sample rate. Their clocks are synchronized
+ * to a shared TimeSource, then samples are matched by index: the first
+ * block timestamp of each radio anchors it, later samples are counted and
+ * GAP markers advance the count. Samples a radio delivered before the
+ * latest starting radio are dropped.
+ *
+ * Each output block is an IRadioRx::BlockHeader followed by `num_samples`
+ * samples of every channel, channel after channel. The timestamp is the one
+ * of the first sample. Samples a radio lost are zero-filled and the block is
+ * flagged ZERO_FILLED. The output never contains GAP markers.
+ */
+class RadioAggregator {
+   public:
+    using BlockHeader = IRadioRx::BlockHeader;
+    using BlockFlags = IRadioRx::BlockFlags;
+
+    struct Config {
+        // Applied to every radio. sample_length is also the output block
+        // length per channel.
+        StreamConfiguration stream;
+        TimeSource time_source = TimeSource::HOST;
+        // Output blocks the queue holds before the merge stalls.
+        std::size_t queue_blocks = 8;
+        ThreadPolicy thread_policy;
+    };
+
+    struct StartStatus {
+        enum class Code {
+            SUCCESS,
+            CONFIGURATION_ERROR,  // No radios or differing sample rates.
+            TIME_SYNC_FAILURE,    // A radio does not support the time source.
+            RADIO_FAILURE,        // A radio failed to start.
+        } code;
+        std::optional<queue::SPSCQueue::ReadHandle> handle;
+        // Radio the failure refers to.
+        std::size_t radio = 0;
+        ThreadPolicyResult thread_policy{};
+
+        operator bool() const noexcept { return code == Code::SUCCESS; }
+    };
+
+    struct Stats {
+        uint64_t blocks = 0;
+        // Samples dropped to align the radios at start.
+        uint64_t aligned_samples = 0;
+        // Samples zero-filled for receiver gaps, over all channels.
+        uint64_t gap_samples = 0;
+        // Times the output queue was full and merging waited.
+        uint64_t output_stalls = 0;
+    };
+
+    explicit RadioAggregator(std::vector<std::unique_ptr<IRadioRx>> radios);
+    ~RadioAggregator();
+
+    RadioAggregator(const RadioAggregator&) = delete;
+    RadioAggregator& operator=(const RadioAggregator&) = delete;
+
+    /**
+     * @brief Synchronizes and starts every radio, then the merge thread.
+     * Radios already started are stopped again on failure. Invalidates any
+     * previously returned queue.
+     */
+    StartStatus start(const Config& config) noexcept;
+
+    // Stops the merge thread and every radio.
+    void stop() noexcept;
+
+    bool is_running() const noexcept {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    std::size_t num_channels() const noexcept { return radios_.size(); }
+    IRadioRx& radio(std::size_t channel) noexcept { return *radios_[channel]; }
+
+    Stats stats() const noexcept;
+
+   private:
+    struct Channel;
+
+    void merge_loop() noexcept;
+    bool fill(Channel& ch) noexcept;
+    bool anchor() noexcept;
+    bool emit() noexcept;
+
+    std::vector<std::unique_ptr<IRadioRx>> radios_;
+    std::vector<Channel> channels_;
+    std::unique_ptr<queue::SPSCQueue> queue_;
+    std::thread thread_;
+    std::size_t block_len_ = 0;
+    double sample_rate_ = 0;
+    bool anchored_ = false;
+    uint64_t epoch_ns_ = 0;
+    // Index of the next output sample, relative to epoch_ns_.
+    int64_t next_index_ = 0;
+
+    std::atomic<uint64_t> blocks_{0};
+    std::atomic<uint64_t> aligned_samples_{0};
+    std::atomic<uint64_t> gap_samples_{0};
+    std::atomic<uint64_t> output_stalls_{0};
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_signal_{false};
+};
+
+};  // namespace csics::radio
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <csics/ThreadPolicy.hpp>
 #include <csics/radio/Radio.hpp>
 #include <csics/queue/SPSCQueue.hpp>
 #include <optional>
@@ -62,6 +63,31 @@ class IRadioRx {
         const RadioConfiguration& config) noexcept = 0;
     virtual RadioDeviceInfo get_device_info() const noexcept = 0;
 
+    /**
+     * @brief Sets the scheduling policy of the thread filling the queue.
+     * Applied right away if streaming, otherwise by the next start_stream()
+     * which reports the outcome in StartStatus::thread_policy.
+     * @return The outcome if applied right away. Radios without a receive
+     * thread report Unsupported for every requested part.
+     */
+    virtual ThreadPolicyResult set_thread_policy(
+        const ThreadPolicy& policy) noexcept;
+
+    // Context switches of the receive thread, of the last run once stopped.
+    virtual ThreadStats get_thread_stats() const noexcept;
+
+    // Receive counters of the current or last stream.
+    virtual RxStats get_rx_stats() const noexcept;
+
+    /**
+     * @brief Aligns the device clock, and so block timestamps, to `source`.
+     * Call before start_stream(). Blocks of radios synchronized to the same
+     * source can be merged by timestamp.
+     * @return false if the source is not available. Radios stamping blocks
+     * with the host clock are always synchronized to HOST.
+     */
+    virtual bool sync_time(TimeSource source) noexcept;
+
     [[maybe_unused]]
     static std::unique_ptr<IRadioRx> create_radio_rx(
         const RadioDeviceArgs& device_args, const RadioConfiguration& config);
@@ -73,16 +99,44 @@ class IRadioRx {
             CONFIGURATION_ERROR,
         } code;
         std::optional<queue::SPSCQueue::ReadHandle> rx_handle;
+        // Outcome of applying the policy from set_thread_policy(). Streaming
+        // starts regardless, check it when real-time behaviour is required.
+        ThreadPolicyResult thread_policy{};
 
         operator bool() const noexcept {
             return code == Code::SUCCESS;
         }
     };
 
+    enum class BlockFlags : uint32_t {
+        NONE = 0,
+        // Gap marker: carries no samples, `num_samples` were lost between
+        // the previous block and the next one. Zero-fill to stay in sync.
+        GAP = 1u << 0,
+        // Cut short by a stream error or stop, holds fewer samples than a
+        // full block.
+        PARTIAL = 1u << 1,
+        // Transmit only: last block of a burst, the next block starts a new
+        // one.
+        END_OF_BURST = 1u << 2,
+        // Carries `num_samples` samples like a regular block, but some of
+        // them are zeros standing in for samples lost upstream. Unlike GAP
+        // the samples must be consumed.
+        ZERO_FILLED = 1u << 3,
+    };
+
     struct BlockHeader {
-        Timestamp timestamp_ns;  // Timestamp in nanoseconds since epoch. Derived
-                                // from system clock.
+        // Time of the first sample in nanoseconds since epoch. Device time
+        // where the device timestamps samples, see sync_time().
+        Timestamp timestamp_ns;
         uint64_t num_samples;
+        BlockFlags flags;
+        uint32_t reserved;
+
+        bool has(BlockFlags flag) const noexcept {
+            return (static_cast<uint32_t>(flags) &
+                    static_cast<uint32_t>(flag)) != 0;
+        }
     };
 };
 };  // namespace csics::radio
@@ -0,0 +1,102 @@
+#pragma once
+#include <memory>
+#include <csics/ThreadPolicy.hpp>
+#include <csics/radio/Radio.hpp>
+#include <csics/radio/RadioRx.hpp>
+#include <csics/queue/SPSCQueue.hpp>
+#include <optional>
+
+namespace csics::radio {
+
+/** @brief Abstract base class for a radio transmitter.
+ * Counterpart of IRadioRx, represents a single channel.
+ * start_stream() returns the write end of a queue which a transmit thread
+ * drains into the device. Blocks use the same layout as received blocks: a
+ * BlockHeader followed by `num_samples` samples of the stream data type.
+ *
+ * Blocks are sent as bursts. The first block of a burst may carry a
+ * timestamp_ns (device time, the host epoch once synchronized with
+ * sync_time()) at which the burst starts, 0 sends it right away.
+ * Timestamps inside a burst are ignored. A block flagged
+ * END_OF_BURST closes the burst, running out of blocks before that is an
+ * underflow.
+ */
+class IRadioTx {
+   public:
+    struct StartStatus;
+    using BlockHeader = IRadioRx::BlockHeader;
+    using BlockFlags = IRadioRx::BlockFlags;
+
+    virtual ~IRadioTx() = default;
+
+    /**
+     * @brief Starts the transmit stream.
+     * @param stream_config Configuration for the stream. sample_length sets
+     * the largest block the queue accepts.
+     * @return StartStatus indicating success or failure, and the queue for
+     * sending samples. Will invalidate any previously returned queue.
+     */
+    virtual StartStatus start_stream(
+        const StreamConfiguration& stream_config) noexcept = 0;
+
+    /**
+     * @brief Stops the transmit stream once every queued block was sent.
+     * An open burst is closed. No effect if the stream is not active.
+     */
+    virtual void stop_stream() noexcept = 0;
+
+    virtual bool is_streaming() const noexcept = 0;
+
+    virtual double get_sample_rate() const noexcept = 0;
+    virtual Timestamp set_sample_rate(double rate) noexcept = 0;
+
+    virtual double get_center_frequency() const noexcept = 0;
+    virtual Timestamp set_center_frequency(double freq) noexcept = 0;
+
+    virtual double get_gain() const noexcept = 0;
+    virtual Timestamp set_gain(double gain) noexcept = 0;
+
+    virtual RadioConfiguration get_configuration() const noexcept = 0;
+    virtual Timestamp set_configuration(
+        const RadioConfiguration& config) noexcept = 0;
+    virtual RadioDeviceInfo get_device_info() const noexcept = 0;
+
+    /**
+     * @brief Sets the scheduling policy of the thread draining the queue.
+     * Same semantics as IRadioRx::set_thread_policy().
+     */
+    virtual ThreadPolicyResult set_thread_policy(
+        const ThreadPolicy& policy) noexcept;
+
+    // Context switches of the transmit thread, of the last run once stopped.
+    virtual ThreadStats get_thread_stats() const noexcept;
+
+    // Transmit counters of the current or last stream.
+    virtual TxStats get_tx_stats() const noexcept;
+
+    /**
+     * @brief Aligns the device clock, which burst timestamps refer to, to
+     * `source`. Same semantics as IRadioRx::sync_time(). Call before
+     * start_stream() when bursts are timed.
+     */
+    virtual bool sync_time(TimeSource source) noexcept;
+
+    [[maybe_unused]]
+    static std::unique_ptr<IRadioTx> create_radio_tx(
+        const RadioDeviceArgs& device_args, const RadioConfiguration& config);
+
+    struct StartStatus {
+        enum class Code {
+            SUCCESS,
+            HARDWARE_FAILURE,
+            CONFIGURATION_ERROR,
+        } code;
+        std::optional<queue::SPSCQueue::WriteHandle> tx_handle;
+        ThreadPolicyResult thread_policy{};
+
+        operator bool() const noexcept {
+            return code == Code::SUCCESS;
+        }
+    };
+};
+};  // namespace csics::radio
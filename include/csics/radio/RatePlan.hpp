@@ -0,0 +1,55 @@
+#pragma once
+
+#include <csics/radio/Radio.hpp>
+#include <cstdint>
+#include <span>
+
+namespace csics::radio {
+
+/** @brief Limits of a device's rate conversion and host link.
+ * Decimation stands for interpolation when transmitting.
+ */
+struct RateLimits {
+    uint32_t min_decimation = 1;
+    uint32_t max_decimation = 1024;
+    // Sustained sample payload of the host link in bytes per second, 0 if
+    // unknown.
+    double link_bytes_per_sec = 0;
+};
+
+/** @brief How a device produces a requested sample rate. */
+struct RatePlan {
+    double master_clock = 0;
+    uint32_t decimation = 0;
+    // master_clock / decimation, equal to the request when exact.
+    double sample_rate = 0;
+    bool exact = false;
+};
+
+/**
+ * @brief Picks the master clock that reaches `sample_rate` by integer
+ * decimation, so the device needs no fractional resampling.
+ * Exact plans are preferred, then even decimations (which can use the
+ * halfband filters), then higher clocks. Without an exact plan the closest
+ * achievable rate is chosen.
+ * @return decimation 0 if no clock can reach the rate within the limits.
+ */
+RatePlan plan_sample_rate(std::span<const double> master_clocks,
+                          double sample_rate,
+                          const RateLimits& limits) noexcept;
+
+constexpr std::size_t otw_bytes_per_sample(OtwFormat format) noexcept {
+    return format == OtwFormat::SC8 ? 2 : 4;
+}
+
+// Driver name of a concrete format ("sc16", "sc8").
+const char* otw_name(OtwFormat format) noexcept;
+
+/**
+ * @brief Resolves AUTO to the widest format the link carries at
+ * `sample_rate`, falling back to SC8. Explicit formats are kept.
+ */
+OtwFormat select_otw_format(OtwFormat requested, double sample_rate,
+                            double link_bytes_per_sec) noexcept;
+
+};  // namespace csics::radio
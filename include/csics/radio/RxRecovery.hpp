@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <csics/radio/Radio.hpp>
+#include <cstdint>
+
+namespace csics::radio {
+
+/** @brief Outcome of one receive call, independent of the device API. */
+enum class RxEvent : uint8_t {
+    NONE,
+    TIMEOUT,       // No samples within the receive timeout.
+    OVERFLOW,      // The host did not keep up, samples were dropped.
+    LATE_COMMAND,  // A timed command arrived after its time.
+    BROKEN_CHAIN,  // A chained command sequence was interrupted.
+    ALIGNMENT,     // Multi-channel packets could not be aligned.
+    BAD_PACKET,    // Malformed packet from the device.
+    FATAL,         // The receive call itself failed.
+};
+
+enum class RxAction : uint8_t {
+    CONTINUE,  // Keep receiving into the current block.
+    RESYNC,    // Samples were lost, close the block and measure the gap.
+    RESTART,   // Stop and restart streaming after restart_delay().
+    STOP,      // Give the stream up.
+};
+
+/** @brief Loss accounting and restart policy of a receive loop.
+ * Written by the receive thread only, stats() may be called from any thread.
+ * Kept free of device APIs so it can be tested without hardware.
+ */
+class RxRecovery {
+   public:
+    RxRecovery(double sample_rate, const RxRecoveryConfig& config) noexcept;
+
+    /**
+     * @brief Starts over for a new stream, clearing all state and counters.
+     * Must not race the receive thread, stats() may still run concurrently.
+     */
+    void reset(double sample_rate, const RxRecoveryConfig& config) noexcept;
+
+    /**
+     * @brief Counts an event and decides how the loop proceeds.
+     */
+    RxAction on_event(RxEvent event) noexcept;
+
+    /**
+     * @brief Records `num_samples` samples received in one call.
+     * @param time_ns Time of the first of these samples, device time when
+     * available. Must come from the same clock for the whole stream.
+     * @return Samples lost since the last samples, non-zero only after a
+     * RESYNC or RESTART action.
+     */
+    uint64_t on_samples(uint64_t num_samples, uint64_t time_ns) noexcept;
+
+    // Backoff before the next restart attempt.
+    std::chrono::microseconds restart_delay() const noexcept;
+
+    // Counts one block committed to the queue.
+    void on_block() noexcept;
+
+    RxStats stats() const noexcept;
+
+   private:
+    double sample_rate_;
+    RxRecoveryConfig config_;
+    uint64_t next_time_ns_ = 0;
+    bool have_time_ = false;
+    bool gap_pending_ = false;
+    uint32_t consecutive_timeouts_ = 0;
+    uint32_t consecutive_restarts_ = 0;
+
+    std::atomic<uint64_t> blocks_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> overflows_{0};
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> stream_errors_{0};
+    std::atomic<uint64_t> restarts_{0};
+    std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> lost_samples_{0};
+    std::atomic<bool> failed_{false};
+};
+
+};  // namespace csics::radio
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace csics::detail {
+
+// Adds to a statistics counter written by one thread and read by any. With a
+// single writer a relaxed load and store is enough, and avoids the locked
+// read-modify-write of fetch_add on the hot path.
+inline void counter_add(std::atomic<uint64_t>& counter, uint64_t n) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+}
+
+};  // namespace csics::detail
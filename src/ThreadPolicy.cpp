@@ -0,0 +1,241 @@
+#include <csics/ThreadPolicy.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace csics {
+
+ThreadPolicyResult unsupported_thread_policy(
+    const ThreadPolicy& policy) noexcept {
+    ThreadPolicyResult result{};
+    if (!policy.cpus.empty()) result.affinity = ThreadPolicyError::Unsupported;
+    if (policy.fifo_priority != 0)
+        result.scheduling = ThreadPolicyError::Unsupported;
+    if (policy.lock_memory) result.memory = ThreadPolicyError::Unsupported;
+    return result;
+}
+
+#if defined(__linux__)
+
+static ThreadPolicyError from_errno(int err) noexcept {
+    switch (err) {
+        case 0:
+            return ThreadPolicyError::None;
+        case EPERM:
+        case EACCES:
+        case ENOMEM:  // mlockall beyond RLIMIT_MEMLOCK
+            return ThreadPolicyError::PermissionDenied;
+        case EINVAL:
+            return ThreadPolicyError::InvalidArgument;
+        default:
+            return ThreadPolicyError::SystemError;
+    }
+}
+
+// Parses the kernel's cpu list format, e.g. "0,2-3".
+static std::vector<int> parse_cpu_list(const char* s) {
+    std::vector<int> cpus;
+    while (*s != '\0' && *s != '\n') {
+        char* end = nullptr;
+        long first = std::strtol(s, &end, 10);
+        if (end == s) {
+            break;
+        }
+        long last = first;
+        s = end;
+        if (*s == '-') {
+            last = std::strtol(s + 1, &end, 10);
+            s = end;
+        }
+        for (long c = first; c <= last; c++) {
+            cpus.push_back(static_cast<int>(c));
+        }
+        if (*s == ',') {
+            s++;
+        }
+    }
+    return cpus;
+}
+
+static ThreadPolicyResult apply(pthread_t thread,
+                                const ThreadPolicy& policy) noexcept {
+    ThreadPolicyResult result{};
+
+    if (!policy.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : policy.cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                result.affinity = ThreadPolicyError::InvalidArgument;
+                break;
+            }
+            CPU_SET(cpu, &set);
+        }
+        if (result.affinity == ThreadPolicyError::None) {
+            result.affinity = from_errno(
+                pthread_setaffinity_np(thread, sizeof(set), &set));
+        }
+        if (result.affinity == ThreadPolicyError::None &&
+            policy.expect_isolated) {
+            try {
+                auto isolated = isolated_cpus();
+                for (int cpu : policy.cpus) {
+                    if (std::find(isolated.begin(), isolated.end(), cpu) ==
+                        isolated.end()) {
+                        result.affinity = ThreadPolicyError::NotIsolated;
+                        break;
+                    }
+                }
+            } catch (...) {
+                result.affinity = ThreadPolicyError::SystemError;
+            }
+        }
+    }
+
+    if (policy.fifo_priority != 0) {
+        if (policy.fifo_priority < sched_get_priority_min(SCHED_FIFO) ||
+            policy.fifo_priority > sched_get_priority_max(SCHED_FIFO)) {
+            result.scheduling = ThreadPolicyError::InvalidArgument;
+        } else {
+            sched_param param{};
+            param.sched_priority = policy.fifo_priority;
+            result.scheduling =
+                from_errno(pthread_setschedparam(thread, SCHED_FIFO, &param));
+        }
+    }
+
+    if (policy.lock_memory) {
+        result.memory = mlockall(MCL_CURRENT | MCL_FUTURE) == 0
+                            ? ThreadPolicyError::None
+                            : from_errno(errno);
+    }
+
+    if (!policy.name.empty()) {
+        char name[16];
+        std::snprintf(name, sizeof(name), "%s", policy.name.c_str());
+        pthread_setname_np(thread, name);
+    }
+    return result;
+}
+
+ThreadPolicyResult apply_thread_policy(const ThreadPolicy& policy) noexcept {
+    return apply(pthread_self(), policy);
+}
+
+ThreadPolicyResult apply_thread_policy(std::thread& thread,
+                                       const ThreadPolicy& policy) noexcept {
+    if (!thread.joinable()) {
+        return {ThreadPolicyError::InvalidArgument,
+                ThreadPolicyError::InvalidArgument,
+                ThreadPolicyError::InvalidArgument};
+    }
+    return apply(thread.native_handle(), policy);
+}
+
+int current_thread_id() noexcept {
+    return static_cast<int>(syscall(SYS_gettid));
+}
+
+ThreadStats thread_stats(int tid) noexcept {
+    ThreadStats stats{};
+    if (tid < 0) {
+        return stats;
+    }
+    char path[64];
+    char line[256];
+
+    std::snprintf(path, sizeof(path), "/proc/self/task/%d/status", tid);
+    std::FILE* f = std::fopen(path, "r");
+    if (f == nullptr) {
+        return stats;
+    }
+    while (std::fgets(line, sizeof(line), f) != nullptr) {
+        unsigned long long v = 0;
+        if (std::sscanf(line, "voluntary_ctxt_switches: %llu", &v) == 1) {
+            stats.voluntary_switches = v;
+        } else if (std::sscanf(line, "nonvoluntary_ctxt_switches: %llu",
+                               &v) == 1) {
+            stats.involuntary_switches = v;
+        }
+    }
+    std::fclose(f);
+
+    // The processor is field 39 of stat, counted after the "(comm)" field
+    // which may itself contain spaces.
+    std::snprintf(path, sizeof(path), "/proc/self/task/%d/stat", tid);
+    f = std::fopen(path, "r");
+    if (f != nullptr) {
+        char stat[1024];
+        std::size_t n = std::fread(stat, 1, sizeof(stat) - 1, f);
+        stat[n] = '\0';
+        std::fclose(f);
+        const char* p = std::strrchr(stat, ')');
+        for (int field = 2; p != nullptr && field < 39; field++) {
+            p = std::strchr(p + 1, ' ');
+        }
+        if (p != nullptr) {
+            stats.last_cpu = std::atoi(p + 1);
+        }
+    }
+    stats.tid = tid;
+    return stats;
+}
+
+ThreadStats current_thread_stats() noexcept {
+    ThreadStats stats{};
+    rusage usage{};
+    if (getrusage(RUSAGE_THREAD, &usage) != 0) {
+        return stats;
+    }
+    stats.tid = current_thread_id();
+    stats.last_cpu = sched_getcpu();
+    stats.voluntary_switches = static_cast<uint64_t>(usage.ru_nvcsw);
+    stats.involuntary_switches = static_cast<uint64_t>(usage.ru_nivcsw);
+    return stats;
+}
+
+std::vector<int> isolated_cpus() {
+    std::FILE* f = std::fopen("/sys/devices/system/cpu/isolated", "r");
+    if (f == nullptr) {
+        return {};
+    }
+    char line[1024] = {};
+    bool ok = std::fgets(line, sizeof(line), f) != nullptr;
+    std::fclose(f);
+    return ok ? parse_cpu_list(line) : std::vector<int>{};
+}
+
+#else
+
+ThreadPolicyResult apply_thread_policy(const ThreadPolicy& policy) noexcept {
+    return unsupported_thread_policy(policy);
+}
+
+ThreadPolicyResult apply_thread_policy(std::thread&,
+                                       const ThreadPolicy& policy) noexcept {
+    return unsupported_thread_policy(policy);
+}
+
+int current_thread_id() noexcept { return -1; }
+
+ThreadStats thread_stats(int) noexcept { return {}; }
+
+ThreadStats current_thread_stats() noexcept { return {}; }
+
+std::vector<int> isolated_cpus() { return {}; }
+
+#endif
+
+};  // namespace csics
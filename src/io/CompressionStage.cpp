@@ -0,0 +1,272 @@
+#include <csics/io/compression/CompressionStage.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "../Counters.hpp"
+
+namespace csics::io::compression {
+
+using Flags = CompressedBlockHeader::Flags;
+
+static bool is_error(CompressionStatus status) noexcept {
+    return static_cast<uint8_t>(status) >=
+           static_cast<uint8_t>(CompressionStatus::FatalError);
+}
+
+CompressionStage::CompressionStage(queue::SPSCQueue::ReadHandle in,
+                                   queue::SPSCQueue::WriteHandle out,
+                                   const Config& config)
+    : in_(std::move(in)),
+      out_(std::move(out)),
+      config_(config),
+      compressor_(ICompressor::create(config.type, config.options)) {
+    if (config_.output_block_size == 0) {
+        throw std::invalid_argument("CompressionStage output block size is 0");
+    }
+    if (config_.adaptive_level) {
+        const LevelController::Config& adaptive = *config_.adaptive_level;
+        if (config_.blocks_per_frame == 0) {
+            throw std::invalid_argument(
+                "Adaptive compression level needs blocks_per_frame");
+        }
+        if (!compressor_->set_level(adaptive.min_level) ||
+            !compressor_->set_level(adaptive.max_level)) {
+            throw std::invalid_argument(
+                "Adaptive level range not supported by the compressor");
+        }
+        controller_.emplace(
+            adaptive, config_.options.level.value_or(adaptive.max_level));
+        compressor_->set_level(controller_->current().level);
+        compressor_->reset();
+        level_.store(controller_->current().level, std::memory_order_relaxed);
+    } else {
+        level_.store(config_.options.level.value_or(0),
+                     std::memory_order_relaxed);
+    }
+}
+
+CompressionStage::~CompressionStage() { stop(); }
+
+ThreadPolicyResult CompressionStage::start() {
+    stop_.store(false, std::memory_order_relaxed);
+    done_.store(false, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&CompressionStage::run, this);
+    return apply_thread_policy(thread_, config_.thread_policy);
+}
+
+CompressionStatus CompressionStage::stop() {
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return failed() ? CompressionStatus::FatalError
+                    : CompressionStatus::InputBufferFinished;
+}
+
+CompressionStage::Stats CompressionStage::stats() const noexcept {
+    Stats s;
+    s.blocks_in = blocks_in_.load(std::memory_order_relaxed);
+    s.bytes_in = bytes_in_.load(std::memory_order_relaxed);
+    s.blocks_out = blocks_out_.load(std::memory_order_relaxed);
+    s.bytes_out = bytes_out_.load(std::memory_order_relaxed);
+    s.frames = frames_.load(std::memory_order_relaxed);
+    s.stored_frames = stored_frames_.load(std::memory_order_relaxed);
+    s.level = level_.load(std::memory_order_relaxed);
+    s.output_stalls = output_stalls_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void CompressionStage::run() noexcept {
+    frame_start_ = std::chrono::steady_clock::now();
+    frame_start_bytes_out_ = bytes_out_.load(std::memory_order_relaxed);
+    bool ok = true;
+    while (ok) {
+        queue::SPSCQueue::ReadSlot slot{};
+        if (in_.acquire(slot) != queue::SPSCError::None) {
+            // Check the flag before polling again, a block committed just
+            // before stop() must still be seen.
+            if (stop_.load(std::memory_order_acquire)) {
+                if (in_.acquire(slot) != queue::SPSCError::None) {
+                    break;
+                }
+            } else {
+                publish(Flags::NONE);
+                std::this_thread::yield();
+                continue;
+            }
+        }
+
+        std::size_t size = slot.size;
+        ok = compress_block(BufferView(slot.data, size));
+        in_.commit(std::move(slot));
+        detail::counter_add(blocks_in_, 1);
+        detail::counter_add(bytes_in_, size);
+
+        frame_blocks_++;
+        if (ok && frame_blocks_ == config_.blocks_per_frame) {
+            ok = end_frame();
+        }
+    }
+
+    // Streams that never saw input still get a frame, so they decode.
+    if (ok && (frame_blocks_ != 0 ||
+               frames_.load(std::memory_order_relaxed) == 0)) {
+        ok = end_frame();
+    }
+    if (!ok) {
+        failed_.store(true, std::memory_order_release);
+    }
+    done_.store(true, std::memory_order_release);
+}
+
+bool CompressionStage::compress_block(BufferView in) noexcept {
+    if (store_) {
+        while (!in.empty()) {
+            if (!open_block()) {
+                return false;
+            }
+            BufferView out = space();
+            std::size_t n = std::min(in.size(), out.size());
+            std::memcpy(out.data(), in.data(), n);
+            in += n;
+            slot_used_ += n;
+            if (slot_used_ == config_.output_block_size) {
+                publish(Flags::NONE);
+            }
+        }
+        return true;
+    }
+    do {
+        if (!open_block()) {
+            return false;
+        }
+        CompressionResult r = compressor_->compress_buffer(in, space());
+        if (is_error(r.status)) {
+            return false;
+        }
+        in += r.input_consumed;
+        slot_used_ += r.compressed;
+        if (r.status == CompressionStatus::OutputBufferFull ||
+            slot_used_ == config_.output_block_size) {
+            publish(Flags::NONE);
+        }
+    } while (!in.empty());
+    return true;
+}
+
+bool CompressionStage::end_frame() noexcept {
+    while (!store_) {
+        if (!open_block()) {
+            return false;
+        }
+        CompressionResult r = compressor_->finish(BufferView(), space());
+        slot_used_ += r.compressed;
+        if (r.status == CompressionStatus::InputBufferFinished) {
+            break;
+        }
+        if (r.status != CompressionStatus::OutputBufferFull &&
+            r.status != CompressionStatus::NeedsFlush) {
+            return false;
+        }
+        publish(Flags::NONE);
+    }
+    // A stored frame may have filled its last block exactly.
+    if (!open_block()) {
+        return false;
+    }
+    publish(Flags::FRAME_END);
+    if (store_) {
+        detail::counter_add(stored_frames_, 1);
+    }
+    if (controller_) {
+        adapt();
+    }
+    compressor_->reset();
+
+    detail::counter_add(frames_, 1);
+    frame_blocks_ = 0;
+    frame_offset_ = bytes_in_.load(std::memory_order_relaxed);
+    frame_started_ = false;
+    return true;
+}
+
+void CompressionStage::adapt() noexcept {
+    auto now = std::chrono::steady_clock::now();
+    uint64_t bytes_out = bytes_out_.load(std::memory_order_relaxed);
+    double seconds = std::chrono::duration<double>(now - frame_start_).count();
+    LevelController::Sample sample{};
+    sample.fill = static_cast<double>(in_.used_bytes()) /
+                  static_cast<double>(in_.capacity());
+    sample.output_bps =
+        seconds > 0.0
+            ? static_cast<double>(bytes_out - frame_start_bytes_out_) / seconds
+            : 0.0;
+    frame_start_ = now;
+    frame_start_bytes_out_ = bytes_out;
+
+    LevelController::Decision next = controller_->update(sample);
+    store_ = next.store;
+    if (!store_) {
+        compressor_->set_level(next.level);
+    }
+    level_.store(next.level, std::memory_order_relaxed);
+}
+
+bool CompressionStage::open_block() noexcept {
+    if (slot_.data != nullptr) {
+        return true;
+    }
+    std::size_t size =
+        sizeof(CompressedBlockHeader) + config_.output_block_size;
+    while (true) {
+        auto err = out_.acquire(slot_, size);
+        if (err == queue::SPSCError::None) {
+            break;
+        }
+        if (err == queue::SPSCError::TooBig) {
+            return false;
+        }
+        detail::counter_add(output_stalls_, 1);
+        std::this_thread::yield();
+    }
+    slot_used_ = 0;
+    return true;
+}
+
+BufferView CompressionStage::space() noexcept {
+    return BufferView(slot_.data + sizeof(CompressedBlockHeader) + slot_used_,
+                      config_.output_block_size - slot_used_);
+}
+
+void CompressionStage::publish(Flags flags) noexcept {
+    if (slot_.data == nullptr ||
+        (slot_used_ == 0 && flags == Flags::NONE)) {
+        return;
+    }
+    uint32_t bits = static_cast<uint32_t>(flags);
+    if (!frame_started_) {
+        bits |= static_cast<uint32_t>(Flags::FRAME_START);
+        frame_started_ = true;
+    }
+    if (store_) {
+        bits |= static_cast<uint32_t>(Flags::STORED);
+    }
+    flags = static_cast<Flags>(bits);
+    CompressedBlockHeader hdr{};
+    hdr.frame_offset = frame_offset_;
+    hdr.frame = static_cast<uint32_t>(frames_.load(std::memory_order_relaxed));
+    hdr.flags = flags;
+    std::memcpy(slot_.data, &hdr, sizeof(hdr));
+
+    slot_.size = sizeof(CompressedBlockHeader) + slot_used_;
+    out_.commit(std::move(slot_));
+    detail::counter_add(blocks_out_, 1);
+    detail::counter_add(bytes_out_, slot_used_);
+    slot_.data = nullptr;
+    slot_.size = 0;
+    slot_used_ = 0;
+}
+
+};  // namespace csics::io::compression
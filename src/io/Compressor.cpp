@@ -1,21 +1,40 @@
 #include <csics/io/compression/Compressor.hpp>
+#include "FilteredCompressor.hpp"
 #include "ZLIBCompressor.hpp"
 #include "ZSTDCompressor.hpp"
+#ifdef CSICS_USE_LZ4
+#include "LZ4Compressor.hpp"
+#endif
 
 namespace csics::io::compression {
 
-    std::unique_ptr<ICompressor> ICompressor::create(CompressorType type) {
+    static std::unique_ptr<ICompressor> create_backend(
+        CompressorType type, [[maybe_unused]] const CompressionOptions& options) {
         switch (type) {
 #ifdef CSICS_USE_ZLIB
             case CompressorType::ZLIB:
-                return std::make_unique<ZLIBCompressor>();
+                return std::make_unique<ZLIBCompressor>(options);
 #endif
 #ifdef CSICS_USE_ZSTD
             case CompressorType::ZSTD:
-                return std::make_unique<ZSTDCompressor>();
+                return std::make_unique<ZSTDCompressor>(options);
+#endif
+#ifdef CSICS_USE_LZ4
+            case CompressorType::LZ4:
+                return std::make_unique<LZ4Compressor>(options);
 #endif
             default:
                 throw std::invalid_argument("Unsupported compressor type");
         }
     }
+
+    std::unique_ptr<ICompressor> ICompressor::create(
+        CompressorType type, const CompressionOptions& options) {
+        auto backend = create_backend(type, options);
+        if (options.filter == IQFilter::None) {
+            return backend;
+        }
+        return std::make_unique<FilteredCompressor>(std::move(backend),
+                                                    options.filter);
+    }
 };
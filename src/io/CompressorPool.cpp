@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <csics/io/compression/CompressorPool.hpp>
+
+namespace csics::io::compression {
+
+CompressorPool::CompressorPool(CompressorType type,
+                               const CompressionOptions& options,
+                               std::size_t prewarm, std::size_t max_idle)
+    : type_(type), options_(options), max_idle_(max_idle) {
+    idle_.reserve(max_idle_);
+    // At least one, which validates the configuration.
+    std::size_t n = std::max<std::size_t>(std::min(prewarm, max_idle_), 1);
+    for (std::size_t i = 0; i < n; i++) {
+        idle_.push_back(ICompressor::create(type_, options_));
+    }
+    if (max_idle_ == 0) {
+        idle_.clear();
+    }
+}
+
+CompressorPool::Handle CompressorPool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_.empty()) {
+            ICompressor* compressor = idle_.back().release();
+            idle_.pop_back();
+            return Handle(compressor, Release{this});
+        }
+    }
+    return Handle(ICompressor::create(type_, options_).release(),
+                  Release{this});
+}
+
+std::size_t CompressorPool::idle() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+}
+
+void CompressorPool::release(ICompressor* compressor) noexcept {
+    std::unique_ptr<ICompressor> owned(compressor);
+    // Reset outside the lock, it may touch the whole context.
+    owned->reset();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.size() < max_idle_) {
+        // Capacity was reserved for max_idle_, this does not allocate.
+        idle_.push_back(std::move(owned));
+    }
+}
+
+void CompressorPool::Release::operator()(
+    ICompressor* compressor) const noexcept {
+    pool->release(compressor);
+}
+
+};  // namespace csics::io::compression
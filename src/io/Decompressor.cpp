@@ -0,0 +1,56 @@
+#include <csics/io/decompression/Decompressor.hpp>
+#include <stdexcept>
+
+#include "FilteredDecompressor.hpp"
+
+#ifdef CSICS_USE_ZLIB
+#include "ZLIBDecompressor.hpp"
+#endif
+#ifdef CSICS_USE_ZSTD
+#include "ZSTDDecompressor.hpp"
+#endif
+#ifdef CSICS_USE_LZ4
+#include "LZ4Decompressor.hpp"
+#endif
+
+namespace csics::io::decompression {
+
+static std::unique_ptr<IDecompressor> create_backend(
+    CompressorType type, [[maybe_unused]] const DecompressionOptions& options) {
+    switch (type) {
+#ifdef CSICS_USE_ZLIB
+        case CompressorType::ZLIB:
+            if (!options.dictionaries.empty()) {
+                throw std::invalid_argument(
+                    "ZLIB does not support ZSTD dictionaries");
+            }
+            return std::make_unique<ZLIBDecompressor>(options);
+#endif
+#ifdef CSICS_USE_ZSTD
+        case CompressorType::ZSTD:
+            return std::make_unique<ZSTDDecompressor>(options);
+#endif
+#ifdef CSICS_USE_LZ4
+        case CompressorType::LZ4:
+            if (!options.dictionaries.empty()) {
+                throw std::invalid_argument(
+                    "LZ4 does not support ZSTD dictionaries");
+            }
+            return std::make_unique<LZ4Decompressor>();
+#endif
+        default:
+            throw std::invalid_argument("Unsupported decompressor type");
+    }
+}
+
+std::unique_ptr<IDecompressor> IDecompressor::create(
+    CompressorType type, const DecompressionOptions& options) {
+    auto backend = create_backend(type, options);
+    if (options.filter == compression::IQFilter::None) {
+        return backend;
+    }
+    return std::make_unique<FilteredDecompressor>(std::move(backend),
+                                                  options.filter);
+}
+
+};  // namespace csics::io::decompression
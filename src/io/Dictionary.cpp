@@ -0,0 +1,78 @@
+#include <zdict.h>
+#include <zstd.h>
+
+#include <csics/io/compression/Dictionary.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace csics::io::compression {
+
+Dictionary::Dictionary(BufferView data, int level)
+    : data_(data.data(), data.data() + data.size()),
+      id_(0),
+      level_(level),
+      cdict_(nullptr),
+      ddict_(nullptr) {
+    id_ = ZDICT_getDictID(data_.data(), data_.size());
+    if (id_ == 0) {
+        throw std::invalid_argument("Not a ZSTD dictionary");
+    }
+    cdict_ = ZSTD_createCDict(data_.data(), data_.size(), level_);
+    ddict_ = ZSTD_createDDict(data_.data(), data_.size());
+    if (cdict_ == nullptr || ddict_ == nullptr) {
+        ZSTD_freeCDict(static_cast<ZSTD_CDict*>(cdict_));
+        ZSTD_freeDDict(static_cast<ZSTD_DDict*>(ddict_));
+        throw std::invalid_argument("Failed to load ZSTD dictionary");
+    }
+}
+
+Dictionary::~Dictionary() {
+    ZSTD_freeCDict(static_cast<ZSTD_CDict*>(cdict_));
+    ZSTD_freeDDict(static_cast<ZSTD_DDict*>(ddict_));
+}
+
+std::shared_ptr<const Dictionary> Dictionary::train(
+    std::span<const BufferView> samples, std::size_t max_size, uint32_t id,
+    int level) {
+    std::vector<char> flat;
+    std::vector<std::size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& s : samples) {
+        flat.insert(flat.end(), s.data(), s.data() + s.size());
+        sizes.push_back(s.size());
+    }
+
+    std::vector<char> dict(max_size);
+    std::size_t size =
+        ZDICT_trainFromBuffer(dict.data(), dict.size(), flat.data(),
+                              sizes.data(), static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(size)) {
+        throw std::runtime_error(std::string("ZSTD dictionary training failed: ") +
+                                 ZDICT_getErrorName(size));
+    }
+
+    if (id != 0) {
+        // Rebuilds the headers around the trained content with the ID.
+        std::size_t header = ZDICT_getDictHeaderSize(dict.data(), size);
+        if (ZDICT_isError(header)) {
+            throw std::runtime_error("ZSTD dictionary training failed");
+        }
+        std::vector<char> content(dict.begin() + header, dict.begin() + size);
+        ZDICT_params_t params{};
+        params.compressionLevel = level;
+        params.dictID = id;
+        size = ZDICT_finalizeDictionary(
+            dict.data(), dict.size(), content.data(), content.size(),
+            flat.data(), sizes.data(), static_cast<unsigned>(sizes.size()),
+            params);
+        if (ZDICT_isError(size)) {
+            throw std::runtime_error(
+                std::string("ZSTD dictionary training failed: ") +
+                ZDICT_getErrorName(size));
+        }
+    }
+    return std::make_shared<const Dictionary>(BufferView(dict.data(), size),
+                                              level);
+}
+
+};  // namespace csics::io::compression
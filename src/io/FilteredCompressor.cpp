@@ -0,0 +1,151 @@
+#include "FilteredCompressor.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace csics::io::compression {
+
+// FatalError and the statuses after it.
+static bool failed(CompressionStatus status) noexcept {
+    return static_cast<uint8_t>(status) >=
+           static_cast<uint8_t>(CompressionStatus::FatalError);
+}
+
+FilteredCompressor::FilteredCompressor(std::unique_ptr<ICompressor> inner,
+                                       IQFilter filter)
+    : inner_(std::move(inner)),
+      filter_(filter),
+      block_(kIQFilterBlockSize),
+      filtered_(kIQFilterBlockSize) {}
+
+void FilteredCompressor::reset() {
+    inner_->reset();
+    block_fill_ = 0;
+    filtered_begin_ = 0;
+    filtered_end_ = 0;
+    finishing_ = false;
+}
+
+CompressionResult FilteredCompressor::push(BufferView& out) {
+    if (filtered_begin_ == filtered_end_) {
+        return CompressionResult{0, 0, CompressionStatus::NeedsInput};
+    }
+    CompressionResult r = inner_->compress_buffer(
+        BufferView(filtered_.data() + filtered_begin_,
+                   filtered_end_ - filtered_begin_),
+        out);
+    filtered_begin_ += r.input_consumed;
+    out += r.compressed;
+    if (filtered_begin_ == filtered_end_) {
+        filtered_begin_ = 0;
+        filtered_end_ = 0;
+    }
+    return r;
+}
+
+CompressionResult FilteredCompressor::compress_partial(BufferView in,
+                                                       BufferView out) {
+    CompressionResult r{0, 0, CompressionStatus::NeedsInput};
+    if (finishing_) {
+        r.status = CompressionStatus::InvalidState;
+        return r;
+    }
+    CompressionResult p = push(out);
+    r.compressed += p.compressed;
+    if (failed(p.status)) {
+        r.status = p.status;
+        return r;
+    }
+    if (filtered_end_ != 0) {
+        r.status = CompressionStatus::OutputBufferFull;
+        return r;
+    }
+    if (in.empty()) {
+        return r;
+    }
+
+    if (block_fill_ == 0 && in.size() >= kIQFilterBlockSize) {
+        // Whole blocks are filtered straight from the input.
+        iq_filter_encode(filter_, in(0, kIQFilterBlockSize),
+                         BufferView(filtered_));
+        r.input_consumed = kIQFilterBlockSize;
+    } else {
+        std::size_t n = std::min(in.size(), kIQFilterBlockSize - block_fill_);
+        std::memcpy(block_.data() + block_fill_, in.data(), n);
+        block_fill_ += n;
+        r.input_consumed = n;
+        if (block_fill_ != kIQFilterBlockSize) {
+            return r;
+        }
+        iq_filter_encode(filter_, BufferView(block_), BufferView(filtered_));
+        block_fill_ = 0;
+    }
+    filtered_end_ = kIQFilterBlockSize;
+
+    p = push(out);
+    r.compressed += p.compressed;
+    if (failed(p.status)) {
+        r.status = p.status;
+    } else if (filtered_end_ != 0) {
+        r.status = CompressionStatus::OutputBufferFull;
+    } else if (r.input_consumed == in.size()) {
+        r.status = CompressionStatus::NeedsInput;
+    } else {
+        r.status = CompressionStatus::Ok;
+    }
+    return r;
+}
+
+CompressionResult FilteredCompressor::compress_buffer(BufferView in,
+                                                      BufferView out) {
+    CompressionResult total{0, 0, CompressionStatus::NeedsInput};
+    while (true) {
+        CompressionResult r = compress_partial(in, out);
+        in += r.input_consumed;
+        out += r.compressed;
+        total.input_consumed += r.input_consumed;
+        total.compressed += r.compressed;
+        if (r.status != CompressionStatus::Ok) {
+            total.status = r.status;
+            return total;
+        }
+    }
+}
+
+CompressionResult FilteredCompressor::finish(BufferView in, BufferView out) {
+    CompressionResult r{0, 0, CompressionStatus::InputBufferFinished};
+    if (!finishing_) {
+        r = compress_buffer(in, out);
+        if (r.status != CompressionStatus::NeedsInput) {
+            return r;
+        }
+        out += r.compressed;
+        if (block_fill_ != 0) {
+            iq_filter_encode(filter_, BufferView(block_.data(), block_fill_),
+                             BufferView(filtered_));
+            filtered_end_ = block_fill_;
+            block_fill_ = 0;
+        }
+        finishing_ = true;
+    }
+
+    CompressionResult p = push(out);
+    r.compressed += p.compressed;
+    if (failed(p.status)) {
+        r.status = p.status;
+        return r;
+    }
+    if (filtered_end_ != 0) {
+        r.status = CompressionStatus::OutputBufferFull;
+        return r;
+    }
+    CompressionResult f = inner_->finish(BufferView(), out);
+    r.compressed += f.compressed;
+    r.status = f.status;
+    if (f.status == CompressionStatus::InputBufferFinished) {
+        finishing_ = false;
+    }
+    return r;
+}
+
+};  // namespace csics::io::compression
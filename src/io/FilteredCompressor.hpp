@@ -0,0 +1,34 @@
+#pragma once
+#include <csics/io/compression/Compressor.hpp>
+#include <csics/io/compression/IQFilter.hpp>
+#include <memory>
+#include <vector>
+
+namespace csics::io::compression {
+
+// Applies an IQFilter to each kIQFilterBlockSize block of the stream
+// before handing it to the backend. The last block of a stream may be
+// shorter.
+class FilteredCompressor : public ICompressor {
+   public:
+    FilteredCompressor(std::unique_ptr<ICompressor> inner, IQFilter filter);
+    CompressionResult compress_partial(BufferView in, BufferView out) override;
+    CompressionResult compress_buffer(BufferView in, BufferView out) override;
+    CompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+    bool set_level(int level) override { return inner_->set_level(level); }
+
+   private:
+    // Feeds filtered bytes to the backend, returns its result.
+    CompressionResult push(BufferView& out);
+
+    std::unique_ptr<ICompressor> inner_;
+    IQFilter filter_;
+    std::vector<char> block_;
+    std::size_t block_fill_ = 0;
+    std::vector<char> filtered_;
+    std::size_t filtered_begin_ = 0;
+    std::size_t filtered_end_ = 0;
+    bool finishing_ = false;
+};
+};  // namespace csics::io::compression
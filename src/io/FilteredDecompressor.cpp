@@ -0,0 +1,126 @@
+#include "FilteredDecompressor.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace csics::io::decompression {
+
+using compression::kIQFilterBlockSize;
+
+FilteredDecompressor::FilteredDecompressor(
+    std::unique_ptr<IDecompressor> inner, compression::IQFilter filter)
+    : inner_(std::move(inner)),
+      filter_(filter),
+      filtered_(kIQFilterBlockSize),
+      decoded_(kIQFilterBlockSize) {}
+
+void FilteredDecompressor::reset() {
+    inner_->reset();
+    filtered_fill_ = 0;
+    decoded_begin_ = 0;
+    decoded_end_ = 0;
+    in_frame_ = false;
+    frame_done_ = false;
+}
+
+void FilteredDecompressor::drain(BufferView& out,
+                                 std::size_t& written) noexcept {
+    std::size_t n = std::min(out.size(), decoded_end_ - decoded_begin_);
+    std::memcpy(out.data(), decoded_.data() + decoded_begin_, n);
+    decoded_begin_ += n;
+    out += n;
+    written += n;
+    if (decoded_begin_ == decoded_end_) {
+        decoded_begin_ = 0;
+        decoded_end_ = 0;
+    }
+}
+
+void FilteredDecompressor::decode_block(BufferView& out,
+                                        std::size_t& written) {
+    BufferView block(filtered_.data(), filtered_fill_);
+    if (out.size() >= filtered_fill_) {
+        iq_filter_decode(filter_, block, out);
+        out += filtered_fill_;
+        written += filtered_fill_;
+    } else {
+        iq_filter_decode(filter_, block, BufferView(decoded_));
+        decoded_begin_ = 0;
+        decoded_end_ = filtered_fill_;
+        drain(out, written);
+    }
+    filtered_fill_ = 0;
+}
+
+DecompressionResult FilteredDecompressor::decompress_partial(BufferView in,
+                                                             BufferView out) {
+    DecompressionResult r{0, 0, CompressionStatus::NeedsInput};
+    drain(out, r.decompressed);
+    if (decoded_end_ != 0) {
+        r.status = CompressionStatus::OutputBufferFull;
+        return r;
+    }
+    if (frame_done_) {
+        frame_done_ = false;
+        r.status = CompressionStatus::InputBufferFinished;
+        return r;
+    }
+
+    DecompressionResult d = inner_->decompress_partial(
+        in, BufferView(filtered_.data() + filtered_fill_,
+                       kIQFilterBlockSize - filtered_fill_));
+    filtered_fill_ += d.decompressed;
+    r.input_consumed = d.input_consumed;
+    if (d.status == CompressionStatus::FatalError) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+        return r;
+    }
+    bool ended = d.status == CompressionStatus::InputBufferFinished;
+    in_frame_ = !ended && (in_frame_ || d.input_consumed != 0);
+    if (filtered_fill_ == kIQFilterBlockSize ||
+        (ended && filtered_fill_ != 0)) {
+        decode_block(out, r.decompressed);
+    }
+
+    if (decoded_end_ != 0) {
+        frame_done_ = ended;
+        r.status = CompressionStatus::OutputBufferFull;
+    } else {
+        r.status = d.status;
+    }
+    return r;
+}
+
+DecompressionResult FilteredDecompressor::decompress_buffer(BufferView in,
+                                                            BufferView out) {
+    DecompressionResult total{0, 0, CompressionStatus::InputBufferFinished};
+    while (!in.empty() || in_frame_ || decoded_end_ != 0 || frame_done_) {
+        DecompressionResult r = decompress_partial(in, out);
+        in += r.input_consumed;
+        out += r.decompressed;
+        total.input_consumed += r.input_consumed;
+        total.decompressed += r.decompressed;
+        total.status = r.status;
+        // A full block buffer is not a full output.
+        bool more = r.status == CompressionStatus::InputBufferFinished ||
+                    (r.status == CompressionStatus::OutputBufferFull &&
+                     !out.empty());
+        if (!more) {
+            break;
+        }
+    }
+    return total;
+}
+
+DecompressionResult FilteredDecompressor::finish(BufferView in,
+                                                 BufferView out) {
+    DecompressionResult r = decompress_buffer(in, out);
+    if (r.status == CompressionStatus::NeedsInput) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+    }
+    return r;
+}
+
+};  // namespace csics::io::decompression
@@ -0,0 +1,39 @@
+#pragma once
+#include <csics/io/compression/IQFilter.hpp>
+#include <csics/io/decompression/Decompressor.hpp>
+#include <memory>
+#include <vector>
+
+namespace csics::io::decompression {
+
+// Inverse of FilteredCompressor: decodes each block once the backend has
+// produced all of it, or the frame has ended.
+class FilteredDecompressor : public IDecompressor {
+   public:
+    FilteredDecompressor(std::unique_ptr<IDecompressor> inner,
+                         compression::IQFilter filter);
+    DecompressionResult decompress_partial(BufferView in,
+                                           BufferView out) override;
+    DecompressionResult decompress_buffer(BufferView in,
+                                          BufferView out) override;
+    DecompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+   private:
+    // Decodes the filtered block into `out`, staging what does not fit.
+    void decode_block(BufferView& out, std::size_t& written);
+    // Moves staged output into `out`.
+    void drain(BufferView& out, std::size_t& written) noexcept;
+
+    std::unique_ptr<IDecompressor> inner_;
+    compression::IQFilter filter_;
+    std::vector<char> filtered_;
+    std::size_t filtered_fill_ = 0;
+    std::vector<char> decoded_;
+    std::size_t decoded_begin_ = 0;
+    std::size_t decoded_end_ = 0;
+    bool in_frame_ = false;
+    // The frame ended while decoded output was still staged.
+    bool frame_done_ = false;
+};
+};  // namespace csics::io::decompression
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <csics/io/compression/IQFilter.hpp>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace csics::io::compression {
+
+namespace {
+
+// Block layout, for `values` int16 values (two per sample): the low byte
+// plane, then the high byte plane, then any trailing partial sample.
+// Bit shuffled planes hold bit plane k of every complete group of 8 bytes
+// at [k * groups, (k + 1) * groups), followed by the bytes left over.
+
+// Groups bit transposed at a time. The bit planes of a block are far
+// apart, writing them a tile at a time keeps the accesses sequential.
+constexpr std::size_t kTileGroups = 128;
+
+// Transposes an 8x8 bit matrix held as byte i = row i, bit j = column j.
+inline uint64_t transpose8x8(uint64_t x) noexcept {
+    uint64_t t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+    return x ^ t ^ (t << 28);
+}
+
+// Small negative and positive deltas both get zero high bits.
+inline uint16_t zigzag(uint16_t d) noexcept {
+    return static_cast<uint16_t>((d << 1) ^ (0u - (d >> 15)));
+}
+
+inline uint16_t unzigzag(uint16_t z) noexcept {
+    return static_cast<uint16_t>((z >> 1) ^ (0u - (z & 1u)));
+}
+
+inline uint16_t load_value(const uint8_t* p, std::size_t n) noexcept {
+    uint16_t v;
+    std::memcpy(&v, p + 2 * n, sizeof(v));
+    return v;
+}
+
+inline void store_value(uint8_t* p, std::size_t n, uint16_t v) noexcept {
+    std::memcpy(p + 2 * n, &v, sizeof(v));
+}
+
+#if defined(__SSE2__)
+// Values [n, n + 8), delta and zigzag encoded if asked.
+inline __m128i prepare_sse2(const uint8_t* src, std::size_t n,
+                            bool delta) noexcept {
+    __m128i cur =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 2 * n));
+    if (!delta) {
+        return cur;
+    }
+    // The previous sample of each channel is 4 bytes back.
+    __m128i prev =
+        n >= 2 ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                     src + 2 * n - 4))
+               : _mm_slli_si128(cur, 4);
+    __m128i d = _mm_sub_epi16(cur, prev);
+    return _mm_xor_si128(_mm_slli_epi16(d, 1), _mm_srai_epi16(d, 15));
+}
+
+// Undoes the zigzag and prefix sums the deltas per channel, continuing
+// from `carry`, the last sample decoded, in every 32 bit lane.
+inline __m128i restore_sse2(__m128i z, __m128i& carry) noexcept {
+    __m128i d = _mm_xor_si128(
+        _mm_srli_epi16(z, 1),
+        _mm_sub_epi16(_mm_setzero_si128(),
+                      _mm_and_si128(z, _mm_set1_epi16(1))));
+    __m128i x = _mm_add_epi16(d, _mm_slli_si128(d, 4));
+    x = _mm_add_epi16(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi16(x, carry);
+    carry = _mm_shuffle_epi32(x, 0xFF);
+    return x;
+}
+#endif
+
+// Splits values [begin, end) of `src` into lo[0, end - begin) and
+// hi[0, end - begin).
+void shuffle(const uint8_t* src, std::size_t begin, std::size_t end,
+             bool delta, uint8_t* lo, uint8_t* hi) noexcept {
+    std::size_t n = begin;
+#if defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi16(0xFF);
+    for (; n + 16 <= end; n += 16) {
+        __m128i z0 = prepare_sse2(src, n, delta);
+        __m128i z1 = prepare_sse2(src, n + 8, delta);
+        __m128i l = _mm_packus_epi16(_mm_and_si128(z0, mask),
+                                     _mm_and_si128(z1, mask));
+        __m128i h =
+            _mm_packus_epi16(_mm_srli_epi16(z0, 8), _mm_srli_epi16(z1, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lo + (n - begin)), l);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hi + (n - begin)), h);
+    }
+#endif
+    for (; n < end; n++) {
+        uint16_t v = load_value(src, n);
+        if (delta) {
+            uint16_t prev = n >= 2 ? load_value(src, n - 2) : 0;
+            v = zigzag(static_cast<uint16_t>(v - prev));
+        }
+        lo[n - begin] = static_cast<uint8_t>(v);
+        hi[n - begin] = static_cast<uint8_t>(v >> 8);
+    }
+}
+
+// Inverse of shuffle, values before `begin` are already in `dst`.
+void unshuffle(const uint8_t* lo, const uint8_t* hi, std::size_t begin,
+               std::size_t end, bool delta, uint8_t* dst) noexcept {
+    std::size_t n = begin;
+#if defined(__SSE2__)
+    __m128i carry = _mm_setzero_si128();
+    if (begin >= 2) {
+        int32_t last;
+        std::memcpy(&last, dst + 2 * (begin - 2), sizeof(last));
+        carry = _mm_set1_epi32(last);
+    }
+    for (; n + 16 <= end; n += 16) {
+        __m128i l = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(lo + (n - begin)));
+        __m128i h = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(hi + (n - begin)));
+        __m128i z0 = _mm_unpacklo_epi8(l, h);
+        __m128i z1 = _mm_unpackhi_epi8(l, h);
+        if (delta) {
+            z0 = restore_sse2(z0, carry);
+            z1 = restore_sse2(z1, carry);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * n), z0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * n + 16), z1);
+    }
+#endif
+    for (; n < end; n++) {
+        auto v = static_cast<uint16_t>(lo[n - begin] | hi[n - begin] << 8);
+        if (delta) {
+            uint16_t prev = n >= 2 ? load_value(dst, n - 2) : 0;
+            v = static_cast<uint16_t>(unzigzag(v) + prev);
+        }
+        store_value(dst, n, v);
+    }
+}
+
+// Writes bit plane k of `count` groups of 8 `bytes` to
+// planes[k * stride, k * stride + count).
+void split_bits(const uint8_t* bytes, std::size_t count, uint8_t* planes,
+                std::size_t stride) noexcept {
+    uint64_t t[kTileGroups];
+    for (std::size_t g = 0; g < count; g++) {
+        std::memcpy(&t[g], bytes + 8 * g, sizeof(t[g]));
+        t[g] = transpose8x8(t[g]);
+    }
+    for (std::size_t k = 0; k < 8; k++) {
+        uint8_t* row = planes + k * stride;
+        for (std::size_t g = 0; g < count; g++) {
+            row[g] = static_cast<uint8_t>(t[g] >> (8 * k));
+        }
+    }
+}
+
+// Inverse of split_bits.
+void join_bits(const uint8_t* planes, std::size_t stride, std::size_t count,
+               uint8_t* bytes) noexcept {
+    uint64_t t[kTileGroups] = {};
+    std::size_t g = 0;
+#if defined(__SSE2__)
+    // Byte k of t[g] is row k at g, an 8x16 byte transpose by unpacking.
+    for (; g + 16 <= count; g += 16) {
+        __m128i r[8];
+        for (std::size_t k = 0; k < 8; k++) {
+            r[k] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(planes + k * stride + g));
+        }
+        __m128i a[8];
+        for (std::size_t k = 0; k < 8; k += 2) {
+            a[k] = _mm_unpacklo_epi8(r[k], r[k + 1]);
+            a[k + 1] = _mm_unpackhi_epi8(r[k], r[k + 1]);
+        }
+        __m128i b[8];
+        for (std::size_t k = 0; k < 8; k += 4) {
+            b[k] = _mm_unpacklo_epi16(a[k], a[k + 2]);
+            b[k + 1] = _mm_unpackhi_epi16(a[k], a[k + 2]);
+            b[k + 2] = _mm_unpacklo_epi16(a[k + 1], a[k + 3]);
+            b[k + 3] = _mm_unpackhi_epi16(a[k + 1], a[k + 3]);
+        }
+        auto* out = reinterpret_cast<__m128i*>(t + g);
+        for (std::size_t i = 0; i < 4; i++) {
+            _mm_storeu_si128(out + 2 * i, _mm_unpacklo_epi32(b[i], b[i + 4]));
+            _mm_storeu_si128(out + 2 * i + 1,
+                             _mm_unpackhi_epi32(b[i], b[i + 4]));
+        }
+    }
+#endif
+    for (std::size_t k = 0; k < 8; k++) {
+        const uint8_t* row = planes + k * stride;
+        for (std::size_t i = g; i < count; i++) {
+            t[i] |= static_cast<uint64_t>(row[i]) << (8 * k);
+        }
+    }
+    for (g = 0; g < count; g++) {
+        uint64_t x = transpose8x8(t[g]);
+        std::memcpy(bytes + 8 * g, &x, sizeof(x));
+    }
+}
+
+bool uses_delta(IQFilter filter) noexcept {
+    return filter == IQFilter::DeltaShuffle ||
+           filter == IQFilter::DeltaBitShuffle;
+}
+
+bool uses_bits(IQFilter filter) noexcept {
+    return filter == IQFilter::BitShuffle ||
+           filter == IQFilter::DeltaBitShuffle;
+}
+
+};  // namespace
+
+void iq_filter_encode(IQFilter filter, BufferView in, BufferView out) noexcept {
+    if (filter == IQFilter::None) {
+        std::memcpy(out.data(), in.data(), in.size());
+        return;
+    }
+    const uint8_t* src = in.uc();
+    uint8_t* lo = out.uc();
+    std::size_t values = in.size() / 4 * 2;
+    uint8_t* hi = lo + values;
+    bool delta = uses_delta(filter);
+    std::size_t begin = 0;
+
+    if (uses_bits(filter)) {
+        std::size_t groups = values / 8;
+        uint8_t lo_tile[8 * kTileGroups];
+        uint8_t hi_tile[8 * kTileGroups];
+        for (std::size_t g = 0; g < groups; g += kTileGroups) {
+            std::size_t count = std::min(kTileGroups, groups - g);
+            shuffle(src, 8 * g, 8 * (g + count), delta, lo_tile, hi_tile);
+            split_bits(lo_tile, count, lo + g, groups);
+            split_bits(hi_tile, count, hi + g, groups);
+        }
+        begin = 8 * groups;
+    }
+    shuffle(src, begin, values, delta, lo + begin, hi + begin);
+    std::memcpy(out.data() + 2 * values, in.data() + 2 * values,
+                in.size() - 2 * values);
+}
+
+void iq_filter_decode(IQFilter filter, BufferView in, BufferView out) noexcept {
+    if (filter == IQFilter::None) {
+        std::memcpy(out.data(), in.data(), in.size());
+        return;
+    }
+    const uint8_t* lo = in.uc();
+    uint8_t* dst = out.uc();
+    std::size_t values = in.size() / 4 * 2;
+    const uint8_t* hi = lo + values;
+    bool delta = uses_delta(filter);
+    std::size_t begin = 0;
+
+    if (uses_bits(filter)) {
+        std::size_t groups = values / 8;
+        uint8_t lo_tile[8 * kTileGroups];
+        uint8_t hi_tile[8 * kTileGroups];
+        for (std::size_t g = 0; g < groups; g += kTileGroups) {
+            std::size_t count = std::min(kTileGroups, groups - g);
+            join_bits(lo + g, groups, count, lo_tile);
+            join_bits(hi + g, groups, count, hi_tile);
+            unshuffle(lo_tile, hi_tile, 8 * g, 8 * (g + count), delta, dst);
+        }
+        begin = 8 * groups;
+    }
+    unshuffle(lo + begin, hi + begin, begin, values, delta, dst);
+    std::memcpy(out.data() + 2 * values, in.data() + 2 * values,
+                in.size() - 2 * values);
+}
+
+};  // namespace csics::io::compression
@@ -0,0 +1,242 @@
+#include "LZ4Compressor.hpp"
+
+#include <lz4frame.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace csics::io::compression {
+
+// Linked blocks of the default 64 KiB, each fed to LZ4F in one update.
+static constexpr std::size_t kBlockSize = 64 * 1024;
+
+static LZ4F_preferences_t make_preferences(
+    int level, std::size_t content_size) noexcept {
+    LZ4F_preferences_t prefs{};
+    // Negative levels trade ratio for speed, 3 and up use LZ4HC.
+    prefs.compressionLevel = level;
+    prefs.frameInfo.contentSize = content_size;
+    return prefs;
+}
+
+LZ4Compressor::LZ4Compressor(const CompressionOptions& options)
+    : cctx_(nullptr),
+      level_(options.level.value_or(0)),
+      next_level_(level_) {
+    if (level_ > LZ4F_compressionLevel_max()) {
+        throw std::invalid_argument("Invalid LZ4 compression level");
+    }
+    if (options.dictionary) {
+        throw std::invalid_argument("LZ4 does not support ZSTD dictionaries");
+    }
+    LZ4F_cctx* cctx = nullptr;
+    if (LZ4F_isError(LZ4F_createCompressionContext(&cctx, LZ4F_VERSION))) {
+        throw std::runtime_error("Failed to create LZ4 compression context");
+    }
+    cctx_ = cctx;
+    LZ4F_preferences_t prefs = make_preferences(level_, 0);
+    // Enough for the header, or for any one update or the frame end.
+    staging_.resize(LZ4F_compressBound(kBlockSize, &prefs) +
+                    LZ4F_HEADER_SIZE_MAX);
+}
+
+LZ4Compressor::~LZ4Compressor() {
+    if (cctx_ != nullptr) {
+        LZ4F_freeCompressionContext(static_cast<LZ4F_cctx*>(cctx_));
+        cctx_ = nullptr;
+    }
+}
+
+void LZ4Compressor::reset() {
+    // The context is reinitialized by the next frame header.
+    staged_begin_ = 0;
+    staged_end_ = 0;
+    state_ = State::Idle;
+    level_ = next_level_;
+}
+
+bool LZ4Compressor::set_level(int level) {
+    if (level > LZ4F_compressionLevel_max()) {
+        return false;
+    }
+    next_level_ = level;
+    return true;
+}
+
+bool LZ4Compressor::begin(std::size_t content_size) noexcept {
+    LZ4F_preferences_t prefs = make_preferences(level_, content_size);
+    std::size_t n = LZ4F_compressBegin(static_cast<LZ4F_cctx*>(cctx_),
+                                       staging_.data(), staging_.size(),
+                                       &prefs);
+    if (LZ4F_isError(n)) {
+        return false;
+    }
+    staged_begin_ = 0;
+    staged_end_ = n;
+    state_ = State::Compressing;
+    return true;
+}
+
+std::size_t LZ4Compressor::drain(BufferView& out) noexcept {
+    std::size_t n = std::min(out.size(), staged_end_ - staged_begin_);
+    std::memcpy(out.data(), staging_.data() + staged_begin_, n);
+    staged_begin_ += n;
+    out += n;
+    if (staged_begin_ == staged_end_) {
+        staged_begin_ = 0;
+        staged_end_ = 0;
+    }
+    return n;
+}
+
+CompressionResult LZ4Compressor::compress_partial(BufferView in,
+                                                  BufferView out) {
+    CompressionResult r{0, 0, CompressionStatus::NeedsInput};
+    if (state_ == State::Ending) {
+        r.status = CompressionStatus::InvalidState;
+        return r;
+    }
+    if (state_ == State::Idle) {
+        if (in.empty()) {
+            return r;
+        }
+        if (!begin(0)) {
+            r.status = CompressionStatus::FatalError;
+            return r;
+        }
+    }
+
+    r.compressed += drain(out);
+    if (staged_end_ != 0) {
+        r.status = CompressionStatus::OutputBufferFull;
+        return r;
+    }
+    if (in.empty()) {
+        return r;
+    }
+
+    auto* cctx = static_cast<LZ4F_cctx*>(cctx_);
+    std::size_t n = std::min(in.size(), kBlockSize);
+    // Compressed in place when the worst case fits, staged otherwise.
+    bool direct = out.size() >= staging_.size();
+    std::size_t written =
+        direct ? LZ4F_compressUpdate(cctx, out.data(), out.size(), in.data(),
+                                     n, nullptr)
+               : LZ4F_compressUpdate(cctx, staging_.data(), staging_.size(),
+                                     in.data(), n, nullptr);
+    if (LZ4F_isError(written)) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+        return r;
+    }
+    r.input_consumed = n;
+    if (direct) {
+        out += written;
+        r.compressed += written;
+    } else {
+        staged_end_ = written;
+        r.compressed += drain(out);
+    }
+
+    if (staged_end_ != 0 || out.empty()) {
+        r.status = CompressionStatus::OutputBufferFull;
+    } else if (n == in.size()) {
+        r.status = CompressionStatus::NeedsInput;
+    } else {
+        r.status = CompressionStatus::Ok;
+    }
+    return r;
+}
+
+CompressionResult LZ4Compressor::compress_buffer(BufferView in,
+                                                 BufferView out) {
+    CompressionResult total{0, 0, CompressionStatus::NeedsInput};
+    while (true) {
+        CompressionResult r = compress_partial(in, out);
+        in += r.input_consumed;
+        out += r.compressed;
+        total.input_consumed += r.input_consumed;
+        total.compressed += r.compressed;
+        if (r.status != CompressionStatus::Ok) {
+            total.status = r.status;
+            return total;
+        }
+    }
+}
+
+CompressionResult LZ4Compressor::finish(BufferView in, BufferView out) {
+    auto* cctx = static_cast<LZ4F_cctx*>(cctx_);
+    CompressionResult r{0, 0, CompressionStatus::InputBufferFinished};
+
+    if (state_ == State::Idle) {
+        LZ4F_preferences_t prefs = make_preferences(level_, in.size());
+        if (out.size() >= LZ4F_compressFrameBound(in.size(), &prefs)) {
+            // The whole message in one frame, without staging.
+            std::size_t header =
+                LZ4F_compressBegin(cctx, out.data(), out.size(), &prefs);
+            if (LZ4F_isError(header)) {
+                r.status = CompressionStatus::FatalError;
+                return r;
+            }
+            out += header;
+            std::size_t body = LZ4F_compressUpdate(
+                cctx, out.data(), out.size(), in.data(), in.size(), nullptr);
+            if (LZ4F_isError(body)) {
+                r.status = CompressionStatus::FatalError;
+                return r;
+            }
+            out += body;
+            std::size_t end =
+                LZ4F_compressEnd(cctx, out.data(), out.size(), nullptr);
+            if (LZ4F_isError(end)) {
+                r.status = CompressionStatus::FatalError;
+                return r;
+            }
+            r.compressed = header + body + end;
+            r.input_consumed = in.size();
+            return r;
+        }
+        // An empty stream still gets a frame, so it decodes to nothing.
+        if (!begin(0)) {
+            r.status = CompressionStatus::FatalError;
+            return r;
+        }
+    }
+
+    if (state_ == State::Compressing) {
+        r = compress_buffer(in, out);
+        if (r.status != CompressionStatus::NeedsInput) {
+            return r;
+        }
+        out += r.compressed;
+        bool direct = out.size() >= staging_.size();
+        std::size_t written =
+            direct ? LZ4F_compressEnd(cctx, out.data(), out.size(), nullptr)
+                   : LZ4F_compressEnd(cctx, staging_.data(), staging_.size(),
+                                      nullptr);
+        if (LZ4F_isError(written)) {
+            reset();
+            r.status = CompressionStatus::FatalError;
+            return r;
+        }
+        if (direct) {
+            out += written;
+            r.compressed += written;
+        } else {
+            staged_end_ = written;
+        }
+        state_ = State::Ending;
+    }
+
+    r.compressed += drain(out);
+    if (staged_end_ != 0) {
+        r.status = CompressionStatus::OutputBufferFull;
+        return r;
+    }
+    state_ = State::Idle;
+    r.status = CompressionStatus::InputBufferFinished;
+    return r;
+}
+
+};  // namespace csics::io::compression
@@ -0,0 +1,41 @@
+#pragma once
+#include <csics/io/compression/Compressor.hpp>
+#include <vector>
+
+namespace csics::io::compression {
+
+/** @brief Writes the LZ4 frame format, readable by the `lz4` tool.
+ * Streaming: compress_partial/compress_buffer emit linked 64 KiB blocks as
+ * they fill, output that does not fit is staged until the next call.
+ * Frame: finish on a fresh stream with room for the whole frame writes it
+ * straight into the output, recording the content size.
+ */
+class LZ4Compressor : public ICompressor {
+   public:
+    explicit LZ4Compressor(const CompressionOptions& options = {});
+    ~LZ4Compressor() override;
+    CompressionResult compress_partial(BufferView in, BufferView out) override;
+    CompressionResult compress_buffer(BufferView in, BufferView out) override;
+    CompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+    bool set_level(int level) override;
+
+   private:
+    // Writes the frame header into the staging buffer.
+    bool begin(std::size_t content_size) noexcept;
+    // Moves staged output into `out`, returns the bytes written.
+    std::size_t drain(BufferView& out) noexcept;
+
+    void* cctx_;
+    int level_;
+    int next_level_;
+    std::vector<char> staging_;
+    std::size_t staged_begin_ = 0;
+    std::size_t staged_end_ = 0;
+    enum class State : uint8_t {
+        Idle,
+        Compressing,
+        Ending
+    } state_ = State::Idle;
+};
+};  // namespace csics::io::compression
@@ -0,0 +1,82 @@
+#include "LZ4Decompressor.hpp"
+
+#include <lz4frame.h>
+
+#include <stdexcept>
+
+namespace csics::io::decompression {
+
+LZ4Decompressor::LZ4Decompressor() : dctx_(nullptr) {
+    LZ4F_dctx* dctx = nullptr;
+    if (LZ4F_isError(LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION))) {
+        throw std::runtime_error("Failed to create LZ4 decompression context");
+    }
+    dctx_ = dctx;
+}
+
+LZ4Decompressor::~LZ4Decompressor() {
+    if (dctx_ != nullptr) {
+        LZ4F_freeDecompressionContext(static_cast<LZ4F_dctx*>(dctx_));
+        dctx_ = nullptr;
+    }
+}
+
+void LZ4Decompressor::reset() {
+    LZ4F_resetDecompressionContext(static_cast<LZ4F_dctx*>(dctx_));
+    in_frame_ = false;
+}
+
+DecompressionResult LZ4Decompressor::decompress_partial(BufferView in,
+                                                        BufferView out) {
+    std::size_t out_size = out.size();
+    std::size_t in_size = in.size();
+    // Stops exactly at the end of a frame, returning 0 there.
+    std::size_t hint =
+        LZ4F_decompress(static_cast<LZ4F_dctx*>(dctx_), out.data(), &out_size,
+                        in.data(), &in_size, nullptr);
+
+    DecompressionResult r{};
+    r.decompressed = out_size;
+    r.input_consumed = in_size;
+    if (LZ4F_isError(hint)) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+    } else if (hint == 0) {
+        in_frame_ = false;
+        r.status = CompressionStatus::InputBufferFinished;
+    } else {
+        in_frame_ = in_frame_ || in_size != 0;
+        r.status = out_size == out.size()
+                       ? CompressionStatus::OutputBufferFull
+                       : CompressionStatus::NeedsInput;
+    }
+    return r;
+}
+
+DecompressionResult LZ4Decompressor::decompress_buffer(BufferView in,
+                                                       BufferView out) {
+    DecompressionResult total{0, 0, CompressionStatus::InputBufferFinished};
+    while (!in.empty() || in_frame_) {
+        DecompressionResult r = decompress_partial(in, out);
+        in += r.input_consumed;
+        out += r.decompressed;
+        total.input_consumed += r.input_consumed;
+        total.decompressed += r.decompressed;
+        total.status = r.status;
+        if (r.status != CompressionStatus::InputBufferFinished) {
+            break;
+        }
+    }
+    return total;
+}
+
+DecompressionResult LZ4Decompressor::finish(BufferView in, BufferView out) {
+    DecompressionResult r = decompress_buffer(in, out);
+    if (r.status == CompressionStatus::NeedsInput) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+    }
+    return r;
+}
+
+};  // namespace csics::io::decompression
@@ -0,0 +1,22 @@
+#pragma once
+#include <csics/io/decompression/Decompressor.hpp>
+
+namespace csics::io::decompression {
+
+// Reads LZ4 frames, as written by LZ4Compressor or the `lz4` tool.
+class LZ4Decompressor : public IDecompressor {
+   public:
+    LZ4Decompressor();
+    ~LZ4Decompressor() override;
+    DecompressionResult decompress_partial(BufferView in,
+                                           BufferView out) override;
+    DecompressionResult decompress_buffer(BufferView in,
+                                          BufferView out) override;
+    DecompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+   private:
+    void* dctx_;
+    bool in_frame_ = false;
+};
+};  // namespace csics::io::decompression
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <csics/io/compression/LevelController.hpp>
+#include <stdexcept>
+
+namespace csics::io::compression {
+
+LevelController::LevelController(const Config& config, int initial_level)
+    : config_(config),
+      level_(std::clamp(initial_level, config.min_level,
+                        std::max(config.min_level, config.max_level))) {
+    if (config_.min_level > config_.max_level) {
+        throw std::invalid_argument("LevelController min level above max");
+    }
+    if (!(config_.low_water >= 0.0 &&
+          config_.low_water <= config_.high_water &&
+          config_.high_water <= config_.store_water)) {
+        throw std::invalid_argument(
+            "LevelController water marks must be ordered");
+    }
+}
+
+LevelController::Decision LevelController::update(
+    const Sample& sample) noexcept {
+    if (sample.fill >= config_.store_water) {
+        // Falling behind further would drop input, store right away.
+        store_ = true;
+        hold_ = config_.hold_frames;
+        return current();
+    }
+    if (store_) {
+        if (sample.fill < config_.high_water) {
+            store_ = false;
+            level_ = config_.min_level;
+            hold_ = config_.hold_frames;
+        }
+        return current();
+    }
+    if (hold_ > 0) {
+        hold_--;
+        return current();
+    }
+
+    int level = level_;
+    if (sample.fill > config_.high_water) {
+        level -= std::max(1, (level_ - config_.min_level) / 2);
+    } else if (sample.fill < config_.low_water ||
+               (config_.max_output_bps > 0.0 &&
+                sample.output_bps > config_.max_output_bps)) {
+        level++;
+    }
+    level = std::clamp(level, config_.min_level, config_.max_level);
+    if (level != level_) {
+        level_ = level;
+        hold_ = config_.hold_frames;
+    }
+    return current();
+}
+
+};  // namespace csics::io::compression
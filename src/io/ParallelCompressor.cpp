@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <csics/io/compression/ParallelCompressor.hpp>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace csics::io::compression {
+
+// Worst case growth of the backends on incompressible data, plus headers.
+static std::size_t output_bound(std::size_t input_size) noexcept {
+    return input_size + input_size / 64 + 4096;
+}
+
+ParallelCompressor::ParallelCompressor(const Config& config) : config_(config) {
+    if (config_.chunk_size == 0) {
+        throw std::invalid_argument("ParallelCompressor chunk size is 0");
+    }
+    std::size_t workers = config_.workers;
+    if (workers == 0) {
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t in_flight = config_.max_in_flight;
+    if (in_flight == 0) {
+        in_flight = 2 * workers;
+    }
+    frames_.resize(std::max<std::size_t>(in_flight, 2));
+
+    for (std::size_t i = 0; i < workers; i++) {
+        compressors_.push_back(
+            ICompressor::create(config_.type, config_.options));
+    }
+    threads_.reserve(workers);
+    for (auto& compressor : compressors_) {
+        threads_.emplace_back(&ParallelCompressor::worker_loop, this,
+                              std::ref(*compressor));
+    }
+}
+
+ParallelCompressor::~ParallelCompressor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    queued_cv_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+void ParallelCompressor::worker_loop(ICompressor& compressor) noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        queued_cv_.wait(lock, [this] { return stop_ || started_ < submitted_; });
+        if (stop_) {
+            return;
+        }
+        Frame& frame = frames_[started_++ % frames_.size()];
+        lock.unlock();
+        bool ok = compress_frame(compressor, frame);
+        lock.lock();
+        frame.state = ok ? Frame::State::Done : Frame::State::Failed;
+        done_cv_.notify_all();
+    }
+}
+
+bool ParallelCompressor::compress_frame(ICompressor& compressor,
+                                        Frame& frame) noexcept {
+    compressor.reset();
+    try {
+        if (frame.output.size() < output_bound(frame.input_size)) {
+            frame.output.resize(output_bound(frame.input_size));
+        }
+    } catch (...) {
+        return false;
+    }
+
+    std::size_t in_pos = 0;
+    std::size_t out_pos = 0;
+    auto grow = [&frame]() {
+        try {
+            frame.output.resize(frame.output.size() * 2);
+            return true;
+        } catch (...) {
+            return false;
+        }
+    };
+
+    // The whole frame in one finish call, so backends can take their
+    // one-shot path.
+    while (true) {
+        BufferView in(frame.input.data() + in_pos, frame.input_size - in_pos);
+        BufferView out(frame.output.data() + out_pos,
+                       frame.output.size() - out_pos);
+        CompressionResult r = compressor.finish(in, out);
+        in_pos += r.input_consumed;
+        out_pos += r.compressed;
+        if (r.status == CompressionStatus::InputBufferFinished) {
+            break;
+        }
+        if ((r.status != CompressionStatus::OutputBufferFull &&
+             r.status != CompressionStatus::NeedsFlush) ||
+            !grow()) {
+            return false;
+        }
+    }
+    frame.output_size = out_pos;
+    return true;
+}
+
+void ParallelCompressor::submit() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frames_[submitted_ % frames_.size()].state = Frame::State::Queued;
+        submitted_++;
+    }
+    queued_cv_.notify_one();
+}
+
+bool ParallelCompressor::drain(BufferView& out, std::size_t& written,
+                               bool wait) {
+    while (drained_ < submitted_ && !out.empty()) {
+        Frame& frame = frames_[drained_ % frames_.size()];
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (wait) {
+                done_cv_.wait(lock, [&frame] {
+                    return frame.state == Frame::State::Done ||
+                           frame.state == Frame::State::Failed;
+                });
+            }
+            if (frame.state == Frame::State::Failed) {
+                return false;
+            }
+            if (frame.state != Frame::State::Done) {
+                return true;
+            }
+        }
+        std::size_t n = std::min(out.size(), frame.output_size - frame.written);
+        std::memcpy(out.data(), frame.output.data() + frame.written, n);
+        frame.written += n;
+        out += n;
+        written += n;
+        if (frame.written == frame.output_size) {
+            frame.state = Frame::State::Filling;
+            frame.input_size = 0;
+            frame.output_size = 0;
+            frame.written = 0;
+            drained_++;
+        }
+    }
+    return true;
+}
+
+void ParallelCompressor::reset() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (std::size_t n = drained_; n < submitted_; n++) {
+        Frame& frame = frames_[n % frames_.size()];
+        done_cv_.wait(lock, [&frame] {
+            return frame.state == Frame::State::Done ||
+                   frame.state == Frame::State::Failed;
+        });
+    }
+    for (auto& frame : frames_) {
+        frame.state = Frame::State::Filling;
+        frame.input_size = 0;
+        frame.output_size = 0;
+        frame.written = 0;
+    }
+    drained_ = submitted_;
+    stream_begin_ = submitted_;
+    finishing_ = false;
+}
+
+CompressionResult ParallelCompressor::compress_partial(BufferView in,
+                                                       BufferView out) {
+    CompressionResult r{0, 0, CompressionStatus::NeedsInput};
+    if (finishing_) {
+        r.status = CompressionStatus::InvalidState;
+        return r;
+    }
+    while (true) {
+        if (!drain(out, r.compressed, false)) {
+            r.status = CompressionStatus::FatalError;
+            return r;
+        }
+        if (in.empty()) {
+            r.status = CompressionStatus::NeedsInput;
+            return r;
+        }
+        if (out.empty()) {
+            r.status = CompressionStatus::OutputBufferFull;
+            return r;
+        }
+        if (submitted_ - drained_ == frames_.size()) {
+            // Every frame is in flight, the oldest one frees a slot.
+            if (!drain(out, r.compressed, true)) {
+                r.status = CompressionStatus::FatalError;
+                return r;
+            }
+            continue;
+        }
+
+        Frame& frame = frames_[submitted_ % frames_.size()];
+        if (frame.input.size() != config_.chunk_size) {
+            try {
+                frame.input.resize(config_.chunk_size);
+            } catch (...) {
+                r.status = CompressionStatus::FatalError;
+                return r;
+            }
+        }
+        std::size_t n = std::min(in.size(), config_.chunk_size - frame.input_size);
+        std::memcpy(frame.input.data() + frame.input_size, in.data(), n);
+        frame.input_size += n;
+        in += n;
+        r.input_consumed += n;
+        if (frame.input_size == config_.chunk_size) {
+            submit();
+        }
+    }
+}
+
+CompressionResult ParallelCompressor::compress_buffer(BufferView in,
+                                                      BufferView out) {
+    return compress_partial(in, out);
+}
+
+CompressionResult ParallelCompressor::finish(BufferView in, BufferView out) {
+    CompressionResult r{0, 0, CompressionStatus::InputBufferFinished};
+    if (!finishing_) {
+        r = compress_partial(in, out);
+        if (r.status != CompressionStatus::NeedsInput) {
+            return r;
+        }
+        out += r.compressed;
+        if (submitted_ - drained_ == frames_.size()) {
+            if (!drain(out, r.compressed, true)) {
+                r.status = CompressionStatus::FatalError;
+                return r;
+            }
+            if (submitted_ - drained_ == frames_.size()) {
+                r.status = CompressionStatus::OutputBufferFull;
+                return r;
+            }
+        }
+        Frame& frame = frames_[submitted_ % frames_.size()];
+        // An empty stream still gets a frame, so it decodes to nothing.
+        if (frame.input_size != 0 || submitted_ == stream_begin_) {
+            submit();
+        }
+        finishing_ = true;
+    }
+
+    std::size_t written = 0;
+    if (!drain(out, written, true)) {
+        r.status = CompressionStatus::FatalError;
+        return r;
+    }
+    r.compressed += written;
+    if (drained_ < submitted_) {
+        r.status = CompressionStatus::OutputBufferFull;
+        return r;
+    }
+    finishing_ = false;
+    stream_begin_ = submitted_;
+    r.status = CompressionStatus::InputBufferFinished;
+    return r;
+}
+
+};  // namespace csics::io::compression
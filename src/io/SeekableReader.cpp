@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <csics/io/decompression/SeekableReader.hpp>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+namespace csics::io::decompression {
+
+using compression::seekable::Footer;
+using compression::seekable::IndexEntry;
+
+SeekableReader::SeekableReader(BufferView container, const Config& config)
+    : container_(container), footer_{} {
+    if (container_.size() < sizeof(Footer)) {
+        throw std::invalid_argument("Seekable container too small");
+    }
+    std::size_t body = container_.size() - sizeof(Footer);
+    std::memcpy(&footer_, container_.data() + body, sizeof(Footer));
+    CompressorType type{};
+    if (footer_.magic != compression::seekable::kMagic ||
+        footer_.version != compression::seekable::kVersion) {
+        throw std::invalid_argument("Not a seekable container");
+    }
+    if (!compression::seekable::codec_type(footer_.codec, type)) {
+        throw std::invalid_argument("Unsupported seekable container codec");
+    }
+    uint64_t frames = footer_.frame_size == 0
+                          ? 0
+                          : (footer_.uncompressed_size + footer_.frame_size -
+                             1) / footer_.frame_size;
+    if (footer_.frame_size == 0 || footer_.frame_count != frames ||
+        footer_.frame_count > body / sizeof(IndexEntry) ||
+        footer_.index_offset !=
+            body - footer_.frame_count * sizeof(IndexEntry)) {
+        throw std::invalid_argument("Corrupt seekable container index");
+    }
+
+    index_.resize(footer_.frame_count);
+    std::memcpy(index_.data(), container_.data() + footer_.index_offset,
+                index_.size() * sizeof(IndexEntry));
+    for (const IndexEntry& entry : index_) {
+        if (entry.compressed_offset > footer_.index_offset ||
+            entry.compressed_size >
+                footer_.index_offset - entry.compressed_offset) {
+            throw std::invalid_argument("Corrupt seekable container index");
+        }
+    }
+
+    DecompressionOptions options = config.options;
+    options.filter = footer_.filter;
+    std::size_t threads = config.workers;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    }
+    for (std::size_t i = 0; i <= threads; i++) {
+        auto worker = std::make_unique<Worker>();
+        worker->decompressor = IDecompressor::create(type, options);
+        workers_.push_back(std::move(worker));
+    }
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        threads_.emplace_back(&SeekableReader::worker_loop, this,
+                              std::ref(*workers_[i]));
+    }
+}
+
+SeekableReader::SeekableReader(BufferView container)
+    : SeekableReader(container, Config{}) {}
+
+SeekableReader::~SeekableReader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+uint64_t SeekableReader::offset_at(uint64_t timestamp_ns) const noexcept {
+    auto it = std::upper_bound(
+        index_.begin(), index_.end(), timestamp_ns,
+        [](uint64_t t, const IndexEntry& e) { return t < e.timestamp_ns; });
+    if (it == index_.begin()) {
+        return 0;
+    }
+    return static_cast<uint64_t>(it - index_.begin() - 1) *
+           footer_.frame_size;
+}
+
+DecompressionResult SeekableReader::read(uint64_t offset, BufferView out) {
+    DecompressionResult r{0, 0, CompressionStatus::InputBufferFinished};
+    if (offset >= size() || out.empty()) {
+        return r;
+    }
+    std::size_t len = static_cast<std::size_t>(
+        std::min<uint64_t>(out.size(), size() - offset));
+    std::size_t first = offset / footer_.frame_size;
+    std::size_t last = (offset + len - 1) / footer_.frame_size + 1;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        read_offset_ = offset;
+        read_out_ = out(0, len);
+        next_frame_ = first;
+        end_frame_ = last;
+        pending_ = last - first;
+        read_failed_ = false;
+    }
+    if (last - first > 1) {
+        work_cv_.notify_all();
+    }
+    decode_frames(*workers_.back());
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+    if (read_failed_) {
+        r.status = CompressionStatus::FatalError;
+        return r;
+    }
+    for (std::size_t i = first; i < last; i++) {
+        r.input_consumed += index_[i].compressed_size;
+    }
+    r.decompressed = len;
+    return r;
+}
+
+void SeekableReader::worker_loop(Worker& worker) noexcept {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock,
+                      [this] { return stop_ || next_frame_ < end_frame_; });
+        if (stop_) {
+            return;
+        }
+        lock.unlock();
+        decode_frames(worker);
+        lock.lock();
+    }
+}
+
+void SeekableReader::decode_frames(Worker& worker) noexcept {
+    while (true) {
+        std::size_t i;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (next_frame_ == end_frame_) {
+                return;
+            }
+            i = next_frame_++;
+        }
+        bool ok = decode_frame(worker, i);
+        std::lock_guard<std::mutex> lock(mutex_);
+        read_failed_ = read_failed_ || !ok;
+        if (--pending_ == 0) {
+            done_cv_.notify_all();
+        }
+    }
+}
+
+bool SeekableReader::decode_frame(Worker& worker, std::size_t i) noexcept {
+    const IndexEntry& entry = index_[i];
+    uint64_t frame_begin = static_cast<uint64_t>(i) * footer_.frame_size;
+    std::size_t frame_len = static_cast<std::size_t>(std::min<uint64_t>(
+        footer_.frame_size, size() - frame_begin));
+    // The part of the frame inside the read.
+    uint64_t begin = std::max(frame_begin, read_offset_);
+    uint64_t end = std::min(frame_begin + frame_len,
+                            read_offset_ + read_out_.size());
+    char* dst = read_out_.data() + (begin - read_offset_);
+    // Only the prefix up to the end of the read is decoded.
+    std::size_t need = static_cast<std::size_t>(end - frame_begin);
+
+    // Frames starting inside the read are decoded in place.
+    bool direct = begin == frame_begin;
+    BufferView target;
+    if (direct) {
+        target = BufferView(dst, need);
+    } else {
+        try {
+            worker.scratch.resize(std::max<std::size_t>(
+                worker.scratch.size(), frame_len));
+        } catch (...) {
+            return false;
+        }
+        target = BufferView(worker.scratch.data(), need);
+    }
+
+    BufferView in(container_.data() + entry.compressed_offset,
+                  entry.compressed_size);
+    IDecompressor& decompressor = *worker.decompressor;
+    decompressor.reset();
+    DecompressionResult r = need == frame_len
+                                ? decompressor.finish(in, target)
+                                : decompressor.decompress_buffer(in, target);
+    if (r.decompressed != need ||
+        (need == frame_len &&
+         r.status != CompressionStatus::InputBufferFinished) ||
+        r.status == CompressionStatus::FatalError) {
+        return false;
+    }
+    if (!direct) {
+        std::memcpy(dst, worker.scratch.data() + (begin - frame_begin),
+                    end - begin);
+    }
+    return true;
+}
+
+};  // namespace csics::io::decompression
@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <cmath>
+#include <csics/io/compression/SeekableWriter.hpp>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace csics::io::compression {
+
+namespace seekable {
+
+uint8_t codec_id(CompressorType type) noexcept {
+    switch (type) {
+#ifdef CSICS_USE_ZLIB
+        case CompressorType::ZLIB:
+            return 1;
+#endif
+#ifdef CSICS_USE_ZSTD
+        case CompressorType::ZSTD:
+            return 2;
+#endif
+#ifdef CSICS_USE_LZ4
+        case CompressorType::LZ4:
+            return 3;
+#endif
+        default:
+            return 0;
+    }
+}
+
+bool codec_type(uint8_t codec, [[maybe_unused]] CompressorType& type) noexcept {
+    switch (codec) {
+#ifdef CSICS_USE_ZLIB
+        case 1:
+            type = CompressorType::ZLIB;
+            return true;
+#endif
+#ifdef CSICS_USE_ZSTD
+        case 2:
+            type = CompressorType::ZSTD;
+            return true;
+#endif
+#ifdef CSICS_USE_LZ4
+        case 3:
+            type = CompressorType::LZ4;
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+};  // namespace seekable
+
+SeekableWriter::SeekableWriter(const Config& config)
+    : config_(config),
+      compressor_(ICompressor::create(config.type, config.options)) {
+    if (config_.frame_size == 0 ||
+        config_.frame_size > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Invalid seekable frame size");
+    }
+    if (config_.bytes_per_sample == 0) {
+        throw std::invalid_argument("Seekable bytes per sample is 0");
+    }
+}
+
+void SeekableWriter::set_timestamp(uint64_t timestamp_ns) noexcept {
+    has_timestamp_ = true;
+    timestamp_ns_ = timestamp_ns;
+    timestamp_offset_ = consumed_;
+}
+
+uint64_t SeekableWriter::timestamp_at(uint64_t offset) const noexcept {
+    if (!has_timestamp_ || config_.sample_rate <= 0.0) {
+        return timestamp_ns_;
+    }
+    double samples =
+        static_cast<double>((offset - timestamp_offset_) /
+                            config_.bytes_per_sample);
+    return timestamp_ns_ +
+           static_cast<uint64_t>(std::llround(samples * 1e9 /
+                                              config_.sample_rate));
+}
+
+void SeekableWriter::reset() {
+    compressor_->reset();
+    index_.clear();
+    tail_.clear();
+    tail_written_ = 0;
+    compressed_ = 0;
+    consumed_ = 0;
+    frame_fill_ = 0;
+    frame_open_ = false;
+    ending_frame_ = false;
+    finishing_ = false;
+    has_timestamp_ = false;
+    timestamp_ns_ = 0;
+    timestamp_offset_ = 0;
+}
+
+CompressionStatus SeekableWriter::end_frame(BufferView& out,
+                                            std::size_t& written) {
+    while (true) {
+        if (out.empty()) {
+            return CompressionStatus::OutputBufferFull;
+        }
+        CompressionResult r = compressor_->finish(BufferView(), out);
+        out += r.compressed;
+        written += r.compressed;
+        compressed_ += r.compressed;
+        if (r.status == CompressionStatus::InputBufferFinished) {
+            break;
+        }
+        if (r.status != CompressionStatus::OutputBufferFull &&
+            r.status != CompressionStatus::NeedsFlush) {
+            return CompressionStatus::FatalError;
+        }
+    }
+    seekable::IndexEntry& entry = index_.back();
+    entry.compressed_size = compressed_ - entry.compressed_offset;
+    compressor_->reset();
+    frame_fill_ = 0;
+    frame_open_ = false;
+    ending_frame_ = false;
+    return CompressionStatus::InputBufferFinished;
+}
+
+CompressionResult SeekableWriter::compress_partial(BufferView in,
+                                                   BufferView out) {
+    CompressionResult r{0, 0, CompressionStatus::NeedsInput};
+    if (finishing_) {
+        r.status = CompressionStatus::InvalidState;
+        return r;
+    }
+    while (true) {
+        if (ending_frame_) {
+            CompressionStatus status = end_frame(out, r.compressed);
+            if (status != CompressionStatus::InputBufferFinished) {
+                r.status = status;
+                return r;
+            }
+        }
+        if (in.empty()) {
+            return r;
+        }
+        if (out.empty()) {
+            r.status = CompressionStatus::OutputBufferFull;
+            return r;
+        }
+        if (!frame_open_) {
+            try {
+                index_.push_back({compressed_, 0, timestamp_at(consumed_)});
+            } catch (...) {
+                r.status = CompressionStatus::FatalError;
+                return r;
+            }
+            frame_open_ = true;
+        }
+
+        std::size_t n = std::min(in.size(), config_.frame_size - frame_fill_);
+        CompressionResult c = compressor_->compress_buffer(in(0, n), out);
+        if (static_cast<uint8_t>(c.status) >=
+            static_cast<uint8_t>(CompressionStatus::FatalError)) {
+            r.status = CompressionStatus::FatalError;
+            return r;
+        }
+        in += c.input_consumed;
+        out += c.compressed;
+        r.input_consumed += c.input_consumed;
+        r.compressed += c.compressed;
+        consumed_ += c.input_consumed;
+        compressed_ += c.compressed;
+        frame_fill_ += c.input_consumed;
+        if (frame_fill_ == config_.frame_size) {
+            ending_frame_ = true;
+        } else if (c.status == CompressionStatus::OutputBufferFull) {
+            r.status = CompressionStatus::OutputBufferFull;
+            return r;
+        }
+    }
+}
+
+CompressionResult SeekableWriter::compress_buffer(BufferView in,
+                                                  BufferView out) {
+    return compress_partial(in, out);
+}
+
+CompressionResult SeekableWriter::finish(BufferView in, BufferView out) {
+    CompressionResult r{0, 0, CompressionStatus::InputBufferFinished};
+    if (!finishing_) {
+        r = compress_partial(in, out);
+        if (r.status != CompressionStatus::NeedsInput) {
+            return r;
+        }
+        out += r.compressed;
+        ending_frame_ = frame_open_;
+        finishing_ = true;
+    }
+    if (ending_frame_) {
+        r.status = end_frame(out, r.compressed);
+        if (r.status != CompressionStatus::InputBufferFinished) {
+            return r;
+        }
+    }
+
+    if (tail_.empty()) {
+        seekable::Footer footer{};
+        footer.index_offset = compressed_;
+        footer.uncompressed_size = consumed_;
+        footer.frame_count = index_.size();
+        footer.frame_size = static_cast<uint32_t>(config_.frame_size);
+        footer.codec = seekable::codec_id(config_.type);
+        footer.filter = config_.options.filter;
+        footer.version = seekable::kVersion;
+        footer.magic = seekable::kMagic;
+        std::size_t index_size = index_.size() * sizeof(seekable::IndexEntry);
+        try {
+            tail_.resize(index_size + sizeof(footer));
+        } catch (...) {
+            r.status = CompressionStatus::FatalError;
+            return r;
+        }
+        std::memcpy(tail_.data(), index_.data(), index_size);
+        std::memcpy(tail_.data() + index_size, &footer, sizeof(footer));
+    }
+
+    std::size_t n = std::min(out.size(), tail_.size() - tail_written_);
+    std::memcpy(out.data(), tail_.data() + tail_written_, n);
+    tail_written_ += n;
+    r.compressed += n;
+    if (tail_written_ < tail_.size()) {
+        r.status = CompressionStatus::OutputBufferFull;
+        return r;
+    }
+    std::size_t input_consumed = r.input_consumed;
+    reset();
+    return {r.compressed, input_consumed,
+            CompressionStatus::InputBufferFinished};
+}
+
+};  // namespace csics::io::compression
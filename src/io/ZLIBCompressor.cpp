@@ -2,26 +2,91 @@
 
 #include "ZLIBCompressor.hpp"
 #include <cstring>
+#include <stdexcept>
+
+#ifdef CSICS_USE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
 
 namespace csics::io::compression {
 
-ZLIBCompressor::ZLIBCompressor(): zstream_(new z_stream), state_(State::Compressing) {
-    z_stream* zstream = static_cast<z_stream*>(zstream_);
+// Window bits for deflateInit2, -N writes raw deflate and N + 16 gzip.
+static int window_bits(ZLIBFormat format, int window_log) {
+    switch (format) {
+        case ZLIBFormat::Gzip:
+            return window_log + 16;
+        case ZLIBFormat::Raw:
+            return -window_log;
+        default:
+            return window_log;
+    }
+}
+
+static int zlib_strategy(ZLIBStrategy strategy) {
+    switch (strategy) {
+        case ZLIBStrategy::Filtered:
+            return Z_FILTERED;
+        case ZLIBStrategy::HuffmanOnly:
+            return Z_HUFFMAN_ONLY;
+        case ZLIBStrategy::RLE:
+            return Z_RLE;
+        case ZLIBStrategy::Fixed:
+            return Z_FIXED;
+        default:
+            return Z_DEFAULT_STRATEGY;
+    }
+}
+
+ZLIBCompressor::ZLIBCompressor(const CompressionOptions& options)
+    : zstream_(nullptr), state_(State::Compressing) {
+    int level = options.level.value_or(Z_DEFAULT_COMPRESSION);
+    level_ = level;
+    next_level_ = level;
+    strategy_ = zlib_strategy(options.zlib_strategy);
+    format_ = options.zlib_format;
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) {
+        throw std::invalid_argument("Invalid ZLIB compression level");
+    }
+    if (options.dictionary) {
+        throw std::invalid_argument("ZLIB does not support ZSTD dictionaries");
+    }
+    int window_log = options.window_log == 0 ? MAX_WBITS : options.window_log;
+    if (window_log < 9 || window_log > MAX_WBITS) {
+        throw std::invalid_argument("Invalid ZLIB window log");
+    }
+#ifdef CSICS_USE_LIBDEFLATE
+    oneshot_ = window_log == MAX_WBITS && strategy_ == Z_DEFAULT_STRATEGY;
+#endif
+    z_stream* zstream = new z_stream;
     std::memset(zstream, 0, sizeof(z_stream));
-    int ret = deflateInit(zstream, Z_DEFAULT_COMPRESSION);
+    // 8 is the memLevel deflateInit uses.
+    int ret = deflateInit2(zstream, level, Z_DEFLATED,
+                           window_bits(format_, window_log), 8, strategy_);
     if (ret != Z_OK) {
+        delete zstream;
         throw std::runtime_error("Failed to initialize ZLIB compressor");
     }
+    zstream_ = zstream;
 }
 
-CompressionStatus ZLIBCompressor::init() {
-    auto zstream = static_cast<z_streamp>(zstream_);
-    int ret = deflateReset(zstream);
-    if (ret != Z_OK) {
-        return CompressionStatus::FatalError;
+void ZLIBCompressor::reset() {
+    auto* zstream = static_cast<z_streamp>(zstream_);
+    deflateReset(zstream);
+    if (next_level_ != level_) {
+        // Nothing is buffered right after a reset, so this cannot flush.
+        deflateParams(zstream, next_level_, strategy_);
+        level_ = next_level_;
     }
     state_ = State::Compressing;
-    return CompressionStatus::Ok;
+    fresh_ = true;
+}
+
+bool ZLIBCompressor::set_level(int level) {
+    if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) {
+        return false;
+    }
+    next_level_ = level;
+    return true;
 }
 
 ZLIBCompressor::~ZLIBCompressor() {
@@ -31,6 +96,12 @@ ZLIBCompressor::~ZLIBCompressor() {
         delete zstream;
         zstream_ = nullptr;
     }
+#ifdef CSICS_USE_LIBDEFLATE
+    if (deflater_ != nullptr) {
+        libdeflate_free_compressor(
+            static_cast<libdeflate_compressor*>(deflater_));
+    }
+#endif
 }
 
 static void set_zstream(z_streamp z, BufferView in, BufferView out) {
@@ -44,6 +115,7 @@ CompressionResult ZLIBCompressor::compress_partial(BufferView in,
                                                    BufferView out) {
     auto* zstream = static_cast<z_streamp>(zstream_);
     set_zstream(zstream, in, out);
+    fresh_ = false;
 
     int zout = deflate(zstream, Z_NO_FLUSH);
 
@@ -104,9 +176,17 @@ CompressionResult ZLIBCompressor::finish(BufferView in, BufferView out) {
             .input_consumed = 0,
             .status = CompressionStatus::InvalidState
         };
-    } else {
-        state_ = State::Finishing;
     }
+#ifdef CSICS_USE_LIBDEFLATE
+    if (state_ == State::Compressing && fresh_ && oneshot_) {
+        CompressionResult r{};
+        if (compress_oneshot(in, out, r)) {
+            state_ = State::Finished;
+            return r;
+        }
+    }
+#endif
+    state_ = State::Finishing;
     auto* zstream = static_cast<z_streamp>(zstream_);
     set_zstream(zstream, in, out);
 
@@ -119,15 +199,61 @@ CompressionResult ZLIBCompressor::finish(BufferView in, BufferView out) {
             return ret;
         }
         if (zstream->avail_out == 0 && zout == Z_BUF_ERROR) {
+            ret.compressed = zstream->next_out - out.uc();
+            ret.input_consumed = zstream->next_in - in.uc();
             ret.status = CompressionStatus::OutputBufferFull;
             return ret;
         }
     };
 
     ret.compressed = zstream->next_out - out.uc();
-    ret.input_consumed = 0;
+    ret.input_consumed = zstream->next_in - in.uc();
     ret.status = CompressionStatus::InputBufferFinished;
+    state_ = State::Finished;
 
     return ret;
 }
+
+#ifdef CSICS_USE_LIBDEFLATE
+bool ZLIBCompressor::compress_oneshot(BufferView in, BufferView out,
+                                      CompressionResult& r) {
+    // Same scale as zlib up to 9, zlib's default is 6.
+    int level = level_ == Z_DEFAULT_COMPRESSION ? 6 : level_;
+    if (deflater_ == nullptr || deflater_level_ != level) {
+        if (deflater_ != nullptr) {
+            libdeflate_free_compressor(
+                static_cast<libdeflate_compressor*>(deflater_));
+        }
+        deflater_ = libdeflate_alloc_compressor(level);
+        deflater_level_ = level;
+        if (deflater_ == nullptr) {
+            return false;
+        }
+    }
+    auto* c = static_cast<libdeflate_compressor*>(deflater_);
+    std::size_t n = 0;
+    switch (format_) {
+        case ZLIBFormat::Gzip:
+            n = libdeflate_gzip_compress(c, in.data(), in.size(), out.data(),
+                                         out.size());
+            break;
+        case ZLIBFormat::Raw:
+            n = libdeflate_deflate_compress(c, in.data(), in.size(),
+                                            out.data(), out.size());
+            break;
+        default:
+            n = libdeflate_zlib_compress(c, in.data(), in.size(), out.data(),
+                                         out.size());
+            break;
+    }
+    // 0 means it did not fit, zlib streams it out instead.
+    if (n == 0) {
+        return false;
+    }
+    r.compressed = n;
+    r.input_consumed = in.size();
+    r.status = CompressionStatus::InputBufferFinished;
+    return true;
+}
+#endif
 };  // namespace csics::io::compression
@@ -6,20 +6,40 @@
 namespace csics::io::compression {
 class ZLIBCompressor : public ICompressor {
    public:
-    ZLIBCompressor();
+    explicit ZLIBCompressor(const CompressionOptions& options = {});
     ~ZLIBCompressor() override;
 
-    CompressionStatus init();
     CompressionResult compress_partial(BufferView in, BufferView out) override;
     CompressionResult compress_buffer(BufferView in, BufferView out) override;
     CompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+    bool set_level(int level) override;
 
     inline CompressionResult operator()(BufferView in, BufferView out) {
         return compress_buffer(in, out);
     }
 
    private:
+#ifdef CSICS_USE_LIBDEFLATE
+    // Compresses a whole stream at once, false if libdeflate cannot.
+    bool compress_oneshot(BufferView in, BufferView out,
+                          CompressionResult& r);
+#endif
+
     void* zstream_;
+    int level_;
+    int next_level_;
+    int strategy_;
+    ZLIBFormat format_;
+    // Nothing was compressed since the last reset.
+    bool fresh_ = true;
+#ifdef CSICS_USE_LIBDEFLATE
+    // Created on first use, for the level in deflater_level_.
+    void* deflater_ = nullptr;
+    int deflater_level_ = 0;
+    // libdeflate always writes a 32 KiB window and has no strategies.
+    bool oneshot_ = false;
+#endif
     std::vector<char> leftover_;
     enum class State: uint8_t {
         Compressing,
@@ -0,0 +1,102 @@
+#include "ZLIBDecompressor.hpp"
+
+#include <zlib.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace csics::io::decompression {
+
+// 15 bit window, +32 detects a zlib or gzip header.
+constexpr int kWindowBitsAuto = 15 + 32;
+// Negative for a headerless stream. Smaller windows decode too.
+constexpr int kWindowBitsRaw = -15;
+
+ZLIBDecompressor::ZLIBDecompressor(const DecompressionOptions& options)
+    : zstream_(nullptr) {
+    int window_bits = options.zlib_format == compression::ZLIBFormat::Raw
+                          ? kWindowBitsRaw
+                          : kWindowBitsAuto;
+    auto* zstream = new z_stream;
+    std::memset(zstream, 0, sizeof(z_stream));
+    if (inflateInit2(zstream, window_bits) != Z_OK) {
+        delete zstream;
+        throw std::runtime_error("Failed to initialize ZLIB decompressor");
+    }
+    zstream_ = zstream;
+}
+
+ZLIBDecompressor::~ZLIBDecompressor() {
+    if (zstream_ != nullptr) {
+        auto* zstream = static_cast<z_streamp>(zstream_);
+        inflateEnd(zstream);
+        delete zstream;
+        zstream_ = nullptr;
+    }
+}
+
+void ZLIBDecompressor::reset() {
+    inflateReset(static_cast<z_streamp>(zstream_));
+    in_frame_ = false;
+}
+
+DecompressionResult ZLIBDecompressor::decompress_partial(BufferView in,
+                                                         BufferView out) {
+    auto* zstream = static_cast<z_streamp>(zstream_);
+    zstream->next_in = in.uc();
+    zstream->avail_in = in.size();
+    zstream->next_out = out.uc();
+    zstream->avail_out = out.size();
+
+    int zout = inflate(zstream, Z_NO_FLUSH);
+
+    DecompressionResult r{};
+    r.decompressed = zstream->next_out - out.uc();
+    r.input_consumed = zstream->next_in - in.uc();
+    switch (zout) {
+        case Z_STREAM_END:
+            reset();
+            r.status = CompressionStatus::InputBufferFinished;
+            break;
+        case Z_OK:
+        case Z_BUF_ERROR:
+            in_frame_ = in_frame_ || r.input_consumed != 0;
+            r.status = zstream->avail_out == 0
+                           ? CompressionStatus::OutputBufferFull
+                           : CompressionStatus::NeedsInput;
+            break;
+        default:
+            reset();
+            r.status = CompressionStatus::FatalError;
+            break;
+    }
+    return r;
+}
+
+DecompressionResult ZLIBDecompressor::decompress_buffer(BufferView in,
+                                                        BufferView out) {
+    DecompressionResult total{0, 0, CompressionStatus::InputBufferFinished};
+    while (!in.empty() || in_frame_) {
+        DecompressionResult r = decompress_partial(in, out);
+        in += r.input_consumed;
+        out += r.decompressed;
+        total.input_consumed += r.input_consumed;
+        total.decompressed += r.decompressed;
+        total.status = r.status;
+        if (r.status != CompressionStatus::InputBufferFinished) {
+            break;
+        }
+    }
+    return total;
+}
+
+DecompressionResult ZLIBDecompressor::finish(BufferView in, BufferView out) {
+    DecompressionResult r = decompress_buffer(in, out);
+    if (r.status == CompressionStatus::NeedsInput) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+    }
+    return r;
+}
+
+};  // namespace csics::io::decompression
@@ -0,0 +1,22 @@
+#pragma once
+#include <csics/io/decompression/Decompressor.hpp>
+
+namespace csics::io::decompression {
+
+// Reads zlib and gzip streams, detected from the header, or raw deflate.
+class ZLIBDecompressor : public IDecompressor {
+   public:
+    explicit ZLIBDecompressor(const DecompressionOptions& options = {});
+    ~ZLIBDecompressor() override;
+    DecompressionResult decompress_partial(BufferView in,
+                                           BufferView out) override;
+    DecompressionResult decompress_buffer(BufferView in,
+                                          BufferView out) override;
+    DecompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+   private:
+    void* zstream_;
+    bool in_frame_ = false;
+};
+};  // namespace csics::io::decompression
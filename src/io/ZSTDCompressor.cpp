@@ -1,17 +1,43 @@
 #include "ZSTDCompressor.hpp"
+
+#include <csics/io/compression/Dictionary.hpp>
 #include <zstd.h>
 
+#include <stdexcept>
+
 namespace csics::io::compression {
-ZSTDCompressor::ZSTDCompressor() : stream_(nullptr) {
-    stream_ = ZSTD_createCStream();
-    if (stream_ == nullptr) {
+ZSTDCompressor::ZSTDCompressor(const CompressionOptions& options)
+    : stream_(nullptr) {
+    ZSTD_CCtx* cctx = ZSTD_createCCtx();
+    if (cctx == nullptr) {
         throw std::runtime_error("Failed to create ZSTD compressor stream");
     }
-    std::size_t ret = ZSTD_initCStream(static_cast<ZSTD_CStream*>(stream_), 3);
-    if (ZSTD_isError(ret)) {
-        ZSTD_freeCStream(static_cast<ZSTD_CStream*>(stream_));
-        throw std::runtime_error("Failed to initialize ZSTD compressor stream");
+    auto set = [cctx](ZSTD_cParameter param, int value) {
+        if (ZSTD_isError(ZSTD_CCtx_setParameter(cctx, param, value))) {
+            ZSTD_freeCCtx(cctx);
+            throw std::invalid_argument(
+                "Unsupported ZSTD compression parameter");
+        }
+    };
+    level_ = options.level.value_or(3);
+    next_level_ = level_;
+    set(ZSTD_c_compressionLevel, level_);
+    if (options.window_log != 0) {
+        set(ZSTD_c_windowLog, options.window_log);
+    }
+    if (options.long_distance_matching) {
+        set(ZSTD_c_enableLongDistanceMatching, 1);
+    }
+    if (options.workers != 0) {
+        // Fails if libzstd was built without multithreading.
+        set(ZSTD_c_nbWorkers, static_cast<int>(options.workers));
+    }
+    if (options.dictionary) {
+        dictionary_ = options.dictionary;
+        ZSTD_CCtx_refCDict(
+            cctx, static_cast<const ZSTD_CDict*>(dictionary_->cdict()));
     }
+    stream_ = cctx;
 }
 
 ZSTDCompressor::~ZSTDCompressor() {
@@ -21,6 +47,24 @@ ZSTDCompressor::~ZSTDCompressor() {
     }
 }
 
+void ZSTDCompressor::reset() {
+    // Parameters and the dictionary are kept.
+    auto* cctx = static_cast<ZSTD_CCtx*>(stream_);
+    ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only);
+    if (next_level_ != level_) {
+        ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, next_level_);
+        level_ = next_level_;
+    }
+}
+
+bool ZSTDCompressor::set_level(int level) {
+    if (level < ZSTD_minCLevel() || level > ZSTD_maxCLevel()) {
+        return false;
+    }
+    next_level_ = level;
+    return true;
+}
+
 CompressionResult ZSTDCompressor::compress_partial(BufferView in,
                                                    BufferView out) {
     ZSTD_CStream* stream = static_cast<ZSTD_CStream*>(stream_);
@@ -88,7 +132,8 @@ CompressionResult ZSTDCompressor::compress_buffer(BufferView in,
                 .status = CompressionStatus::FatalError
             };
         }
-    } while (status == CompressionStatus::NeedsFlush);
+    } while (status == CompressionStatus::NeedsFlush ||
+             (status == CompressionStatus::NeedsInput && !in.empty()));
 
     return CompressionResult{
         .compressed = total_compressed,
@@ -118,7 +163,7 @@ CompressionResult ZSTDCompressor::finish(BufferView in, BufferView out) {
             ZSTD_CCtx_reset(stream, ZSTD_reset_session_only);
             CompressionResult r{};
             r.compressed = compressed_total;
-            r.input_consumed = 0;
+            r.input_consumed = i_buf.pos;
             r.status = CompressionStatus::NonFatalError;
             return r;
         }
@@ -130,12 +175,12 @@ CompressionResult ZSTDCompressor::finish(BufferView in, BufferView out) {
 
     CompressionResult r{};
     r.compressed = compressed_total;
-    r.input_consumed = 0;
+    r.input_consumed = i_buf.pos;
 
+    // The frame is complete once nothing is left to flush, even if that
+    // filled `out` exactly.
     if (bytes != 0) {
         r.status = CompressionStatus::NeedsFlush;
-    } else if (out.size() == 0) {
-        r.status = CompressionStatus::OutputBufferFull;
     } else {
         r.status = CompressionStatus::InputBufferFinished;
     }
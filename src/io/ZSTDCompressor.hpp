@@ -5,13 +5,18 @@ namespace csics::io::compression {
 
 class ZSTDCompressor: public ICompressor {
    public:
-    explicit ZSTDCompressor();
+    explicit ZSTDCompressor(const CompressionOptions& options = {});
     ~ZSTDCompressor();
     CompressionResult compress_partial(BufferView in, BufferView out) override;
     CompressionResult compress_buffer(BufferView in, BufferView out) override;
     CompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+    bool set_level(int level) override;
 
    private:
     void* stream_;
+    int level_;
+    int next_level_;
+    std::shared_ptr<const Dictionary> dictionary_;
 };
 };  // namespace csics::io::compression
@@ -0,0 +1,143 @@
+#include "ZSTDDecompressor.hpp"
+
+// For ZSTD_d_refMultipleDDicts, a plain parameter value since 1.5.
+#define ZSTD_STATIC_LINKING_ONLY
+#include <zstd.h>
+
+#include <csics/io/compression/Dictionary.hpp>
+#include <stdexcept>
+
+namespace csics::io::decompression {
+
+ZSTDDecompressor::ZSTDDecompressor(const DecompressionOptions& options)
+    : dctx_(nullptr), dictionaries_(options.dictionaries) {
+    ZSTD_DCtx* dctx = ZSTD_createDCtx();
+    if (dctx == nullptr) {
+        throw std::runtime_error("Failed to create ZSTD decompression context");
+    }
+    // Streaming picks the dictionary from the frame header among all
+    // referenced ones, instead of using the last.
+    if (dictionaries_.size() > 1 &&
+        ZSTD_isError(ZSTD_DCtx_setParameter(dctx, ZSTD_d_refMultipleDDicts,
+                                            ZSTD_rmd_refMultipleDDicts))) {
+        ZSTD_freeDCtx(dctx);
+        throw std::invalid_argument(
+            "libzstd does not support multiple dictionaries");
+    }
+    for (const auto& dict : dictionaries_) {
+        if (!dict || ZSTD_isError(ZSTD_DCtx_refDDict(
+                         dctx, static_cast<const ZSTD_DDict*>(dict->ddict())))) {
+            ZSTD_freeDCtx(dctx);
+            throw std::invalid_argument("Invalid ZSTD dictionary");
+        }
+    }
+    dctx_ = dctx;
+}
+
+const void* ZSTDDecompressor::find_ddict(uint32_t id) const noexcept {
+    for (const auto& dict : dictionaries_) {
+        if (id != 0 && dict->id() == id) {
+            return dict->ddict();
+        }
+    }
+    return nullptr;
+}
+
+ZSTDDecompressor::~ZSTDDecompressor() {
+    if (dctx_ != nullptr) {
+        ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(dctx_));
+        dctx_ = nullptr;
+    }
+}
+
+void ZSTDDecompressor::reset() {
+    ZSTD_DCtx_reset(static_cast<ZSTD_DCtx*>(dctx_), ZSTD_reset_session_only);
+    in_frame_ = false;
+}
+
+DecompressionResult ZSTDDecompressor::decompress_partial(BufferView in,
+                                                         BufferView out) {
+    auto* dctx = static_cast<ZSTD_DCtx*>(dctx_);
+    ZSTD_inBuffer i_buf{in.data(), in.size(), 0};
+    ZSTD_outBuffer o_buf{out.data(), out.size(), 0};
+
+    std::size_t ret = ZSTD_decompressStream(dctx, &o_buf, &i_buf);
+
+    DecompressionResult r{};
+    r.decompressed = o_buf.pos;
+    r.input_consumed = i_buf.pos;
+    if (ZSTD_isError(ret)) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+    } else if (ret == 0) {
+        in_frame_ = false;
+        r.status = CompressionStatus::InputBufferFinished;
+    } else {
+        in_frame_ = in_frame_ || i_buf.pos != 0;
+        r.status = o_buf.pos == o_buf.size
+                       ? CompressionStatus::OutputBufferFull
+                       : CompressionStatus::NeedsInput;
+    }
+    return r;
+}
+
+DecompressionResult ZSTDDecompressor::decompress_buffer(BufferView in,
+                                                        BufferView out) {
+    auto* dctx = static_cast<ZSTD_DCtx*>(dctx_);
+    DecompressionResult total{0, 0, CompressionStatus::InputBufferFinished};
+    while (true) {
+        if (!in_frame_) {
+            if (in.empty()) {
+                total.status = CompressionStatus::InputBufferFinished;
+                return total;
+            }
+            // A whole frame of known size that fits is decoded in one call,
+            // skipping the context's window buffer.
+            unsigned long long content =
+                ZSTD_getFrameContentSize(in.data(), in.size());
+            std::size_t frame =
+                ZSTD_findFrameCompressedSize(in.data(), in.size());
+            if (content != ZSTD_CONTENTSIZE_UNKNOWN &&
+                content != ZSTD_CONTENTSIZE_ERROR && content <= out.size() &&
+                !ZSTD_isError(frame)) {
+                unsigned id = ZSTD_getDictID_fromFrame(in.data(), frame);
+                const auto* ddict =
+                    static_cast<const ZSTD_DDict*>(find_ddict(id));
+                std::size_t n = ZSTD_decompress_usingDDict(
+                    dctx, out.data(), out.size(), in.data(), frame, ddict);
+                // Frames referencing an unknown dictionary cannot be decoded.
+                if (ZSTD_isError(n) || (id != 0 && ddict == nullptr)) {
+                    reset();
+                    total.status = CompressionStatus::FatalError;
+                    return total;
+                }
+                in += frame;
+                out += n;
+                total.input_consumed += frame;
+                total.decompressed += n;
+                continue;
+            }
+        }
+
+        DecompressionResult r = decompress_partial(in, out);
+        in += r.input_consumed;
+        out += r.decompressed;
+        total.input_consumed += r.input_consumed;
+        total.decompressed += r.decompressed;
+        if (r.status != CompressionStatus::InputBufferFinished) {
+            total.status = r.status;
+            return total;
+        }
+    }
+}
+
+DecompressionResult ZSTDDecompressor::finish(BufferView in, BufferView out) {
+    DecompressionResult r = decompress_buffer(in, out);
+    if (r.status == CompressionStatus::NeedsInput) {
+        reset();
+        r.status = CompressionStatus::FatalError;
+    }
+    return r;
+}
+
+};  // namespace csics::io::decompression
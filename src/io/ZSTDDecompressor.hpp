@@ -0,0 +1,27 @@
+#pragma once
+#include <csics/io/decompression/Decompressor.hpp>
+#include <cstdint>
+
+namespace csics::io::decompression {
+
+class ZSTDDecompressor : public IDecompressor {
+   public:
+    explicit ZSTDDecompressor(const DecompressionOptions& options = {});
+    ~ZSTDDecompressor() override;
+    DecompressionResult decompress_partial(BufferView in,
+                                           BufferView out) override;
+    DecompressionResult decompress_buffer(BufferView in,
+                                          BufferView out) override;
+    DecompressionResult finish(BufferView in, BufferView out) override;
+    void reset() override;
+
+   private:
+    // DDict of a dictionary ID, nullptr if unknown or 0.
+    const void* find_ddict(uint32_t id) const noexcept;
+
+    void* dctx_;
+    std::vector<std::shared_ptr<const compression::Dictionary>> dictionaries_;
+    // Inside a frame decoded by streaming.
+    bool in_frame_ = false;
+};
+};  // namespace csics::io::decompression
@@ -0,0 +1,93 @@
+#include <csics/io/checksum/Checksum.hpp>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#ifdef CSICS_USE_XXHASH
+#include <xxhash.h>
+#endif
+
+namespace csics::io::checksum {
+
+Checksum::Checksum(ChecksumType type) : type_(type) {
+    switch (type) {
+        case ChecksumType::CRC32C:
+            break;
+#ifdef CSICS_USE_XXHASH
+        case ChecksumType::XXH3:
+            xxh3_ = XXH3_createState();
+            if (xxh3_ == nullptr) {
+                throw std::bad_alloc();
+            }
+            XXH3_64bits_reset(static_cast<XXH3_state_t*>(xxh3_));
+            break;
+#endif
+        default:
+            throw std::invalid_argument("Unsupported checksum type");
+    }
+}
+
+Checksum::~Checksum() {
+#ifdef CSICS_USE_XXHASH
+    XXH3_freeState(static_cast<XXH3_state_t*>(xxh3_));
+#endif
+}
+
+Checksum::Checksum(Checksum&& other) noexcept
+    : type_(other.type_),
+      crc_(other.crc_),
+      xxh3_(std::exchange(other.xxh3_, nullptr)) {}
+
+Checksum& Checksum::operator=(Checksum&& other) noexcept {
+    if (this != &other) {
+        std::swap(type_, other.type_);
+        std::swap(crc_, other.crc_);
+        std::swap(xxh3_, other.xxh3_);
+    }
+    return *this;
+}
+
+void Checksum::update(BufferView data) noexcept {
+#ifdef CSICS_USE_XXHASH
+    if (type_ == ChecksumType::XXH3) {
+        XXH3_64bits_update(static_cast<XXH3_state_t*>(xxh3_), data.u8(),
+                           data.size());
+        return;
+    }
+#endif
+    crc_ = crc32c(data, crc_);
+}
+
+uint64_t Checksum::digest() const noexcept {
+#ifdef CSICS_USE_XXHASH
+    if (type_ == ChecksumType::XXH3) {
+        return XXH3_64bits_digest(static_cast<const XXH3_state_t*>(xxh3_));
+    }
+#endif
+    return crc_;
+}
+
+void Checksum::reset() noexcept {
+#ifdef CSICS_USE_XXHASH
+    if (type_ == ChecksumType::XXH3) {
+        XXH3_64bits_reset(static_cast<XXH3_state_t*>(xxh3_));
+        return;
+    }
+#endif
+    crc_ = 0;
+}
+
+uint64_t checksum(ChecksumType type, BufferView data) {
+    switch (type) {
+        case ChecksumType::CRC32C:
+            return crc32c(data);
+#ifdef CSICS_USE_XXHASH
+        case ChecksumType::XXH3:
+            return XXH3_64bits(data.u8(), data.size());
+#endif
+        default:
+            throw std::invalid_argument("Unsupported checksum type");
+    }
+}
+
+};  // namespace csics::io::checksum
@@ -0,0 +1,191 @@
+#include <array>
+#include <bit>
+#include <csics/io/checksum/Checksum.hpp>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define CSICS_CRC32C_X86
+#include <immintrin.h>
+#endif
+
+namespace csics::io::checksum {
+
+namespace {
+
+// Reflected Castagnoli polynomial.
+constexpr uint32_t kPoly = 0x82F63B78;
+
+using Table = std::array<uint32_t, 256>;
+
+// Slicing by 8: table k advances a byte through k more zero bytes.
+constexpr std::array<Table, 8> make_slice_tables() {
+    std::array<Table, 8> t{};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = (c & 1) ? (c >> 1) ^ kPoly : c >> 1;
+        }
+        t[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int s = 1; s < 8; s++) {
+            t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+        }
+    }
+    return t;
+}
+
+constexpr std::array<Table, 8> slice_tables = make_slice_tables();
+
+uint32_t crc32c_bytes(const uint8_t* p, std::size_t n, uint32_t c) noexcept {
+    for (; n > 0; n--, p++) {
+        c = (c >> 8) ^ slice_tables[0][(c ^ *p) & 0xFF];
+    }
+    return c;
+}
+
+#ifdef CSICS_CRC32C_X86
+// The crc32 instruction has a latency of 3 and a throughput of 1, so three
+// independent streams keep it busy. Each covers a third of a block, then
+// the first two are shifted past the rest and the three combined.
+constexpr std::size_t kLongBlock = 8192;
+constexpr std::size_t kShortBlock = 256;
+
+// A linear map on CRC registers over GF(2), as the images of each bit.
+using Matrix = std::array<uint32_t, 32>;
+
+constexpr uint32_t apply(const Matrix& m, uint32_t v) {
+    uint32_t sum = 0;
+    for (int i = 0; v != 0; i++, v >>= 1) {
+        if (v & 1) {
+            sum ^= m[i];
+        }
+    }
+    return sum;
+}
+
+constexpr Matrix compose(const Matrix& a, const Matrix& b) {
+    Matrix m{};
+    for (int i = 0; i < 32; i++) {
+        m[i] = apply(a, b[i]);
+    }
+    return m;
+}
+
+// Byte-wise lookups of the map appending `len` zero bytes to a CRC.
+constexpr std::array<Table, 4> make_shift_tables(std::size_t len) {
+    Matrix bit{};
+    bit[0] = kPoly;
+    for (int i = 1; i < 32; i++) {
+        bit[i] = uint32_t(1) << (i - 1);
+    }
+    Matrix byte = compose(bit, bit);
+    byte = compose(byte, byte);
+    byte = compose(byte, byte);
+
+    Matrix op{};
+    for (int i = 0; i < 32; i++) {
+        op[i] = uint32_t(1) << i;
+    }
+    for (; len != 0; len >>= 1, byte = compose(byte, byte)) {
+        if (len & 1) {
+            op = compose(byte, op);
+        }
+    }
+
+    std::array<Table, 4> t{};
+    for (int k = 0; k < 4; k++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            t[k][b] = apply(op, b << (8 * k));
+        }
+    }
+    return t;
+}
+
+constexpr std::array<Table, 4> long_shift = make_shift_tables(kLongBlock);
+constexpr std::array<Table, 4> short_shift = make_shift_tables(kShortBlock);
+
+inline uint32_t shift(const std::array<Table, 4>& t, uint32_t c) noexcept {
+    return t[0][c & 0xFF] ^ t[1][(c >> 8) & 0xFF] ^ t[2][(c >> 16) & 0xFF] ^
+           t[3][c >> 24];
+}
+
+inline uint64_t load64(const uint8_t* p) noexcept {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+__attribute__((target("sse4.2"))) uint32_t crc32c_sse42(
+    const uint8_t* p, std::size_t n, uint32_t crc) noexcept {
+    uint64_t c0 = crc;
+    for (; n > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0; n--, p++) {
+        c0 = _mm_crc32_u8(static_cast<uint32_t>(c0), *p);
+    }
+
+    for (std::size_t block : {kLongBlock, kShortBlock}) {
+        const auto& t = block == kLongBlock ? long_shift : short_shift;
+        for (; n >= 3 * block; n -= 3 * block, p += 2 * block) {
+            uint64_t c1 = 0;
+            uint64_t c2 = 0;
+            for (const uint8_t* end = p + block; p < end; p += 8) {
+                c0 = _mm_crc32_u64(c0, load64(p));
+                c1 = _mm_crc32_u64(c1, load64(p + block));
+                c2 = _mm_crc32_u64(c2, load64(p + 2 * block));
+            }
+            c0 = shift(t, static_cast<uint32_t>(c0)) ^ c1;
+            c0 = shift(t, static_cast<uint32_t>(c0)) ^ c2;
+        }
+    }
+
+    for (; n >= 8; n -= 8, p += 8) {
+        c0 = _mm_crc32_u64(c0, load64(p));
+    }
+    for (; n > 0; n--, p++) {
+        c0 = _mm_crc32_u8(static_cast<uint32_t>(c0), *p);
+    }
+    return static_cast<uint32_t>(c0);
+}
+#endif
+
+};  // namespace
+
+bool crc32c_hardware() noexcept {
+#ifdef CSICS_CRC32C_X86
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+uint32_t crc32c(BufferView data, uint32_t crc) noexcept {
+#ifdef CSICS_CRC32C_X86
+    if (crc32c_hardware()) {
+        return ~crc32c_sse42(data.u8(), data.size(), ~crc);
+    }
+#endif
+    return crc32c_portable(data, crc);
+}
+
+uint32_t crc32c_portable(BufferView data, uint32_t crc) noexcept {
+    const uint8_t* p = data.u8();
+    std::size_t n = data.size();
+    uint32_t c = ~crc;
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; n >= 8; n -= 8, p += 8) {
+            uint64_t w;
+            std::memcpy(&w, p, sizeof(w));
+            w ^= c;
+            c = slice_tables[7][w & 0xFF] ^ slice_tables[6][(w >> 8) & 0xFF] ^
+                slice_tables[5][(w >> 16) & 0xFF] ^
+                slice_tables[4][(w >> 24) & 0xFF] ^
+                slice_tables[3][(w >> 32) & 0xFF] ^
+                slice_tables[2][(w >> 40) & 0xFF] ^
+                slice_tables[1][(w >> 48) & 0xFF] ^ slice_tables[0][w >> 56];
+        }
+    }
+    return ~crc32c_bytes(p, n, c);
+}
+
+};  // namespace csics::io::checksum
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <array>
+#include <csics/io/encdec/Base32.hpp>
+#include <cstring>
+
+namespace csics::io::encdec {
+
+namespace {
+
+constexpr uint8_t base32_chars[33] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+constexpr std::array<uint8_t, 256> make_base32_values() {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    for (uint8_t i = 0; i < 32; i++) {
+        values[base32_chars[i]] = i;
+    }
+    return values;
+}
+
+constexpr std::array<uint8_t, 256> base32_values = make_base32_values();
+
+// Characters of a group ending in each number of bytes.
+constexpr uint8_t base32_data_chars[5] = {0, 2, 4, 5, 7};
+
+// A group of 5 bytes as one 40 bit word, then 8 characters of it.
+void encode_groups(const uint8_t* in, std::size_t groups,
+                   uint8_t* out) noexcept {
+    for (std::size_t g = 0; g < groups; g++, in += 5, out += 8) {
+        uint64_t v = (uint64_t(in[0]) << 32) | (uint64_t(in[1]) << 24) |
+                     (uint64_t(in[2]) << 16) | (uint64_t(in[3]) << 8) | in[4];
+        for (int i = 0; i < 8; i++) {
+            out[i] = base32_chars[(v >> (35 - 5 * i)) & 0x1F];
+        }
+    }
+}
+
+// Decodes unpadded groups, returns those decoded before the first one
+// holding a character outside the alphabet.
+std::size_t decode_groups(const uint8_t* in, std::size_t groups,
+                          uint8_t* out) noexcept {
+    for (std::size_t g = 0; g < groups; g++, in += 8, out += 5) {
+        uint64_t v = 0;
+        uint8_t bad = 0;
+        for (int i = 0; i < 8; i++) {
+            uint8_t c = base32_values[in[i]];
+            bad |= c;
+            v = (v << 5) | (c & 0x1F);
+        }
+        if (bad & 0x80) {
+            return g;
+        }
+        for (int i = 0; i < 5; i++) {
+            out[i] = static_cast<uint8_t>(v >> (32 - 8 * i));
+        }
+    }
+    return groups;
+}
+
+};  // namespace
+
+EncodingResult Base32Encoder::encode(BufferView in, BufferView out) {
+    const uint8_t* src = in.u8();
+    uint8_t* dst = out.u8();
+    std::size_t n = in.size();
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+
+    // Complete the group held over from the last call first.
+    if (held_ != 0) {
+        while (held_ < 5 && r.processed < n) {
+            holdover_[held_++] = src[r.processed++];
+        }
+        if (held_ < 5) {
+            return r;
+        }
+        if (out.size() < 8) {
+            r.status = EncodingStatus::OutputBufferFull;
+            return r;
+        }
+        encode_groups(holdover_, 1, dst);
+        r.output = 8;
+        held_ = 0;
+    }
+
+    std::size_t groups = (n - r.processed) / 5;
+    std::size_t fit = std::min(groups, (out.size() - r.output) / 8);
+    encode_groups(src + r.processed, fit, dst + r.output);
+    r.processed += 5 * fit;
+    r.output += 8 * fit;
+    if (fit < groups) {
+        r.status = EncodingStatus::OutputBufferFull;
+        return r;
+    }
+
+    while (r.processed < n) {
+        holdover_[held_++] = src[r.processed++];
+    }
+    return r;
+}
+
+EncodingResult Base32Encoder::finish(BufferView in, BufferView out) {
+    auto r = encode(in, out);
+    if (r.status == EncodingStatus::OutputBufferFull || held_ == 0) {
+        return r;
+    }
+    if (out.size() - r.output < 8) {
+        r.status = EncodingStatus::OutputBufferFull;
+        return r;
+    }
+    uint8_t group[5] = {};
+    std::memcpy(group, holdover_, held_);
+    uint8_t* dst = out.u8() + r.output;
+    encode_groups(group, 1, dst);
+    std::fill(dst + base32_data_chars[held_], dst + 8, '=');
+    r.output += 8;
+    held_ = 0;
+    return r;
+}
+
+EncodingStatus Base32Decoder::emit(const uint8_t* group, BufferView out,
+                                   std::size_t& written) {
+    std::size_t chars = 8;
+    while (chars > 0 && group[chars - 1] == '=') {
+        chars--;
+    }
+    const uint8_t* len_end =
+        std::find(base32_data_chars, base32_data_chars + 5, chars);
+    std::size_t len = len_end - base32_data_chars;
+    if (chars == 8) {
+        len = 5;
+    } else if (len == 5 || len == 0) {
+        return EncodingStatus::InvalidInput;
+    }
+    uint64_t v = 0;
+    for (std::size_t i = 0; i < 8; i++) {
+        uint8_t c = i < chars ? base32_values[group[i]] : 0;
+        if (c & 0x80) {
+            return EncodingStatus::InvalidInput;
+        }
+        v = (v << 5) | c;
+    }
+    // The encoder leaves the bits under the padding zero.
+    if ((v & ((uint64_t(1) << (40 - 8 * len)) - 1)) != 0) {
+        return EncodingStatus::InvalidInput;
+    }
+    if (out.size() - written < len) {
+        return EncodingStatus::OutputBufferFull;
+    }
+    uint8_t* dst = out.u8() + written;
+    for (std::size_t i = 0; i < len; i++) {
+        dst[i] = static_cast<uint8_t>(v >> (32 - 8 * i));
+    }
+    written += len;
+    ended_ = len < 5;
+    return EncodingStatus::Ok;
+}
+
+EncodingResult Base32Decoder::decode(BufferView in, BufferView out) {
+    const uint8_t* src = in.u8();
+    std::size_t n = in.size();
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+
+    // A whole group held over from a full output goes first.
+    if (held_ == 8) {
+        r.status = emit(holdover_, out, r.output);
+        if (r.status != EncodingStatus::Ok) {
+            return r;
+        }
+        held_ = 0;
+    }
+
+    while (r.processed < n) {
+        if (held_ == 0 && !ended_) {
+            std::size_t groups = (n - r.processed) / 8;
+            std::size_t fit = std::min(groups, (out.size() - r.output) / 5);
+            std::size_t done =
+                decode_groups(src + r.processed, fit, out.u8() + r.output);
+            r.processed += 8 * done;
+            r.output += 5 * done;
+            if (r.processed == n) {
+                break;
+            }
+        }
+        // Padding, a bad character, a partial group, or no room for a
+        // whole group.
+        if (ended_) {
+            r.status = EncodingStatus::InvalidInput;
+            return r;
+        }
+        holdover_[held_++] = src[r.processed++];
+        if (held_ == 8) {
+            r.status = emit(holdover_, out, r.output);
+            if (r.status != EncodingStatus::Ok) {
+                return r;
+            }
+            held_ = 0;
+        }
+    }
+    return r;
+}
+
+EncodingResult Base32Decoder::finish(BufferView in, BufferView out) {
+    auto r = decode(in, out);
+    if (r.status == EncodingStatus::OutputBufferFull) {
+        return r;
+    }
+    if (r.status == EncodingStatus::Ok && held_ != 0) {
+        r.status = EncodingStatus::InvalidInput;
+    }
+    held_ = 0;
+    ended_ = false;
+    return r;
+}
+
+};  // namespace csics::io::encdec
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <csics/io/encdec/Base64.hpp>
+#include <cstring>
+#include <stdexcept>
+
+#include "Base64Kernels.hpp"
+
+namespace csics::io::encdec {
+
+namespace {
+
+bool is_space(uint8_t c) noexcept {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+};  // namespace
+
+Base64Decoder::Base64Decoder() : Base64Decoder(Config{}) {}
+
+Base64Decoder::Base64Decoder(const Config& config)
+    : kernels_(&detail::base64_kernels(config.isa, config.alphabet)),
+      values_(detail::base64_values_of(config.alphabet)),
+      lenient_(config.lenient),
+      holdover_{} {
+    if (!base64_isa_supported(config.isa)) {
+        throw std::invalid_argument("Base64 ISA not supported by this CPU");
+    }
+}
+
+EncodingStatus Base64Decoder::emit(const uint8_t* group, BufferView out,
+                                   std::size_t& written) {
+    uint8_t v[4];
+    std::size_t len = 3;
+    for (std::size_t i = 0; i < 4; i++) {
+        v[i] = values_[group[i]];
+    }
+    if (group[3] == '=') {
+        len = group[2] == '=' ? 1 : 2;
+        v[3] = 0;
+        v[2] = len == 1 ? 0 : v[2];
+    }
+    if ((v[0] | v[1] | v[2] | v[3]) & 0x80) {
+        return EncodingStatus::InvalidInput;
+    }
+    // The encoder leaves the bits under the padding zero.
+    if (!lenient_ && ((len == 1 && (v[1] & 0x0F) != 0) ||
+                      (len == 2 && (v[2] & 0x03) != 0))) {
+        return EncodingStatus::InvalidInput;
+    }
+    if (out.size() - written < len) {
+        return EncodingStatus::OutputBufferFull;
+    }
+    uint8_t bytes[3] = {
+        static_cast<uint8_t>((v[0] << 2) | (v[1] >> 4)),
+        static_cast<uint8_t>((v[1] << 4) | (v[2] >> 2)),
+        static_cast<uint8_t>((v[2] << 6) | v[3])};
+    std::memcpy(out.u8() + written, bytes, len);
+    written += len;
+    ended_ = len < 3;
+    return EncodingStatus::Ok;
+}
+
+EncodingResult Base64Decoder::decode(BufferView in, BufferView out) {
+    const uint8_t* src = in.u8();
+    std::size_t n = in.size();
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+
+    // A whole group held over from a full output goes first.
+    if (held_ == 4) {
+        r.status = emit(holdover_, out, r.output);
+        if (r.status != EncodingStatus::Ok) {
+            return r;
+        }
+        held_ = 0;
+    }
+
+    while (r.processed < n) {
+        if (held_ == 0 && !ended_) {
+            std::size_t groups = (n - r.processed) / 4;
+            std::size_t fit = std::min(groups, (out.size() - r.output) / 3);
+            std::size_t done = kernels_->decode(src + r.processed, fit,
+                                                out.u8() + r.output);
+            r.processed += 4 * done;
+            r.output += 3 * done;
+            if (r.processed == n) {
+                break;
+            }
+        }
+        // Padding, whitespace, a bad character, a partial group, or no
+        // room for a whole group.
+        uint8_t c = src[r.processed];
+        if (lenient_ && is_space(c)) {
+            r.processed++;
+            continue;
+        }
+        if (ended_) {
+            r.status = EncodingStatus::InvalidInput;
+            return r;
+        }
+        holdover_[held_++] = c;
+        r.processed++;
+        if (held_ == 4) {
+            r.status = emit(holdover_, out, r.output);
+            if (r.status != EncodingStatus::Ok) {
+                return r;
+            }
+            held_ = 0;
+        }
+    }
+    return r;
+}
+
+EncodingResult Base64Decoder::finish(BufferView in, BufferView out) {
+    auto r = decode(in, out);
+    if (r.status == EncodingStatus::OutputBufferFull) {
+        return r;
+    }
+    if (r.status == EncodingStatus::Ok && held_ != 0) {
+        if (lenient_ && held_ >= 2) {
+            // An unpadded last group.
+            while (held_ < 4) {
+                holdover_[held_++] = '=';
+            }
+            r.status = emit(holdover_, out, r.output);
+            if (r.status == EncodingStatus::OutputBufferFull) {
+                return r;
+            }
+        } else {
+            r.status = EncodingStatus::InvalidInput;
+        }
+    }
+    held_ = 0;
+    ended_ = false;
+    return r;
+}
+
+};  // namespace csics::io::encdec
@@ -0,0 +1,322 @@
+#include "Base64Kernels.hpp"
+
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define CSICS_BASE64_X86
+#include <immintrin.h>
+#endif
+
+namespace csics::io::encdec::detail {
+
+namespace {
+
+// Portable kernels, also what NEON targets run.
+template <bool kUrl>
+void encode_scalar(const uint8_t* in, std::size_t groups,
+                   uint8_t* out) noexcept {
+    const auto& chars = base64_chars<kUrl>;
+    for (std::size_t i = 0; i < groups; i++, in += 3, out += 4) {
+        uint32_t v = (uint32_t(in[0]) << 16) | (uint32_t(in[1]) << 8) | in[2];
+        out[0] = chars[v >> 18];
+        out[1] = chars[(v >> 12) & 0x3F];
+        out[2] = chars[(v >> 6) & 0x3F];
+        out[3] = chars[v & 0x3F];
+    }
+}
+
+template <bool kUrl>
+std::size_t decode_scalar(const uint8_t* in, std::size_t quads,
+                          uint8_t* out) noexcept {
+    const auto& values = base64_values<kUrl>;
+    for (std::size_t i = 0; i < quads; i++, in += 4, out += 3) {
+        uint8_t a = values[in[0]];
+        uint8_t b = values[in[1]];
+        uint8_t c = values[in[2]];
+        uint8_t d = values[in[3]];
+        if ((a | b | c | d) & 0x80) {
+            return i;
+        }
+        uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) |
+                     (uint32_t(c) << 6) | d;
+        out[0] = static_cast<uint8_t>(v >> 16);
+        out[1] = static_cast<uint8_t>(v >> 8);
+        out[2] = static_cast<uint8_t>(v);
+    }
+    return quads;
+}
+
+#ifdef CSICS_BASE64_X86
+// Muła's reshuffle and translation, and the nibble lookup validation of
+// the Muła/Lemire decoder, as in aklomp/base64. The URL-safe alphabet is
+// mapped onto the standard one before validation.
+#define CSICS_SSSE3 __attribute__((target("ssse3")))
+#define CSICS_AVX2 __attribute__((target("avx2")))
+
+// Offsets from an index range to its characters: A-Z, a-z, 0-9, then the
+// two characters that differ between the alphabets.
+template <bool kUrl>
+CSICS_SSSE3 inline __m128i enc_lut() noexcept {
+    constexpr char c62 = kUrl ? '-' - 62 : '+' - 62;
+    constexpr char c63 = kUrl ? '_' - 63 : '/' - 63;
+    return _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, c62,
+                         c63, 0, 0);
+}
+
+// 12 bytes to 16 six bit indices, one per byte.
+CSICS_SSSE3 inline __m128i enc_reshuffle(__m128i in) noexcept {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5,
+                                           3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+    __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+    __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+template <bool kUrl>
+CSICS_SSSE3 inline __m128i enc_translate(__m128i in) noexcept {
+    __m128i index = _mm_subs_epu8(in, _mm_set1_epi8(51));
+    index = _mm_sub_epi8(index, _mm_cmpgt_epi8(in, _mm_set1_epi8(25)));
+    return _mm_add_epi8(in, _mm_shuffle_epi8(enc_lut<kUrl>(), index));
+}
+
+// '-' and '_' become '+' and '/', which get the high bit so they fail.
+CSICS_SSSE3 inline __m128i dec_url_to_std(__m128i str) noexcept {
+    __m128i minus = _mm_cmpeq_epi8(str, _mm_set1_epi8('-'));
+    __m128i under = _mm_cmpeq_epi8(str, _mm_set1_epi8('_'));
+    __m128i plain = _mm_or_si128(_mm_cmpeq_epi8(str, _mm_set1_epi8('+')),
+                               _mm_cmpeq_epi8(str, _mm_set1_epi8('/')));
+    str = _mm_sub_epi8(str, _mm_and_si128(minus, _mm_set1_epi8('-' - '+')));
+    str = _mm_sub_epi8(str, _mm_and_si128(under, _mm_set1_epi8('_' - '/')));
+    return _mm_or_si128(str, _mm_and_si128(plain, _mm_set1_epi8(-128)));
+}
+
+// Indices of 16 characters, or false if one is outside the alphabet.
+template <bool kUrl>
+CSICS_SSSE3 inline bool dec_translate(__m128i& str) noexcept {
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                         0x11, 0x11, 0x11, 0x11, 0x13, 0x1A,
+                                         0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08,
+                                         0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                         0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                           0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    if constexpr (kUrl) {
+        str = dec_url_to_std(str);
+    }
+    __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), nibble);
+    __m128i lo_nibbles = _mm_and_si128(str, nibble);
+    __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    __m128i valid = _mm_cmpeq_epi8(_mm_and_si128(lo, hi),
+                                   _mm_setzero_si128());
+    if (_mm_movemask_epi8(valid) != 0xFFFF) {
+        return false;
+    }
+    __m128i eq_2f = _mm_cmpeq_epi8(str, _mm_set1_epi8(0x2F));
+    __m128i roll =
+        _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+    str = _mm_add_epi8(str, roll);
+    return true;
+}
+
+// 16 indices to 12 bytes, in the low 12 bytes.
+CSICS_SSSE3 inline __m128i dec_reshuffle(__m128i in) noexcept {
+    __m128i ab_bc = _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140));
+    __m128i out = _mm_madd_epi16(ab_bc, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                               14, 13, 12, -1, -1, -1, -1));
+}
+
+template <bool kUrl>
+CSICS_SSSE3 void encode_ssse3(const uint8_t* in, std::size_t groups,
+                              uint8_t* out) noexcept {
+    // Loads 16 bytes for 12, so the last group stays scalar.
+    for (; groups >= 6; groups -= 4, in += 12, out += 16) {
+        __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        str = enc_translate<kUrl>(enc_reshuffle(str));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), str);
+    }
+    encode_scalar<kUrl>(in, groups, out);
+}
+
+template <bool kUrl>
+CSICS_SSSE3 std::size_t decode_ssse3(const uint8_t* in, std::size_t quads,
+                                     uint8_t* out) noexcept {
+    std::size_t done = 0;
+    for (; quads - done >= 4; done += 4, in += 16, out += 12) {
+        __m128i str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        if (!dec_translate<kUrl>(str)) {
+            break;
+        }
+        str = dec_reshuffle(str);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), str);
+        uint32_t tail = static_cast<uint32_t>(
+            _mm_cvtsi128_si32(_mm_srli_si128(str, 8)));
+        std::memcpy(out + 8, &tail, sizeof(tail));
+    }
+    return done + decode_scalar<kUrl>(in, quads - done, out);
+}
+
+// The AVX2 kernels run the SSSE3 steps on both lanes at once.
+CSICS_AVX2 inline __m256i broadcast(__m128i v) noexcept {
+    return _mm256_broadcastsi128_si256(v);
+}
+
+template <bool kUrl>
+CSICS_AVX2 void encode_avx2(const uint8_t* in, std::size_t groups,
+                            uint8_t* out) noexcept {
+    const __m256i shuffle = broadcast(_mm_set_epi8(
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m256i lut = broadcast(enc_lut<kUrl>());
+    // Each lane takes 12 of 16 bytes loaded, 28 bytes for 24.
+    for (; groups >= 10; groups -= 8, in += 24, out += 32) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        __m128i hi =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12));
+        __m256i str = _mm256_shuffle_epi8(_mm256_set_m128i(hi, lo), shuffle);
+        __m256i t0 = _mm256_and_si256(str, _mm256_set1_epi32(0x0FC0FC00));
+        __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        __m256i t2 = _mm256_and_si256(str, _mm256_set1_epi32(0x003F03F0));
+        __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        str = _mm256_or_si256(t1, t3);
+
+        __m256i index = _mm256_subs_epu8(str, _mm256_set1_epi8(51));
+        index = _mm256_sub_epi8(
+            index, _mm256_cmpgt_epi8(str, _mm256_set1_epi8(25)));
+        str = _mm256_add_epi8(str, _mm256_shuffle_epi8(lut, index));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), str);
+    }
+    encode_ssse3<kUrl>(in, groups, out);
+}
+
+CSICS_AVX2 inline __m256i dec_url_to_std(__m256i str) noexcept {
+    __m256i minus = _mm256_cmpeq_epi8(str, _mm256_set1_epi8('-'));
+    __m256i under = _mm256_cmpeq_epi8(str, _mm256_set1_epi8('_'));
+    __m256i plain =
+        _mm256_or_si256(_mm256_cmpeq_epi8(str, _mm256_set1_epi8('+')),
+                        _mm256_cmpeq_epi8(str, _mm256_set1_epi8('/')));
+    str = _mm256_sub_epi8(
+        str, _mm256_and_si256(minus, _mm256_set1_epi8('-' - '+')));
+    str = _mm256_sub_epi8(
+        str, _mm256_and_si256(under, _mm256_set1_epi8('_' - '/')));
+    return _mm256_or_si256(str,
+                           _mm256_and_si256(plain, _mm256_set1_epi8(-128)));
+}
+
+// Validates and decodes 32 characters per iteration.
+template <bool kUrl>
+CSICS_AVX2 std::size_t decode_avx2(const uint8_t* in, std::size_t quads,
+                                   uint8_t* out) noexcept {
+    const __m256i lut_lo = broadcast(
+        _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                      0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+    const __m256i lut_hi = broadcast(
+        _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10,
+                      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+    const __m256i lut_roll = broadcast(_mm_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+    const __m256i pack = broadcast(_mm_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    std::size_t done = 0;
+    for (; quads - done >= 8; done += 8, in += 32, out += 24) {
+        __m256i str =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        if constexpr (kUrl) {
+            str = dec_url_to_std(str);
+        }
+        __m256i hi_nibbles =
+            _mm256_and_si256(_mm256_srli_epi32(str, 4), nibble);
+        __m256i lo_nibbles = _mm256_and_si256(str, nibble);
+        __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+        __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+        if (!_mm256_testz_si256(lo, hi)) {
+            break;
+        }
+        __m256i eq_2f = _mm256_cmpeq_epi8(str, _mm256_set1_epi8(0x2F));
+        __m256i roll = _mm256_shuffle_epi8(
+            lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+        str = _mm256_add_epi8(str, roll);
+
+        __m256i ab_bc =
+            _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+        str = _mm256_madd_epi16(ab_bc, _mm256_set1_epi32(0x00011000));
+        str = _mm256_shuffle_epi8(str, pack);
+        // The 12 bytes of each lane next to each other.
+        str = _mm256_permutevar8x32_epi32(
+            str, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         _mm256_castsi256_si128(str));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16),
+                         _mm256_extracti128_si256(str, 1));
+    }
+    return done + decode_ssse3<kUrl>(in, quads - done, out);
+}
+#endif
+
+template <bool kUrl>
+const Base64Kernels& kernels_for(Base64Isa isa) noexcept {
+    static const Base64Kernels scalar{encode_scalar<kUrl>,
+                                      decode_scalar<kUrl>};
+#ifdef CSICS_BASE64_X86
+    static const Base64Kernels ssse3{encode_ssse3<kUrl>, decode_ssse3<kUrl>};
+    static const Base64Kernels avx2{encode_avx2<kUrl>, decode_avx2<kUrl>};
+    switch (isa) {
+        case Base64Isa::SSSE3:
+            return ssse3;
+        case Base64Isa::AVX2:
+            return avx2;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    return scalar;
+}
+
+};  // namespace
+
+const Base64Kernels& base64_kernels(Base64Isa isa,
+                                    Base64Alphabet alphabet) noexcept {
+    return alphabet == Base64Alphabet::UrlSafe ? kernels_for<true>(isa)
+                                               : kernels_for<false>(isa);
+}
+
+};  // namespace csics::io::encdec::detail
+
+namespace csics::io::encdec {
+
+bool base64_isa_supported(Base64Isa isa) noexcept {
+    switch (isa) {
+        case Base64Isa::Scalar:
+            return true;
+#ifdef CSICS_BASE64_X86
+        case Base64Isa::SSSE3:
+            return __builtin_cpu_supports("ssse3");
+        case Base64Isa::AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+Base64Isa base64_best_isa() noexcept {
+    static const Base64Isa best = [] {
+        for (Base64Isa isa : {Base64Isa::AVX2, Base64Isa::SSSE3}) {
+            if (base64_isa_supported(isa)) {
+                return isa;
+            }
+        }
+        return Base64Isa::Scalar;
+    }();
+    return best;
+}
+
+};  // namespace csics::io::encdec
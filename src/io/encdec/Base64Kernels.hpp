@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <csics/io/encdec/Base64.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace csics::io::encdec::detail {
+
+// Encodes `groups` groups of 3 bytes into 4 characters each.
+using Base64EncodeFn = void (*)(const uint8_t* in, std::size_t groups,
+                                uint8_t* out) noexcept;
+// Decodes `quads` groups of 4 characters, without padding, into 3 bytes
+// each. Returns the quads decoded before the first one holding a character
+// outside the alphabet. `out` may alias `in`.
+using Base64DecodeFn = std::size_t (*)(const uint8_t* in, std::size_t quads,
+                                       uint8_t* out) noexcept;
+
+struct Base64Kernels {
+    Base64EncodeFn encode;
+    Base64DecodeFn decode;
+};
+
+// Kernels for `isa`, which the CPU must support.
+const Base64Kernels& base64_kernels(Base64Isa isa,
+                                    Base64Alphabet alphabet) noexcept;
+
+constexpr std::array<uint8_t, 64> make_base64_chars(bool url) {
+    std::array<uint8_t, 64> chars{};
+    for (uint8_t i = 0; i < 26; i++) {
+        chars[i] = 'A' + i;
+        chars[26 + i] = 'a' + i;
+    }
+    for (uint8_t i = 0; i < 10; i++) {
+        chars[52 + i] = '0' + i;
+    }
+    chars[62] = url ? '-' : '+';
+    chars[63] = url ? '_' : '/';
+    return chars;
+}
+
+// Value of each alphabet character, 0xFF for any other byte.
+constexpr std::array<uint8_t, 256> make_base64_values(bool url) {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    auto chars = make_base64_chars(url);
+    for (uint8_t i = 0; i < 64; i++) {
+        values[chars[i]] = i;
+    }
+    return values;
+}
+
+template <bool kUrl>
+inline constexpr std::array<uint8_t, 64> base64_chars =
+    make_base64_chars(kUrl);
+template <bool kUrl>
+inline constexpr std::array<uint8_t, 256> base64_values =
+    make_base64_values(kUrl);
+
+inline const uint8_t* base64_chars_of(Base64Alphabet alphabet) noexcept {
+    return alphabet == Base64Alphabet::UrlSafe ? base64_chars<true>.data()
+                                               : base64_chars<false>.data();
+}
+
+inline const uint8_t* base64_values_of(Base64Alphabet alphabet) noexcept {
+    return alphabet == Base64Alphabet::UrlSafe ? base64_values<true>.data()
+                                               : base64_values<false>.data();
+}
+
+};  // namespace csics::io::encdec::detail
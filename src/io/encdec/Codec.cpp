@@ -0,0 +1,288 @@
+#include <csics/io/encdec/Codec.hpp>
+#include <cstring>
+#include <stdexcept>
+
+namespace csics::io::encdec {
+
+using compression::CompressionStatus;
+
+namespace {
+
+EncodingStatus from_compression(CompressionStatus status) noexcept {
+    switch (status) {
+        case CompressionStatus::Ok:
+        case CompressionStatus::NeedsInput:
+        case CompressionStatus::InputBufferFinished:
+            return EncodingStatus::Ok;
+        case CompressionStatus::OutputBufferFull:
+        case CompressionStatus::NeedsFlush:
+            return EncodingStatus::OutputBufferFull;
+        default:
+            return EncodingStatus::FatalError;
+    }
+}
+
+};  // namespace
+
+CompressorCodec::CompressorCodec(
+    std::unique_ptr<compression::ICompressor> compressor)
+    : compressor_(std::move(compressor)) {
+    if (compressor_ == nullptr) {
+        throw std::invalid_argument("CompressorCodec needs a compressor");
+    }
+}
+
+EncodingResult CompressorCodec::process(BufferView in, BufferView out) {
+    auto r = compressor_->compress_buffer(in, out);
+    EncodingResult e{r.input_consumed, r.compressed,
+                     from_compression(r.status)};
+    if (e.status == EncodingStatus::Ok && e.processed < in.size()) {
+        e.status = EncodingStatus::OutputBufferFull;
+    }
+    return e;
+}
+
+EncodingResult CompressorCodec::finish(BufferView in, BufferView out) {
+    auto r = compressor_->finish(in, out);
+    EncodingResult e{r.input_consumed, r.compressed,
+                     from_compression(r.status)};
+    if (r.status == CompressionStatus::InputBufferFinished) {
+        compressor_->reset();
+    } else if (e.status == EncodingStatus::Ok) {
+        e.status = EncodingStatus::OutputBufferFull;
+    }
+    return e;
+}
+
+void CompressorCodec::reset() { compressor_->reset(); }
+
+DecompressorCodec::DecompressorCodec(
+    std::unique_ptr<decompression::IDecompressor> decompressor)
+    : decompressor_(std::move(decompressor)) {
+    if (decompressor_ == nullptr) {
+        throw std::invalid_argument("DecompressorCodec needs a decompressor");
+    }
+}
+
+EncodingResult DecompressorCodec::process(BufferView in, BufferView out) {
+    auto r = decompressor_->decompress_buffer(in, out);
+    EncodingResult e{r.input_consumed, r.decompressed,
+                     from_compression(r.status)};
+    if (e.status == EncodingStatus::FatalError) {
+        e.status = EncodingStatus::InvalidInput;
+    } else if (e.status == EncodingStatus::Ok && e.processed < in.size()) {
+        e.status = EncodingStatus::OutputBufferFull;
+    }
+    return e;
+}
+
+EncodingResult DecompressorCodec::finish(BufferView in, BufferView out) {
+    auto r = decompressor_->finish(in, out);
+    EncodingResult e{r.input_consumed, r.decompressed,
+                     from_compression(r.status)};
+    switch (r.status) {
+        case CompressionStatus::InputBufferFinished:
+            if (e.processed < in.size()) {
+                e.status = EncodingStatus::OutputBufferFull;
+            } else {
+                decompressor_->reset();
+            }
+            break;
+        case CompressionStatus::OutputBufferFull:
+            break;
+        default:
+            // Truncated, or corrupt.
+            e.status = EncodingStatus::InvalidInput;
+            break;
+    }
+    return e;
+}
+
+void DecompressorCodec::reset() { decompressor_->reset(); }
+
+CodecChain::CodecChain(std::vector<std::unique_ptr<ICodec>> stages,
+                       std::size_t chunk_size) {
+    if (stages.empty() || chunk_size == 0) {
+        throw std::invalid_argument(
+            "CodecChain needs a stage and a non-zero chunk size");
+    }
+    stages_.resize(stages.size());
+    for (std::size_t i = 0; i < stages.size(); i++) {
+        if (stages[i] == nullptr) {
+            throw std::invalid_argument("CodecChain stage is null");
+        }
+        stages_[i].codec = std::move(stages[i]);
+        if (i + 1 < stages.size()) {
+            stages_[i].buffer.resize(chunk_size);
+        }
+    }
+}
+
+EncodingResult CodecChain::run(BufferView in, BufferView out,
+                               bool finishing) {
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+    const std::size_t last = stages_.size() - 1;
+
+    // Passes over the stages until nothing moves: the input is used up,
+    // `out` is full, or every stage has finished.
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        for (std::size_t i = 0; i <= last; i++) {
+            Stage& s = stages_[i];
+            if (s.finished) {
+                continue;
+            }
+            BufferView src = in.subview(r.processed, in.size());
+            if (i > 0) {
+                Stage& prev = stages_[i - 1];
+                src = BufferView(prev.buffer.data() + prev.begin,
+                                 prev.end - prev.begin);
+            }
+            BufferView dst = out.subview(r.output, out.size());
+            if (i < last) {
+                if (s.begin == s.end) {
+                    s.begin = s.end = 0;
+                } else if (s.begin > 0) {
+                    std::memmove(s.buffer.data(), s.buffer.data() + s.begin,
+                                 s.end - s.begin);
+                    s.end -= s.begin;
+                    s.begin = 0;
+                }
+                dst = BufferView(s.buffer.data() + s.end,
+                                 s.buffer.size() - s.end);
+            }
+            // Nothing can move without room, and zlib rejects a null
+            // output.
+            if (dst.empty()) {
+                continue;
+            }
+
+            // A stage finishes once everything before it has and its input
+            // is used up. Finishing with input left would tempt the
+            // compressors into one-shot paths that cannot fit a chunk.
+            bool ending = finishing && src.empty() &&
+                          (i == 0 || stages_[i - 1].finished);
+            auto sr = ending ? s.codec->finish(src, dst)
+                             : s.codec->process(src, dst);
+            if (sr.status == EncodingStatus::InvalidInput ||
+                sr.status == EncodingStatus::FatalError) {
+                r.status = sr.status;
+                return r;
+            }
+
+            if (i == 0) {
+                r.processed += sr.processed;
+            } else {
+                stages_[i - 1].begin += sr.processed;
+            }
+            if (i == last) {
+                r.output += sr.output;
+            } else {
+                s.end += sr.output;
+            }
+            moved = moved || sr.processed != 0 || sr.output != 0;
+            if (ending && sr.status == EncodingStatus::Ok &&
+                sr.processed == src.size()) {
+                s.finished = true;
+                moved = true;
+            }
+        }
+    }
+
+    if (finishing) {
+        if (stages_[last].finished) {
+            reset();
+        } else {
+            r.status = EncodingStatus::OutputBufferFull;
+        }
+    } else if (r.processed < in.size()) {
+        r.status = EncodingStatus::OutputBufferFull;
+    }
+    return r;
+}
+
+EncodingResult CodecChain::process(BufferView in, BufferView out) {
+    return run(in, out, false);
+}
+
+EncodingResult CodecChain::finish(BufferView in, BufferView out) {
+    return run(in, out, true);
+}
+
+void CodecChain::reset() {
+    for (Stage& s : stages_) {
+        // Finished stages started a new stream already.
+        if (!s.finished) {
+            s.codec->reset();
+        }
+        s.begin = s.end = 0;
+        s.finished = false;
+    }
+}
+
+ChecksumCodec::ChecksumCodec(std::unique_ptr<ICodec> inner,
+                             checksum::ChecksumType type, Side side,
+                             std::size_t slice_size)
+    : inner_(std::move(inner)),
+      sum_(type),
+      side_(side),
+      slice_size_(slice_size) {
+    if (inner_ == nullptr || slice_size == 0) {
+        throw std::invalid_argument(
+            "ChecksumCodec needs a codec and a non-zero slice size");
+    }
+}
+
+EncodingResult ChecksumCodec::run(BufferView in, BufferView out,
+                                  bool finishing) {
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+    finished_ = false;
+    do {
+        std::size_t left = in.size() - r.processed;
+        bool last = left <= slice_size_;
+        BufferView src(in.u8() + r.processed, last ? left : slice_size_);
+        BufferView dst(out.u8() + r.output, out.size() - r.output);
+        if (dst.empty() && !src.empty()) {
+            r.status = EncodingStatus::OutputBufferFull;
+            break;
+        }
+
+        auto sr = finishing && last ? inner_->finish(src, dst)
+                                    : inner_->process(src, dst);
+        sum_.update(side_ == Side::Input ? src.head(sr.processed)
+                                         : dst.head(sr.output));
+        r.processed += sr.processed;
+        r.output += sr.output;
+        if (sr.status != EncodingStatus::Ok) {
+            r.status = sr.status;
+            break;
+        }
+        if (finishing && last) {
+            finished_digest_ = sum_.digest();
+            finished_ = true;
+            sum_.reset();
+        }
+    } while (r.processed < in.size());
+    return r;
+}
+
+EncodingResult ChecksumCodec::process(BufferView in, BufferView out) {
+    return run(in, out, false);
+}
+
+EncodingResult ChecksumCodec::finish(BufferView in, BufferView out) {
+    return run(in, out, true);
+}
+
+void ChecksumCodec::reset() {
+    inner_->reset();
+    sum_.reset();
+    finished_ = false;
+}
+
+uint64_t ChecksumCodec::digest() const noexcept {
+    return finished_ ? finished_digest_ : sum_.digest();
+}
+
+};  // namespace csics::io::encdec
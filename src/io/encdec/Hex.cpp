@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <csics/io/encdec/Hex.hpp>
+#include <stdexcept>
+
+#include "HexKernels.hpp"
+
+namespace csics::io::encdec {
+
+HexEncoder::HexEncoder(Base64Isa isa, bool uppercase)
+    : kernels_(&detail::hex_kernels(isa)),
+      digits_(uppercase ? detail::hex_upper : detail::hex_lower) {
+    if (!base64_isa_supported(isa)) {
+        throw std::invalid_argument("Hex ISA not supported by this CPU");
+    }
+}
+
+EncodingResult HexEncoder::encode(BufferView in, BufferView out) {
+    std::size_t fit = std::min(in.size(), out.size() / 2);
+    kernels_->encode(in.u8(), fit, out.u8(), digits_);
+    EncodingResult r{fit, 2 * fit, EncodingStatus::Ok};
+    if (fit < in.size()) {
+        r.status = EncodingStatus::OutputBufferFull;
+    }
+    return r;
+}
+
+HexDecoder::HexDecoder(Base64Isa isa) : kernels_(&detail::hex_kernels(isa)) {
+    if (!base64_isa_supported(isa)) {
+        throw std::invalid_argument("Hex ISA not supported by this CPU");
+    }
+}
+
+EncodingResult HexDecoder::decode(BufferView in, BufferView out) {
+    const uint8_t* src = in.u8();
+    std::size_t n = in.size();
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+
+    // Complete the digit held over from the last call first.
+    if (held_ && n != 0) {
+        if (out.size() == 0) {
+            r.status = EncodingStatus::OutputBufferFull;
+            return r;
+        }
+        uint8_t pair[2] = {holdover_, src[0]};
+        if (kernels_->decode(pair, 1, out.u8()) != 1) {
+            r.status = EncodingStatus::InvalidInput;
+            return r;
+        }
+        held_ = false;
+        r.processed = 1;
+        r.output = 1;
+    }
+
+    std::size_t pairs = (n - r.processed) / 2;
+    std::size_t fit = std::min(pairs, out.size() - r.output);
+    std::size_t done =
+        kernels_->decode(src + r.processed, fit, out.u8() + r.output);
+    r.processed += 2 * done;
+    r.output += done;
+    if (done < fit) {
+        r.status = EncodingStatus::InvalidInput;
+        return r;
+    }
+    if (fit < pairs) {
+        r.status = EncodingStatus::OutputBufferFull;
+        return r;
+    }
+
+    if (r.processed < n) {
+        holdover_ = src[r.processed++];
+        held_ = true;
+    }
+    return r;
+}
+
+EncodingResult HexDecoder::finish(BufferView in, BufferView out) {
+    auto r = decode(in, out);
+    if (r.status == EncodingStatus::OutputBufferFull) {
+        return r;
+    }
+    if (r.status == EncodingStatus::Ok && held_) {
+        r.status = EncodingStatus::InvalidInput;
+    }
+    held_ = false;
+    return r;
+}
+
+};  // namespace csics::io::encdec
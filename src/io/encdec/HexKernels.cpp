@@ -0,0 +1,176 @@
+#include "HexKernels.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define CSICS_HEX_X86
+#include <immintrin.h>
+#endif
+
+namespace csics::io::encdec::detail {
+
+namespace {
+
+void encode_scalar(const uint8_t* in, std::size_t n, uint8_t* out,
+                   const uint8_t* digits) noexcept {
+    for (std::size_t i = 0; i < n; i++) {
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0F];
+    }
+}
+
+std::size_t decode_scalar(const uint8_t* in, std::size_t pairs,
+                          uint8_t* out) noexcept {
+    for (std::size_t i = 0; i < pairs; i++) {
+        uint8_t hi = hex_values[in[2 * i]];
+        uint8_t lo = hex_values[in[2 * i + 1]];
+        if ((hi | lo) & 0x80) {
+            return i;
+        }
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return pairs;
+}
+
+#ifdef CSICS_HEX_X86
+// The nibbles index a shuffle of the 16 digits. Decoding maps digits and
+// letters of either case to their values with unsigned range checks, then
+// pairs them up with a multiply-add.
+#define CSICS_SSSE3 __attribute__((target("ssse3")))
+#define CSICS_AVX2 __attribute__((target("avx2")))
+
+CSICS_SSSE3 void encode_ssse3(const uint8_t* in, std::size_t n,
+                              uint8_t* out, const uint8_t* digits) noexcept {
+    const __m128i lut =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    for (; n >= 16; n -= 16, in += 16, out += 32) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        __m128i hi = _mm_shuffle_epi8(
+            lut, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16),
+                         _mm_unpackhi_epi8(hi, lo));
+    }
+    encode_scalar(in, n, out, digits);
+}
+
+// Values of 16 digits, or false if one is not a digit.
+CSICS_SSSE3 inline bool nibbles(__m128i& c) noexcept {
+    __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)),
+                             _mm_set1_epi8('a'));
+    __m128i is_letter =
+        _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xFFFF) {
+        return false;
+    }
+    c = _mm_or_si128(
+        _mm_and_si128(is_digit, d),
+        _mm_and_si128(is_letter, _mm_add_epi8(l, _mm_set1_epi8(10))));
+    return true;
+}
+
+CSICS_SSSE3 std::size_t decode_ssse3(const uint8_t* in, std::size_t pairs,
+                                     uint8_t* out) noexcept {
+    // High nibble times 16 plus low nibble, in each 16 bit lane.
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    std::size_t done = 0;
+    for (; pairs - done >= 16; done += 16, in += 32, out += 16) {
+        __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        __m128i c1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+        if (!nibbles(c0) || !nibbles(c1)) {
+            break;
+        }
+        __m128i w0 = _mm_maddubs_epi16(c0, weights);
+        __m128i w1 = _mm_maddubs_epi16(c1, weights);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         _mm_packus_epi16(w0, w1));
+    }
+    return done + decode_scalar(in, pairs - done, out);
+}
+
+CSICS_AVX2 void encode_avx2(const uint8_t* in, std::size_t n, uint8_t* out,
+                            const uint8_t* digits) noexcept {
+    const __m256i lut = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    for (; n >= 32; n -= 32, in += 32, out += 64) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        __m256i hi = _mm256_shuffle_epi8(
+            lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble));
+        // Per lane, so bytes 0-7 and 16-23 land in `a`, 8-15 and 24-31 in
+        // `b`.
+        __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                            _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32),
+                            _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    encode_ssse3(in, n, out, digits);
+}
+
+CSICS_AVX2 inline bool nibbles(__m256i& c) noexcept {
+    __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    __m256i is_digit =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+    __m256i l = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)),
+                                _mm256_set1_epi8('a'));
+    __m256i is_letter =
+        _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+    if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_letter)) != -1) {
+        return false;
+    }
+    c = _mm256_or_si256(
+        _mm256_and_si256(is_digit, d),
+        _mm256_and_si256(is_letter, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+    return true;
+}
+
+CSICS_AVX2 std::size_t decode_avx2(const uint8_t* in, std::size_t pairs,
+                                   uint8_t* out) noexcept {
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    std::size_t done = 0;
+    for (; pairs - done >= 32; done += 32, in += 64, out += 32) {
+        __m256i c0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        __m256i c1 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32));
+        if (!nibbles(c0) || !nibbles(c1)) {
+            break;
+        }
+        __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(c0, weights),
+                                             _mm256_maddubs_epi16(c1, weights));
+        // packus works per lane.
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return done + decode_ssse3(in, pairs - done, out);
+}
+#endif
+
+};  // namespace
+
+const HexKernels& hex_kernels(Base64Isa isa) noexcept {
+    static const HexKernels scalar{encode_scalar, decode_scalar};
+#ifdef CSICS_HEX_X86
+    static const HexKernels ssse3{encode_ssse3, decode_ssse3};
+    static const HexKernels avx2{encode_avx2, decode_avx2};
+    switch (isa) {
+        case Base64Isa::SSSE3:
+            return ssse3;
+        case Base64Isa::AVX2:
+            return avx2;
+        default:
+            break;
+    }
+#else
+    (void)isa;
+#endif
+    return scalar;
+}
+
+};  // namespace csics::io::encdec::detail
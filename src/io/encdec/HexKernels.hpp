@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <csics/io/encdec/Base64.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace csics::io::encdec::detail {
+
+// Encodes `n` bytes into 2n digits taken from the 16 in `digits`.
+using HexEncodeFn = void (*)(const uint8_t* in, std::size_t n, uint8_t* out,
+                             const uint8_t* digits) noexcept;
+// Decodes `pairs` pairs of digits of either case into a byte each. Returns
+// the pairs decoded before the first one holding a non-digit. `out` may
+// alias `in`.
+using HexDecodeFn = std::size_t (*)(const uint8_t* in, std::size_t pairs,
+                                    uint8_t* out) noexcept;
+
+struct HexKernels {
+    HexEncodeFn encode;
+    HexDecodeFn decode;
+};
+
+// Kernels for `isa`, which the CPU must support.
+const HexKernels& hex_kernels(Base64Isa isa) noexcept;
+
+inline constexpr uint8_t hex_lower[16] = {'0', '1', '2', '3', '4', '5',
+                                          '6', '7', '8', '9', 'a', 'b',
+                                          'c', 'd', 'e', 'f'};
+inline constexpr uint8_t hex_upper[16] = {'0', '1', '2', '3', '4', '5',
+                                          '6', '7', '8', '9', 'A', 'B',
+                                          'C', 'D', 'E', 'F'};
+
+// Value of each digit of either case, 0xFF for any other byte.
+constexpr std::array<uint8_t, 256> make_hex_values() {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    for (uint8_t i = 0; i < 16; i++) {
+        values[hex_lower[i]] = i;
+        values[hex_upper[i]] = i;
+    }
+    return values;
+}
+
+inline constexpr std::array<uint8_t, 256> hex_values = make_hex_values();
+
+};  // namespace csics::io::encdec::detail
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <array>
+#include <csics/io/encdec/Z85.hpp>
+
+namespace csics::io::encdec {
+
+namespace {
+
+constexpr uint8_t z85_chars[86] =
+    "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    ".-:+=^!/*?&<>()[]{}@%$#";
+
+constexpr std::array<uint8_t, 256> make_z85_values() {
+    std::array<uint8_t, 256> values{};
+    values.fill(0xFF);
+    for (uint8_t i = 0; i < 85; i++) {
+        values[z85_chars[i]] = i;
+    }
+    return values;
+}
+
+constexpr std::array<uint8_t, 256> z85_values = make_z85_values();
+
+// Big endian words, most significant digit first. The divisions by
+// constants compile to multiplies.
+void encode_groups(const uint8_t* in, std::size_t groups,
+                   uint8_t* out) noexcept {
+    for (std::size_t g = 0; g < groups; g++, in += 4, out += 5) {
+        uint32_t v = (uint32_t(in[0]) << 24) | (uint32_t(in[1]) << 16) |
+                     (uint32_t(in[2]) << 8) | in[3];
+        out[4] = z85_chars[v % 85];
+        v /= 85;
+        out[3] = z85_chars[v % 85];
+        v /= 85;
+        out[2] = z85_chars[v % 85];
+        v /= 85;
+        out[1] = z85_chars[v % 85];
+        out[0] = z85_chars[v / 85];
+    }
+}
+
+// Returns the groups decoded before the first one holding a character
+// outside the alphabet or a value above 2^32 - 1.
+std::size_t decode_groups(const uint8_t* in, std::size_t groups,
+                          uint8_t* out) noexcept {
+    for (std::size_t g = 0; g < groups; g++, in += 5, out += 4) {
+        uint64_t v = 0;
+        uint8_t bad = 0;
+        for (int i = 0; i < 5; i++) {
+            uint8_t c = z85_values[in[i]];
+            bad |= c;
+            v = v * 85 + (c & 0x7F);
+        }
+        if ((bad & 0x80) || v > 0xFFFFFFFF) {
+            return g;
+        }
+        out[0] = static_cast<uint8_t>(v >> 24);
+        out[1] = static_cast<uint8_t>(v >> 16);
+        out[2] = static_cast<uint8_t>(v >> 8);
+        out[3] = static_cast<uint8_t>(v);
+    }
+    return groups;
+}
+
+};  // namespace
+
+EncodingResult Z85Encoder::encode(BufferView in, BufferView out) {
+    const uint8_t* src = in.u8();
+    uint8_t* dst = out.u8();
+    std::size_t n = in.size();
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+
+    // Complete the group held over from the last call first.
+    if (held_ != 0) {
+        while (held_ < 4 && r.processed < n) {
+            holdover_[held_++] = src[r.processed++];
+        }
+        if (held_ < 4) {
+            return r;
+        }
+        if (out.size() < 5) {
+            r.status = EncodingStatus::OutputBufferFull;
+            return r;
+        }
+        encode_groups(holdover_, 1, dst);
+        r.output = 5;
+        held_ = 0;
+    }
+
+    std::size_t groups = (n - r.processed) / 4;
+    std::size_t fit = std::min(groups, (out.size() - r.output) / 5);
+    encode_groups(src + r.processed, fit, dst + r.output);
+    r.processed += 4 * fit;
+    r.output += 5 * fit;
+    if (fit < groups) {
+        r.status = EncodingStatus::OutputBufferFull;
+        return r;
+    }
+
+    while (r.processed < n) {
+        holdover_[held_++] = src[r.processed++];
+    }
+    return r;
+}
+
+EncodingResult Z85Encoder::finish(BufferView in, BufferView out) {
+    auto r = encode(in, out);
+    if (r.status == EncodingStatus::OutputBufferFull) {
+        return r;
+    }
+    if (held_ != 0) {
+        r.status = EncodingStatus::InvalidInput;
+    }
+    held_ = 0;
+    return r;
+}
+
+EncodingResult Z85Decoder::decode(BufferView in, BufferView out) {
+    const uint8_t* src = in.u8();
+    std::size_t n = in.size();
+    EncodingResult r{0, 0, EncodingStatus::Ok};
+
+    // Complete the group held over from the last call first.
+    if (held_ != 0) {
+        while (held_ < 5 && r.processed < n) {
+            holdover_[held_++] = src[r.processed++];
+        }
+        if (held_ < 5) {
+            return r;
+        }
+        if (out.size() < 4) {
+            // Given back, so the next call completes the group again.
+            held_ -= static_cast<uint8_t>(r.processed);
+            r.processed = 0;
+            r.status = EncodingStatus::OutputBufferFull;
+            return r;
+        }
+        if (decode_groups(holdover_, 1, out.u8()) != 1) {
+            r.status = EncodingStatus::InvalidInput;
+            return r;
+        }
+        r.output = 4;
+        held_ = 0;
+    }
+
+    std::size_t groups = (n - r.processed) / 5;
+    std::size_t fit = std::min(groups, (out.size() - r.output) / 4);
+    std::size_t done =
+        decode_groups(src + r.processed, fit, out.u8() + r.output);
+    r.processed += 5 * done;
+    r.output += 4 * done;
+    if (done < fit) {
+        r.status = EncodingStatus::InvalidInput;
+        return r;
+    }
+    if (fit < groups) {
+        r.status = EncodingStatus::OutputBufferFull;
+        return r;
+    }
+
+    while (r.processed < n) {
+        holdover_[held_++] = src[r.processed++];
+    }
+    return r;
+}
+
+EncodingResult Z85Decoder::finish(BufferView in, BufferView out) {
+    auto r = decode(in, out);
+    if (r.status == EncodingStatus::OutputBufferFull) {
+        return r;
+    }
+    if (r.status == EncodingStatus::Ok && held_ != 0) {
+        r.status = EncodingStatus::InvalidInput;
+    }
+    held_ = 0;
+    return r;
+}
+
+};  // namespace csics::io::encdec
@@ -0,0 +1,52 @@
+#include <csics/io/net/NetTypes.hpp>
+#include <stdexcept>
+
+namespace csics::io::net {
+
+// Dotted decimal IPv4 only, e.g. "127.0.0.1".
+IPAddress::IPAddress(const char* address) : IPAddress() {
+    if (address == nullptr) {
+        throw std::invalid_argument("IPAddress needs an address");
+    }
+    const char* p = address;
+    for (int i = 0; i < 4; i++) {
+        if (i > 0 && *p++ != '.') {
+            throw std::invalid_argument("Malformed IPv4 address");
+        }
+        int value = 0;
+        int digits = 0;
+        for (; *p >= '0' && *p <= '9' && digits < 4; p++, digits++) {
+            value = value * 10 + (*p - '0');
+        }
+        if (digits == 0 || digits > 3 || value > 255) {
+            throw std::invalid_argument("Malformed IPv4 address");
+        }
+        bytes_[i] = static_cast<uint8_t>(value);
+    }
+    if (*p != '\0') {
+        throw std::invalid_argument("Malformed IPv4 address");
+    }
+}
+
+IPAddress::IPAddress(const std::string& address)
+    : IPAddress(address.c_str()) {}
+
+SockAddr::SockAddr(const SockAddr& other) noexcept
+    : address_(other.address_), port_(other.port_) {}
+
+SockAddr& SockAddr::operator=(const SockAddr& other) noexcept {
+    address_ = other.address_;
+    port_ = other.port_;
+    return *this;
+}
+
+SockAddr::SockAddr(SockAddr&& other) noexcept
+    : address_(other.address_), port_(other.port_) {}
+
+SockAddr& SockAddr::operator=(SockAddr&& other) noexcept {
+    address_ = other.address_;
+    port_ = other.port_;
+    return *this;
+}
+
+};  // namespace csics::io::net
@@ -0,0 +1,125 @@
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <csics/io/net/UDPEndpoint.hpp>
+
+#include "../../../platform/unix/SocketUnix.hpp"
+
+namespace csics::io::net {
+struct UDPEndpoint::Internal {
+    int sockfd;
+    bool nonblocking;
+    Internal() : sockfd(-1), nonblocking(false) {}
+    ~Internal() {
+        if (sockfd != -1) {
+            close(sockfd);
+        }
+    }
+    bool open() {
+        if (sockfd == -1) {
+            sockfd = detail::open_socket(SOCK_DGRAM, nonblocking);
+        }
+        return sockfd != -1;
+    }
+};
+
+UDPEndpoint::UDPEndpoint() : internal_(new Internal()) {}
+
+UDPEndpoint::~UDPEndpoint() { delete internal_; }
+
+UDPEndpoint::UDPEndpoint(UDPEndpoint&& other) noexcept
+    : internal_(other.internal_) {
+    other.internal_ = nullptr;
+}
+
+UDPEndpoint& UDPEndpoint::operator=(UDPEndpoint&& other) noexcept {
+    if (this != &other) {
+        delete internal_;
+        internal_ = other.internal_;
+        other.internal_ = nullptr;
+    }
+    return *this;
+}
+
+NetResult UDPEndpoint::send(BufferView data, const SockAddr& dest) {
+    if (internal_ == nullptr || !internal_->open()) {
+        return NetResult{NetStatus::Error, 0};
+    }
+    sockaddr_in sa = detail::to_sockaddr(dest);
+    ssize_t bytesSent;
+    do {
+        bytesSent = ::sendto(internal_->sockfd, data.data(), data.size(),
+                             MSG_NOSIGNAL,
+                             reinterpret_cast<const sockaddr*>(&sa),
+                             sizeof(sa));
+    } while (bytesSent < 0 && errno == EINTR);
+    if (bytesSent < 0) {
+        return NetResult{detail::status_from_errno(errno), 0};
+    }
+    return NetResult{NetStatus::Success,
+                     static_cast<std::size_t>(bytesSent)};
+}
+
+NetResult UDPEndpoint::recv(BufferView buffer, SockAddr& src) {
+    if (internal_ == nullptr || internal_->sockfd == -1) {
+        return NetResult{NetStatus::Error, 0};
+    }
+    sockaddr_in sa;
+    socklen_t len = sizeof(sa);
+    ssize_t bytesReceived;
+    do {
+        bytesReceived =
+            ::recvfrom(internal_->sockfd, buffer.data(), buffer.size(), 0,
+                       reinterpret_cast<sockaddr*>(&sa), &len);
+    } while (bytesReceived < 0 && errno == EINTR);
+    if (bytesReceived < 0) {
+        return NetResult{detail::status_from_errno(errno), 0};
+    }
+    src = detail::from_sockaddr(sa);
+    return NetResult{NetStatus::Success,
+                     static_cast<std::size_t>(bytesReceived)};
+}
+
+NetResult UDPEndpoint::connect_(SockAddr addr) {
+    if (internal_ == nullptr || !internal_->open()) {
+        return NetResult{NetStatus::Error, 0};
+    }
+    sockaddr_in sa = detail::to_sockaddr(addr);
+    if (::connect(internal_->sockfd, reinterpret_cast<const sockaddr*>(&sa),
+                  sizeof(sa)) < 0) {
+        return NetResult{NetStatus::Error, 0};
+    }
+    return NetResult{NetStatus::Success, 0};
+}
+
+NetStatus UDPEndpoint::bind(const SockAddr& addr) {
+    if (internal_ == nullptr || !internal_->open()) {
+        return NetStatus::Error;
+    }
+    return detail::bind_socket(internal_->sockfd, addr);
+}
+
+NetStatus UDPEndpoint::set_nonblocking(bool nonblocking) {
+    if (internal_ == nullptr) {
+        return NetStatus::Error;
+    }
+    if (internal_->sockfd != -1 &&
+        !detail::set_nonblocking(internal_->sockfd, nonblocking)) {
+        return NetStatus::Error;
+    }
+    internal_->nonblocking = nonblocking;
+    return NetStatus::Success;
+}
+
+SockAddr UDPEndpoint::local_address() const {
+    if (internal_ == nullptr || internal_->sockfd == -1) {
+        return SockAddr();
+    }
+    return detail::local_address(internal_->sockfd);
+}
+
+int UDPEndpoint::native_handle() const noexcept {
+    return internal_ == nullptr ? -1 : internal_->sockfd;
+}
+};  // namespace csics::io::net
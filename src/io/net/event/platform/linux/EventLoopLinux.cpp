@@ -0,0 +1,350 @@
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csics/io/net/EventLoop.hpp>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace csics::io::net {
+
+namespace {
+
+// epoll_event.data of the wake up eventfd; endpoints carry their
+// descriptor and a registration generation, never all ones.
+constexpr uint64_t kWakeToken = ~uint64_t(0);
+
+uint32_t to_epoll(IoEvent interest) noexcept {
+    uint32_t events = EPOLLET | EPOLLRDHUP;
+    if (any(interest & IoEvent::Readable)) {
+        events |= EPOLLIN;
+    }
+    if (any(interest & IoEvent::Writable)) {
+        events |= EPOLLOUT;
+    }
+    return events;
+}
+
+IoEvent from_epoll(uint32_t events) noexcept {
+    IoEvent e = IoEvent::None;
+    if (events & EPOLLIN) {
+        e = e | IoEvent::Readable;
+    }
+    if (events & EPOLLOUT) {
+        e = e | IoEvent::Writable;
+    }
+    if (events & (EPOLLHUP | EPOLLRDHUP)) {
+        e = e | IoEvent::Hangup;
+    }
+    if (events & EPOLLERR) {
+        e = e | IoEvent::Error;
+    }
+    return e;
+}
+
+};  // namespace
+
+struct EventLoop::Internal {
+    struct Registration {
+        Handler handler;
+        uint32_t generation;
+    };
+
+    struct Timer {
+        std::function<void()> callback;
+        Clock::duration period;
+        bool repeat;
+    };
+
+    using Deadline = std::pair<Clock::time_point, TimerId>;
+
+    int epfd = -1;
+    int wakefd = -1;
+
+    std::unordered_map<int, std::unique_ptr<Registration>> registrations;
+    // Removed while dispatching, kept alive until the batch is done since
+    // the handler running may be one of them.
+    std::vector<std::unique_ptr<Registration>> retired;
+    bool dispatching = false;
+    uint32_t next_generation = 0;
+
+    // Cancelled timers leave their deadline behind, skipped when due.
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>>
+        deadlines;
+    std::unordered_map<TimerId, std::shared_ptr<Timer>> timers;
+    TimerId next_timer = 1;
+
+    std::mutex posted_mutex;
+    std::vector<std::function<void()>> posted;
+    std::atomic<bool> has_posted{false};
+    std::atomic<bool> stopped{false};
+
+    std::vector<epoll_event> events = std::vector<epoll_event>(64);
+
+    ~Internal() {
+        if (epfd != -1) {
+            ::close(epfd);
+        }
+        if (wakefd != -1) {
+            ::close(wakefd);
+        }
+    }
+
+    void wake() noexcept {
+        uint64_t one = 1;
+        // Only fails when the counter is saturated, awake either way.
+        [[maybe_unused]] ssize_t n = ::write(wakefd, &one, sizeof(one));
+    }
+
+    // Milliseconds epoll_wait may sleep, rounded up so timers are not
+    // polled early.
+    int wait_ms(std::chrono::milliseconds timeout) const noexcept {
+        if (has_posted.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        long long ms = timeout.count() < 0 ? -1 : timeout.count();
+        if (!deadlines.empty()) {
+            auto left = deadlines.top().first - Clock::now();
+            long long due = 0;
+            if (left.count() > 0) {
+                due = std::chrono::ceil<std::chrono::milliseconds>(left)
+                          .count();
+            }
+            ms = ms < 0 ? due : std::min(ms, due);
+        }
+        return static_cast<int>(std::min<long long>(ms, INT32_MAX));
+    }
+
+    std::size_t run_timers() {
+        std::size_t ran = 0;
+        const auto now = Clock::now();
+        while (!deadlines.empty() && deadlines.top().first <= now) {
+            auto [deadline, id] = deadlines.top();
+            deadlines.pop();
+            auto it = timers.find(id);
+            if (it == timers.end()) {
+                continue;
+            }
+            // Held here in case the callback cancels its own timer.
+            std::shared_ptr<Timer> timer = it->second;
+            if (timer->repeat) {
+                // Missed periods are skipped, not run back to back.
+                auto next = deadline + timer->period;
+                deadlines.emplace(next > now ? next : now + timer->period,
+                                  id);
+            } else {
+                timers.erase(it);
+            }
+            timer->callback();
+            ran++;
+        }
+        return ran;
+    }
+
+    std::size_t run_posted() {
+        if (!has_posted.load(std::memory_order_acquire)) {
+            return 0;
+        }
+        std::vector<std::function<void()>> batch;
+        {
+            std::lock_guard lock(posted_mutex);
+            batch.swap(posted);
+            has_posted.store(false, std::memory_order_release);
+        }
+        for (auto& fn : batch) {
+            fn();
+        }
+        return batch.size();
+    }
+};
+
+EventLoop::EventLoop() : internal_(new Internal()) {
+    internal_->epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    internal_->wakefd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = kWakeToken;
+    if (internal_->epfd < 0 || internal_->wakefd < 0 ||
+        ::epoll_ctl(internal_->epfd, EPOLL_CTL_ADD, internal_->wakefd, &ev) <
+            0) {
+        delete internal_;
+        throw std::runtime_error("Failed to create epoll event loop");
+    }
+}
+
+EventLoop::~EventLoop() { delete internal_; }
+
+NetStatus EventLoop::add_(int fd, IoEvent interest, Handler handler) {
+    if (fd < 0 || internal_->registrations.count(fd) != 0) {
+        return NetStatus::Error;
+    }
+    uint32_t generation = internal_->next_generation++;
+    epoll_event ev{};
+    ev.events = to_epoll(interest);
+    ev.data.u64 = (uint64_t(generation) << 32) | uint32_t(fd);
+    if (::epoll_ctl(internal_->epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        return NetStatus::Error;
+    }
+    internal_->registrations.emplace(
+        fd, std::make_unique<Internal::Registration>(
+                Internal::Registration{std::move(handler), generation}));
+    return NetStatus::Success;
+}
+
+NetStatus EventLoop::modify_(int fd, IoEvent interest) {
+    auto it = internal_->registrations.find(fd);
+    if (it == internal_->registrations.end()) {
+        return NetStatus::Error;
+    }
+    epoll_event ev{};
+    ev.events = to_epoll(interest);
+    ev.data.u64 = (uint64_t(it->second->generation) << 32) | uint32_t(fd);
+    if (::epoll_ctl(internal_->epfd, EPOLL_CTL_MOD, fd, &ev) < 0) {
+        return NetStatus::Error;
+    }
+    return NetStatus::Success;
+}
+
+NetStatus EventLoop::remove_(int fd) {
+    auto it = internal_->registrations.find(fd);
+    if (it == internal_->registrations.end()) {
+        return NetStatus::Error;
+    }
+    int result = ::epoll_ctl(internal_->epfd, EPOLL_CTL_DEL, fd, nullptr);
+    if (internal_->dispatching) {
+        internal_->retired.push_back(std::move(it->second));
+    }
+    internal_->registrations.erase(it);
+    return result < 0 ? NetStatus::Error : NetStatus::Success;
+}
+
+NetStatus EventLoop::add(TCPEndpoint& endpoint, IoEvent interest,
+                         Handler handler) {
+    if (endpoint.native_handle() < 0 ||
+        endpoint.set_nonblocking(true) != NetStatus::Success) {
+        return NetStatus::Error;
+    }
+    return add_(endpoint.native_handle(), interest, std::move(handler));
+}
+
+NetStatus EventLoop::add(UDPEndpoint& endpoint, IoEvent interest,
+                         Handler handler) {
+    if (endpoint.native_handle() < 0 ||
+        endpoint.set_nonblocking(true) != NetStatus::Success) {
+        return NetStatus::Error;
+    }
+    return add_(endpoint.native_handle(), interest, std::move(handler));
+}
+
+NetStatus EventLoop::modify(const TCPEndpoint& endpoint, IoEvent interest) {
+    return modify_(endpoint.native_handle(), interest);
+}
+
+NetStatus EventLoop::modify(const UDPEndpoint& endpoint, IoEvent interest) {
+    return modify_(endpoint.native_handle(), interest);
+}
+
+NetStatus EventLoop::remove(const TCPEndpoint& endpoint) {
+    return remove_(endpoint.native_handle());
+}
+
+NetStatus EventLoop::remove(const UDPEndpoint& endpoint) {
+    return remove_(endpoint.native_handle());
+}
+
+EventLoop::TimerId EventLoop::add_timer(Clock::duration delay,
+                                        std::function<void()> callback,
+                                        bool repeat) {
+    if (repeat && delay <= Clock::duration::zero()) {
+        throw std::invalid_argument("A repeating timer needs a period");
+    }
+    TimerId id = internal_->next_timer++;
+    internal_->timers.emplace(
+        id, std::make_shared<Internal::Timer>(
+                Internal::Timer{std::move(callback), delay, repeat}));
+    internal_->deadlines.emplace(Clock::now() + delay, id);
+    return id;
+}
+
+bool EventLoop::cancel_timer(TimerId id) {
+    return internal_->timers.erase(id) != 0;
+}
+
+void EventLoop::post(std::function<void()> fn) {
+    {
+        std::lock_guard lock(internal_->posted_mutex);
+        internal_->posted.push_back(std::move(fn));
+        internal_->has_posted.store(true, std::memory_order_release);
+    }
+    internal_->wake();
+}
+
+std::size_t EventLoop::run_once(std::chrono::milliseconds timeout) {
+    Internal& in = *internal_;
+    int n = ::epoll_wait(in.epfd, in.events.data(),
+                         static_cast<int>(in.events.size()),
+                         in.wait_ms(timeout));
+    if (n < 0) {
+        // EINTR, the timers and posted work are still due.
+        n = 0;
+    }
+
+    std::size_t ran = 0;
+    in.dispatching = true;
+    for (int i = 0; i < n; i++) {
+        const epoll_event& ev = in.events[i];
+        if (ev.data.u64 == kWakeToken) {
+            uint64_t count;
+            [[maybe_unused]] ssize_t r =
+                ::read(in.wakefd, &count, sizeof(count));
+            continue;
+        }
+        int fd = static_cast<int>(ev.data.u64 & 0xFFFFFFFF);
+        auto it = in.registrations.find(fd);
+        // Removed, or removed and the descriptor reused, earlier in the
+        // batch.
+        if (it == in.registrations.end() ||
+            it->second->generation != uint32_t(ev.data.u64 >> 32)) {
+            continue;
+        }
+        Internal::Registration* reg = it->second.get();
+        reg->handler(from_epoll(ev.events));
+        ran++;
+    }
+    in.dispatching = false;
+    in.retired.clear();
+    if (static_cast<std::size_t>(n) == in.events.size()) {
+        in.events.resize(2 * in.events.size());
+    }
+
+    ran += in.run_timers();
+    ran += in.run_posted();
+    return ran;
+}
+
+void EventLoop::run() {
+    while (!internal_->stopped.load(std::memory_order_acquire)) {
+        run_once(std::chrono::milliseconds(-1));
+    }
+    internal_->stopped.store(false, std::memory_order_release);
+}
+
+void EventLoop::stop() {
+    internal_->stopped.store(true, std::memory_order_release);
+    internal_->wake();
+}
+
+std::size_t EventLoop::size() const noexcept {
+    return internal_->registrations.size();
+}
+
+};  // namespace csics::io::net
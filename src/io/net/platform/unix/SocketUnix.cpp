@@ -0,0 +1,92 @@
+#include "SocketUnix.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace csics::io::net::detail {
+
+sockaddr_in to_sockaddr(const SockAddr& addr) noexcept {
+    sockaddr_in sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(addr.port());
+    auto bytes = addr.address().v4();
+    std::memcpy(&sa.sin_addr.s_addr, bytes.data(), bytes.size());
+    return sa;
+}
+
+SockAddr from_sockaddr(const sockaddr_in& addr) noexcept {
+    std::array<uint8_t, 4> bytes;
+    std::memcpy(bytes.data(), &addr.sin_addr.s_addr, bytes.size());
+    return SockAddr(IPAddress(bytes), ntohs(addr.sin_port));
+}
+
+int open_socket(int type, bool nonblocking) noexcept {
+    int flags = SOCK_CLOEXEC | (nonblocking ? SOCK_NONBLOCK : 0);
+    return ::socket(AF_INET, type | flags, 0);
+}
+
+bool set_nonblocking(int fd, bool nonblocking) noexcept {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return false;
+    }
+    flags = nonblocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    return ::fcntl(fd, F_SETFL, flags) == 0;
+}
+
+NetStatus bind_socket(int fd, const SockAddr& addr) noexcept {
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in sa = to_sockaddr(addr);
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&sa), sizeof(sa)) < 0) {
+        return NetStatus::Error;
+    }
+    return NetStatus::Success;
+}
+
+SockAddr local_address(int fd) noexcept {
+    sockaddr_in sa;
+    socklen_t len = sizeof(sa);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&sa), &len) < 0) {
+        return SockAddr();
+    }
+    return from_sockaddr(sa);
+}
+
+NetStatus status_from_errno(int err) noexcept {
+    switch (err) {
+        case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+            return NetStatus::Empty;
+        case ECONNRESET:
+        case EPIPE:
+        case ENOTCONN:
+            return NetStatus::Disconnected;
+        default:
+            return NetStatus::Error;
+    }
+}
+
+PollStatus poll_status(short revents) noexcept {
+    if (revents & (POLLERR | POLLNVAL)) {
+        return PollStatus::Error;
+    }
+    // Data left before a hang up is still read first.
+    if (revents & POLLIN) {
+        return PollStatus::Ready;
+    }
+    if (revents & POLLHUP) {
+        return PollStatus::Disconnected;
+    }
+    return PollStatus::Empty;
+}
+
+};  // namespace csics::io::net::detail
@@ -0,0 +1,24 @@
+#pragma once
+#include <netinet/in.h>
+
+#include <csics/io/net/NetTypes.hpp>
+
+namespace csics::io::net::detail {
+
+sockaddr_in to_sockaddr(const SockAddr& addr) noexcept;
+SockAddr from_sockaddr(const sockaddr_in& addr) noexcept;
+
+// Creates a socket of `type`, non-blocking and close-on-exec as asked.
+int open_socket(int type, bool nonblocking) noexcept;
+bool set_nonblocking(int fd, bool nonblocking) noexcept;
+NetStatus bind_socket(int fd, const SockAddr& addr) noexcept;
+SockAddr local_address(int fd) noexcept;
+
+// Maps the errno of a failed call: EAGAIN is Empty, a reset or closed
+// peer Disconnected, anything else Error.
+NetStatus status_from_errno(int err) noexcept;
+
+// For TCPEndpoint::poll, Ready when readable.
+PollStatus poll_status(short revents) noexcept;
+
+};  // namespace csics::io::net::detail
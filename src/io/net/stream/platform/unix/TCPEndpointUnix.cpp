@@ -1,15 +1,24 @@
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <cerrno>
 #include <csics/io/net/TCPEndpoint.hpp>
 
+#include "../../../platform/unix/SocketUnix.hpp"
+
 namespace csics::io::net {
 struct TCPEndpoint::Internal {
     int sockfd;
-    Internal() : sockfd(-1) {}
-    ~Internal() {
+    bool nonblocking;
+    Internal() : sockfd(-1), nonblocking(false) {}
+    ~Internal() { close(); }
+    void close() {
         if (sockfd != -1) {
-            close(sockfd);
+            ::close(sockfd);
+            sockfd = -1;
         }
     }
 };
@@ -36,9 +45,14 @@ NetResult TCPEndpoint::send(BufferView data) {
     if (internal_ == nullptr || internal_->sockfd == -1) {
         return NetResult{NetStatus::Error, 0};
     }
-    ssize_t bytesSent = ::send(internal_->sockfd, data.data(), data.size(), 0);
+    ssize_t bytesSent;
+    do {
+        // A closed peer is Disconnected, not SIGPIPE.
+        bytesSent = ::send(internal_->sockfd, data.data(), data.size(),
+                           MSG_NOSIGNAL);
+    } while (bytesSent < 0 && errno == EINTR);
     if (bytesSent < 0) {
-        return NetResult{NetStatus::Error, 0};
+        return NetResult{detail::status_from_errno(errno), 0};
     }
     return NetResult{NetStatus::Success,
                         static_cast<std::size_t>(bytesSent)};
@@ -48,19 +62,28 @@ NetStatus TCPEndpoint::connect_(SockAddr addr) {
     if (internal_ == nullptr) {
         return NetStatus::Error;
     }
+    internal_->close();
     // Create socket
-    internal_->sockfd = ::socket(AF_INET, SOCK_STREAM, 0);
+    internal_->sockfd =
+        detail::open_socket(SOCK_STREAM, internal_->nonblocking);
     if (internal_->sockfd < 0) {
         return NetStatus::Error;
     }
+    // Frames are small and latency bound.
+    int one = 1;
+    ::setsockopt(internal_->sockfd, IPPROTO_TCP, TCP_NODELAY, &one,
+                 sizeof(one));
 
     // Connect to the server
+    sockaddr_in sa = detail::to_sockaddr(addr);
     int result = ::connect(internal_->sockfd,
-                           reinterpret_cast<const struct sockaddr*>(&addr),
-                           sizeof(addr));
+                           reinterpret_cast<const struct sockaddr*>(&sa),
+                           sizeof(sa));
     if (result < 0) {
-        close(internal_->sockfd);
-        internal_->sockfd = -1;
+        if (errno == EINPROGRESS) {
+            return NetStatus::Empty;
+        }
+        internal_->close();
         return NetStatus::Error;
     }
 
@@ -71,14 +94,136 @@ NetResult TCPEndpoint::recv(BufferView buffer) {
     if (internal_ == nullptr || internal_->sockfd == -1) {
         return NetResult{NetStatus::Error, 0};
     }
-    ssize_t bytesReceived =
-        ::recv(internal_->sockfd, buffer.data(), buffer.size(), 0);
+    ssize_t bytesReceived;
+    do {
+        bytesReceived =
+            ::recv(internal_->sockfd, buffer.data(), buffer.size(), 0);
+    } while (bytesReceived < 0 && errno == EINTR);
     if (bytesReceived < 0) {
-        return NetResult{NetStatus::Error, 0};
+        return NetResult{detail::status_from_errno(errno), 0};
     } else if (bytesReceived == 0) {
         return NetResult{NetStatus::Disconnected, 0};
     }
     return NetResult{NetStatus::Success,
                         static_cast<std::size_t>(bytesReceived)};
 }
+
+NetStatus TCPEndpoint::listen(const SockAddr& addr, int backlog) {
+    if (internal_ == nullptr) {
+        return NetStatus::Error;
+    }
+    internal_->close();
+    internal_->sockfd =
+        detail::open_socket(SOCK_STREAM, internal_->nonblocking);
+    if (internal_->sockfd < 0) {
+        return NetStatus::Error;
+    }
+    if (detail::bind_socket(internal_->sockfd, addr) != NetStatus::Success ||
+        ::listen(internal_->sockfd, backlog) < 0) {
+        internal_->close();
+        return NetStatus::Error;
+    }
+    return NetStatus::Success;
+}
+
+NetStatus TCPEndpoint::accept(TCPEndpoint& connection) {
+    if (internal_ == nullptr || internal_->sockfd == -1 ||
+        connection.internal_ == nullptr) {
+        return NetStatus::Error;
+    }
+    int flags = SOCK_CLOEXEC | (internal_->nonblocking ? SOCK_NONBLOCK : 0);
+    int fd;
+    do {
+        fd = ::accept4(internal_->sockfd, nullptr, nullptr, flags);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        // A connection reset while pending is not the listener's fault.
+        if (errno == ECONNABORTED) {
+            return NetStatus::Empty;
+        }
+        NetStatus status = detail::status_from_errno(errno);
+        return status == NetStatus::Empty ? status : NetStatus::Error;
+    }
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    connection.internal_->close();
+    connection.internal_->sockfd = fd;
+    connection.internal_->nonblocking = internal_->nonblocking;
+    return NetStatus::Success;
+}
+
+NetStatus TCPEndpoint::set_nonblocking(bool nonblocking) {
+    if (internal_ == nullptr) {
+        return NetStatus::Error;
+    }
+    if (internal_->sockfd != -1 &&
+        !detail::set_nonblocking(internal_->sockfd, nonblocking)) {
+        return NetStatus::Error;
+    }
+    internal_->nonblocking = nonblocking;
+    return NetStatus::Success;
+}
+
+SockAddr TCPEndpoint::local_address() const {
+    if (internal_ == nullptr || internal_->sockfd == -1) {
+        return SockAddr();
+    }
+    return detail::local_address(internal_->sockfd);
+}
+
+int TCPEndpoint::native_handle() const noexcept {
+    return internal_ == nullptr ? -1 : internal_->sockfd;
+}
+
+void TCPEndpoint::close() {
+    if (internal_ != nullptr) {
+        internal_->close();
+    }
+}
+
+PollStatus TCPEndpoint::poll(const TCPEndpoint* endpoint, int timeoutMs) {
+    if (endpoint == nullptr || endpoint->native_handle() == -1) {
+        return PollStatus::Error;
+    }
+    pollfd pfd{endpoint->native_handle(), POLLIN, 0};
+    int result;
+    do {
+        result = ::poll(&pfd, 1, timeoutMs);
+    } while (result < 0 && errno == EINTR);
+    if (result < 0) {
+        return PollStatus::Error;
+    }
+    if (result == 0) {
+        return PollStatus::Timeout;
+    }
+    return detail::poll_status(pfd.revents);
+}
+
+std::vector<PollStatus> TCPEndpoint::poll(
+    const std::vector<TCPEndpoint*>& endpoints, int timeoutMs) {
+    std::vector<pollfd> pfds(endpoints.size());
+    for (std::size_t i = 0; i < endpoints.size(); i++) {
+        // poll() ignores negative descriptors, they are reported as Error.
+        int fd = endpoints[i] == nullptr ? -1 : endpoints[i]->native_handle();
+        pfds[i] = pollfd{fd, POLLIN, 0};
+    }
+    int result;
+    do {
+        result = ::poll(pfds.data(), pfds.size(), timeoutMs);
+    } while (result < 0 && errno == EINTR);
+
+    std::vector<PollStatus> statuses(endpoints.size(), PollStatus::Timeout);
+    if (result < 0) {
+        statuses.assign(endpoints.size(), PollStatus::Error);
+        return statuses;
+    }
+    for (std::size_t i = 0; i < endpoints.size(); i++) {
+        if (pfds[i].fd < 0) {
+            statuses[i] = PollStatus::Error;
+        } else if (result > 0) {
+            statuses[i] = detail::poll_status(pfds[i].revents);
+        }
+    }
+    return statuses;
+}
 };  // namespace csics::io::net
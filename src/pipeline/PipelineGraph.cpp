@@ -0,0 +1,576 @@
+#include <csics/pipeline/PipelineGraph.hpp>
+#include <csics/queue/SPSCQueue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include "../Counters.hpp"
+
+namespace csics::pipeline {
+
+using SteadyClock = std::chrono::steady_clock;
+
+struct alignas(queue::kCacheLineSize) StageCounters {
+    std::atomic<uint64_t> blocks_in{0};
+    std::atomic<uint64_t> blocks_out{0};
+    std::atomic<uint64_t> bytes_in{0};
+    std::atomic<uint64_t> bytes_out{0};
+    std::atomic<uint64_t> busy_ns{0};
+    std::atomic<uint64_t> max_latency_ns{0};
+    std::atomic<uint64_t> output_stalls{0};
+    std::atomic<uint64_t> input_starved{0};
+    std::atomic<uint64_t> involuntary_switches{0};
+    std::atomic<int64_t> start_ns{0};
+    std::atomic<int64_t> end_ns{0};
+
+    void reset() noexcept {
+        blocks_in.store(0, std::memory_order_relaxed);
+        blocks_out.store(0, std::memory_order_relaxed);
+        bytes_in.store(0, std::memory_order_relaxed);
+        bytes_out.store(0, std::memory_order_relaxed);
+        busy_ns.store(0, std::memory_order_relaxed);
+        max_latency_ns.store(0, std::memory_order_relaxed);
+        output_stalls.store(0, std::memory_order_relaxed);
+        input_starved.store(0, std::memory_order_relaxed);
+        involuntary_switches.store(0, std::memory_order_relaxed);
+        start_ns.store(0, std::memory_order_relaxed);
+        end_ns.store(0, std::memory_order_relaxed);
+    }
+
+    void record_latency(uint64_t ns) noexcept {
+        detail::counter_add(busy_ns, ns);
+        if (ns > max_latency_ns.load(std::memory_order_relaxed)) {
+            max_latency_ns.store(ns, std::memory_order_relaxed);
+        }
+    }
+};
+
+// One block owned by a parallel stage while a worker processes it.
+struct ReorderSlot : WorkStealingExecutor::Task {
+    IStage* stage;
+    Buffer<char, queue::kCacheLineSize> in;
+    Buffer<char, queue::kCacheLineSize> out;
+    std::size_t in_size = 0;
+    StageResult result{0, StageStatus::Ok};
+    uint64_t process_ns = 0;
+    std::atomic<bool> done{true};
+
+    ReorderSlot(IStage* stage, std::size_t in_block, std::size_t out_block)
+        : stage(stage), in(in_block), out(out_block) {
+        run = &ReorderSlot::execute;
+    }
+
+    static void execute(Task& task, std::size_t) noexcept {
+        auto& slot = static_cast<ReorderSlot&>(task);
+        BufferView out;
+        if (slot.out.size() != 0) {
+            out = BufferView(slot.out.data(), slot.out.size());
+        }
+        auto t0 = SteadyClock::now();
+        slot.result =
+            slot.stage->process(BufferView(slot.in.data(), slot.in_size), out);
+        slot.process_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                SteadyClock::now() - t0)
+                .count());
+        slot.done.store(true, std::memory_order_release);
+    }
+};
+
+struct PipelineGraph::Node {
+    std::unique_ptr<IStage> stage;
+    radio::IRadioRx* radio = nullptr;
+    radio::StreamConfiguration stream_config;
+    WorkStealingExecutor* executor = nullptr;
+    StageOptions options;
+
+    std::size_t out_block = 0;
+    std::unique_ptr<queue::SPSCQueue> out_queue;
+    std::optional<queue::SPSCQueue::ReadHandle> in;
+    std::optional<queue::SPSCQueue::WriteHandle> out;
+
+    std::thread thread;
+    std::atomic<int> tid{-1};
+    ThreadPolicyResult policy_result;
+    std::atomic<bool> done{false};
+    StageCounters counters;
+
+    // Called first and last on the stage thread.
+    void thread_started() noexcept {
+        tid.store(current_thread_id(), std::memory_order_release);
+    }
+    void thread_exiting() noexcept {
+        counters.involuntary_switches.store(
+            current_thread_stats().involuntary_switches,
+            std::memory_order_relaxed);
+        tid.store(-1, std::memory_order_release);
+    }
+};
+
+static int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               SteadyClock::now().time_since_epoch())
+        .count();
+}
+
+PipelineGraph::PipelineGraph() = default;
+
+PipelineGraph::~PipelineGraph() { stop(); }
+
+PipelineGraph::StageId PipelineGraph::add_source(
+    std::unique_ptr<IStage> stage, const StageOptions& options) {
+    if (!nodes_.empty()) {
+        throw std::logic_error("Pipeline already has a source");
+    }
+    auto node = std::make_unique<Node>();
+    node->stage = std::move(stage);
+    node->options = options;
+    nodes_.push_back(std::move(node));
+    return nodes_.size() - 1;
+}
+
+PipelineGraph::StageId PipelineGraph::add_source(
+    radio::IRadioRx& radio, const radio::StreamConfiguration& stream_config) {
+    if (!nodes_.empty()) {
+        throw std::logic_error("Pipeline already has a source");
+    }
+    auto node = std::make_unique<Node>();
+    node->radio = &radio;
+    node->stream_config = stream_config;
+    nodes_.push_back(std::move(node));
+    return nodes_.size() - 1;
+}
+
+PipelineGraph::StageId PipelineGraph::add_stage(std::unique_ptr<IStage> stage,
+                                                const StageOptions& options) {
+    if (nodes_.empty()) {
+        throw std::logic_error("Pipeline needs a source before other stages");
+    }
+    auto node = std::make_unique<Node>();
+    node->stage = std::move(stage);
+    node->options = options;
+    nodes_.push_back(std::move(node));
+    return nodes_.size() - 1;
+}
+
+PipelineGraph::StageId PipelineGraph::add_parallel_stage(
+    std::unique_ptr<IStage> stage, WorkStealingExecutor& executor,
+    const StageOptions& options) {
+    StageId id = add_stage(std::move(stage), options);
+    Node& node = *nodes_[id];
+    node.executor = &executor;
+    if (node.options.in_flight == 0) {
+        node.options.in_flight = 2 * executor.num_workers();
+    }
+    return id;
+}
+
+PipelineStatus PipelineGraph::start() {
+    if (running_) {
+        return PipelineStatus::AlreadyRunning;
+    }
+    if (nodes_.size() < 2) {
+        return PipelineStatus::InvalidGraph;
+    }
+
+    // Walk the chain once to size every queue from the block sizes.
+    std::size_t in_block = 0;
+    for (std::size_t i = 0; i < nodes_.size(); i++) {
+        Node& node = *nodes_[i];
+        if (node.radio != nullptr) {
+            node.out_block =
+                node.stream_config.sample_length.get_num_bytes(
+                    node.radio->get_sample_rate(),
+                    node.stream_config.data_type) +
+                sizeof(radio::IRadioRx::BlockHeader);
+        } else {
+            node.out_block = node.stage->output_block_size(in_block);
+        }
+        bool last = i + 1 == nodes_.size();
+        if (last != (node.out_block == 0)) {
+            return PipelineStatus::InvalidGraph;
+        }
+        in_block = node.out_block;
+    }
+
+    for (std::size_t i = 0; i < nodes_.size(); i++) {
+        Node& node = *nodes_[i];
+        node.in.reset();
+        node.out.reset();
+        node.done.store(false, std::memory_order_relaxed);
+        node.counters.reset();
+        node.policy_result = {};
+        if (node.radio == nullptr && node.out_block != 0) {
+            node.out_queue = std::make_unique<queue::SPSCQueue>(
+                queue::SPSCQueue::capacity_for(
+                    node.out_block, std::max<std::size_t>(
+                                        node.options.queue_depth, 1)));
+            node.out.emplace(node.out_queue->get_write_handle());
+        }
+    }
+    for (std::size_t i = 1; i < nodes_.size(); i++) {
+        if (nodes_[i - 1]->out_queue) {
+            nodes_[i]->in.emplace(nodes_[i - 1]->out_queue->get_read_handle());
+        }
+    }
+
+    Node& source = *nodes_.front();
+    if (source.radio != nullptr) {
+        auto status = source.radio->start_stream(source.stream_config);
+        if (!status || !status.rx_handle) {
+            return PipelineStatus::RadioFailure;
+        }
+        nodes_[1]->in.emplace(std::move(*status.rx_handle));
+        source.policy_result = status.thread_policy;
+        source.counters.start_ns.store(now_ns(), std::memory_order_relaxed);
+    }
+
+    stop_requested_.store(false, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+
+    // Consumers are started first so the source never races ahead of an
+    // idle chain.
+    for (std::size_t i = nodes_.size(); i-- > 1;) {
+        Node* downstream = i + 1 < nodes_.size() ? nodes_[i + 1].get() : nullptr;
+        auto run = nodes_[i]->executor != nullptr
+                       ? &PipelineGraph::run_parallel_stage
+                       : &PipelineGraph::run_stage;
+        nodes_[i]->thread = std::thread(run, this, std::ref(*nodes_[i]),
+                                        std::ref(*nodes_[i - 1]), downstream);
+        nodes_[i]->policy_result = apply_thread_policy(
+            nodes_[i]->thread, nodes_[i]->options.thread_policy);
+    }
+    if (source.radio == nullptr) {
+        source.thread = std::thread(&PipelineGraph::run_source, this,
+                                    std::ref(source), nodes_[1].get());
+        source.policy_result =
+            apply_thread_policy(source.thread, source.options.thread_policy);
+    }
+
+    running_ = true;
+    return PipelineStatus::Ok;
+}
+
+void PipelineGraph::stop() noexcept {
+    if (!running_) {
+        return;
+    }
+    stop_requested_.store(true, std::memory_order_release);
+    Node& source = *nodes_.front();
+    if (source.radio != nullptr) {
+        source.radio->stop_stream();
+        source.counters.end_ns.store(now_ns(), std::memory_order_relaxed);
+        source.done.store(true, std::memory_order_release);
+    }
+    join();
+}
+
+void PipelineGraph::wait() noexcept {
+    if (!running_) {
+        return;
+    }
+    join();
+    Node& source = *nodes_.front();
+    if (source.radio != nullptr) {
+        source.radio->stop_stream();
+    }
+}
+
+void PipelineGraph::join() noexcept {
+    for (auto& node : nodes_) {
+        if (node->thread.joinable()) {
+            node->thread.join();
+        }
+    }
+    running_ = false;
+}
+
+bool PipelineGraph::is_running() const noexcept { return running_; }
+
+bool PipelineGraph::failed() const noexcept {
+    return failed_.load(std::memory_order_acquire);
+}
+
+std::size_t PipelineGraph::size() const noexcept { return nodes_.size(); }
+
+StageStats PipelineGraph::stats(StageId id) const noexcept {
+    StageStats s{};
+    if (id >= nodes_.size()) {
+        return s;
+    }
+    const StageCounters& c = nodes_[id]->counters;
+    s.blocks_in = c.blocks_in.load(std::memory_order_relaxed);
+    s.blocks_out = c.blocks_out.load(std::memory_order_relaxed);
+    s.bytes_in = c.bytes_in.load(std::memory_order_relaxed);
+    s.bytes_out = c.bytes_out.load(std::memory_order_relaxed);
+    s.busy_ns = c.busy_ns.load(std::memory_order_relaxed);
+    s.max_latency_ns = c.max_latency_ns.load(std::memory_order_relaxed);
+    s.output_stalls = c.output_stalls.load(std::memory_order_relaxed);
+    s.input_starved = c.input_starved.load(std::memory_order_relaxed);
+    s.thread_policy = nodes_[id]->policy_result;
+    if (nodes_[id]->radio != nullptr) {
+        s.involuntary_switches =
+            nodes_[id]->radio->get_thread_stats().involuntary_switches;
+    } else {
+        ThreadStats ts =
+            thread_stats(nodes_[id]->tid.load(std::memory_order_acquire));
+        s.involuntary_switches =
+            ts.tid >= 0
+                ? ts.involuntary_switches
+                : c.involuntary_switches.load(std::memory_order_relaxed);
+    }
+    int64_t start = c.start_ns.load(std::memory_order_relaxed);
+    int64_t end = c.end_ns.load(std::memory_order_relaxed);
+    if (start != 0) {
+        s.elapsed = std::chrono::nanoseconds((end != 0 ? end : now_ns()) -
+                                             start);
+    }
+    return s;
+}
+
+std::size_t PipelineGraph::queue_capacity(StageId id) const noexcept {
+    if (id >= nodes_.size() || !nodes_[id]->out_queue) {
+        return 0;
+    }
+    return nodes_[id]->out_queue->capacity();
+}
+
+bool PipelineGraph::acquire_output(Node& node, Node* downstream,
+                                   queue::SPSCQueue::WriteSlot& slot,
+                                   bool is_source) noexcept {
+    while (true) {
+        auto err = node.out->acquire(slot, node.out_block);
+        if (err == queue::SPSCError::None) {
+            return true;
+        }
+        if (err != queue::SPSCError::Full) {
+            failed_.store(true, std::memory_order_release);
+            return false;
+        }
+        if (failed_.load(std::memory_order_acquire) ||
+            downstream->done.load(std::memory_order_acquire) ||
+            (is_source && stop_requested_.load(std::memory_order_acquire))) {
+            return false;
+        }
+        detail::counter_add(node.counters.output_stalls, 1);
+        std::this_thread::yield();
+    }
+}
+
+void PipelineGraph::run_source(Node& node, Node* downstream) noexcept {
+    node.thread_started();
+    StageCounters& c = node.counters;
+    c.start_ns.store(now_ns(), std::memory_order_relaxed);
+    node.stage->on_start();
+
+    while (!stop_requested_.load(std::memory_order_acquire) &&
+           !failed_.load(std::memory_order_acquire)) {
+        queue::SPSCQueue::WriteSlot slot{};
+        if (!acquire_output(node, downstream, slot, true)) {
+            break;
+        }
+
+        auto t0 = SteadyClock::now();
+        StageResult r = node.stage->process(BufferView(),
+                                            BufferView(slot.data, slot.size));
+        auto latency = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() -
+                                                                 t0)
+                .count());
+
+        if (r.status == StageStatus::Ok && r.output > 0) {
+            slot.size = std::min(r.output, slot.size);
+            detail::counter_add(c.bytes_out, slot.size);
+            node.out->commit(std::move(slot));
+            detail::counter_add(c.blocks_out, 1);
+            c.record_latency(latency);
+        } else if (r.status == StageStatus::Idle) {
+            std::this_thread::yield();
+        } else if (r.status == StageStatus::Finished) {
+            break;
+        } else if (r.status == StageStatus::Error) {
+            failed_.store(true, std::memory_order_release);
+            break;
+        }
+    }
+
+    node.stage->on_stop();
+    node.thread_exiting();
+    c.end_ns.store(now_ns(), std::memory_order_relaxed);
+    node.done.store(true, std::memory_order_release);
+}
+
+void PipelineGraph::run_stage(Node& node, Node& upstream,
+                              Node* downstream) noexcept {
+    node.thread_started();
+    StageCounters& c = node.counters;
+    c.start_ns.store(now_ns(), std::memory_order_relaxed);
+    node.stage->on_start();
+
+    while (!failed_.load(std::memory_order_acquire)) {
+        queue::SPSCQueue::ReadSlot in_slot{};
+        auto err = node.in->acquire(in_slot);
+        if (err != queue::SPSCError::None) {
+            // Check the flag before polling again, a block committed just
+            // before `done` was set must still be seen.
+            if (upstream.done.load(std::memory_order_acquire)) {
+                if (node.in->acquire(in_slot) != queue::SPSCError::None) {
+                    break;
+                }
+            } else {
+                detail::counter_add(c.input_starved, 1);
+                std::this_thread::yield();
+                continue;
+            }
+        }
+
+        queue::SPSCQueue::WriteSlot out_slot{};
+        BufferView out;
+        if (downstream != nullptr) {
+            if (!acquire_output(node, downstream, out_slot, false)) {
+                node.in->commit(std::move(in_slot));
+                break;
+            }
+            out = BufferView(out_slot.data, out_slot.size);
+        }
+
+        std::size_t in_size = in_slot.size;
+        auto t0 = SteadyClock::now();
+        StageResult r =
+            node.stage->process(BufferView(in_slot.data, in_size), out);
+        auto latency = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(SteadyClock::now() -
+                                                                 t0)
+                .count());
+        node.in->commit(std::move(in_slot));
+        detail::counter_add(c.blocks_in, 1);
+        detail::counter_add(c.bytes_in, in_size);
+        c.record_latency(latency);
+
+        if (r.status == StageStatus::Ok && downstream != nullptr &&
+            r.output > 0) {
+            out_slot.size = std::min(r.output, out_slot.size);
+            detail::counter_add(c.bytes_out, out_slot.size);
+            node.out->commit(std::move(out_slot));
+            detail::counter_add(c.blocks_out, 1);
+        } else if (r.status == StageStatus::Finished) {
+            break;
+        } else if (r.status == StageStatus::Error) {
+            failed_.store(true, std::memory_order_release);
+            break;
+        }
+    }
+
+    node.stage->on_stop();
+    node.thread_exiting();
+    c.end_ns.store(now_ns(), std::memory_order_relaxed);
+    node.done.store(true, std::memory_order_release);
+}
+
+void PipelineGraph::run_parallel_stage(Node& node, Node& upstream,
+                                       Node* downstream) noexcept {
+    node.thread_started();
+    StageCounters& c = node.counters;
+    c.start_ns.store(now_ns(), std::memory_order_relaxed);
+    node.stage->on_start();
+
+    const std::size_t slots = std::max<std::size_t>(node.options.in_flight, 1);
+    std::vector<std::unique_ptr<ReorderSlot>> ring;
+    ring.reserve(slots);
+    for (std::size_t i = 0; i < slots; i++) {
+        ring.push_back(std::make_unique<ReorderSlot>(
+            node.stage.get(), upstream.out_block, node.out_block));
+    }
+    auto submitter = node.executor->make_submitter(slots);
+    if (!submitter) {
+        failed_.store(true, std::memory_order_release);
+    }
+
+    // Blocks [head, tail) are with the executor, retired strictly in order.
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    bool input_done = false;
+    bool finishing = !submitter;
+
+    while (true) {
+        bool progressed = false;
+
+        while (head != tail) {
+            ReorderSlot& slot = *ring[head % slots];
+            if (!slot.done.load(std::memory_order_acquire)) {
+                break;
+            }
+            c.record_latency(slot.process_ns);
+            const StageResult& r = slot.result;
+            if (r.status == StageStatus::Ok && !finishing &&
+                downstream != nullptr && r.output > 0) {
+                queue::SPSCQueue::WriteSlot out_slot{};
+                if (acquire_output(node, downstream, out_slot, false)) {
+                    out_slot.size = std::min(r.output, out_slot.size);
+                    std::memcpy(out_slot.data, slot.out.data(), out_slot.size);
+                    detail::counter_add(c.bytes_out, out_slot.size);
+                    node.out->commit(std::move(out_slot));
+                    detail::counter_add(c.blocks_out, 1);
+                } else {
+                    finishing = true;
+                }
+            } else if (r.status == StageStatus::Finished) {
+                finishing = true;
+            } else if (r.status == StageStatus::Error) {
+                failed_.store(true, std::memory_order_release);
+                finishing = true;
+            }
+            head++;
+            progressed = true;
+        }
+
+        if (failed_.load(std::memory_order_acquire)) {
+            finishing = true;
+        }
+
+        if (!finishing && !input_done && tail - head < slots) {
+            bool upstream_done = upstream.done.load(std::memory_order_acquire);
+            queue::SPSCQueue::ReadSlot in_slot{};
+            if (node.in->acquire(in_slot) == queue::SPSCError::None) {
+                ReorderSlot& slot = *ring[tail % slots];
+                std::size_t in_size = std::min(in_slot.size, slot.in.size());
+                std::memcpy(slot.in.data(), in_slot.data, in_size);
+                slot.in_size = in_size;
+                node.in->commit(std::move(in_slot));
+                detail::counter_add(c.blocks_in, 1);
+                detail::counter_add(c.bytes_in, in_size);
+
+                slot.done.store(false, std::memory_order_relaxed);
+                while (submitter->submit(slot) != queue::DequeError::None) {
+                    std::this_thread::yield();
+                }
+                tail++;
+                progressed = true;
+            } else if (upstream_done) {
+                input_done = true;
+            } else {
+                detail::counter_add(c.input_starved, 1);
+            }
+        }
+
+        // Slots still with the executor must finish before the ring goes.
+        if ((finishing || input_done) && head == tail) {
+            break;
+        }
+        if (!progressed) {
+            std::this_thread::yield();
+        }
+    }
+
+    submitter.reset();
+    node.stage->on_stop();
+    node.thread_exiting();
+    c.end_ns.store(now_ns(), std::memory_order_relaxed);
+    node.done.store(true, std::memory_order_release);
+}
+
+};  // namespace csics::pipeline
@@ -0,0 +1,60 @@
+#include <csics/pipeline/Stages.hpp>
+
+#include <cmath>
+#include <numbers>
+
+namespace csics::pipeline {
+
+using BlockHeader = radio::IRadioRx::BlockHeader;
+
+SyntheticSource::SyntheticSource(const Config& config)
+    : config_(config), produced_(0), phase_(0.0), start_ns_(0) {}
+
+std::size_t SyntheticSource::output_block_size(std::size_t) const noexcept {
+    return sizeof(BlockHeader) +
+           config_.block_len * sizeof(radio::SDRRawSample);
+}
+
+void SyntheticSource::on_start() noexcept {
+    produced_ = 0;
+    phase_ = 0.0;
+    start_ns_ = radio::Timestamp::now();
+}
+
+StageResult SyntheticSource::process(BufferView, BufferView out) noexcept {
+    if (config_.num_blocks != 0 && produced_ >= config_.num_blocks) {
+        return {0, StageStatus::Finished};
+    }
+    std::size_t size = output_block_size(0);
+    if (out.size() < size) {
+        return {0, StageStatus::Error};
+    }
+
+    auto* hdr = reinterpret_cast<BlockHeader*>(out.data());
+    auto* samples =
+        reinterpret_cast<radio::SDRRawSample*>(out.data() + sizeof(BlockHeader));
+
+    uint64_t sample_index =
+        static_cast<uint64_t>(produced_) * config_.block_len;
+    hdr->timestamp_ns = radio::Timestamp(
+        start_ns_ + static_cast<uint64_t>(sample_index * 1e9 /
+                                          config_.sample_rate));
+    hdr->num_samples = config_.block_len;
+    hdr->flags = radio::IRadioRx::BlockFlags::NONE;
+    hdr->reserved = 0;
+
+    const double step =
+        2.0 * std::numbers::pi * config_.tone_frequency / config_.sample_rate;
+    for (std::size_t i = 0; i < config_.block_len; i++) {
+        samples[i] = radio::SDRRawSample(
+            static_cast<int16_t>(config_.amplitude * std::cos(phase_)),
+            static_cast<int16_t>(config_.amplitude * std::sin(phase_)));
+        phase_ += step;
+    }
+    phase_ = std::fmod(phase_, 2.0 * std::numbers::pi);
+
+    produced_++;
+    return {size, StageStatus::Ok};
+}
+
+};  // namespace csics::pipeline
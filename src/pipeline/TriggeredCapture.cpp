@@ -0,0 +1,259 @@
+#include <csics/pipeline/TriggeredCapture.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "../Counters.hpp"
+
+namespace csics::pipeline {
+
+using BlockHeader = radio::IRadioRx::BlockHeader;
+using BlockFlags = radio::IRadioRx::BlockFlags;
+using radio::SDRRawSample;
+
+TriggeredCapture::TriggeredCapture(const Config& config)
+    : config_(config),
+      mask_(0),
+      threshold_sq_(config.amplitude_threshold > 0
+                        ? std::llround(config.amplitude_threshold *
+                                       config.amplitude_threshold)
+                        : 0) {
+    if (config.post_trigger == 0) {
+        throw std::invalid_argument(
+            "TriggeredCapture post_trigger must include the trigger sample");
+    }
+    on_start();
+}
+
+void TriggeredCapture::on_start() noexcept {
+    anchored_ = false;
+    base_ns_ = 0;
+    next_index_ = 0;
+    scan_index_ = 0;
+    holdoff_index_ = 0;
+    gap_begin_ = 0;
+    gap_end_ = 0;
+    deferred_zeros_ = 0;
+    pending_ = false;
+    trigger_index_ = 0;
+    source_ = CaptureHeader::Source::POWER;
+    captures_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+}
+
+void TriggeredCapture::trigger_at(radio::Timestamp timestamp_ns) noexcept {
+    external_ns_.store(timestamp_ns, std::memory_order_release);
+}
+
+std::size_t TriggeredCapture::output_block_size(std::size_t) const noexcept {
+    return sizeof(CaptureHeader) +
+           (config_.pre_trigger + config_.post_trigger) * sizeof(SDRRawSample);
+}
+
+int64_t TriggeredCapture::index_of(uint64_t timestamp_ns) const noexcept {
+    auto offset = static_cast<int64_t>(timestamp_ns - base_ns_);
+    return std::llround(static_cast<double>(offset) * config_.sample_rate /
+                        1e9);
+}
+
+int64_t TriggeredCapture::history_begin() const noexcept {
+    return std::max<int64_t>(0,
+                             next_index_ - static_cast<int64_t>(ring_.size()));
+}
+
+// Copies a block into the ring, the only copy made of samples that never
+// become part of a capture.
+bool TriggeredCapture::ingest(BufferView in) noexcept {
+    if (in.size() < sizeof(BlockHeader)) {
+        return true;
+    }
+    const auto* hdr = reinterpret_cast<const BlockHeader*>(in.data());
+    const auto* samples =
+        reinterpret_cast<const SDRRawSample*>(in.data() + sizeof(BlockHeader));
+    const bool gap = hdr->has(BlockFlags::GAP);
+    if (!anchored_) {
+        if (gap) {
+            return true;
+        }
+        base_ns_ = hdr->timestamp_ns;
+        anchored_ = true;
+    }
+    const std::size_t n =
+        gap ? 0
+            : std::min<std::size_t>(hdr->num_samples,
+                                    (in.size() - sizeof(BlockHeader)) /
+                                        sizeof(SDRRawSample));
+
+    // Room for the window plus two blocks, so a window completed by one
+    // block survives until the next call emits it.
+    std::size_t needed =
+        config_.pre_trigger + config_.post_trigger + 2 * std::max<std::size_t>(n, 1);
+    if (ring_.size() < needed) {
+        std::vector<SDRRawSample> ring;
+        try {
+            ring.resize(std::bit_ceil(needed));
+        } catch (...) {
+            return false;
+        }
+        std::size_t mask = ring.size() - 1;
+        for (int64_t i = history_begin(); i < next_index_; i++) {
+            ring[i & mask] = ring_[i & mask_];
+        }
+        ring_.swap(ring);
+        mask_ = mask;
+    }
+
+    if (gap) {
+        auto lost = static_cast<int64_t>(hdr->num_samples);
+        if (pending_) {
+            // The whole gap could push the pending window out of the ring.
+            // Only fill up to its end, the rest follows once it is emitted.
+            const int64_t window_end =
+                trigger_index_ + static_cast<int64_t>(config_.post_trigger);
+            const int64_t now =
+                std::clamp<int64_t>(window_end - next_index_, 0, lost);
+            deferred_zeros_ = lost - now;
+            lost = now;
+        }
+        zero_fill(lost);
+        return true;
+    }
+
+    std::size_t pos = static_cast<std::size_t>(next_index_) & mask_;
+    std::size_t first = std::min(n, ring_.size() - pos);
+    std::memcpy(ring_.data() + pos, samples, first * sizeof(SDRRawSample));
+    std::memcpy(ring_.data(), samples + first,
+                (n - first) * sizeof(SDRRawSample));
+    next_index_ += static_cast<int64_t>(n);
+    return true;
+}
+
+void TriggeredCapture::zero_fill(int64_t lost) noexcept {
+    if (lost <= 0) {
+        return;
+    }
+    // Merged with the previous gap while it is still in the history.
+    if (gap_end_ <= history_begin()) {
+        gap_begin_ = next_index_;
+    }
+    gap_end_ = next_index_ + lost;
+    int64_t zeros = std::min<int64_t>(lost, ring_.size());
+    for (int64_t i = gap_end_ - zeros; i < gap_end_; i++) {
+        ring_[i & mask_] = SDRRawSample{};
+    }
+    next_index_ = gap_end_;
+}
+
+// Looks for the next trigger after the last window.
+void TriggeredCapture::scan() noexcept {
+    if (pending_ || !anchored_) {
+        return;
+    }
+    int64_t found = -1;
+    auto source = CaptureHeader::Source::POWER;
+
+    if (threshold_sq_ > 0) {
+        int64_t i = std::max(scan_index_, holdoff_index_);
+        for (; i < next_index_; i++) {
+            const SDRRawSample s = ring_[i & mask_];
+            const int64_t re = s.real();
+            const int64_t im = s.imag();
+            if (re * re + im * im >= threshold_sq_) {
+                found = i;
+                break;
+            }
+        }
+        scan_index_ = i;
+    }
+
+    uint64_t ext = external_ns_.load(std::memory_order_acquire);
+    if (ext != 0) {
+        int64_t idx = index_of(ext);
+        if (idx < std::max(holdoff_index_, history_begin())) {
+            external_ns_.compare_exchange_strong(ext, 0);
+        } else if (idx < next_index_ && (found < 0 || idx < found)) {
+            found = idx;
+            source = CaptureHeader::Source::EXTERNAL;
+            external_ns_.compare_exchange_strong(ext, 0);
+        }
+    }
+
+    if (found >= 0) {
+        pending_ = true;
+        trigger_index_ = found;
+        source_ = source;
+        holdoff_index_ = found + static_cast<int64_t>(config_.post_trigger);
+    }
+}
+
+std::size_t TriggeredCapture::emit(BufferView out) noexcept {
+    const int64_t end =
+        trigger_index_ + static_cast<int64_t>(config_.post_trigger);
+    if (!pending_ || next_index_ < end) {
+        return 0;
+    }
+    const int64_t wanted =
+        trigger_index_ - static_cast<int64_t>(config_.pre_trigger);
+    const int64_t begin = std::max(wanted, history_begin());
+    pending_ = false;
+    // The trigger sample itself has left the history, nothing to anchor the
+    // window on.
+    if (begin > trigger_index_ || trigger_index_ >= end) {
+        detail::counter_add(dropped_, 1);
+        return 0;
+    }
+    const auto n = static_cast<std::size_t>(end - begin);
+    const std::size_t size = sizeof(CaptureHeader) + n * sizeof(SDRRawSample);
+    if (out.size() < size) {
+        detail::counter_add(dropped_, 1);
+        return 0;
+    }
+
+    auto* hdr = reinterpret_cast<CaptureHeader*>(out.data());
+    auto* samples =
+        reinterpret_cast<SDRRawSample*>(out.data() + sizeof(CaptureHeader));
+    hdr->timestamp_ns = radio::Timestamp(
+        base_ns_ + static_cast<uint64_t>(std::llround(
+                       static_cast<double>(begin) * 1e9 / config_.sample_rate)));
+    hdr->num_samples = n;
+    hdr->first_index = static_cast<uint64_t>(begin);
+    hdr->trigger_offset = static_cast<uint64_t>(trigger_index_ - begin);
+    uint32_t flags = 0;
+    if (begin > wanted) {
+        flags |= static_cast<uint32_t>(BlockFlags::PARTIAL);
+    }
+    if (gap_end_ > begin && gap_begin_ < end) {
+        flags |= static_cast<uint32_t>(BlockFlags::ZERO_FILLED);
+    }
+    hdr->flags = static_cast<BlockFlags>(flags);
+    hdr->source = source_;
+
+    std::size_t pos = static_cast<std::size_t>(begin) & mask_;
+    std::size_t first = std::min(n, ring_.size() - pos);
+    std::memcpy(samples, ring_.data() + pos, first * sizeof(SDRRawSample));
+    std::memcpy(samples + first, ring_.data(),
+                (n - first) * sizeof(SDRRawSample));
+    detail::counter_add(captures_, 1);
+    return size;
+}
+
+StageResult TriggeredCapture::process(BufferView in, BufferView out) noexcept {
+    if (!ingest(in)) {
+        return {0, StageStatus::Error};
+    }
+    std::size_t written = emit(out);
+    if (deferred_zeros_ != 0) {
+        zero_fill(deferred_zeros_);
+        deferred_zeros_ = 0;
+    }
+    scan();
+    if (written == 0) {
+        written = emit(out);
+    }
+    return {written, StageStatus::Ok};
+}
+
+};  // namespace csics::pipeline
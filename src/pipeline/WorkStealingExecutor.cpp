@@ -0,0 +1,222 @@
+#include <csics/pipeline/WorkStealingExecutor.hpp>
+
+#include <algorithm>
+
+#include "../Counters.hpp"
+
+namespace csics::pipeline {
+
+using queue::DequeError;
+
+// Spins before a worker parks. Short, parking is only for real idleness.
+constexpr uint32_t kSpinLimit = 64;
+
+static thread_local WorkStealingExecutor* tls_executor = nullptr;
+static thread_local std::size_t tls_worker = 0;
+
+struct alignas(queue::kCacheLineSize) WorkStealingExecutor::Worker {
+    queue::ChaseLevDeque<Task*> deque;
+    std::thread thread;
+    ThreadPolicyResult policy_result;
+    std::atomic<int> tid{-1};
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> stolen{0};
+    std::atomic<uint64_t> parked{0};
+    std::atomic<uint64_t> involuntary_switches{0};
+
+    explicit Worker(std::size_t capacity) : deque(capacity) {}
+};
+
+WorkStealingExecutor::Submitter::Submitter(WorkStealingExecutor& executor,
+                                           std::size_t slot,
+                                           std::size_t capacity)
+    : executor_(executor), slot_(slot), deque_(capacity) {}
+
+WorkStealingExecutor::Submitter::~Submitter() {
+    executor_.submitters_[slot_].store(nullptr, std::memory_order_seq_cst);
+    auto& users = executor_.slot_users_[slot_];
+    while (users.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    executor_.claimed_[slot_].store(false, std::memory_order_release);
+}
+
+DequeError WorkStealingExecutor::Submitter::submit(Task& task) noexcept {
+    DequeError err = deque_.push(&task);
+    if (err == DequeError::None) {
+        executor_.wake();
+    }
+    return err;
+}
+
+WorkStealingExecutor::WorkStealingExecutor(std::size_t num_workers,
+                                           std::size_t deque_capacity,
+                                           const ThreadPolicy& policy)
+    : stop_(false), epoch_(0), sleepers_(0) {
+    if (num_workers == 0) {
+        num_workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (auto& s : submitters_) {
+        s.store(nullptr, std::memory_order_relaxed);
+    }
+    for (auto& u : slot_users_) {
+        u.store(0, std::memory_order_relaxed);
+    }
+    for (auto& c : claimed_) {
+        c.store(false, std::memory_order_relaxed);
+    }
+    workers_.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; i++) {
+        workers_.push_back(std::make_unique<Worker>(deque_capacity));
+    }
+    // Start threads only once every deque exists, workers steal from all.
+    ThreadPolicy worker_policy = policy;
+    for (std::size_t i = 0; i < num_workers; i++) {
+        Worker& w = *workers_[i];
+        w.thread = std::thread(&WorkStealingExecutor::worker_loop, this, i);
+        if (!policy.cpus.empty()) {
+            worker_policy.cpus = {policy.cpus[i % policy.cpus.size()]};
+        }
+        w.policy_result = apply_thread_policy(w.thread, worker_policy);
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    stop_.store(true, std::memory_order_seq_cst);
+    epoch_.fetch_add(1, std::memory_order_release);
+    epoch_.notify_all();
+    for (auto& w : workers_) {
+        if (w->thread.joinable()) {
+            w->thread.join();
+        }
+    }
+}
+
+std::unique_ptr<WorkStealingExecutor::Submitter>
+WorkStealingExecutor::make_submitter(std::size_t capacity) {
+    for (std::size_t i = 0; i < kMaxSubmitters; i++) {
+        if (claimed_[i].exchange(true, std::memory_order_acq_rel)) {
+            continue;
+        }
+        std::unique_ptr<Submitter> submitter(new Submitter(*this, i, capacity));
+        submitters_[i].store(submitter.get(), std::memory_order_release);
+        return submitter;
+    }
+    return nullptr;
+}
+
+DequeError WorkStealingExecutor::spawn(Task& task) noexcept {
+    if (tls_executor != this) {
+        return DequeError::Full;
+    }
+    DequeError err = workers_[tls_worker]->deque.push(&task);
+    if (err == DequeError::None) {
+        wake();
+    }
+    return err;
+}
+
+WorkStealingExecutor::WorkerStats WorkStealingExecutor::stats(
+    std::size_t worker) const noexcept {
+    WorkerStats s{};
+    if (worker >= workers_.size()) {
+        return s;
+    }
+    const Worker& w = *workers_[worker];
+    s.executed = w.executed.load(std::memory_order_relaxed);
+    s.stolen = w.stolen.load(std::memory_order_relaxed);
+    s.parked = w.parked.load(std::memory_order_relaxed);
+    s.thread_policy = w.policy_result;
+    ThreadStats ts = thread_stats(w.tid.load(std::memory_order_acquire));
+    s.involuntary_switches =
+        ts.tid >= 0 ? ts.involuntary_switches
+                    : w.involuntary_switches.load(std::memory_order_relaxed);
+    return s;
+}
+
+void WorkStealingExecutor::wake() noexcept {
+    // Pairs with the sleepers_ increment in worker_loop: either the worker
+    // sees the new task on its last check, or we see it as a sleeper.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) != 0) {
+        epoch_.fetch_add(1, std::memory_order_release);
+        epoch_.notify_one();
+    }
+}
+
+bool WorkStealingExecutor::find_task(std::size_t id, Task*& task) noexcept {
+    Worker& self = *workers_[id];
+    if (self.deque.pop(task) == DequeError::None) {
+        return true;
+    }
+
+    // Submitted work first, it is what keeps the pipeline moving.
+    for (std::size_t k = 0; k < kMaxSubmitters; k++) {
+        std::size_t i = (id + k) % kMaxSubmitters;
+        if (submitters_[i].load(std::memory_order_relaxed) == nullptr) {
+            continue;
+        }
+        slot_users_[i].fetch_add(1, std::memory_order_seq_cst);
+        Submitter* s = submitters_[i].load(std::memory_order_seq_cst);
+        bool found = s != nullptr && s->deque_.steal(task) == DequeError::None;
+        slot_users_[i].fetch_sub(1, std::memory_order_release);
+        if (found) {
+            return true;
+        }
+    }
+
+    const std::size_t n = workers_.size();
+    for (std::size_t k = 1; k < n; k++) {
+        Worker& victim = *workers_[(id + k) % n];
+        if (victim.deque.steal(task) == DequeError::None) {
+            detail::counter_add(self.stolen, 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingExecutor::worker_loop(std::size_t id) noexcept {
+    Worker& self = *workers_[id];
+    self.tid.store(current_thread_id(), std::memory_order_release);
+    tls_executor = this;
+    tls_worker = id;
+
+    uint32_t spins = 0;
+    Task* task = nullptr;
+    while (!stop_.load(std::memory_order_acquire)) {
+        if (find_task(id, task)) {
+            task->run(*task, id);
+            detail::counter_add(self.executed, 1);
+            spins = 0;
+            continue;
+        }
+        if (++spins < kSpinLimit) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32_t seen = epoch_.load(std::memory_order_acquire);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        if (find_task(id, task)) {
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            task->run(*task, id);
+            detail::counter_add(self.executed, 1);
+            spins = 0;
+            continue;
+        }
+        if (!stop_.load(std::memory_order_seq_cst)) {
+            detail::counter_add(self.parked, 1);
+            epoch_.wait(seen, std::memory_order_acquire);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        spins = 0;
+    }
+
+    tls_executor = nullptr;
+    self.involuntary_switches.store(
+        current_thread_stats().involuntary_switches, std::memory_order_relaxed);
+    self.tid.store(-1, std::memory_order_release);
+}
+
+};  // namespace csics::pipeline
@@ -90,9 +90,15 @@ SPSCError SPSCQueue::acquire_read(ReadSlot& slot) noexcept {
         reinterpret_cast<QueueSlotHeader*>(&buffer_[mod_index]);
 
     if (hdr->padded) {
+        const std::size_t next_index =
+            read_index + hdr->size + sizeof(QueueSlotHeader);
+        read_index_.store(next_index, std::memory_order_release);
+        // The padding is published at acquire time, the wrapped slot only on
+        // commit. Until then the header at 0 is stale.
+        if (next_index == write_index) {
+            return SPSCError::Empty;
+        }
         mod_index = 0;
-        read_index_.fetch_add(hdr->size + sizeof(QueueSlotHeader),
-                              std::memory_order_release);
         hdr = reinterpret_cast<QueueSlotHeader*>(&buffer_[mod_index]);
     }
     slot.size = hdr->size;
@@ -101,6 +107,12 @@ SPSCError SPSCQueue::acquire_read(ReadSlot& slot) noexcept {
 }
 
 void SPSCQueue::commit_write(WriteSlot&& slot) noexcept {
+    // The slot may have been shrunk since it was acquired, the reader takes
+    // the size from the header.
+    QueueSlotHeader hdr{};
+    hdr.size = slot.size;
+    std::memcpy(slot.data - sizeof(QueueSlotHeader), &hdr,
+                sizeof(QueueSlotHeader));
     auto new_index = write_index_.load(std::memory_order_acquire) + slot.size +
                      sizeof(QueueSlotHeader);
     new_index = (new_index + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
@@ -0,0 +1,234 @@
+#include <csics/radio/DeviceCache.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace csics::radio {
+
+// Bumped whenever the line format changes, older files are ignored.
+constexpr const char* kCacheHeader = "csics-device-cache 2";
+
+// Fields are whitespace separated. Whitespace, control characters and '%'
+// are percent-encoded, and "-" stands for an empty field.
+static std::string escape(const std::string& s) {
+    if (s.empty()) {
+        return "-";
+    }
+    if (s == "-") {
+        return "%2D";
+    }
+    std::string out;
+    out.reserve(s.size());
+    for (char c : s) {
+        auto u = static_cast<unsigned char>(c);
+        if (u <= ' ' || u == '%' || u == 0x7F) {
+            char hex[4];
+            std::snprintf(hex, sizeof(hex), "%%%02X", u);
+            out += hex;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static bool unescape(std::string& s) {
+    if (s == "-") {
+        s.clear();
+        return true;
+    }
+    std::string out;
+    out.reserve(s.size());
+    for (std::size_t i = 0; i < s.size(); i++) {
+        if (s[i] != '%') {
+            out += s[i];
+            continue;
+        }
+        int hi = i + 2 < s.size() ? hex_value(s[i + 1]) : -1;
+        int lo = hi < 0 ? -1 : hex_value(s[i + 2]);
+        if (lo < 0) {
+            return false;
+        }
+        out += static_cast<char>(hi * 16 + lo);
+        i += 2;
+    }
+    s = std::move(out);
+    return true;
+}
+
+// Unique per process and per save, so concurrent writers never share one.
+static std::string temp_path(const std::string& path) {
+    static std::atomic<uint64_t> counter{0};
+    long pid = 0;
+#if defined(__unix__) || defined(__APPLE__)
+    pid = static_cast<long>(::getpid());
+#endif
+    return path + ".tmp." + std::to_string(pid) + '.' +
+           std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+}
+
+static void write_info(std::ostream& os, const RadioDeviceInfo& info) {
+    os << ' ' << info.frequency_range.min << ' ' << info.frequency_range.max
+       << ' ' << info.sample_rate_range.min << ' '
+       << info.sample_rate_range.max << ' ' << info.max_gain;
+}
+
+static bool read_info(std::istream& is, RadioDeviceInfo& info) {
+    return static_cast<bool>(
+        is >> info.frequency_range.min >> info.frequency_range.max >>
+        info.sample_rate_range.min >> info.sample_rate_range.max >>
+        info.max_gain);
+}
+
+DeviceCache::DeviceCache(std::string path) : path_(std::move(path)) {
+    load();
+}
+
+DeviceCache& DeviceCache::instance() {
+    static DeviceCache cache(default_path());
+    return cache;
+}
+
+std::string DeviceCache::default_path() {
+    if (const char* p = std::getenv("CSICS_DEVICE_CACHE"); p != nullptr) {
+        return p;
+    }
+    if (const char* p = std::getenv("XDG_CACHE_HOME");
+        p != nullptr && *p != '\0') {
+        return std::string(p) + "/csics/devices";
+    }
+    if (const char* p = std::getenv("HOME"); p != nullptr && *p != '\0') {
+        return std::string(p) + "/.cache/csics/devices";
+    }
+    return {};
+}
+
+std::optional<std::vector<std::string>> DeviceCache::discovered(
+    const std::string& hint, std::chrono::milliseconds max_age) const {
+    std::lock_guard lock(mutex_);
+    auto it = discoveries_.find(hint);
+    if (it == discoveries_.end() || Clock::now() - it->second.time > max_age) {
+        return std::nullopt;
+    }
+    return it->second.addresses;
+}
+
+void DeviceCache::store_discovery(const std::string& hint,
+                                  std::vector<std::string> addresses) {
+    std::lock_guard lock(mutex_);
+    discoveries_[hint] = {Clock::now(), std::move(addresses)};
+}
+
+void DeviceCache::invalidate_discovery() {
+    std::lock_guard lock(mutex_);
+    discoveries_.clear();
+}
+
+std::optional<DeviceProfile> DeviceCache::profile(
+    const std::string& serial) const {
+    std::lock_guard lock(mutex_);
+    auto it = profiles_.find(serial);
+    if (it == profiles_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+bool DeviceCache::store_profile(const DeviceProfile& profile) {
+    std::lock_guard lock(mutex_);
+    profiles_[profile.serial] = profile;
+    return save();
+}
+
+void DeviceCache::load() {
+    if (path_.empty()) {
+        return;
+    }
+    std::ifstream in(path_);
+    std::string line;
+    if (!std::getline(in, line) || line != kCacheHeader) {
+        return;
+    }
+    while (std::getline(in, line)) {
+        std::istringstream is(line);
+        DeviceProfile p;
+        std::size_t num_clocks = 0;
+        if (!(is >> p.serial >> p.product) || !unescape(p.serial) ||
+            !unescape(p.product) || !read_info(is, p.rx_info) ||
+            !read_info(is, p.tx_info) || !(is >> num_clocks)) {
+            continue;
+        }
+        double clock = 0;
+        while (p.master_clocks.size() < num_clocks && is >> clock) {
+            p.master_clocks.push_back(clock);
+        }
+        if (p.master_clocks.size() == num_clocks && !p.serial.empty()) {
+            // Profiles already in memory are newer than the file.
+            profiles_.try_emplace(p.serial, std::move(p));
+        }
+    }
+}
+
+bool DeviceCache::save() {
+    if (path_.empty()) {
+        return true;
+    }
+    // Other processes may have stored profiles since this one loaded.
+    load();
+    std::error_code ec;
+    std::filesystem::path path(path_);
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    // Written aside and renamed, so concurrent processes never read a
+    // partial file.
+    std::string tmp = temp_path(path_);
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        out.precision(std::numeric_limits<double>::max_digits10);
+        out << kCacheHeader << '\n';
+        for (const auto& [serial, p] : profiles_) {
+            out << escape(p.serial) << ' ' << escape(p.product);
+            write_info(out, p.rx_info);
+            write_info(out, p.tx_info);
+            out << ' ' << p.master_clocks.size();
+            for (double clock : p.master_clocks) {
+                out << ' ' << clock;
+            }
+            out << '\n';
+        }
+        if (!out.flush()) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::error_code ignored;
+        std::filesystem::remove(tmp, ignored);
+        return false;
+    }
+    return true;
+}
+
+};  // namespace csics::radio
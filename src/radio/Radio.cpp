@@ -5,6 +5,13 @@ namespace csics::radio {
 RadioDeviceArgs::RadioDeviceArgs()
     : device_type(DeviceType::DEFAULT), args(std::monostate{}) {}
 
+NullDeviceArgs::operator RadioDeviceArgs() const {
+    RadioDeviceArgs args;
+    args.device_type = DeviceType::NULL_DEVICE;
+    args.args = *this;
+    return args;
+}
+
 #ifdef CSICS_USE_UHD
 UsrpArgs::operator RadioDeviceArgs() const {
     RadioDeviceArgs args;
@@ -0,0 +1,313 @@
+#include <csics/radio/RadioAggregator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "../Counters.hpp"
+
+namespace csics::radio {
+
+// Staging per channel, in output blocks. Lets a radio run ahead of the
+// others by a few blocks without stalling its queue.
+constexpr std::size_t kStagingBlocks = 4;
+
+struct RadioAggregator::Channel {
+    std::optional<queue::SPSCQueue::ReadHandle> handle;
+    std::vector<SDRRawSample> buf;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    // Index of buf[begin], relative to epoch_ns_.
+    int64_t index = 0;
+    // Samples of the queue's head block already staged.
+    std::size_t consumed = 0;
+    // Samples of a gap still to be zero-filled.
+    uint64_t pending_zeros = 0;
+    // Zero-filled samples not yet merged, flags the blocks overlapping it.
+    int64_t gap_begin = 0;
+    int64_t gap_end = 0;
+    bool has_first = false;
+    uint64_t first_ns = 0;
+
+    std::size_t staged() const noexcept { return end - begin; }
+};
+
+RadioAggregator::RadioAggregator(
+    std::vector<std::unique_ptr<IRadioRx>> radios)
+    : radios_(std::move(radios)) {}
+
+RadioAggregator::~RadioAggregator() { stop(); }
+
+RadioAggregator::StartStatus RadioAggregator::start(
+    const Config& config) noexcept {
+    using Code = StartStatus::Code;
+    stop();
+
+    if (radios_.empty()) {
+        return {Code::CONFIGURATION_ERROR, std::nullopt};
+    }
+    sample_rate_ = radios_[0]->get_sample_rate();
+    for (std::size_t i = 1; i < radios_.size(); i++) {
+        if (std::abs(radios_[i]->get_sample_rate() - sample_rate_) >
+            1e-9 * sample_rate_) {
+            return {Code::CONFIGURATION_ERROR, std::nullopt, i};
+        }
+    }
+    block_len_ = config.stream.sample_length.get_num_samples(sample_rate_);
+    if (block_len_ == 0 || sample_rate_ <= 0) {
+        return {Code::CONFIGURATION_ERROR, std::nullopt};
+    }
+    for (std::size_t i = 0; i < radios_.size(); i++) {
+        if (!radios_[i]->sync_time(config.time_source)) {
+            return {Code::TIME_SYNC_FAILURE, std::nullopt, i};
+        }
+    }
+
+    try {
+        channels_ = std::vector<Channel>(radios_.size());
+        for (auto& ch : channels_) {
+            ch.buf.resize(block_len_ * kStagingBlocks);
+        }
+        queue_ = std::make_unique<queue::SPSCQueue>(
+            queue::SPSCQueue::capacity_for(
+                sizeof(BlockHeader) +
+                    block_len_ * radios_.size() * sizeof(SDRRawSample),
+                config.queue_blocks));
+    } catch (...) {
+        return {Code::CONFIGURATION_ERROR, std::nullopt};
+    }
+
+    for (std::size_t i = 0; i < radios_.size(); i++) {
+        auto status = radios_[i]->start_stream(config.stream);
+        if (!status || !status.rx_handle) {
+            for (std::size_t j = 0; j < i; j++) {
+                radios_[j]->stop_stream();
+            }
+            return {Code::RADIO_FAILURE, std::nullopt, i};
+        }
+        channels_[i].handle.emplace(std::move(*status.rx_handle));
+    }
+
+    anchored_ = false;
+    epoch_ns_ = 0;
+    next_index_ = 0;
+    for (auto* c : {&blocks_, &aligned_samples_, &gap_samples_,
+                    &output_stalls_}) {
+        c->store(0, std::memory_order_relaxed);
+    }
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread(&RadioAggregator::merge_loop, this);
+    ThreadPolicyResult policy =
+        apply_thread_policy(thread_, config.thread_policy);
+    return {Code::SUCCESS, queue_->get_read_handle(), 0, policy};
+}
+
+void RadioAggregator::stop() noexcept {
+    if (!is_running()) {
+        return;
+    }
+    stop_signal_.store(true, std::memory_order_release);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    for (auto& radio : radios_) {
+        radio->stop_stream();
+    }
+    running_.store(false, std::memory_order_release);
+    stop_signal_.store(false, std::memory_order_release);
+}
+
+RadioAggregator::Stats RadioAggregator::stats() const noexcept {
+    Stats s{};
+    s.blocks = blocks_.load(std::memory_order_relaxed);
+    s.aligned_samples = aligned_samples_.load(std::memory_order_relaxed);
+    s.gap_samples = gap_samples_.load(std::memory_order_relaxed);
+    s.output_stalls = output_stalls_.load(std::memory_order_relaxed);
+    return s;
+}
+
+// Stages samples of one radio, returns true if anything was consumed.
+bool RadioAggregator::fill(Channel& ch) noexcept {
+    bool progressed = false;
+    while (true) {
+        if (anchored_ && ch.index < next_index_) {
+            std::size_t drop = static_cast<std::size_t>(std::min<int64_t>(
+                next_index_ - ch.index, static_cast<int64_t>(ch.staged())));
+            ch.begin += drop;
+            ch.index += static_cast<int64_t>(drop);
+            detail::counter_add(aligned_samples_, drop);
+        }
+        if (ch.begin == ch.end) {
+            ch.begin = ch.end = 0;
+        } else if (ch.end == ch.buf.size() && ch.begin != 0) {
+            std::memmove(ch.buf.data(), ch.buf.data() + ch.begin,
+                         ch.staged() * sizeof(SDRRawSample));
+            ch.end -= ch.begin;
+            ch.begin = 0;
+        }
+        std::size_t room = ch.buf.size() - ch.end;
+        if (room == 0) {
+            break;
+        }
+
+        if (ch.pending_zeros != 0) {
+            std::size_t n =
+                static_cast<std::size_t>(std::min<uint64_t>(room,
+                                                            ch.pending_zeros));
+            std::fill_n(ch.buf.data() + ch.end, n, SDRRawSample{});
+            ch.end += n;
+            ch.pending_zeros -= n;
+            progressed = true;
+            continue;
+        }
+
+        queue::SPSCQueue::ReadSlot slot{};
+        if (ch.handle->acquire(slot) != queue::SPSCError::None) {
+            break;
+        }
+        BlockHeader* hdr = nullptr;
+        SDRRawSample* samples = nullptr;
+        slot.as_block(hdr, samples);
+
+        if (!anchored_) {
+            // Only the first timestamp is needed until every radio has one.
+            if (hdr->has(BlockFlags::GAP)) {
+                ch.handle->commit(std::move(slot));
+                progressed = true;
+                continue;
+            }
+            if (!ch.has_first) {
+                // Time of the block's first sample on the synchronized
+                // device clock, not when the host received it.
+                ch.has_first = true;
+                ch.first_ns = hdr->timestamp_ns;
+                progressed = true;
+            }
+            break;
+        }
+
+        if (hdr->has(BlockFlags::GAP)) {
+            int64_t at = ch.index + static_cast<int64_t>(ch.staged());
+            if (ch.gap_end <= next_index_) {
+                ch.gap_begin = at;
+            }
+            ch.gap_end = at + static_cast<int64_t>(hdr->num_samples);
+            ch.pending_zeros += hdr->num_samples;
+            detail::counter_add(gap_samples_, hdr->num_samples);
+            ch.handle->commit(std::move(slot));
+            progressed = true;
+            continue;
+        }
+
+        std::size_t num_samples = std::min<std::size_t>(
+            hdr->num_samples,
+            (slot.size - sizeof(BlockHeader)) / sizeof(SDRRawSample));
+        std::size_t n = std::min(room, num_samples - ch.consumed);
+        std::memcpy(ch.buf.data() + ch.end, samples + ch.consumed,
+                    n * sizeof(SDRRawSample));
+        ch.end += n;
+        ch.consumed += n;
+        if (ch.consumed == num_samples) {
+            ch.consumed = 0;
+            ch.handle->commit(std::move(slot));
+        }
+        progressed = true;
+    }
+    return progressed;
+}
+
+// Places every radio on a common sample index once all delivered samples.
+bool RadioAggregator::anchor() noexcept {
+    uint64_t epoch = UINT64_MAX;
+    for (const auto& ch : channels_) {
+        if (!ch.has_first) {
+            return false;
+        }
+        epoch = std::min(epoch, ch.first_ns);
+    }
+    epoch_ns_ = epoch;
+    next_index_ = 0;
+    for (auto& ch : channels_) {
+        // Relative to the epoch, so the product stays well within a double's
+        // precision.
+        ch.index = std::llround(static_cast<double>(ch.first_ns - epoch) *
+                                sample_rate_ / 1e9);
+        next_index_ = std::max(next_index_, ch.index);
+    }
+    anchored_ = true;
+    return true;
+}
+
+bool RadioAggregator::emit() noexcept {
+    bool gap = false;
+    const int64_t block_end = next_index_ + static_cast<int64_t>(block_len_);
+    for (const auto& ch : channels_) {
+        if (ch.index != next_index_ || ch.staged() < block_len_) {
+            return false;
+        }
+        gap = gap || (ch.gap_end > next_index_ && ch.gap_begin < block_end);
+    }
+
+    const std::size_t bytes = block_len_ * sizeof(SDRRawSample);
+    queue::SPSCQueue::WriteSlot slot{};
+    if (queue_->acquire_write(slot, sizeof(BlockHeader) +
+                                        bytes * channels_.size()) !=
+        queue::SPSCError::None) {
+        return false;
+    }
+    BlockHeader* hdr = nullptr;
+    SDRRawSample* out = nullptr;
+    slot.as_block(hdr, out);
+    hdr->timestamp_ns =
+        epoch_ns_ + static_cast<uint64_t>(std::llround(
+                        static_cast<double>(next_index_) * 1e9 / sample_rate_));
+    hdr->num_samples = block_len_;
+    hdr->flags = gap ? BlockFlags::ZERO_FILLED : BlockFlags::NONE;
+    hdr->reserved = 0;
+    for (auto& ch : channels_) {
+        std::memcpy(out, ch.buf.data() + ch.begin, bytes);
+        out += block_len_;
+        ch.begin += block_len_;
+        ch.index = block_end;
+    }
+    next_index_ = block_end;
+    queue_->commit_write(std::move(slot));
+    detail::counter_add(blocks_, 1);
+    return true;
+}
+
+void RadioAggregator::merge_loop() noexcept {
+    bool stalled = false;
+    while (!stop_signal_.load(std::memory_order_acquire)) {
+        bool progressed = false;
+        for (auto& ch : channels_) {
+            progressed = fill(ch) || progressed;
+        }
+        if (!anchored_) {
+            if (anchor()) {
+                continue;
+            }
+        } else {
+            while (emit()) {
+                stalled = false;
+                progressed = true;
+            }
+            // Every channel has a block staged but the queue is full.
+            bool ready = std::all_of(
+                channels_.begin(), channels_.end(), [&](const Channel& ch) {
+                    return ch.index == next_index_ &&
+                           ch.staged() >= block_len_;
+                });
+            if (ready && !stalled) {
+                detail::counter_add(output_stalls_, 1);
+                stalled = true;
+            }
+        }
+        if (!progressed) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+};  // namespace csics::radio
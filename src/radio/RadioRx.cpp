@@ -1,48 +1,41 @@
 #include <csics/radio/RadioRx.hpp>
 
 #ifdef CSICS_USE_UHD
+#include "usrp/USRPDevice.hpp"
 #include "usrp/USRPRadioRx.hpp"
 #endif
 
 namespace csics::radio {
 
-#ifdef CSICS_USE_UHD
-inline bool find_usrp() { 
-    uhd_string_vector_handle sv;
-    uhd_string_vector_make(&sv);
-    uhd_usrp_find("", &sv);
-    size_t size = 0;
-    uhd_string_vector_size(sv, &size);
-    uhd_string_vector_free(&sv);
-    return size != 0;
+ThreadPolicyResult IRadioRx::set_thread_policy(
+    const ThreadPolicy& policy) noexcept {
+    return unsupported_thread_policy(policy);
 }
 
-inline std::unique_ptr<USRPRadioRx> create_usrp(const RadioDeviceArgs& dv,
-                                                const RadioConfiguration& cfg) {
-    if (!find_usrp()) {
-        return nullptr;
-    }
-    auto pRadio = std::make_unique<USRPRadioRx>(dv);
-    pRadio->set_configuration(cfg);
-    return pRadio;
+ThreadStats IRadioRx::get_thread_stats() const noexcept { return {}; }
+
+RxStats IRadioRx::get_rx_stats() const noexcept { return {}; }
+
+bool IRadioRx::sync_time(TimeSource source) noexcept {
+    return source == TimeSource::HOST;
 }
-#endif
 
 std::unique_ptr<IRadioRx> IRadioRx::create_radio_rx(
     const RadioDeviceArgs& device_args, const RadioConfiguration& config) {
     switch (device_args.device_type) {
 #ifdef CSICS_USE_UHD
         case DeviceType::USRP:
-            return create_usrp(device_args, config);
+            return open_usrp<USRPRadioRx>(device_args, config);
 #endif
+        case DeviceType::NULL_DEVICE:
+            return nullptr;
         case DeviceType::DEFAULT:
         default: {
 #ifdef CSICS_USE_UHD
-            if (find_usrp()) {
-                return create_usrp(device_args, config);
-            }
-#endif
+            return open_usrp<USRPRadioRx>(device_args, config);
+#else
             return nullptr;
+#endif
         }
     }
 }
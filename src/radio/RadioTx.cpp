@@ -0,0 +1,48 @@
+#include <csics/radio/RadioTx.hpp>
+
+#include "null/NullRadioTx.hpp"
+
+#ifdef CSICS_USE_UHD
+#include "usrp/USRPDevice.hpp"
+#include "usrp/USRPRadioTx.hpp"
+#endif
+
+namespace csics::radio {
+
+ThreadPolicyResult IRadioTx::set_thread_policy(
+    const ThreadPolicy& policy) noexcept {
+    return unsupported_thread_policy(policy);
+}
+
+ThreadStats IRadioTx::get_thread_stats() const noexcept { return {}; }
+
+TxStats IRadioTx::get_tx_stats() const noexcept { return {}; }
+
+bool IRadioTx::sync_time(TimeSource source) noexcept {
+    return source == TimeSource::HOST;
+}
+
+std::unique_ptr<IRadioTx> IRadioTx::create_radio_tx(
+    const RadioDeviceArgs& device_args, const RadioConfiguration& config) {
+    switch (device_args.device_type) {
+        case DeviceType::NULL_DEVICE: {
+            auto pRadio = std::make_unique<NullRadioTx>(
+                std::get<NullDeviceArgs>(device_args.args));
+            pRadio->set_configuration(config);
+            return pRadio;
+        }
+#ifdef CSICS_USE_UHD
+        case DeviceType::USRP:
+            return open_usrp<USRPRadioTx>(device_args, config);
+#endif
+        case DeviceType::DEFAULT:
+        default: {
+#ifdef CSICS_USE_UHD
+            return open_usrp<USRPRadioTx>(device_args, config);
+#else
+            return nullptr;
+#endif
+        }
+    }
+}
+};  // namespace csics::radio
@@ -0,0 +1,77 @@
+#include <csics/radio/RatePlan.hpp>
+
+#include <cmath>
+
+namespace csics::radio {
+
+// Relative rate error still treated as exact, absorbs float noise in
+// rates like 122.88e6 / 3.
+constexpr double kExactTolerance = 1e-9;
+
+// Orders candidate plans, true if `a` is preferred over `b`.
+static bool better(const RatePlan& a, double a_error, const RatePlan& b,
+                   double b_error) noexcept {
+    if (b.decimation == 0) return true;
+    if (a.exact != b.exact) return a.exact;
+    if (!a.exact && a_error != b_error) return a_error < b_error;
+    bool a_even = a.decimation % 2 == 0;
+    bool b_even = b.decimation % 2 == 0;
+    if (a_even != b_even) return a_even;
+    return a.master_clock > b.master_clock;
+}
+
+RatePlan plan_sample_rate(std::span<const double> master_clocks,
+                          double sample_rate,
+                          const RateLimits& limits) noexcept {
+    RatePlan best{};
+    double best_error = 0;
+    if (sample_rate <= 0) {
+        return best;
+    }
+    for (double clock : master_clocks) {
+        double ratio = clock / sample_rate;
+        // Both neighbours of a fractional ratio are candidates.
+        for (double d : {std::floor(ratio), std::ceil(ratio)}) {
+            if (d < limits.min_decimation || d > limits.max_decimation) {
+                continue;
+            }
+            RatePlan plan{};
+            plan.master_clock = clock;
+            plan.decimation = static_cast<uint32_t>(d);
+            plan.sample_rate = clock / d;
+            double error = std::abs(plan.sample_rate - sample_rate);
+            plan.exact = error <= kExactTolerance * sample_rate;
+            if (better(plan, error, best, best_error)) {
+                best = plan;
+                best_error = error;
+            }
+        }
+    }
+    return best;
+}
+
+const char* otw_name(OtwFormat format) noexcept {
+    switch (format) {
+        case OtwFormat::SC8:
+            return "sc8";
+        case OtwFormat::SC16:
+        case OtwFormat::AUTO:
+        default:
+            return "sc16";
+    }
+}
+
+OtwFormat select_otw_format(OtwFormat requested, double sample_rate,
+                            double link_bytes_per_sec) noexcept {
+    if (requested != OtwFormat::AUTO) {
+        return requested;
+    }
+    if (link_bytes_per_sec <= 0 ||
+        sample_rate * otw_bytes_per_sample(OtwFormat::SC16) <=
+            link_bytes_per_sec) {
+        return OtwFormat::SC16;
+    }
+    return OtwFormat::SC8;
+}
+
+};  // namespace csics::radio
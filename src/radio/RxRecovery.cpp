@@ -0,0 +1,121 @@
+#include <csics/radio/RxRecovery.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../Counters.hpp"
+
+namespace csics::radio {
+
+RxRecovery::RxRecovery(double sample_rate,
+                       const RxRecoveryConfig& config) noexcept
+    : sample_rate_(sample_rate), config_(config) {}
+
+void RxRecovery::reset(double sample_rate,
+                       const RxRecoveryConfig& config) noexcept {
+    sample_rate_ = sample_rate;
+    config_ = config;
+    next_time_ns_ = 0;
+    have_time_ = false;
+    gap_pending_ = false;
+    consecutive_timeouts_ = 0;
+    consecutive_restarts_ = 0;
+    for (auto* c : {&blocks_, &samples_, &overflows_, &timeouts_,
+                    &stream_errors_, &restarts_, &gaps_, &lost_samples_}) {
+        c->store(0, std::memory_order_relaxed);
+    }
+    failed_.store(false, std::memory_order_relaxed);
+}
+
+RxAction RxRecovery::on_event(RxEvent event) noexcept {
+    if (event != RxEvent::TIMEOUT) {
+        consecutive_timeouts_ = 0;
+    }
+    switch (event) {
+        case RxEvent::NONE:
+            return RxAction::CONTINUE;
+        case RxEvent::TIMEOUT:
+            detail::counter_add(timeouts_, 1);
+            if (config_.max_timeouts != 0 &&
+                ++consecutive_timeouts_ >= config_.max_timeouts) {
+                break;
+            }
+            return RxAction::CONTINUE;
+        case RxEvent::OVERFLOW:
+            // Continuous streams keep running after an overflow, only the
+            // dropped samples have to be accounted for.
+            detail::counter_add(overflows_, 1);
+            gap_pending_ = true;
+            return RxAction::RESYNC;
+        case RxEvent::LATE_COMMAND:
+        case RxEvent::BROKEN_CHAIN:
+        case RxEvent::ALIGNMENT:
+        case RxEvent::BAD_PACKET:
+            detail::counter_add(stream_errors_, 1);
+            break;
+        case RxEvent::FATAL:
+            failed_.store(true, std::memory_order_relaxed);
+            return RxAction::STOP;
+    }
+
+    consecutive_timeouts_ = 0;
+    if (config_.max_restarts != 0 &&
+        consecutive_restarts_ >= config_.max_restarts) {
+        failed_.store(true, std::memory_order_relaxed);
+        return RxAction::STOP;
+    }
+    consecutive_restarts_++;
+    detail::counter_add(restarts_, 1);
+    gap_pending_ = true;
+    return RxAction::RESTART;
+}
+
+uint64_t RxRecovery::on_samples(uint64_t num_samples,
+                                uint64_t time_ns) noexcept {
+    uint64_t lost = 0;
+    if (gap_pending_ && have_time_ && time_ns > next_time_ns_) {
+        double missing = static_cast<double>(time_ns - next_time_ns_) *
+                         sample_rate_ / 1e9;
+        lost = static_cast<uint64_t>(std::llround(missing));
+    }
+    if (lost != 0) {
+        detail::counter_add(gaps_, 1);
+        detail::counter_add(lost_samples_, lost);
+    }
+    gap_pending_ = false;
+    consecutive_restarts_ = 0;
+    consecutive_timeouts_ = 0;
+
+    next_time_ns_ =
+        time_ns + static_cast<uint64_t>(std::llround(
+                      static_cast<double>(num_samples) * 1e9 / sample_rate_));
+    have_time_ = true;
+    detail::counter_add(samples_, num_samples);
+    return lost;
+}
+
+std::chrono::microseconds RxRecovery::restart_delay() const noexcept {
+    uint32_t doublings = consecutive_restarts_ == 0
+                             ? 0
+                             : std::min<uint32_t>(consecutive_restarts_ - 1, 20);
+    auto delay = config_.restart_delay * (int64_t{1} << doublings);
+    return std::min(delay, config_.max_restart_delay);
+}
+
+void RxRecovery::on_block() noexcept { detail::counter_add(blocks_, 1); }
+
+RxStats RxRecovery::stats() const noexcept {
+    RxStats s{};
+    s.blocks = blocks_.load(std::memory_order_relaxed);
+    s.samples = samples_.load(std::memory_order_relaxed);
+    s.overflows = overflows_.load(std::memory_order_relaxed);
+    s.timeouts = timeouts_.load(std::memory_order_relaxed);
+    s.stream_errors = stream_errors_.load(std::memory_order_relaxed);
+    s.restarts = restarts_.load(std::memory_order_relaxed);
+    s.gaps = gaps_.load(std::memory_order_relaxed);
+    s.lost_samples = lost_samples_.load(std::memory_order_relaxed);
+    s.failed = failed_.load(std::memory_order_relaxed);
+    return s;
+}
+
+};  // namespace csics::radio
@@ -0,0 +1,37 @@
+#pragma once
+#include <atomic>
+#include <csics/radio/Radio.hpp>
+
+#include "../Counters.hpp"
+
+namespace csics::radio {
+
+// TxStats shared between a transmit thread (only writer) and readers.
+struct TxCounters {
+    std::atomic<uint64_t> blocks{0};
+    std::atomic<uint64_t> samples{0};
+    std::atomic<uint64_t> bursts{0};
+    std::atomic<uint64_t> underflows{0};
+    std::atomic<uint64_t> late_bursts{0};
+    std::atomic<uint64_t> sequence_errors{0};
+
+    void reset() noexcept {
+        for (auto* c : {&blocks, &samples, &bursts, &underflows, &late_bursts,
+                        &sequence_errors}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+    }
+
+    TxStats snapshot() const noexcept {
+        TxStats s{};
+        s.blocks = blocks.load(std::memory_order_relaxed);
+        s.samples = samples.load(std::memory_order_relaxed);
+        s.bursts = bursts.load(std::memory_order_relaxed);
+        s.underflows = underflows.load(std::memory_order_relaxed);
+        s.late_bursts = late_bursts.load(std::memory_order_relaxed);
+        s.sequence_errors = sequence_errors.load(std::memory_order_relaxed);
+        return s;
+    }
+};
+
+};  // namespace csics::radio
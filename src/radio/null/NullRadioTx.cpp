@@ -0,0 +1,199 @@
+#include "NullRadioTx.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace csics::radio {
+
+// Blocks the queue holds before the producer is blocked.
+constexpr std::size_t kTxQueueDepth = 8;
+
+static uint64_t now_ns() noexcept { return Timestamp::now(); }
+
+static void sleep_until_ns(uint64_t t) noexcept {
+    std::this_thread::sleep_until(
+        std::chrono::system_clock::time_point(std::chrono::nanoseconds(t)));
+}
+
+NullRadioTx::NullRadioTx(const NullDeviceArgs& device_args)
+    : paced_(device_args.paced) {}
+
+NullRadioTx::~NullRadioTx() { stop_stream(); }
+
+NullRadioTx::StartStatus NullRadioTx::start_stream(
+    const StreamConfiguration& stream_config) noexcept {
+    stop_stream();
+
+    std::size_t block_len = stream_config.sample_length.get_num_samples(
+        current_config_.sample_rate);
+    if (block_len == 0 || current_config_.sample_rate <= 0) {
+        return {StartStatus::Code::CONFIGURATION_ERROR, std::nullopt};
+    }
+    queue_ = std::make_unique<queue::SPSCQueue>(queue::SPSCQueue::capacity_for(
+        block_len * sizeof(SDRRawSample) + sizeof(BlockHeader),
+        kTxQueueDepth));
+    counters_.reset();
+
+    streaming_.store(true, std::memory_order_release);
+    tx_thread_ = std::thread(&NullRadioTx::tx_loop, this);
+    ThreadPolicyResult policy = apply_thread_policy(tx_thread_, thread_policy_);
+    return {StartStatus::Code::SUCCESS, queue_->get_write_handle(), policy};
+}
+
+void NullRadioTx::stop_stream() noexcept {
+    if (is_streaming()) {
+        stop_signal_.store(true, std::memory_order_release);
+        if (tx_thread_.joinable()) {
+            tx_thread_.join();
+        }
+        streaming_.store(false, std::memory_order_release);
+        stop_signal_.store(false, std::memory_order_release);
+    }
+}
+
+bool NullRadioTx::is_streaming() const noexcept {
+    return streaming_.load(std::memory_order_acquire);
+}
+
+double NullRadioTx::get_sample_rate() const noexcept {
+    return current_config_.sample_rate;
+}
+
+Timestamp NullRadioTx::set_sample_rate(double rate) noexcept {
+    current_config_.sample_rate = rate;
+    return Timestamp::now();
+}
+
+double NullRadioTx::get_center_frequency() const noexcept {
+    return current_config_.center_frequency;
+}
+
+Timestamp NullRadioTx::set_center_frequency(double freq) noexcept {
+    current_config_.center_frequency = freq;
+    return Timestamp::now();
+}
+
+double NullRadioTx::get_gain() const noexcept { return current_config_.gain; }
+
+Timestamp NullRadioTx::set_gain(double gain) noexcept {
+    current_config_.gain = gain;
+    return Timestamp::now();
+}
+
+RadioConfiguration NullRadioTx::get_configuration() const noexcept {
+    return current_config_;
+}
+
+Timestamp NullRadioTx::set_configuration(
+    const RadioConfiguration& config) noexcept {
+    current_config_ = config;
+    return Timestamp::now();
+}
+
+RadioDeviceInfo NullRadioTx::get_device_info() const noexcept {
+    RadioDeviceInfo info{};
+    info.frequency_range = {0, std::numeric_limits<double>::max()};
+    info.sample_rate_range = {0, std::numeric_limits<double>::max()};
+    info.max_gain = std::numeric_limits<double>::max();
+    return info;
+}
+
+ThreadPolicyResult NullRadioTx::set_thread_policy(
+    const ThreadPolicy& policy) noexcept {
+    thread_policy_ = policy;
+    if (is_streaming()) {
+        return apply_thread_policy(tx_thread_, thread_policy_);
+    }
+    return {};
+}
+
+ThreadStats NullRadioTx::get_thread_stats() const noexcept {
+    ThreadStats stats = thread_stats(tx_tid_.load(std::memory_order_acquire));
+    if (stats.tid < 0) {
+        stats.involuntary_switches =
+            tx_involuntary_switches_.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+TxStats NullRadioTx::get_tx_stats() const noexcept {
+    return counters_.snapshot();
+}
+
+void NullRadioTx::tx_loop() noexcept {
+    tx_tid_.store(current_thread_id(), std::memory_order_release);
+    const double ns_per_sample = 1e9 / current_config_.sample_rate;
+    bool in_burst = false;
+    bool underflowing = false;
+    // When the simulated device plays out the last sample handed to it.
+    uint64_t device_end_ns = 0;
+    uint64_t prev_start_ns = 0;
+
+    while (true) {
+        queue::SPSCQueue::ReadSlot slot{};
+        if (queue_->acquire_read(slot) != queue::SPSCError::None) {
+            // Everything queued before stop_stream() was sent.
+            if (stop_signal_.load(std::memory_order_acquire)) {
+                break;
+            }
+            if (paced_ && in_burst && !underflowing &&
+                now_ns() > device_end_ns) {
+                detail::counter_add(counters_.underflows, 1);
+                underflowing = true;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        BlockHeader* hdr = nullptr;
+        SDRRawSample* samples = nullptr;
+        slot.as_block(hdr, samples);
+        uint64_t n = std::min<uint64_t>(
+            hdr->num_samples,
+            (slot.size - sizeof(BlockHeader)) / sizeof(SDRRawSample));
+
+        if (paced_) {
+            uint64_t now = now_ns();
+            if (!in_burst) {
+                uint64_t start = std::max(now, device_end_ns);
+                if (hdr->timestamp_ns != 0) {
+                    if (hdr->timestamp_ns < start) {
+                        detail::counter_add(counters_.late_bursts, 1);
+                    } else {
+                        start = hdr->timestamp_ns;
+                    }
+                }
+                device_end_ns = start;
+            } else if (now > device_end_ns) {
+                if (!underflowing) {
+                    detail::counter_add(counters_.underflows, 1);
+                }
+                device_end_ns = now;
+            }
+            // One block of device buffering: this block is taken once the
+            // previous one starts playing.
+            sleep_until_ns(prev_start_ns);
+            prev_start_ns = device_end_ns;
+            device_end_ns += static_cast<uint64_t>(n * ns_per_sample);
+        }
+        if (!in_burst) {
+            detail::counter_add(counters_.bursts, 1);
+            in_burst = true;
+        }
+        underflowing = false;
+
+        detail::counter_add(counters_.blocks, 1);
+        detail::counter_add(counters_.samples, n);
+        if (hdr->has(BlockFlags::END_OF_BURST)) {
+            in_burst = false;
+        }
+        queue_->commit_read(std::move(slot));
+    }
+
+    tx_involuntary_switches_.store(current_thread_stats().involuntary_switches,
+                                   std::memory_order_relaxed);
+    tx_tid_.store(-1, std::memory_order_release);
+}
+
+};  // namespace csics::radio
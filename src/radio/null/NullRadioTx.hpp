@@ -0,0 +1,59 @@
+#pragma once
+#include <csics/radio/RadioTx.hpp>
+#include <memory>
+#include <thread>
+
+#include "../TxCounters.hpp"
+
+namespace csics::radio {
+
+/** @brief Transmitter that discards every sample.
+ * When paced it consumes blocks at the sample rate with one block of
+ * device-side buffering, honours timed bursts and reports underflows and
+ * late bursts the way hardware would. Unpaced it measures how fast the
+ * producer can fill the queue.
+ */
+class NullRadioTx : public IRadioTx {
+   public:
+    explicit NullRadioTx(const NullDeviceArgs& device_args);
+    ~NullRadioTx() override;
+    StartStatus start_stream(
+        const StreamConfiguration& stream_config) noexcept override;
+
+    void stop_stream() noexcept override;
+
+    bool is_streaming() const noexcept override;
+
+    double get_sample_rate() const noexcept override;
+    Timestamp set_sample_rate(double rate) noexcept override;
+
+    double get_center_frequency() const noexcept override;
+    Timestamp set_center_frequency(double freq) noexcept override;
+
+    double get_gain() const noexcept override;
+    Timestamp set_gain(double gain) noexcept override;
+
+    RadioConfiguration get_configuration() const noexcept override;
+    Timestamp set_configuration(const RadioConfiguration& config) noexcept override;
+    RadioDeviceInfo get_device_info() const noexcept override;
+
+    ThreadPolicyResult set_thread_policy(
+        const ThreadPolicy& policy) noexcept override;
+    ThreadStats get_thread_stats() const noexcept override;
+    TxStats get_tx_stats() const noexcept override;
+   private:
+    std::unique_ptr<queue::SPSCQueue> queue_;
+    RadioConfiguration current_config_;
+    bool paced_;
+    std::thread tx_thread_;
+    ThreadPolicy thread_policy_;
+    std::atomic<int> tx_tid_{-1};
+    std::atomic<uint64_t> tx_involuntary_switches_{0};
+    TxCounters counters_;
+
+    std::atomic<bool> streaming_{false};
+    std::atomic<bool> stop_signal_{false};
+
+    void tx_loop() noexcept;
+};
+};  // namespace csics::radio
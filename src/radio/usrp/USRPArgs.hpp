@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace csics::radio {
+
+// Whether `key` is set in a UHD device address ("key=value,key=value"),
+// its value is stored in `value`.
+inline bool usrp_arg(std::string_view args, std::string_view key,
+                     std::string_view* value = nullptr) {
+    while (!args.empty()) {
+        std::size_t comma = args.find(',');
+        std::string_view pair = args.substr(0, comma);
+        std::size_t eq = pair.find('=');
+        if (pair.substr(0, eq) == key) {
+            if (value != nullptr) {
+                *value = eq == std::string_view::npos ? std::string_view{}
+                                                      : pair.substr(eq + 1);
+            }
+            return true;
+        }
+        args = comma == std::string_view::npos ? std::string_view{}
+                                               : args.substr(comma + 1);
+    }
+    return false;
+}
+
+/**
+ * @brief The caller's device arguments, pinned to the device discovery
+ * resolved.
+ * The identifying keys of `resolved` (addr, resource, serial, type) are
+ * appended unless the caller set them. Everything else the caller passed,
+ * such as master_clock_rate or buffer sizes, is kept as is.
+ */
+inline std::string merge_usrp_args(std::string_view args,
+                                   std::string_view resolved) {
+    std::string merged(args);
+    for (std::string_view key : {"addr", "resource", "serial", "type"}) {
+        std::string_view value;
+        if (!usrp_arg(resolved, key, &value) || value.empty() ||
+            usrp_arg(args, key)) {
+            continue;
+        }
+        if (!merged.empty()) {
+            merged += ',';
+        }
+        merged.append(key).append("=").append(value);
+    }
+    return merged;
+}
+
+};  // namespace csics::radio
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <csics/radio/RatePlan.hpp>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
 enum class USRPDevice { DEFAULT, N210, N310, B205, B210, X310, X410 };
 
 struct USRPConfiguration {
@@ -8,7 +13,9 @@ struct USRPConfiguration {
         double max;
     } frequency_range;
     const double* master_clocks;
+    std::size_t num_master_clocks;
     double max_gain;
+    csics::radio::RateLimits rate_limits;
 };
 
 constexpr double n210_master_clocks[] = {100e6};
@@ -16,27 +23,30 @@ constexpr double n210_master_clocks[] = {100e6};
 constexpr USRPConfiguration n210_config = {
     .frequency_range = {70e6, 6e9},
     .master_clocks = n210_master_clocks,
+    .num_master_clocks = std::size(n210_master_clocks),
     .max_gain = 76.0,
+    // Gigabit Ethernet carries 25 MS/s of sc16, 50 MS/s needs sc8.
+    .rate_limits = {.min_decimation = 2,
+                    .max_decimation = 512,
+                    .link_bytes_per_sec = 100e6},
 };
 
 constexpr double n310_master_clocks[] = {122.88e6, 125e6, 153.6e6};
 constexpr USRPConfiguration n310_config = {
     .frequency_range = {10e6, 6e9},
     .master_clocks = n310_master_clocks,
+    .num_master_clocks = std::size(n310_master_clocks),
     .max_gain = 76.0,
+    // 10 Gigabit Ethernet.
+    .rate_limits = {.min_decimation = 1,
+                    .max_decimation = 1024,
+                    .link_bytes_per_sec = 1.2e9},
 };
 
-constexpr const char* preferred_otw = "sc16";
-
-constexpr const char* supported_otw_n210[] = {
-    "sc16",  // for sample rates > 25 MHz
-    "sc8"    // for sample rates <= 25 MHz
-};
-
-constexpr const char* n210_preferred_otw(double sample_rate) {
-    if (sample_rate <= 25e6) {
-        return supported_otw_n210[1];  // sc8
-    } else {
-        return supported_otw_n210[0];  // sc16
-    }
+// Known configuration for a motherboard id as reported by UHD (e.g. "N210r4"),
+// nullptr if the device has no table.
+inline const USRPConfiguration* find_usrp_config(const char* mboard_id) {
+    if (std::strncmp(mboard_id, "N210", 4) == 0) return &n210_config;
+    if (std::strncmp(mboard_id, "N310", 4) == 0) return &n310_config;
+    return nullptr;
 }
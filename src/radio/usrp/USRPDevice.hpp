@@ -0,0 +1,224 @@
+#pragma once
+// Using C API for now for issues with ABI
+#include <uhd/usrp/usrp.h>
+
+#include <csics/radio/DeviceCache.hpp>
+#include <csics/radio/RatePlan.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "USRPArgs.hpp"
+#include "USRPConfigs.hpp"
+
+namespace csics::radio {
+
+// Throws the last UHD error, for constructors.
+inline void throw_on_uhd_error(uhd_error err) {
+    if (err != UHD_ERROR_NONE) {
+        // Do error logging here eventually
+        char err_str[256];
+        uhd_get_last_error(err_str, 256);
+        throw std::runtime_error(err_str);
+    }
+}
+
+/**
+ * @brief Addresses of the USRPs matching `hint`.
+ * Discovery broadcasts and waits for replies, so results are served from
+ * the DeviceCache while fresh.
+ */
+inline std::vector<std::string> discover_usrps(const char* hint) {
+    auto& cache = DeviceCache::instance();
+    if (auto found = cache.discovered(hint)) {
+        return *found;
+    }
+    std::vector<std::string> addresses;
+    uhd_string_vector_handle sv;
+    uhd_string_vector_make(&sv);
+    if (uhd_usrp_find(hint, &sv) == UHD_ERROR_NONE) {
+        size_t size = 0;
+        uhd_string_vector_size(sv, &size);
+        char buf[512];
+        for (size_t i = 0; i < size; i++) {
+            if (uhd_string_vector_at(sv, i, buf, sizeof(buf)) ==
+                UHD_ERROR_NONE) {
+                addresses.emplace_back(buf);
+            }
+        }
+    }
+    uhd_string_vector_free(&sv);
+    cache.store_discovery(hint, addresses);
+    return addresses;
+}
+
+/**
+ * @brief Full address of the first USRP matching `hint`, empty if none.
+ * Opening by full address (serial, addr) lets UHD skip a broadcast search.
+ */
+inline std::string resolve_usrp(const char* hint) {
+    auto addresses = discover_usrps(hint);
+    return addresses.empty() ? std::string{} : addresses.front();
+}
+
+/**
+ * @brief Opens the first USRP matching the device args with one (cached)
+ * discovery. nullptr if there is none.
+ */
+template <typename Radio>
+std::unique_ptr<Radio> open_usrp(const RadioDeviceArgs& dv,
+                                 const RadioConfiguration& cfg) {
+    const UsrpArgs* args = std::get_if<UsrpArgs>(&dv.args);
+    const char* user_args = args ? args->device_args : "";
+    std::string address = resolve_usrp(user_args);
+    if (address.empty()) {
+        return nullptr;
+    }
+    // Keeps the caller's arguments, only pins them to the found device.
+    std::string merged = merge_usrp_args(user_args, address);
+    std::unique_ptr<Radio> pRadio;
+    try {
+        pRadio = std::make_unique<Radio>(UsrpArgs{merged.c_str()});
+    } catch (...) {
+        // The device may have gone away since it was discovered.
+        DeviceCache::instance().invalidate_discovery();
+        throw;
+    }
+    pRadio->set_configuration(cfg);
+    return pRadio;
+}
+
+inline void query_range(uhd_usrp_handle usrp,
+                        uhd_error (*get)(uhd_usrp_handle, size_t,
+                                         uhd_meta_range_handle),
+                        double& min, double& max) {
+    uhd_meta_range_handle range_handle;
+    uhd_meta_range_make(&range_handle);
+    get(usrp, 0, range_handle);
+    uhd_meta_range_start(range_handle, &min);
+    uhd_meta_range_stop(range_handle, &max);
+    uhd_meta_range_free(&range_handle);
+}
+
+inline double query_max_gain(uhd_usrp_handle usrp,
+                             uhd_error (*get)(uhd_usrp_handle, const char*,
+                                              size_t, uhd_meta_range_handle)) {
+    double max_gain = 0;
+    uhd_meta_range_handle range_handle;
+    uhd_meta_range_make(&range_handle);
+    get(usrp, nullptr, 0, range_handle);
+    uhd_meta_range_stop(range_handle, &max_gain);
+    uhd_meta_range_free(&range_handle);
+    return max_gain;
+}
+
+/**
+ * @brief Capabilities of an opened USRP.
+ * Cached by motherboard serial, only the first open of a device queries
+ * the ranges.
+ */
+inline DeviceProfile usrp_profile(uhd_usrp_handle usrp) {
+    DeviceProfile profile;
+    uhd_usrp_rx_info_t rx_info{};
+    if (uhd_usrp_get_rx_info(usrp, 0, &rx_info) == UHD_ERROR_NONE) {
+        profile.serial = rx_info.mboard_serial ? rx_info.mboard_serial : "";
+        profile.product = rx_info.mboard_id ? rx_info.mboard_id : "";
+        uhd_usrp_rx_info_free(&rx_info);
+    }
+
+    auto& cache = DeviceCache::instance();
+    if (!profile.serial.empty()) {
+        if (auto cached = cache.profile(profile.serial)) {
+            return *cached;
+        }
+    }
+
+    query_range(usrp, uhd_usrp_get_rx_freq_range,
+                profile.rx_info.frequency_range.min,
+                profile.rx_info.frequency_range.max);
+    query_range(usrp, uhd_usrp_get_rx_rates,
+                profile.rx_info.sample_rate_range.min,
+                profile.rx_info.sample_rate_range.max);
+    profile.rx_info.max_gain = query_max_gain(usrp, uhd_usrp_get_rx_gain_range);
+    query_range(usrp, uhd_usrp_get_tx_freq_range,
+                profile.tx_info.frequency_range.min,
+                profile.tx_info.frequency_range.max);
+    query_range(usrp, uhd_usrp_get_tx_rates,
+                profile.tx_info.sample_rate_range.min,
+                profile.tx_info.sample_rate_range.max);
+    profile.tx_info.max_gain = query_max_gain(usrp, uhd_usrp_get_tx_gain_range);
+
+    if (const auto* config = find_usrp_config(profile.product.c_str())) {
+        profile.master_clocks.assign(
+            config->master_clocks,
+            config->master_clocks + config->num_master_clocks);
+    } else {
+        double rate = 0;
+        if (uhd_usrp_get_master_clock_rate(usrp, 0, &rate) == UHD_ERROR_NONE) {
+            profile.master_clocks.push_back(rate);
+        }
+    }
+
+    if (!profile.serial.empty()) {
+        cache.store_profile(profile);
+    }
+    return profile;
+}
+
+inline RateLimits usrp_rate_limits(const DeviceProfile& profile) {
+    const auto* config = find_usrp_config(profile.product.c_str());
+    return config ? config->rate_limits : RateLimits{};
+}
+
+/**
+ * @brief Switches the master clock to the one reaching `rate` by integer
+ * decimation.
+ * @return The rate to request from the device.
+ */
+inline double prepare_sample_rate(uhd_usrp_handle usrp,
+                                  const DeviceProfile& profile, double rate) {
+    RatePlan plan = plan_sample_rate(profile.master_clocks, rate,
+                                     usrp_rate_limits(profile));
+    if (plan.decimation == 0) {
+        return rate;
+    }
+    double clock = 0;
+    uhd_usrp_get_master_clock_rate(usrp, 0, &clock);
+    if (clock != plan.master_clock) {
+        uhd_usrp_set_master_clock_rate(usrp, plan.master_clock, 0);
+    }
+    return plan.sample_rate;
+}
+
+/**
+ * @brief Sets the device time of a USRP from `source`, see
+ * IRadioRx::sync_time(). The time is shared by the receive and transmit
+ * sides of one device.
+ */
+inline bool sync_usrp_time(uhd_usrp_handle usrp, TimeSource source) noexcept {
+    uint64_t now = Timestamp::now();
+    int64_t secs = static_cast<int64_t>(now / 1000000000ull);
+    switch (source) {
+        case TimeSource::HOST:
+            return uhd_usrp_set_time_now(
+                       usrp, secs,
+                       static_cast<double>(now % 1000000000ull) / 1e9,
+                       0) == UHD_ERROR_NONE;
+        case TimeSource::PPS:
+            if (uhd_usrp_set_clock_source(usrp, "external", 0) !=
+                    UHD_ERROR_NONE ||
+                uhd_usrp_set_time_source(usrp, "external", 0) !=
+                    UHD_ERROR_NONE) {
+                return false;
+            }
+            // Waits for a PPS edge and sets the time at the one after it.
+            // With a disciplined host clock the edges fall on whole seconds,
+            // that is the second after next.
+            return uhd_usrp_set_time_unknown_pps(usrp, secs + 2, 0.0) ==
+                   UHD_ERROR_NONE;
+    }
+    return false;
+}
+
+};  // namespace csics::radio
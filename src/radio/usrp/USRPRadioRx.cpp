@@ -2,6 +2,11 @@
 
 #include <uhd/usrp/usrp.h>
 
+#include <cmath>
+#include <cstring>
+
+#include "USRPDevice.hpp"
+
 namespace csics::radio {
 
 USRPRadioRx::~USRPRadioRx() {
@@ -12,7 +17,10 @@ USRPRadioRx::~USRPRadioRx() {
 };
 
 USRPRadioRx::USRPRadioRx(const RadioDeviceArgs& device_args)
-    : queue_(nullptr), usrp_(nullptr), block_len_(0) {
+    : queue_(nullptr),
+      usrp_(nullptr),
+      block_len_(0),
+      recovery_(0, RxRecoveryConfig{}) {
     auto err =
         uhd_usrp_make(&usrp_, std::get<UsrpArgs>(device_args.args).device_args);
     if (err != UHD_ERROR_NONE) {
@@ -28,6 +36,7 @@ USRPRadioRx::USRPRadioRx(const RadioDeviceArgs& device_args)
         uhd_get_last_error(err_str, 256);
         throw std::runtime_error(err_str);
     }
+    profile_ = usrp_profile(usrp_);
 }
 
 USRPRadioRx::StartStatus USRPRadioRx::start_stream(
@@ -40,11 +49,17 @@ USRPRadioRx::StartStatus USRPRadioRx::start_stream(
 
     block_len_ = stream_config.sample_length.get_num_samples(
         current_config_.sample_rate);
+    // Reset in place, get_rx_stats() may be reading it from another thread.
+    recovery_.reset(current_config_.sample_rate, stream_config.recovery);
+    resync_buffer_.resize(block_len_);
     queue_ = new csics::queue::SPSCQueue(
         (block_len_ * sizeof(std::complex<int16_t>) + sizeof(BlockHeader)) * 4);
     uhd_stream_args_t stream_args{};
     std::vector<size_t> channel_list{0};
-    stream_args.otw_format = const_cast<char*>("sc16");
+    OtwFormat otw = select_otw_format(
+        stream_config.otw_format, current_config_.sample_rate,
+        usrp_rate_limits(profile_).link_bytes_per_sec);
+    stream_args.otw_format = const_cast<char*>(otw_name(otw));
     stream_args.cpu_format = const_cast<char*>("sc16");
     stream_args.args = const_cast<char*>("");
     stream_args.n_channels = 1;
@@ -58,7 +73,30 @@ USRPRadioRx::StartStatus USRPRadioRx::start_stream(
 
     streaming_.store(true, std::memory_order_release);
     rx_thread_ = std::thread(&USRPRadioRx::rx_loop, this);
-    return {StartStatus::Code::SUCCESS, queue_->get_read_handle()};
+    ThreadPolicyResult policy = apply_thread_policy(rx_thread_, thread_policy_);
+    return {StartStatus::Code::SUCCESS, queue_->get_read_handle(), policy};
+}
+
+ThreadPolicyResult USRPRadioRx::set_thread_policy(
+    const ThreadPolicy& policy) noexcept {
+    thread_policy_ = policy;
+    if (is_streaming()) {
+        return apply_thread_policy(rx_thread_, thread_policy_);
+    }
+    return {};
+}
+
+RxStats USRPRadioRx::get_rx_stats() const noexcept {
+    return recovery_.stats();
+}
+
+ThreadStats USRPRadioRx::get_thread_stats() const noexcept {
+    ThreadStats stats = thread_stats(rx_tid_.load(std::memory_order_acquire));
+    if (stats.tid < 0) {
+        stats.involuntary_switches =
+            rx_involuntary_switches_.load(std::memory_order_relaxed);
+    }
+    return stats;
 }
 
 bool USRPRadioRx::is_streaming() const noexcept {
@@ -69,7 +107,9 @@ double USRPRadioRx::get_sample_rate() const noexcept {
     return current_config_.sample_rate;
 }
 
-double USRPRadioRx::get_max_sample_rate() const noexcept { return 0; }
+double USRPRadioRx::get_max_sample_rate() const noexcept {
+    return profile_.rx_info.sample_rate_range.max;
+}
 
 double USRPRadioRx::get_center_frequency() const noexcept {
     return current_config_.center_frequency;
@@ -90,6 +130,7 @@ Timestamp USRPRadioRx::set_gain(double gain) noexcept {
 }
 
 Timestamp USRPRadioRx::set_sample_rate(double rate) noexcept {
+    rate = prepare_sample_rate(usrp_, profile_, rate);
     uhd_usrp_set_rx_rate(usrp_, rate, 0);
     uhd_usrp_get_rx_rate(usrp_, 0, &rate);
     current_config_.sample_rate = rate;
@@ -127,69 +168,200 @@ Timestamp USRPRadioRx::set_configuration(
     if (config.center_frequency != current_config_.center_frequency)
         set_center_frequency(config.center_frequency);
     if (config.gain != current_config_.gain) set_gain(config.gain);
-    current_config_ = config;
+    // The setters store the values the device actually applied.
+    current_config_.channel_bandwidth = config.channel_bandwidth;
     return Timestamp::now();
 }
 
+bool USRPRadioRx::sync_time(TimeSource source) noexcept {
+    return sync_usrp_time(usrp_, source);
+}
+
 RadioConfiguration USRPRadioRx::get_configuration() const noexcept {
     return current_config_;
 }
 
 RadioDeviceInfo USRPRadioRx::get_device_info() const noexcept {
-    RadioDeviceInfo info{};
-    uhd_meta_range_handle range_handle;
-    uhd_meta_range_make(&range_handle);
-    uhd_usrp_get_rx_freq_range(usrp_, 0, range_handle);
-    uhd_meta_range_start(range_handle, &info.frequency_range.min);
-    uhd_meta_range_stop(range_handle, &info.frequency_range.max);
-    uhd_meta_range_free(&range_handle);
-    uhd_meta_range_make(&range_handle);
-    uhd_usrp_get_rx_rates(usrp_, 0, range_handle);
-    uhd_meta_range_start(range_handle, &info.sample_rate_range.min);
-    uhd_meta_range_stop(range_handle, &info.sample_rate_range.max);
-    uhd_meta_range_free(&range_handle);
-    uhd_meta_range_make(&range_handle);
-    uhd_usrp_get_rx_gain_range(usrp_, nullptr, 0, range_handle);
-    uhd_meta_range_stop(range_handle, &info.max_gain);
-    uhd_meta_range_free(&range_handle);
-    return info;
+    return profile_.rx_info;
 }
 
-void USRPRadioRx::rx_loop() noexcept {
-    SDRRawSample* cursor = nullptr;
-    SDRRawSample* base = nullptr;
-    BlockHeader* hdr = nullptr;
-    uhd_rx_metadata_handle md;
+static RxEvent classify(uhd_error err,
+                        uhd_rx_metadata_error_code_t code) noexcept {
+    if (err != UHD_ERROR_NONE) {
+        return RxEvent::FATAL;
+    }
+    switch (code) {
+        case UHD_RX_METADATA_ERROR_CODE_NONE:
+            return RxEvent::NONE;
+        case UHD_RX_METADATA_ERROR_CODE_TIMEOUT:
+            return RxEvent::TIMEOUT;
+        case UHD_RX_METADATA_ERROR_CODE_OVERFLOW:
+            return RxEvent::OVERFLOW;
+        case UHD_RX_METADATA_ERROR_CODE_LATE_COMMAND:
+            return RxEvent::LATE_COMMAND;
+        case UHD_RX_METADATA_ERROR_CODE_BROKEN_CHAIN:
+            return RxEvent::BROKEN_CHAIN;
+        case UHD_RX_METADATA_ERROR_CODE_ALIGNMENT:
+            return RxEvent::ALIGNMENT;
+        case UHD_RX_METADATA_ERROR_CODE_BAD_PACKET:
+            return RxEvent::BAD_PACKET;
+    }
+    return RxEvent::BAD_PACKET;
+}
+
+// Device time of the first sample, falling back to the host clock for
+// devices that do not timestamp packets.
+static uint64_t first_sample_time(uhd_rx_metadata_handle md,
+                                  std::size_t num_samples,
+                                  double sample_rate) noexcept {
+    bool has_time = false;
+    uhd_rx_metadata_has_time_spec(md, &has_time);
+    if (has_time) {
+        int64_t full_secs = 0;
+        double frac_secs = 0;
+        uhd_rx_metadata_time_spec(md, &full_secs, &frac_secs);
+        return static_cast<uint64_t>(full_secs) * 1000000000ull +
+               static_cast<uint64_t>(frac_secs * 1e9);
+    }
+    return Timestamp::now() -
+           static_cast<uint64_t>(num_samples * 1e9 / sample_rate);
+}
+
+void USRPRadioRx::issue_stream_cmd(uhd_stream_mode_t mode) noexcept {
     uhd_stream_cmd_t cmd{};
-    cmd.stream_mode = UHD_STREAM_MODE_START_CONTINUOUS;
+    cmd.stream_mode = mode;
     cmd.stream_now = true;
-    const std::size_t buffer_size = block_len_ * sizeof(SDRRawSample) + sizeof(BlockHeader);
     uhd_rx_streamer_issue_stream_cmd(rx_streamer_, &cmd);
+}
+
+void USRPRadioRx::rx_loop() noexcept {
+    rx_tid_.store(current_thread_id(), std::memory_order_release);
+    RxRecovery& recovery = recovery_;
+    const double rate = current_config_.sample_rate;
+    const std::size_t buffer_size =
+        block_len_ * sizeof(SDRRawSample) + sizeof(BlockHeader);
+
+    queue::SPSCQueue::WriteSlot slot{};
+    BlockHeader* hdr = nullptr;
+    SDRRawSample* base = nullptr;
+    std::size_t filled = 0;
+    bool open = false;
+    // After a loss the next samples go to resync_buffer_, so the gap marker
+    // can be queued ahead of them.
+    bool resync = false;
+
+    auto acquire = [&](std::size_t size) {
+        while (queue_->acquire_write(slot, size) != queue::SPSCError::None) {
+            if (stop_signal_.load(std::memory_order_acquire)) {
+                return false;
+            }
+        }
+        slot.as_block(hdr, base);
+        // Set from the first samples received into the block.
+        hdr->timestamp_ns = 0;
+        hdr->flags = BlockFlags::NONE;
+        hdr->reserved = 0;
+        return true;
+    };
+    auto open_block = [&] {
+        filled = 0;
+        open = acquire(buffer_size);
+        return open;
+    };
+    auto close_block = [&](BlockFlags flags) {
+        if (open && filled != 0) {
+            hdr->num_samples = filled;
+            hdr->flags = flags;
+            slot.size = sizeof(BlockHeader) + filled * sizeof(SDRRawSample);
+            queue_->commit_write(std::move(slot));
+            recovery.on_block();
+        }
+        // An acquired but uncommitted slot is simply reused by the next
+        // acquire.
+        open = false;
+    };
+    auto emit_gap = [&](uint64_t lost, uint64_t time_ns) {
+        if (acquire(sizeof(BlockHeader))) {
+            hdr->timestamp_ns = time_ns;
+            hdr->num_samples = lost;
+            hdr->flags = BlockFlags::GAP;
+            queue_->commit_write(std::move(slot));
+        }
+    };
+
+    uhd_rx_metadata_handle md;
     uhd_rx_metadata_make(&md);
+    issue_stream_cmd(UHD_STREAM_MODE_START_CONTINUOUS);
     while (!stop_signal_.load(std::memory_order_acquire)) {
-        queue::SPSCQueue::WriteSlot slot{};
-        while (queue_->acquire_write(slot, buffer_size) !=
-               queue::SPSCError::None) {
+        if (!resync && !open && !open_block()) {
+            break;
         }
-        slot.as_block(hdr, base);
-        hdr->timestamp_ns = Timestamp::now();
-        size_t num_rx_samps = 0;
-        cursor = base;
-        while (cursor < base + block_len_) {
-            uhd_rx_streamer_recv(
-                rx_streamer_, reinterpret_cast<void**>(&slot.data),
-                (base + block_len_) - cursor, &md, 0.1, false, &num_rx_samps);
-            // add in error handling here later
-            cursor += num_rx_samps;
+        SDRRawSample* dst = resync ? resync_buffer_.data() : base + filled;
+        std::size_t want = resync ? block_len_ : block_len_ - filled;
+        void* buffs = dst;
+        std::size_t num_rx_samps = 0;
+        uhd_error err = uhd_rx_streamer_recv(rx_streamer_, &buffs, want, &md,
+                                             0.1, false, &num_rx_samps);
+        uhd_rx_metadata_error_code_t code = UHD_RX_METADATA_ERROR_CODE_NONE;
+        if (err == UHD_ERROR_NONE) {
+            uhd_rx_metadata_error_code(md, &code);
         }
 
-        hdr->num_samples = block_len_ - ((base + block_len_) - cursor);
+        if (num_rx_samps > 0) {
+            // Device time, so blocks of radios synchronized with sync_time()
+            // line up, independent of when the host got to them.
+            const uint64_t time_ns =
+                first_sample_time(md, num_rx_samps, rate);
+            uint64_t lost = recovery.on_samples(num_rx_samps, time_ns);
+            if (resync) {
+                if (lost != 0) {
+                    // The marker carries the time of the first lost sample.
+                    const auto lost_ns = static_cast<uint64_t>(std::llround(
+                        static_cast<double>(lost) * 1e9 / rate));
+                    emit_gap(lost, time_ns - lost_ns);
+                }
+                if (!open_block()) {
+                    break;
+                }
+                std::memcpy(base, resync_buffer_.data(),
+                            num_rx_samps * sizeof(SDRRawSample));
+                resync = false;
+            }
+            if (filled == 0) {
+                hdr->timestamp_ns = time_ns;
+            }
+            filled += num_rx_samps;
+            if (filled == block_len_) {
+                close_block(BlockFlags::NONE);
+            }
+        }
 
-        queue_->commit_write(std::move(slot));
+        switch (recovery.on_event(classify(err, code))) {
+            case RxAction::CONTINUE:
+                break;
+            case RxAction::RESYNC:
+                close_block(BlockFlags::PARTIAL);
+                resync = true;
+                break;
+            case RxAction::RESTART:
+                close_block(BlockFlags::PARTIAL);
+                resync = true;
+                issue_stream_cmd(UHD_STREAM_MODE_STOP_CONTINUOUS);
+                std::this_thread::sleep_for(recovery.restart_delay());
+                issue_stream_cmd(UHD_STREAM_MODE_START_CONTINUOUS);
+                break;
+            case RxAction::STOP:
+                stop_signal_.store(true, std::memory_order_release);
+                break;
+        }
     }
-    cmd.stream_mode = UHD_STREAM_MODE_STOP_CONTINUOUS;
-    uhd_rx_streamer_issue_stream_cmd(rx_streamer_, &cmd);
+    close_block(BlockFlags::PARTIAL);
+
+    issue_stream_cmd(UHD_STREAM_MODE_STOP_CONTINUOUS);
     uhd_rx_metadata_free(&md);
+    rx_involuntary_switches_.store(current_thread_stats().involuntary_switches,
+                                   std::memory_order_relaxed);
+    rx_tid_.store(-1, std::memory_order_release);
 }
 
 };  // namespace csics::radio
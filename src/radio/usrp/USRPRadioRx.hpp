@@ -1,8 +1,12 @@
 #pragma once
+#include <csics/radio/DeviceCache.hpp>
 #include <csics/radio/RadioRx.hpp>
+#include <csics/radio/RxRecovery.hpp>
 // Using C API for now for issues with ABI
 #include <uhd/usrp/usrp.h>
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace csics::radio {
 
@@ -30,18 +34,33 @@ class USRPRadioRx : public IRadioRx {
     RadioConfiguration get_configuration() const noexcept override;
     Timestamp set_configuration(const RadioConfiguration& config) noexcept override;
     RadioDeviceInfo get_device_info() const noexcept override;
+
+    ThreadPolicyResult set_thread_policy(
+        const ThreadPolicy& policy) noexcept override;
+    ThreadStats get_thread_stats() const noexcept override;
+    RxStats get_rx_stats() const noexcept override;
+    bool sync_time(TimeSource source) noexcept override;
    private:
     queue::SPSCQueue* queue_;
     RadioConfiguration current_config_;
     uhd_usrp_handle usrp_;
     uhd_rx_streamer_handle rx_streamer_;
+    // Queried once at open, shared through the DeviceCache.
+    DeviceProfile profile_;
     std::thread rx_thread_;
+    ThreadPolicy thread_policy_;
+    std::atomic<int> rx_tid_{-1};
+    std::atomic<uint64_t> rx_involuntary_switches_{0};
     std::size_t block_len_;
-    
+    // Lives as long as the radio, get_rx_stats() reads it at any time.
+    RxRecovery recovery_;
+    // Receives the first samples after a loss, until the gap is known.
+    std::vector<SDRRawSample> resync_buffer_;
 
     std::atomic<bool> streaming_;
     std::atomic<bool> stop_signal_{false};
 
     void rx_loop() noexcept;
+    void issue_stream_cmd(uhd_stream_mode_t mode) noexcept;
 };
 };  // namespace csics::radio
@@ -0,0 +1,283 @@
+#include "USRPRadioTx.hpp"
+
+#include <uhd/usrp/usrp.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "USRPDevice.hpp"
+
+namespace csics::radio {
+
+// Blocks the queue holds before the producer is blocked.
+constexpr std::size_t kTxQueueDepth = 8;
+
+USRPRadioTx::~USRPRadioTx() {
+    stop_stream();
+    if (tx_streamer_ != nullptr) uhd_tx_streamer_free(&tx_streamer_);
+    if (usrp_ != nullptr) uhd_usrp_free(&usrp_);
+};
+
+USRPRadioTx::USRPRadioTx(const RadioDeviceArgs& device_args)
+    : usrp_(nullptr), tx_streamer_(nullptr) {
+    throw_on_uhd_error(uhd_usrp_make(
+        &usrp_, std::get<UsrpArgs>(device_args.args).device_args));
+    throw_on_uhd_error(uhd_tx_streamer_make(&tx_streamer_));
+    profile_ = usrp_profile(usrp_);
+}
+
+USRPRadioTx::StartStatus USRPRadioTx::start_stream(
+    const StreamConfiguration& stream_config) noexcept {
+    stop_stream();
+
+    std::size_t block_len = stream_config.sample_length.get_num_samples(
+        current_config_.sample_rate);
+    if (block_len == 0) {
+        return {StartStatus::Code::CONFIGURATION_ERROR, std::nullopt};
+    }
+    uhd_stream_args_t stream_args{};
+    std::vector<size_t> channel_list{0};
+    OtwFormat otw = select_otw_format(
+        stream_config.otw_format, current_config_.sample_rate,
+        usrp_rate_limits(profile_).link_bytes_per_sec);
+    stream_args.otw_format = const_cast<char*>(otw_name(otw));
+    stream_args.cpu_format = const_cast<char*>("sc16");
+    stream_args.args = const_cast<char*>("");
+    stream_args.n_channels = 1;
+    stream_args.channel_list = channel_list.data();
+    if (uhd_usrp_get_tx_stream(usrp_, &stream_args, tx_streamer_) !=
+        UHD_ERROR_NONE) {
+        return {StartStatus::Code::HARDWARE_FAILURE, std::nullopt};
+    }
+
+    queue_ = std::make_unique<queue::SPSCQueue>(queue::SPSCQueue::capacity_for(
+        block_len * sizeof(SDRRawSample) + sizeof(BlockHeader),
+        kTxQueueDepth));
+    counters_.reset();
+
+    streaming_.store(true, std::memory_order_release);
+    tx_thread_ = std::thread(&USRPRadioTx::tx_loop, this);
+    ThreadPolicyResult policy = apply_thread_policy(tx_thread_, thread_policy_);
+    return {StartStatus::Code::SUCCESS, queue_->get_write_handle(), policy};
+}
+
+bool USRPRadioTx::sync_time(TimeSource source) noexcept {
+    return sync_usrp_time(usrp_, source);
+}
+
+void USRPRadioTx::stop_stream() noexcept {
+    if (is_streaming()) {
+        stop_signal_.store(true, std::memory_order_release);
+        if (tx_thread_.joinable()) {
+            tx_thread_.join();
+        }
+        streaming_.store(false, std::memory_order_release);
+        stop_signal_.store(false, std::memory_order_release);
+    }
+}
+
+bool USRPRadioTx::is_streaming() const noexcept {
+    return streaming_.load(std::memory_order_acquire);
+}
+
+double USRPRadioTx::get_sample_rate() const noexcept {
+    return current_config_.sample_rate;
+}
+
+double USRPRadioTx::get_center_frequency() const noexcept {
+    return current_config_.center_frequency;
+}
+
+double USRPRadioTx::get_gain() const noexcept { return current_config_.gain; }
+
+Timestamp USRPRadioTx::set_gain(double gain) noexcept {
+    uhd_usrp_set_tx_gain(usrp_, gain, 0, nullptr);
+    uhd_usrp_get_tx_gain(usrp_, 0, nullptr, &gain);
+    current_config_.gain = gain;
+    return Timestamp::now();
+}
+
+Timestamp USRPRadioTx::set_sample_rate(double rate) noexcept {
+    rate = prepare_sample_rate(usrp_, profile_, rate);
+    uhd_usrp_set_tx_rate(usrp_, rate, 0);
+    uhd_usrp_get_tx_rate(usrp_, 0, &rate);
+    current_config_.sample_rate = rate;
+    return Timestamp::now();
+}
+
+Timestamp USRPRadioTx::set_center_frequency(double freq) noexcept {
+    uhd_tune_request_t tune_req{};
+    tune_req.target_freq = freq;
+    tune_req.rf_freq_policy = UHD_TUNE_REQUEST_POLICY_AUTO;
+    tune_req.dsp_freq_policy = UHD_TUNE_REQUEST_POLICY_AUTO;
+    uhd_tune_result_t tune_res{};
+    uhd_usrp_set_tx_freq(usrp_, &tune_req, 0, &tune_res);
+    current_config_.center_frequency = tune_res.actual_rf_freq;
+    return Timestamp::now();
+}
+
+Timestamp USRPRadioTx::set_configuration(
+    const RadioConfiguration& config) noexcept {
+    if (config.sample_rate != current_config_.sample_rate)
+        set_sample_rate(config.sample_rate);
+    if (config.center_frequency != current_config_.center_frequency)
+        set_center_frequency(config.center_frequency);
+    if (config.gain != current_config_.gain) set_gain(config.gain);
+    // The setters store the values the device actually applied.
+    current_config_.channel_bandwidth = config.channel_bandwidth;
+    return Timestamp::now();
+}
+
+RadioConfiguration USRPRadioTx::get_configuration() const noexcept {
+    return current_config_;
+}
+
+RadioDeviceInfo USRPRadioTx::get_device_info() const noexcept {
+    return profile_.tx_info;
+}
+
+ThreadPolicyResult USRPRadioTx::set_thread_policy(
+    const ThreadPolicy& policy) noexcept {
+    thread_policy_ = policy;
+    if (is_streaming()) {
+        return apply_thread_policy(tx_thread_, thread_policy_);
+    }
+    return {};
+}
+
+ThreadStats USRPRadioTx::get_thread_stats() const noexcept {
+    ThreadStats stats = thread_stats(tx_tid_.load(std::memory_order_acquire));
+    if (stats.tid < 0) {
+        stats.involuntary_switches =
+            tx_involuntary_switches_.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+TxStats USRPRadioTx::get_tx_stats() const noexcept {
+    return counters_.snapshot();
+}
+
+void USRPRadioTx::poll_async(double timeout) noexcept {
+    uhd_async_metadata_handle md;
+    uhd_async_metadata_make(&md);
+    bool valid = true;
+    while (uhd_tx_streamer_recv_async_msg(tx_streamer_, &md, timeout,
+                                          &valid) == UHD_ERROR_NONE &&
+           valid) {
+        uhd_async_metadata_event_code_t code{};
+        uhd_async_metadata_event_code(md, &code);
+        switch (code) {
+            case UHD_ASYNC_METADATA_EVENT_CODE_UNDERFLOW:
+            case UHD_ASYNC_METADATA_EVENT_CODE_UNDERFLOW_IN_PACKET:
+                detail::counter_add(counters_.underflows, 1);
+                break;
+            case UHD_ASYNC_METADATA_EVENT_CODE_SEQ_ERROR:
+            case UHD_ASYNC_METADATA_EVENT_CODE_SEQ_ERROR_IN_BURST:
+                detail::counter_add(counters_.sequence_errors, 1);
+                break;
+            case UHD_ASYNC_METADATA_EVENT_CODE_TIME_ERROR:
+                detail::counter_add(counters_.late_bursts, 1);
+                break;
+            default:
+                break;
+        }
+        timeout = 0.0;
+    }
+    uhd_async_metadata_free(&md);
+}
+
+void USRPRadioTx::send(const SDRRawSample* samples, std::size_t n,
+                       bool start_of_burst, bool end_of_burst,
+                       uint64_t time_ns) noexcept {
+    const bool has_time = start_of_burst && time_ns != 0;
+    const int64_t full_secs = static_cast<int64_t>(time_ns / 1000000000ull);
+    const double frac_secs =
+        static_cast<double>(time_ns % 1000000000ull) / 1e9;
+
+    // The streamer may take fewer samples than asked for. Only the first
+    // samples sent carry the start of burst and its time, otherwise every
+    // chunk would be re-timed as a burst of its own.
+    uhd_tx_metadata_handle md;
+    uhd_tx_metadata_make(&md, has_time, full_secs, frac_secs, start_of_burst,
+                         false);
+    std::size_t sent = 0;
+    while (sent < n) {
+        const void* buffs = samples + sent;
+        std::size_t num_sent = 0;
+        // Not cut short by stop_stream(), blocks queued before it are sent
+        // whole. A timeout with nothing taken means the device stalled, the
+        // rest of the block is given up then.
+        if (uhd_tx_streamer_send(tx_streamer_, &buffs, n - sent, &md, 0.1,
+                                 &num_sent) != UHD_ERROR_NONE ||
+            num_sent == 0) {
+            break;
+        }
+        if (sent == 0 && start_of_burst) {
+            uhd_tx_metadata_free(&md);
+            uhd_tx_metadata_make(&md, false, 0, 0.0, false, false);
+        }
+        sent += num_sent;
+    }
+    uhd_tx_metadata_free(&md);
+
+    // The end of burst goes out on its own once the samples are sent, so a
+    // partial send cannot close the burst early.
+    if (end_of_burst) {
+        const bool first = sent == 0;
+        uhd_tx_metadata_make(&md, first && has_time, full_secs, frac_secs,
+                             first && start_of_burst, true);
+        const void* buffs = samples;
+        std::size_t num_sent = 0;
+        uhd_tx_streamer_send(tx_streamer_, &buffs, 0, &md, 0.1, &num_sent);
+        uhd_tx_metadata_free(&md);
+    }
+}
+
+void USRPRadioTx::tx_loop() noexcept {
+    tx_tid_.store(current_thread_id(), std::memory_order_release);
+    bool in_burst = false;
+
+    while (true) {
+        queue::SPSCQueue::ReadSlot slot{};
+        if (queue_->acquire_read(slot) != queue::SPSCError::None) {
+            // Everything queued before stop_stream() was sent.
+            if (stop_signal_.load(std::memory_order_acquire)) {
+                break;
+            }
+            poll_async(0.0);
+            std::this_thread::yield();
+            continue;
+        }
+
+        BlockHeader* hdr = nullptr;
+        SDRRawSample* samples = nullptr;
+        slot.as_block(hdr, samples);
+        std::size_t n = std::min<std::size_t>(
+            hdr->num_samples,
+            (slot.size - sizeof(BlockHeader)) / sizeof(SDRRawSample));
+        bool start_of_burst = !in_burst;
+        bool end_of_burst = hdr->has(BlockFlags::END_OF_BURST);
+        send(samples, n, start_of_burst, end_of_burst, hdr->timestamp_ns);
+
+        if (start_of_burst) {
+            detail::counter_add(counters_.bursts, 1);
+        }
+        in_burst = !end_of_burst;
+        detail::counter_add(counters_.blocks, 1);
+        detail::counter_add(counters_.samples, n);
+        queue_->commit_read(std::move(slot));
+        poll_async(0.0);
+    }
+
+    if (in_burst) {
+        send(nullptr, 0, false, true, 0);
+    }
+    // Collect the burst ack and any late underflow report.
+    poll_async(0.1);
+    tx_involuntary_switches_.store(current_thread_stats().involuntary_switches,
+                                   std::memory_order_relaxed);
+    tx_tid_.store(-1, std::memory_order_release);
+}
+
+};  // namespace csics::radio
@@ -0,0 +1,68 @@
+#pragma once
+#include <csics/radio/DeviceCache.hpp>
+#include <csics/radio/RadioTx.hpp>
+// Using C API for now for issues with ABI
+#include <uhd/usrp/usrp.h>
+#include <memory>
+#include <thread>
+
+#include "../TxCounters.hpp"
+
+namespace csics::radio {
+
+/** @brief USRP transmitter.
+ * Block timestamps are used directly as burst start times in device time.
+ * They match the host epoch once the device was synchronized with
+ * sync_time(), starting a stream leaves the device time alone.
+ */
+class USRPRadioTx : public IRadioTx {
+   public:
+    explicit USRPRadioTx(const RadioDeviceArgs& device_args);
+    ~USRPRadioTx() override;
+    StartStatus start_stream(
+        const StreamConfiguration& stream_config) noexcept override;
+
+    void stop_stream() noexcept override;
+
+    bool is_streaming() const noexcept override;
+
+    double get_sample_rate() const noexcept override;
+    Timestamp set_sample_rate(double rate) noexcept override;
+
+    double get_center_frequency() const noexcept override;
+    Timestamp set_center_frequency(double freq) noexcept override;
+
+    double get_gain() const noexcept override;
+    Timestamp set_gain(double gain) noexcept override;
+
+    RadioConfiguration get_configuration() const noexcept override;
+    Timestamp set_configuration(const RadioConfiguration& config) noexcept override;
+    RadioDeviceInfo get_device_info() const noexcept override;
+
+    ThreadPolicyResult set_thread_policy(
+        const ThreadPolicy& policy) noexcept override;
+    ThreadStats get_thread_stats() const noexcept override;
+    TxStats get_tx_stats() const noexcept override;
+    bool sync_time(TimeSource source) noexcept override;
+   private:
+    std::unique_ptr<queue::SPSCQueue> queue_;
+    RadioConfiguration current_config_;
+    uhd_usrp_handle usrp_;
+    uhd_tx_streamer_handle tx_streamer_;
+    // Queried once at open, shared through the DeviceCache.
+    DeviceProfile profile_;
+    std::thread tx_thread_;
+    ThreadPolicy thread_policy_;
+    std::atomic<int> tx_tid_{-1};
+    std::atomic<uint64_t> tx_involuntary_switches_{0};
+    TxCounters counters_;
+
+    std::atomic<bool> streaming_{false};
+    std::atomic<bool> stop_signal_{false};
+
+    void tx_loop() noexcept;
+    void poll_async(double timeout) noexcept;
+    void send(const SDRRawSample* samples, std::size_t n, bool start_of_burst,
+              bool end_of_burst, uint64_t time_ns) noexcept;
+};
+};  // namespace csics::radio
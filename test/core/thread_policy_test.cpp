@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csics/csics.hpp>
+#include <thread>
+
+using namespace csics;
+
+TEST(CSICSThreadPolicyTests, DefaultPolicyIsNoOp) {
+    ThreadPolicyResult r = apply_thread_policy(ThreadPolicy{});
+    EXPECT_TRUE(r);
+    EXPECT_EQ(r.affinity, ThreadPolicyError::None);
+    EXPECT_EQ(r.scheduling, ThreadPolicyError::None);
+    EXPECT_EQ(r.memory, ThreadPolicyError::None);
+}
+
+TEST(CSICSThreadPolicyTests, RejectsInvalidArguments) {
+#if !defined(__linux__)
+    GTEST_SKIP() << "Thread policies are only implemented on Linux";
+#endif
+    ThreadPolicy policy;
+    policy.cpus = {-1};
+    policy.fifo_priority = 1000;
+    ThreadPolicyResult r = apply_thread_policy(policy);
+    EXPECT_FALSE(r);
+    EXPECT_EQ(r.affinity, ThreadPolicyError::InvalidArgument);
+    EXPECT_EQ(r.scheduling, ThreadPolicyError::InvalidArgument);
+
+    std::thread not_started;
+    EXPECT_FALSE(apply_thread_policy(not_started, ThreadPolicy{}));
+}
+
+TEST(CSICSThreadPolicyTests, PinsOtherThread) {
+#if !defined(__linux__)
+    GTEST_SKIP() << "Thread policies are only implemented on Linux";
+#endif
+    std::atomic<bool> stop{false};
+    std::atomic<int> tid{-1};
+    std::thread t([&] {
+        tid = current_thread_id();
+        while (!stop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    ThreadPolicy policy;
+    policy.cpus = {0};
+    policy.name = "csics-test-thread-name";
+    ThreadPolicyResult r = apply_thread_policy(t, policy);
+    EXPECT_EQ(r.affinity, ThreadPolicyError::None);
+
+    while (tid == -1) {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ThreadStats stats = thread_stats(tid);
+    EXPECT_EQ(stats.tid, tid.load());
+    EXPECT_EQ(stats.last_cpu, 0);
+    EXPECT_GT(stats.voluntary_switches, 0u);
+
+    stop = true;
+    t.join();
+    EXPECT_EQ(thread_stats(tid).tid, -1);
+}
+
+TEST(CSICSThreadPolicyTests, CurrentThreadStats) {
+#if !defined(__linux__)
+    GTEST_SKIP() << "Thread policies are only implemented on Linux";
+#endif
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ThreadStats stats = current_thread_stats();
+    EXPECT_EQ(stats.tid, current_thread_id());
+    EXPECT_GE(stats.last_cpu, 0);
+    EXPECT_GT(stats.voluntary_switches, 0u);
+}
@@ -2,6 +2,7 @@
 #include <gtest/gtest.h>
 #include <openssl/evp.h>
 
+#include <algorithm>
 #include <csics/csics.hpp>
 #include <fstream>
 #include <random>
@@ -139,3 +140,276 @@ TEST(CSICSEncDecTests, Base64EncodingFuzzTest) {
                   std::memcmp(decoded_data.data(), input.u8(), input.size()));
     }
 }
+
+namespace {
+
+using namespace csics;
+using namespace csics::io::encdec;
+
+std::vector<Base64Isa> supported_isas() {
+    std::vector<Base64Isa> isas;
+    for (Base64Isa isa :
+         {Base64Isa::Scalar, Base64Isa::SSSE3, Base64Isa::AVX2}) {
+        if (base64_isa_supported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+std::vector<uint8_t> to_bytes(const std::string& s) {
+    return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+std::vector<uint8_t> openssl_encode(const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> out(4 * ((input.size() + 2) / 3) + 1);
+    int len = EVP_EncodeBlock(out.data(), input.data(),
+                              static_cast<int>(input.size()));
+    out.resize(len);
+    return out;
+}
+
+EncodingResult decode_all(Base64Decoder& decoder, std::vector<uint8_t> in,
+                          std::vector<uint8_t>& out) {
+    out.assign(in.size(), 0);
+    auto r = decoder.finish(BufferView(in), BufferView(out));
+    out.resize(r.output);
+    return r;
+}
+
+};  // namespace
+
+TEST(CSICSEncDecTests, Base64IsaKernelsMatchOpenSSL) {
+    for (Base64Isa isa : supported_isas()) {
+        Base64Encoder encoder(isa);
+        Base64Decoder decoder({.isa = isa});
+        for (std::size_t size = 0; size < 400; size++) {
+            auto input = generate_random_bytes(size);
+            std::vector<uint8_t> encoded(4 * ((size + 2) / 3));
+            auto r = encoder.finish(BufferView(input), BufferView(encoded));
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            ASSERT_EQ(r.output, encoded.size());
+
+            std::vector<uint8_t> expected(encoded.size() + 1);
+            int len = EVP_EncodeBlock(expected.data(), input.data(),
+                                      static_cast<int>(input.size()));
+            expected.resize(len);
+            ASSERT_EQ(encoded, expected) << "isa " << int(isa) << " size "
+                                         << size;
+
+            std::vector<uint8_t> decoded(size);
+            r = decoder.finish(BufferView(encoded), BufferView(decoded));
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            ASSERT_EQ(r.processed, encoded.size());
+            ASSERT_EQ(r.output, size);
+            ASSERT_EQ(decoded, input);
+        }
+    }
+}
+
+TEST(CSICSEncDecTests, Base64DecodingTest) {
+    Base64Decoder decoder;
+    std::vector<uint8_t> out(8);
+    for (auto [text, plain] :
+         {std::pair<std::string, std::string>{"TWFu", "Man"},
+          {"TWE=", "Ma"},
+          {"TQ==", "M"},
+          {"", ""}}) {
+        auto in = to_bytes(text);
+        auto r = decoder.finish(BufferView(in), BufferView(out));
+        ASSERT_EQ(r.status, EncodingStatus::Ok) << text;
+        EXPECT_EQ(std::string(out.begin(), out.begin() + r.output), plain);
+    }
+
+    for (std::string bad :
+         {"TW@u", "TWFu\n", "TQ==TWFu", "T===", "=QTT", "TWF", "TQ=u"}) {
+        auto in = to_bytes(bad);
+        auto r = decoder.finish(BufferView(in), BufferView(out));
+        EXPECT_EQ(r.status, EncodingStatus::InvalidInput) << bad;
+    }
+}
+
+TEST(CSICSEncDecTests, Base64StreamingRoundTrip) {
+    std::mt19937 rng(3);
+    for (Base64Isa isa : supported_isas()) {
+        for (int iter = 0; iter < 50; iter++) {
+            auto input = generate_random_bytes(rng() % 2000);
+            std::uniform_int_distribution<std::size_t> chunk(0, 70);
+
+            // Small input and output pieces, to exercise the holdovers.
+            Base64Encoder encoder(isa);
+            std::vector<uint8_t> encoded;
+            std::size_t pos = 0;
+            bool done = false;
+            while (!done) {
+                std::size_t in_len = std::min(chunk(rng), input.size() - pos);
+                std::vector<uint8_t> out(chunk(rng));
+                BufferView in(input.data() + pos, in_len);
+                bool last = pos + in_len == input.size();
+                auto r = last ? encoder.finish(in, BufferView(out))
+                              : encoder.encode(in, BufferView(out));
+                ASSERT_NE(r.status, EncodingStatus::InvalidInput);
+                pos += r.processed;
+                encoded.insert(encoded.end(), out.begin(),
+                               out.begin() + r.output);
+                done = last && r.status == EncodingStatus::Ok &&
+                       r.processed == in_len;
+            }
+            ASSERT_EQ(encoded.size(), 4 * ((input.size() + 2) / 3));
+
+            Base64Decoder decoder({.isa = isa});
+            std::vector<uint8_t> decoded;
+            pos = 0;
+            done = false;
+            while (!done) {
+                std::size_t in_len =
+                    std::min(chunk(rng), encoded.size() - pos);
+                std::vector<uint8_t> out(chunk(rng));
+                BufferView in(encoded.data() + pos, in_len);
+                bool last = pos + in_len == encoded.size();
+                auto r = last ? decoder.finish(in, BufferView(out))
+                              : decoder.decode(in, BufferView(out));
+                ASSERT_NE(r.status, EncodingStatus::InvalidInput);
+                pos += r.processed;
+                decoded.insert(decoded.end(), out.begin(),
+                               out.begin() + r.output);
+                done = last && r.status == EncodingStatus::Ok &&
+                       r.processed == in_len;
+            }
+            ASSERT_EQ(decoded, input);
+        }
+    }
+}
+
+TEST(CSICSEncDecTests, Base64FuzzAgainstOpenSSL) {
+    std::mt19937 rng(11);
+    auto values = to_bytes(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+    for (Base64Isa isa : supported_isas()) {
+        Base64Decoder decoder({.isa = isa});
+        for (int iter = 0; iter < 500; iter++) {
+            auto input = generate_random_bytes(4 + rng() % 300);
+            auto encoded = openssl_encode(input);
+            std::vector<uint8_t> decoded;
+            auto r = decode_all(decoder, encoded, decoded);
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            ASSERT_EQ(decoded, input);
+
+            // Any byte of a group before the last one, which OpenSSL
+            // decodes the same way if it is in the alphabet.
+            std::size_t pos = rng() % (encoded.size() - 4);
+            encoded[pos] = static_cast<uint8_t>(rng());
+            bool valid = std::find(values.begin(), values.end(),
+                                   encoded[pos]) != values.end();
+            r = decode_all(decoder, encoded, decoded);
+            if (!valid) {
+                ASSERT_EQ(r.status, EncodingStatus::InvalidInput)
+                    << "isa " << int(isa) << " byte " << int(encoded[pos]);
+                continue;
+            }
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            std::vector<uint8_t> expected(encoded.size());
+            EVP_DecodeBlock(expected.data(), encoded.data(),
+                            static_cast<int>(encoded.size()));
+            expected.resize(input.size());
+            ASSERT_EQ(decoded, expected);
+        }
+    }
+}
+
+TEST(CSICSEncDecTests, Base64UrlSafe) {
+    for (Base64Isa isa : supported_isas()) {
+        Base64Encoder encoder(isa, Base64Alphabet::UrlSafe);
+        Base64Decoder decoder(
+            {.alphabet = Base64Alphabet::UrlSafe, .isa = isa});
+        for (std::size_t size = 0; size < 300; size++) {
+            auto input = generate_random_bytes(size);
+            std::vector<uint8_t> encoded(4 * ((size + 2) / 3));
+            auto r = encoder.finish(BufferView(input), BufferView(encoded));
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+
+            auto expected = openssl_encode(input);
+            std::replace(expected.begin(), expected.end(), '+', '-');
+            std::replace(expected.begin(), expected.end(), '/', '_');
+            ASSERT_EQ(encoded, expected) << "isa " << int(isa);
+
+            std::vector<uint8_t> decoded;
+            r = decode_all(decoder, encoded, decoded);
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            ASSERT_EQ(decoded, input);
+        }
+
+        // Each alphabet rejects the characters only the other one has.
+        std::vector<uint8_t> out;
+        std::string url(64, '-');
+        std::string standard(64, '+');
+        EXPECT_EQ(decode_all(decoder, to_bytes(url), out).status,
+                  EncodingStatus::Ok);
+        EXPECT_EQ(decode_all(decoder, to_bytes(standard), out).status,
+                  EncodingStatus::InvalidInput);
+        Base64Decoder plain({.isa = isa});
+        EXPECT_EQ(decode_all(plain, to_bytes(url), out).status,
+                  EncodingStatus::InvalidInput);
+    }
+}
+
+TEST(CSICSEncDecTests, Base64StrictAndLenient) {
+    Base64Decoder strict;
+    Base64Decoder lenient({.lenient = true});
+    std::vector<uint8_t> out;
+
+    for (auto [text, plain] :
+         {std::pair<std::string, std::string>{"TW Fu\r\nTWE", "ManMa"},
+          {"TWFuTWE=\n", "ManMa"},
+          {" TWFu\tTW", "ManM"}}) {
+        auto r = decode_all(lenient, to_bytes(text), out);
+        ASSERT_EQ(r.status, EncodingStatus::Ok) << text;
+        EXPECT_EQ(std::string(out.begin(), out.end()), plain);
+        EXPECT_EQ(decode_all(strict, to_bytes(text), out).status,
+                  EncodingStatus::InvalidInput)
+            << text;
+    }
+    // Bits under the padding that the encoder would have left zero.
+    for (std::string text : {"TR==", "TWF="}) {
+        EXPECT_EQ(decode_all(strict, to_bytes(text), out).status,
+                  EncodingStatus::InvalidInput)
+            << text;
+        EXPECT_EQ(decode_all(lenient, to_bytes(text), out).status,
+                  EncodingStatus::Ok)
+            << text;
+    }
+    for (std::string bad : {"T", "TWFuT", "TQ== x", "TW@u"}) {
+        EXPECT_EQ(decode_all(lenient, to_bytes(bad), out).status,
+                  EncodingStatus::InvalidInput)
+            << bad;
+    }
+
+    // MIME style lines of 76 characters.
+    auto input = generate_random_bytes(10000);
+    auto encoded = openssl_encode(input);
+    std::vector<uint8_t> wrapped;
+    for (std::size_t i = 0; i < encoded.size(); i += 76) {
+        auto end = encoded.begin() + std::min(encoded.size(), i + 76);
+        wrapped.insert(wrapped.end(), encoded.begin() + i, end);
+        wrapped.push_back('\r');
+        wrapped.push_back('\n');
+    }
+    ASSERT_EQ(decode_all(lenient, wrapped, out).status, EncodingStatus::Ok);
+    EXPECT_EQ(out, input);
+}
+
+TEST(CSICSEncDecTests, Base64InPlaceDecode) {
+    for (Base64Isa isa : supported_isas()) {
+        Base64Decoder decoder({.isa = isa});
+        for (std::size_t size : {0, 1, 2, 3, 47, 48, 100, 1000, 4099}) {
+            auto input = generate_random_bytes(size);
+            auto buffer = openssl_encode(input);
+            BufferView view(buffer);
+            auto r = decoder.finish(view, view);
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            ASSERT_EQ(r.output, size);
+            buffer.resize(size);
+            ASSERT_EQ(buffer, input) << "isa " << int(isa);
+        }
+    }
+}
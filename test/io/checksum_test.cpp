@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+namespace {
+
+using namespace csics;
+using namespace csics::io::checksum;
+using csics::io::encdec::Base64Decoder;
+using csics::io::encdec::Base64Encoder;
+using csics::io::encdec::ChecksumCodec;
+using csics::io::encdec::EncodingStatus;
+
+std::vector<ChecksumType> checksum_types() {
+    return {ChecksumType::CRC32C,
+#ifdef CSICS_USE_XXHASH
+            ChecksumType::XXH3,
+#endif
+    };
+}
+
+BufferView view_of(std::string& s) { return BufferView(s.data(), s.size()); }
+
+};  // namespace
+
+TEST(CSICSChecksumTests, Crc32cVectors) {
+    std::string check = "123456789";
+    EXPECT_EQ(crc32c(view_of(check)), 0xE3069283u);
+    EXPECT_EQ(crc32c_portable(view_of(check)), 0xE3069283u);
+
+    // RFC 3720, appendix B.4.
+    std::vector<uint8_t> zeros(32, 0x00);
+    std::vector<uint8_t> ones(32, 0xFF);
+    std::vector<uint8_t> ascending(32);
+    std::iota(ascending.begin(), ascending.end(), 0);
+    EXPECT_EQ(crc32c(BufferView(zeros)), 0x8A9136AAu);
+    EXPECT_EQ(crc32c(BufferView(ones)), 0x62A8AB43u);
+    EXPECT_EQ(crc32c(BufferView(ascending)), 0x46DD794Eu);
+    EXPECT_EQ(crc32c(BufferView()), 0u);
+}
+
+TEST(CSICSChecksumTests, Crc32cHardwareMatchesPortable) {
+    // Sizes around the interleaved blocks, at every alignment.
+    auto data = generate_random_bytes(3 * 8192 * 2 + 3 * 256 + 64);
+    std::mt19937 rng(5);
+    for (int iter = 0; iter < 200; iter++) {
+        std::size_t offset = rng() % 16;
+        std::size_t size = rng() % (data.size() - offset);
+        BufferView piece(data.data() + offset, size);
+        uint32_t expected = crc32c_portable(piece);
+        ASSERT_EQ(crc32c(piece), expected) << offset << " " << size;
+
+        // Extending a CRC gives that of the whole.
+        std::size_t split = size == 0 ? 0 : rng() % size;
+        uint32_t head = crc32c(piece.head(split));
+        ASSERT_EQ(crc32c(piece.subview(split, size), head), expected);
+        ASSERT_EQ(crc32c_portable(piece.subview(split, size),
+                                  crc32c_portable(piece.head(split))),
+                  expected);
+    }
+}
+
+TEST(CSICSChecksumTests, IncrementalMatchesOneShot) {
+#ifdef CSICS_USE_XXHASH
+    EXPECT_EQ(checksum(ChecksumType::XXH3, BufferView()),
+              0x2D06800538D394C2ull);
+#endif
+    auto data = generate_random_bytes(100000);
+    std::mt19937 rng(6);
+    for (ChecksumType type : checksum_types()) {
+        uint64_t expected = checksum(type, BufferView(data));
+        Checksum sum(type);
+        for (int round = 0; round < 2; round++) {
+            std::size_t pos = 0;
+            while (pos < data.size()) {
+                std::size_t len =
+                    std::min<std::size_t>(rng() % 5000, data.size() - pos);
+                sum.update(BufferView(data.data() + pos, len));
+                pos += len;
+            }
+            EXPECT_EQ(sum.digest(), expected) << int(type);
+            sum.reset();
+        }
+
+        Checksum moved(std::move(sum));
+        moved.update(BufferView(data));
+        EXPECT_EQ(moved.digest(), expected);
+    }
+    EXPECT_THROW(Checksum(static_cast<ChecksumType>(0xFF)),
+                 std::invalid_argument);
+}
+
+TEST(CSICSChecksumTests, ChecksumCodecFusedMatchesSeparate) {
+    std::mt19937 rng(7);
+    for (ChecksumType type : checksum_types()) {
+        ChecksumCodec encoder(std::make_unique<Base64Encoder>(), type);
+        ChecksumCodec decoder(std::make_unique<Base64Decoder>(), type,
+                              ChecksumCodec::Side::Output, 1000);
+        for (int iter = 0; iter < 6; iter++) {
+            auto input = generate_random_bytes(rng() % 100000);
+
+            // Whole stream in random pieces, several slices long.
+            std::vector<uint8_t> encoded;
+            std::size_t pos = 0;
+            bool done = false;
+            while (!done) {
+                std::size_t len = std::min<std::size_t>(
+                    rng() % 40000, input.size() - pos);
+                std::vector<uint8_t> out(rng() % 60000);
+                BufferView in(input.data() + pos, len);
+                bool last = pos + len == input.size();
+                auto r = last ? encoder.finish(in, BufferView(out))
+                              : encoder.process(in, BufferView(out));
+                ASSERT_TRUE(r.status == EncodingStatus::Ok ||
+                            r.status == EncodingStatus::OutputBufferFull);
+                pos += r.processed;
+                encoded.insert(encoded.end(), out.begin(),
+                               out.begin() + r.output);
+                done = last && r.status == EncodingStatus::Ok &&
+                       r.processed == len;
+            }
+            EXPECT_EQ(encoder.digest(), checksum(type, BufferView(input)));
+
+            std::vector<uint8_t> decoded(input.size());
+            auto r = decoder.finish(BufferView(encoded), BufferView(decoded));
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            ASSERT_EQ(decoded, input);
+            EXPECT_EQ(decoder.digest(), encoder.digest());
+        }
+    }
+
+    // A broken stream stops with the error; reset() starts over.
+    ChecksumCodec decoder(std::make_unique<Base64Decoder>());
+    std::string bad = "QUJD*";
+    std::vector<uint8_t> out(16);
+    EXPECT_EQ(decoder.finish(view_of(bad), BufferView(out)).status,
+              EncodingStatus::InvalidInput);
+    decoder.reset();
+    std::string good = "QUJD";
+    ASSERT_EQ(decoder.finish(view_of(good), BufferView(out)).status,
+              EncodingStatus::Ok);
+    EXPECT_EQ(decoder.digest(), crc32c(view_of(good)));
+
+    EXPECT_THROW(ChecksumCodec(nullptr), std::invalid_argument);
+    EXPECT_THROW(ChecksumCodec(std::make_unique<Base64Decoder>(),
+                               ChecksumType::CRC32C,
+                               ChecksumCodec::Side::Input, 0),
+                 std::invalid_argument);
+}
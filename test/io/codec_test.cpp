@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+namespace {
+
+using namespace csics;
+using namespace csics::io::encdec;
+using csics::io::compression::CompressionStatus;
+using csics::io::compression::CompressorType;
+using csics::io::compression::ICompressor;
+using csics::io::decompression::IDecompressor;
+
+std::unique_ptr<ICodec> base64_stage(bool decode) {
+    if (decode) {
+        return std::make_unique<Base64Decoder>();
+    }
+    return std::make_unique<Base64Encoder>();
+}
+
+CodecChain encode_chain(std::size_t chunk) {
+    std::vector<std::unique_ptr<ICodec>> stages;
+    stages.push_back(std::make_unique<CompressorCodec>(
+        ICompressor::create(CompressorType::ZLIB)));
+    stages.push_back(base64_stage(false));
+    return CodecChain(std::move(stages), chunk);
+}
+
+CodecChain decode_chain(std::size_t chunk) {
+    std::vector<std::unique_ptr<ICodec>> stages;
+    stages.push_back(base64_stage(true));
+    stages.push_back(std::make_unique<DecompressorCodec>(
+        IDecompressor::create(CompressorType::ZLIB)));
+    return CodecChain(std::move(stages), chunk);
+}
+
+// Runs a whole stream through `codec` in random input and output pieces.
+std::vector<uint8_t> drive(ICodec& codec, std::vector<uint8_t> input,
+                           std::mt19937& rng) {
+    std::uniform_int_distribution<std::size_t> piece(0, 3000);
+    std::vector<uint8_t> result;
+    std::size_t pos = 0;
+    bool done = false;
+    while (!done) {
+        std::size_t in_len = std::min(piece(rng), input.size() - pos);
+        std::vector<uint8_t> out(piece(rng));
+        BufferView in(input.data() + pos, in_len);
+        bool last = pos + in_len == input.size();
+        auto r = last ? codec.finish(in, BufferView(out))
+                      : codec.process(in, BufferView(out));
+        EXPECT_TRUE(r.status == EncodingStatus::Ok ||
+                    r.status == EncodingStatus::OutputBufferFull);
+        if (!(r.status == EncodingStatus::Ok ||
+              r.status == EncodingStatus::OutputBufferFull)) {
+            break;
+        }
+        pos += r.processed;
+        result.insert(result.end(), out.begin(), out.begin() + r.output);
+        done = last && r.status == EncodingStatus::Ok &&
+               r.processed == in_len;
+    }
+    return result;
+}
+
+std::vector<uint8_t> telemetry(std::size_t records) {
+    std::string text;
+    for (std::size_t i = 0; i < records; i++) {
+        text += "{\"seq\":" + std::to_string(i) + ",\"gain\":" +
+                std::to_string(i % 7) + ",\"freq\":915000000},";
+    }
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+};  // namespace
+
+TEST(CSICSEncDecTests, CodecChainMatchesSeparateStages) {
+    std::mt19937 rng(5);
+    auto input = telemetry(4000);
+
+    // Compressed as a whole, then Base64 encoded.
+    auto compressor = ICompressor::create(CompressorType::ZLIB);
+    std::vector<uint8_t> compressed(input.size() + 1024);
+    BufferView out(compressed);
+    auto c = compressor->compress_buffer(BufferView(input), out);
+    out += c.compressed;
+    c = compressor->finish(BufferView(), out);
+    ASSERT_EQ(c.status, CompressionStatus::InputBufferFinished);
+    compressed.resize(out.data() + c.compressed -
+                      reinterpret_cast<char*>(compressed.data()));
+    std::vector<uint8_t> expected(4 * ((compressed.size() + 2) / 3));
+    auto e = Base64Encoder().finish(BufferView(compressed),
+                                    BufferView(expected));
+    ASSERT_EQ(e.status, EncodingStatus::Ok);
+
+    for (std::size_t chunk : {16, 100, 4096, 64 * 1024}) {
+        auto encoder = encode_chain(chunk);
+        auto encoded = drive(encoder, input, rng);
+        ASSERT_EQ(encoded, expected) << "chunk " << chunk;
+
+        auto decoder = decode_chain(chunk);
+        ASSERT_EQ(drive(decoder, encoded, rng), input) << "chunk " << chunk;
+    }
+}
+
+TEST(CSICSEncDecTests, CodecChainStreamsBackToBack) {
+    std::mt19937 rng(9);
+    auto encoder = encode_chain(512);
+    auto decoder = decode_chain(512);
+    for (int iter = 0; iter < 20; iter++) {
+        auto input = iter % 2 == 0 ? telemetry(rng() % 500)
+                                   : generate_random_bytes(rng() % 5000);
+        auto encoded = drive(encoder, input, rng);
+        ASSERT_EQ(drive(decoder, encoded, rng), input) << "iter " << iter;
+    }
+}
+
+TEST(CSICSEncDecTests, CodecChainErrors) {
+    std::vector<std::unique_ptr<ICodec>> stages;
+    EXPECT_THROW(CodecChain(std::move(stages)), std::invalid_argument);
+    stages.push_back(nullptr);
+    EXPECT_THROW(CodecChain(std::move(stages)), std::invalid_argument);
+    stages.clear();
+    stages.push_back(base64_stage(false));
+    EXPECT_THROW(CodecChain(std::move(stages), 0), std::invalid_argument);
+    EXPECT_THROW(CompressorCodec(nullptr), std::invalid_argument);
+
+    std::mt19937 rng(1);
+    auto encoder = encode_chain(256);
+    auto encoded = drive(encoder, telemetry(300), rng);
+    std::vector<uint8_t> out(1 << 20);
+
+    // Valid Base64 of a frame with a broken zlib header, then invalid
+    // Base64.
+    auto decoder = decode_chain(256);
+    ASSERT_GT(encoded.size(), 4u);
+    std::vector<uint8_t> corrupt(encoded);
+    corrupt[1] = corrupt[1] == 'A' ? 'B' : 'A';
+    auto r = decoder.finish(BufferView(corrupt), BufferView(out));
+    EXPECT_EQ(r.status, EncodingStatus::InvalidInput);
+    decoder.reset();
+    corrupt = encoded;
+    corrupt[corrupt.size() / 2] = '*';
+    r = decoder.finish(BufferView(corrupt), BufferView(out));
+    EXPECT_EQ(r.status, EncodingStatus::InvalidInput);
+
+    // Usable again after a reset.
+    decoder.reset();
+    r = decoder.finish(BufferView(encoded), BufferView(out));
+    EXPECT_EQ(r.status, EncodingStatus::Ok);
+    EXPECT_EQ(r.output, telemetry(300).size());
+}
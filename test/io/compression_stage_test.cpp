@@ -0,0 +1,247 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+using csics::queue::SPSCError;
+using csics::queue::SPSCQueue;
+using Flags = CompressedBlockHeader::Flags;
+
+namespace {
+
+struct Frame {
+    CompressedBlockHeader first;
+    std::vector<uint8_t> data;
+    bool ended = false;
+};
+
+// Reads output blocks until the stage is done, grouped into frames.
+std::vector<Frame> collect(SPSCQueue& queue, const CompressionStage& stage) {
+    std::vector<Frame> frames;
+    while (true) {
+        SPSCQueue::ReadSlot slot{};
+        if (queue.acquire_read(slot) != SPSCError::None) {
+            if (stage.done() && queue.acquire_read(slot) != SPSCError::None) {
+                break;
+            }
+            if (slot.data == nullptr) {
+                std::this_thread::yield();
+                continue;
+            }
+        }
+        CompressedBlockHeader hdr;
+        std::memcpy(&hdr, slot.data, sizeof(hdr));
+        if (hdr.has(Flags::FRAME_START)) {
+            EXPECT_TRUE(frames.empty() || frames.back().ended);
+            frames.push_back(Frame{hdr, {}, false});
+        }
+        EXPECT_FALSE(frames.empty());
+        EXPECT_EQ(hdr.frame, frames.back().first.frame);
+        EXPECT_EQ(hdr.frame_offset, frames.back().first.frame_offset);
+        auto* payload =
+            reinterpret_cast<uint8_t*>(slot.data) + sizeof(hdr);
+        frames.back().data.insert(frames.back().data.end(), payload,
+                                  payload + slot.size - sizeof(hdr));
+        frames.back().ended = hdr.has(Flags::FRAME_END);
+        queue.commit_read(std::move(slot));
+    }
+    return frames;
+}
+
+};  // namespace
+
+TEST(CSICSCompressionTests, CompressionStageRoundTrip) {
+    constexpr std::size_t kBlockSize = 4096;
+    constexpr std::size_t kBlocks = 100;
+    constexpr std::size_t kBlocksPerFrame = 8;
+
+    // Half noise, so frames span several small output blocks.
+    auto input = generate_random_bytes(kBlockSize * kBlocks);
+    for (std::size_t i = 0; i < input.size(); i += 2) {
+        input[i] = static_cast<uint8_t>(i % 29);
+    }
+
+    SPSCQueue in_queue(SPSCQueue::capacity_for(kBlockSize, 4));
+    SPSCQueue out_queue(SPSCQueue::capacity_for(1024, 4));
+    CompressionStage::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.blocks_per_frame = kBlocksPerFrame;
+    config.output_block_size = 1024;
+    CompressionStage stage(in_queue.get_read_handle(),
+                           out_queue.get_write_handle(), config);
+    stage.start();
+
+    std::thread producer([&] {
+        for (std::size_t b = 0; b < kBlocks; b++) {
+            SPSCQueue::WriteSlot slot{};
+            while (in_queue.acquire_write(slot, kBlockSize) !=
+                   SPSCError::None) {
+                std::this_thread::yield();
+            }
+            std::memcpy(slot.data, input.data() + b * kBlockSize, kBlockSize);
+            in_queue.commit_write(std::move(slot));
+        }
+        EXPECT_EQ(stage.stop(), CompressionStatus::InputBufferFinished);
+    });
+    auto frames = collect(out_queue, stage);
+    producer.join();
+
+    std::size_t expected_frames =
+        (kBlocks + kBlocksPerFrame - 1) / kBlocksPerFrame;
+    ASSERT_EQ(frames.size(), expected_frames);
+    auto stats = stage.stats();
+    EXPECT_EQ(stats.blocks_in, kBlocks);
+    EXPECT_EQ(stats.bytes_in, input.size());
+    EXPECT_EQ(stats.frames, expected_frames);
+    EXPECT_GT(stats.blocks_out, expected_frames);
+
+    // Every frame decodes on its own, at the offset its header gives.
+    auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+    for (std::size_t f = 0; f < frames.size(); f++) {
+        EXPECT_EQ(frames[f].first.frame, f);
+        EXPECT_TRUE(frames[f].ended);
+        std::size_t offset = frames[f].first.frame_offset;
+        ASSERT_EQ(offset, f * kBlocksPerFrame * kBlockSize);
+        std::size_t size =
+            std::min(kBlocksPerFrame * kBlockSize, input.size() - offset);
+
+        std::vector<uint8_t> out(size);
+        decompressor->reset();
+        auto r = decompressor->finish(BufferView(frames[f].data),
+                                      BufferView(out));
+        ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        ASSERT_EQ(r.decompressed, size);
+        EXPECT_TRUE(std::equal(out.begin(), out.end(),
+                               input.begin() + offset));
+    }
+}
+
+TEST(CSICSCompressionTests, CompressionStageEmptyStream) {
+    SPSCQueue in_queue(4096);
+    SPSCQueue out_queue(SPSCQueue::capacity_for(1024, 2));
+    CompressionStage::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.output_block_size = 1024;
+    CompressionStage stage(in_queue.get_read_handle(),
+                           out_queue.get_write_handle(), config);
+    stage.start();
+    EXPECT_EQ(stage.stop(), CompressionStatus::InputBufferFinished);
+
+    auto frames = collect(out_queue, stage);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_TRUE(frames[0].ended);
+
+    auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+    std::vector<uint8_t> out(16);
+    auto r = decompressor->finish(BufferView(frames[0].data), BufferView(out));
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    EXPECT_EQ(r.decompressed, 0u);
+}
+
+TEST(CSICSCompressionTests, CompressionStageBlockTooBig) {
+    SPSCQueue in_queue(4096);
+    SPSCQueue out_queue(1024);
+    CompressionStage::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.output_block_size = 64 * 1024;
+    CompressionStage stage(in_queue.get_read_handle(),
+                           out_queue.get_write_handle(), config);
+    stage.start();
+    EXPECT_EQ(stage.stop(), CompressionStatus::FatalError);
+    EXPECT_TRUE(stage.failed());
+    EXPECT_TRUE(out_queue.empty());
+}
+
+TEST(CSICSCompressionTests, CompressionStageAdaptiveStore) {
+    constexpr std::size_t kBlockSize = 4096;
+    constexpr std::size_t kBlocks = 24;
+    constexpr std::size_t kBlocksPerFrame = 4;
+    auto input = generate_random_bytes(kBlockSize * kBlocks);
+
+    SPSCQueue in_queue(SPSCQueue::capacity_for(kBlockSize, 4));
+    SPSCQueue out_queue(SPSCQueue::capacity_for(1024, 4));
+    CompressionStage::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.blocks_per_frame = kBlocksPerFrame;
+    config.output_block_size = 1024;
+    // Any fill is too much, every frame after the first is stored.
+    LevelController::Config adaptive{};
+    adaptive.min_level = 1;
+    adaptive.max_level = 6;
+    adaptive.low_water = 0.0;
+    adaptive.high_water = 0.0;
+    adaptive.store_water = 0.0;
+    config.adaptive_level = adaptive;
+    CompressionStage stage(in_queue.get_read_handle(),
+                           out_queue.get_write_handle(), config);
+    EXPECT_EQ(stage.stats().level, 6);
+    stage.start();
+
+    std::thread producer([&] {
+        for (std::size_t b = 0; b < kBlocks; b++) {
+            SPSCQueue::WriteSlot slot{};
+            while (in_queue.acquire_write(slot, kBlockSize) !=
+                   SPSCError::None) {
+                std::this_thread::yield();
+            }
+            std::memcpy(slot.data, input.data() + b * kBlockSize, kBlockSize);
+            in_queue.commit_write(std::move(slot));
+        }
+        EXPECT_EQ(stage.stop(), CompressionStatus::InputBufferFinished);
+    });
+    auto frames = collect(out_queue, stage);
+    producer.join();
+
+    std::size_t expected_frames = kBlocks / kBlocksPerFrame;
+    ASSERT_EQ(frames.size(), expected_frames);
+    auto stats = stage.stats();
+    EXPECT_EQ(stats.frames, expected_frames);
+    EXPECT_EQ(stats.stored_frames, expected_frames - 1);
+
+    auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+    for (std::size_t f = 0; f < frames.size(); f++) {
+        std::size_t offset = frames[f].first.frame_offset;
+        ASSERT_EQ(offset, f * kBlocksPerFrame * kBlockSize);
+        std::size_t size = kBlocksPerFrame * kBlockSize;
+        EXPECT_EQ(frames[f].first.has(Flags::STORED), f > 0);
+        std::vector<uint8_t> out(size);
+        if (frames[f].first.has(Flags::STORED)) {
+            ASSERT_EQ(frames[f].data.size(), size);
+            out = frames[f].data;
+        } else {
+            decompressor->reset();
+            auto r = decompressor->finish(BufferView(frames[f].data),
+                                          BufferView(out));
+            ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+            ASSERT_EQ(r.decompressed, size);
+        }
+        EXPECT_TRUE(std::equal(out.begin(), out.end(),
+                               input.begin() + offset));
+    }
+}
+
+TEST(CSICSCompressionTests, CompressionStageAdaptiveInvalid) {
+    SPSCQueue in_queue(4096);
+    SPSCQueue out_queue(SPSCQueue::capacity_for(1024, 2));
+    CompressionStage::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.output_block_size = 1024;
+    config.adaptive_level = LevelController::Config{};
+    EXPECT_THROW(CompressionStage(in_queue.get_read_handle(),
+                                  out_queue.get_write_handle(), config),
+                 std::invalid_argument);
+
+    config.blocks_per_frame = 4;
+    config.adaptive_level->max_level = 22;
+    EXPECT_THROW(CompressionStage(in_queue.get_read_handle(),
+                                  out_queue.get_write_handle(), config),
+                 std::invalid_argument);
+}
@@ -0,0 +1,118 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+namespace {
+
+std::string make_message(std::size_t i) {
+    return "{\"seq\":" + std::to_string(i) +
+           ",\"payload\":\"" + std::string(100 + i % 50, 'a' + i % 26) + "\"}";
+}
+
+std::vector<char> compress(ICompressor& compressor, std::string msg) {
+    std::vector<char> out(msg.size() + 256);
+    auto r = compressor.finish(BufferView(msg.data(), msg.size()),
+                               BufferView(out));
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    EXPECT_EQ(r.input_consumed, msg.size());
+    out.resize(r.compressed);
+    return out;
+}
+
+std::string decompress(std::vector<char> frame) {
+    auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+    std::string out(4096, '\0');
+    auto r = decompressor->finish(BufferView(frame),
+                                  BufferView(out.data(), out.size()));
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    out.resize(r.decompressed);
+    return out;
+}
+
+};  // namespace
+
+TEST(CSICSCompressorPoolTests, ReusesResetContexts) {
+    CompressorPool pool(CompressorType::ZLIB);
+    EXPECT_EQ(pool.idle(), 1u);
+
+    ICompressor* first = nullptr;
+    for (std::size_t i = 0; i < 3; i++) {
+        auto compressor = pool.acquire();
+        EXPECT_EQ(pool.idle(), 0u);
+        if (first == nullptr) {
+            first = compressor.get();
+        }
+        EXPECT_EQ(compressor.get(), first);
+        // A finished stream needs the reset done on release.
+        auto msg = make_message(i);
+        EXPECT_EQ(decompress(compress(*compressor, msg)), msg);
+    }
+    EXPECT_EQ(pool.idle(), 1u);
+}
+
+TEST(CSICSCompressorPoolTests, ResetDropsPartialStream) {
+    auto compressor = ICompressor::create(CompressorType::ZLIB);
+    std::string partial(5000, 'x');
+    std::vector<char> out(8192);
+    compressor->compress_buffer(BufferView(partial.data(), partial.size()),
+                                BufferView(out));
+    compressor->reset();
+
+    auto msg = make_message(7);
+    EXPECT_EQ(decompress(compress(*compressor, msg)), msg);
+}
+
+TEST(CSICSCompressorPoolTests, KeepsAtMostMaxIdle) {
+    CompressorPool pool(CompressorType::ZLIB, {}, 2, 2);
+    EXPECT_EQ(pool.idle(), 2u);
+    {
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        auto c = pool.acquire();
+        EXPECT_EQ(pool.idle(), 0u);
+    }
+    EXPECT_EQ(pool.idle(), 2u);
+
+    CompressionOptions bad{};
+    bad.level = 42;
+    EXPECT_THROW(CompressorPool(CompressorType::ZLIB, bad),
+                 std::invalid_argument);
+}
+
+TEST(CSICSCompressorPoolTests, ConcurrentUse) {
+    constexpr std::size_t kThreads = 4;
+    constexpr std::size_t kMessages = 200;
+    CompressorPool pool(CompressorType::ZLIB, {}, kThreads, kThreads);
+
+    std::vector<std::vector<std::vector<char>>> frames(kThreads);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < kThreads; t++) {
+        threads.emplace_back([&, t] {
+            for (std::size_t i = 0; i < kMessages; i++) {
+                auto compressor = pool.acquire();
+                frames[t].push_back(
+                    compress(*compressor, make_message(t * kMessages + i)));
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    EXPECT_LE(pool.idle(), kThreads);
+    for (std::size_t t = 0; t < kThreads; t++) {
+        ASSERT_EQ(frames[t].size(), kMessages);
+        for (std::size_t i = 0; i < kMessages; i++) {
+            EXPECT_EQ(decompress(frames[t][i]),
+                      make_message(t * kMessages + i));
+        }
+    }
+}
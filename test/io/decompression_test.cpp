@@ -0,0 +1,198 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+#ifdef CSICS_USE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef CSICS_USE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+namespace {
+
+std::vector<uint8_t> make_input(std::size_t size) {
+    auto data = generate_random_bytes(size);
+    for (std::size_t i = 0; i < size; i += 3) {
+        data[i] = static_cast<uint8_t>(i % 37);
+    }
+    return data;
+}
+
+std::vector<uint8_t> compress(CompressorType type,
+                              const std::vector<uint8_t>& input) {
+    auto compressor = ICompressor::create(type);
+    std::vector<uint8_t> in = input;
+    std::vector<uint8_t> out(input.size() + input.size() / 8 + 4096);
+    auto r = compressor->finish(BufferView(in), BufferView(out));
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    out.resize(r.compressed);
+    return out;
+}
+
+// Feeds the input and drains the output in small pieces.
+std::vector<uint8_t> decompress_streaming(IDecompressor& decompressor,
+                                          std::vector<uint8_t>& compressed) {
+    std::vector<uint8_t> result;
+    std::vector<uint8_t> out(777);
+    BufferView in(compressed);
+    CompressionStatus status = CompressionStatus::NeedsInput;
+    while (!in.empty() || status == CompressionStatus::OutputBufferFull) {
+        BufferView piece = in(0, std::min<std::size_t>(in.size(), 501));
+        auto r = decompressor.decompress_partial(piece, BufferView(out));
+        EXPECT_NE(r.status, CompressionStatus::FatalError);
+        if (r.status == CompressionStatus::FatalError) {
+            break;
+        }
+        result.insert(result.end(), out.begin(), out.begin() + r.decompressed);
+        in += r.input_consumed;
+        status = r.status;
+    }
+    EXPECT_EQ(status, CompressionStatus::InputBufferFinished);
+    return result;
+}
+
+void check_truncated(CompressorType type) {
+    auto input = make_input(100000);
+    auto compressed = compress(type, input);
+    std::vector<uint8_t> out(input.size());
+    auto decompressor = IDecompressor::create(type);
+
+    BufferView truncated = BufferView(compressed)(0, compressed.size() / 2);
+    auto r = decompressor->finish(truncated, BufferView(out));
+    EXPECT_EQ(r.status, CompressionStatus::FatalError);
+
+    // The context is usable again afterwards.
+    r = decompressor->finish(BufferView(compressed), BufferView(out));
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    ASSERT_EQ(r.decompressed, input.size());
+    EXPECT_THAT(out, ::testing::ElementsAreArray(input));
+}
+
+};  // namespace
+
+#ifdef CSICS_USE_ZLIB
+TEST(CSICSDecompressionTests, ZLIBStreaming) {
+    auto input = make_input(300000);
+    auto compressed = compress(CompressorType::ZLIB, input);
+    auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+
+    // Twice, reusing the context.
+    for (int i = 0; i < 2; i++) {
+        auto result = decompress_streaming(*decompressor, compressed);
+        ASSERT_EQ(result.size(), input.size());
+        EXPECT_THAT(result, ::testing::ElementsAreArray(input));
+    }
+}
+
+TEST(CSICSDecompressionTests, ZLIBGzipAndConcatenatedFrames) {
+    auto input = make_input(200000);
+
+    // gzip framing from zlib itself.
+    std::vector<uint8_t> gz(compressBound(input.size()) + 64);
+    z_stream zs{};
+    deflateInit2(&zs, 6, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+    zs.next_in = input.data();
+    zs.avail_in = input.size();
+    zs.next_out = gz.data();
+    zs.avail_out = gz.size();
+    ASSERT_EQ(deflate(&zs, Z_FINISH), Z_STREAM_END);
+    gz.resize(zs.total_out);
+    deflateEnd(&zs);
+
+    auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+    std::vector<uint8_t> out(input.size());
+    auto r = decompressor->finish(BufferView(gz), BufferView(out));
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    EXPECT_EQ(r.decompressed, input.size());
+    EXPECT_THAT(out, ::testing::ElementsAreArray(input));
+
+    // One zlib stream per chunk, decoded in a single call.
+    ParallelCompressor::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.chunk_size = 16 * 1024;
+    config.workers = 2;
+    ParallelCompressor compressor(config);
+    std::vector<uint8_t> frames(input.size() * 2);
+    auto c = compressor.finish(BufferView(input), BufferView(frames));
+    ASSERT_EQ(c.status, CompressionStatus::InputBufferFinished);
+    frames.resize(c.compressed);
+
+    std::fill(out.begin(), out.end(), 0);
+    r = decompressor->decompress_buffer(BufferView(frames), BufferView(out));
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    EXPECT_EQ(r.input_consumed, frames.size());
+    EXPECT_EQ(r.decompressed, input.size());
+    EXPECT_THAT(out, ::testing::ElementsAreArray(input));
+}
+
+TEST(CSICSDecompressionTests, ZLIBTruncated) {
+    check_truncated(CompressorType::ZLIB);
+}
+#endif
+
+#ifdef CSICS_USE_ZSTD
+TEST(CSICSDecompressionTests, ZSTDStreaming) {
+    auto input = make_input(300000);
+    auto compressed = compress(CompressorType::ZSTD, input);
+    auto decompressor = IDecompressor::create(CompressorType::ZSTD);
+
+    for (int i = 0; i < 2; i++) {
+        auto result = decompress_streaming(*decompressor, compressed);
+        ASSERT_EQ(result.size(), input.size());
+        EXPECT_THAT(result, ::testing::ElementsAreArray(input));
+    }
+}
+
+TEST(CSICSDecompressionTests, ZSTDKnownContentSize) {
+    // ZSTD_compress records the content size, taking the one-shot path.
+    auto first = make_input(50000);
+    auto second = make_input(70000);
+    std::vector<uint8_t> compressed(ZSTD_compressBound(120000) * 2);
+    std::size_t a = ZSTD_compress(compressed.data(), compressed.size(),
+                                  first.data(), first.size(), 3);
+    std::size_t b = ZSTD_compress(compressed.data() + a, compressed.size() - a,
+                                  second.data(), second.size(), 3);
+    compressed.resize(a + b);
+    ASSERT_NE(ZSTD_getFrameContentSize(compressed.data(), a),
+              ZSTD_CONTENTSIZE_UNKNOWN);
+
+    auto decompressor = IDecompressor::create(CompressorType::ZSTD);
+    std::vector<uint8_t> out(first.size() + second.size());
+    auto r = decompressor->finish(BufferView(compressed), BufferView(out));
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    EXPECT_EQ(r.decompressed, out.size());
+    first.insert(first.end(), second.begin(), second.end());
+    EXPECT_THAT(out, ::testing::ElementsAreArray(first));
+}
+
+TEST(CSICSDecompressionTests, ZSTDTruncated) {
+    check_truncated(CompressorType::ZSTD);
+}
+#endif
+
+#ifdef CSICS_USE_LZ4
+TEST(CSICSDecompressionTests, LZ4Streaming) {
+    auto input = make_input(300000);
+    auto compressed = compress(CompressorType::LZ4, input);
+    auto decompressor = IDecompressor::create(CompressorType::LZ4);
+
+    for (int i = 0; i < 2; i++) {
+        auto result = decompress_streaming(*decompressor, compressed);
+        ASSERT_EQ(result.size(), input.size());
+        EXPECT_THAT(result, ::testing::ElementsAreArray(input));
+    }
+}
+
+TEST(CSICSDecompressionTests, LZ4Truncated) {
+    check_truncated(CompressorType::LZ4);
+}
+#endif
@@ -0,0 +1,316 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <csics/csics.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace csics;
+using namespace csics::io::net;
+using namespace std::chrono_literals;
+
+// Reads until `size` bytes arrived or the connection ends.
+std::string recv_exactly(TCPEndpoint& endpoint, std::size_t size) {
+    std::string data(size, '\0');
+    std::size_t got = 0;
+    while (got < size) {
+        auto r = endpoint.recv(BufferView(data.data() + got, size - got));
+        if (r.status != NetStatus::Success) {
+            break;
+        }
+        got += r.bytes_transferred;
+    }
+    data.resize(got);
+    return data;
+}
+
+BufferView view_of(std::string& s) { return BufferView(s.data(), s.size()); }
+
+// Echoes everything back on every connection, all on the loop thread.
+class EchoServer {
+   public:
+    explicit EchoServer(EventLoop& loop) : loop_(loop) {
+        EXPECT_EQ(listener_.listen(SockAddr::localhost(0)),
+                  NetStatus::Success);
+        EXPECT_EQ(loop_.add(listener_, IoEvent::Readable,
+                            [this](IoEvent) { accept_all(); }),
+                  NetStatus::Success);
+    }
+
+    Port port() const { return listener_.local_address().port(); }
+
+    std::atomic<int> accepted{0};
+    std::atomic<int> closed{0};
+
+   private:
+    struct Connection {
+        TCPEndpoint endpoint;
+        // Read but not yet echoed, the client was not reading.
+        std::string pending;
+    };
+
+    void accept_all() {
+        for (;;) {
+            auto c = std::make_unique<Connection>();
+            if (listener_.accept(c->endpoint) != NetStatus::Success) {
+                return;
+            }
+            Connection* raw = c.get();
+            loop_.add(c->endpoint, IoEvent::Readable | IoEvent::Writable,
+                      [this, raw](IoEvent) { echo(*raw); });
+            connections_.push_back(std::move(c));
+            accepted++;
+        }
+    }
+
+    // Edge triggered, so reads until Empty, or until the client stops
+    // taking the echo; its Writable edge resumes from there.
+    void echo(Connection& c) {
+        char buffer[4096];
+        for (;;) {
+            while (!c.pending.empty()) {
+                auto r = c.endpoint.send(view_of(c.pending));
+                if (r.status == NetStatus::Empty) {
+                    return;
+                }
+                if (r.status != NetStatus::Success) {
+                    close(c);
+                    return;
+                }
+                c.pending.erase(0, r.bytes_transferred);
+            }
+            auto r = c.endpoint.recv(BufferView(buffer, sizeof(buffer)));
+            if (r.status == NetStatus::Success) {
+                c.pending.assign(buffer, r.bytes_transferred);
+                continue;
+            }
+            if (r.status != NetStatus::Empty) {
+                close(c);
+            }
+            return;
+        }
+    }
+
+    void close(Connection& c) {
+        loop_.remove(c.endpoint);
+        c.endpoint.close();
+        closed++;
+    }
+
+    EventLoop& loop_;
+    TCPEndpoint listener_;
+    std::vector<std::unique_ptr<Connection>> connections_;
+};
+
+template <typename Pred>
+bool wait_for(Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+};  // namespace
+
+TEST(CSICSNetTests, IPAddressParse) {
+    EXPECT_EQ(IPAddress("192.168.1.20").v4(),
+              (std::array<uint8_t, 4>{192, 168, 1, 20}));
+    EXPECT_EQ(IPAddress(std::string("127.0.0.1")).v4(),
+              IPAddress::localhost().v4());
+    for (const char* bad : {"256.1.1.1", "1.2.3", "1.2.3.4.5", "1..2.3",
+                            "a.b.c.d", "1.2.3.4 ", ""}) {
+        EXPECT_THROW(IPAddress{bad}, std::invalid_argument) << bad;
+    }
+}
+
+TEST(CSICSNetTests, EventLoopServesManyConnections) {
+    EventLoop loop;
+    EchoServer server(loop);
+    std::thread thread([&] { loop.run(); });
+
+    constexpr int kClients = 64;
+    std::vector<TCPEndpoint> clients(kClients);
+    for (int i = 0; i < kClients; i++) {
+        ASSERT_EQ(clients[i].connect(SockAddr::localhost(server.port())),
+                  NetStatus::Success);
+    }
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < kClients; i++) {
+            std::string msg = "frame " + std::to_string(i) + "/" +
+                              std::to_string(round);
+            ASSERT_EQ(clients[i].send(view_of(msg)).status,
+                      NetStatus::Success);
+        }
+        for (int i = 0; i < kClients; i++) {
+            std::string msg = "frame " + std::to_string(i) + "/" +
+                              std::to_string(round);
+            EXPECT_EQ(recv_exactly(clients[i], msg.size()), msg);
+        }
+    }
+    EXPECT_EQ(server.accepted.load(), kClients);
+
+    // A large message is drained across several edges.
+    std::string large(1 << 20, 'x');
+    std::thread sender([&] { clients[0].send(view_of(large)); });
+    EXPECT_EQ(recv_exactly(clients[0], large.size()), large);
+    sender.join();
+
+    clients.clear();
+    EXPECT_TRUE(wait_for([&] { return server.closed == kClients; }));
+    loop.stop();
+    thread.join();
+    // Only the listener is left.
+    EXPECT_EQ(loop.size(), 1u);
+}
+
+TEST(CSICSNetTests, EventLoopTimers) {
+    EventLoop loop;
+    int once = 0;
+    int repeating = 0;
+    int cancelled = 0;
+    loop.add_timer(20ms, [&] { once++; });
+    auto repeat_id = loop.add_timer(2ms, [&] { repeating++; }, true);
+    auto cancel_id = loop.add_timer(1ms, [&] { cancelled++; });
+    EXPECT_TRUE(loop.cancel_timer(cancel_id));
+    EXPECT_FALSE(loop.cancel_timer(cancel_id));
+
+    // run_once() wakes for the timers though there is nothing to read.
+    auto start = std::chrono::steady_clock::now();
+    while (once == 0) {
+        loop.run_once(-1ms);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, 20ms);
+    EXPECT_LT(elapsed, 1s);
+    EXPECT_EQ(cancelled, 0);
+    EXPECT_GE(repeating, 3);
+
+    // A callback may cancel its own timer.
+    int self = 0;
+    EventLoop::TimerId self_id = 0;
+    self_id = loop.add_timer(
+        1ms,
+        [&] {
+            self++;
+            loop.cancel_timer(self_id);
+        },
+        true);
+    EXPECT_TRUE(loop.cancel_timer(repeat_id));
+    while (self == 0) {
+        loop.run_once(5ms);
+    }
+    EXPECT_EQ(loop.run_once(10ms), 0u);
+    EXPECT_EQ(self, 1);
+
+    EXPECT_THROW(loop.add_timer(0ms, [] {}, true), std::invalid_argument);
+}
+
+TEST(CSICSNetTests, EventLoopPostAndStop) {
+    EventLoop loop;
+    std::atomic<int> ran{0};
+    std::thread thread([&] { loop.run(); });
+    for (int i = 0; i < 100; i++) {
+        loop.post([&] { ran++; });
+    }
+    EXPECT_TRUE(wait_for([&] { return ran == 100; }));
+    loop.stop();
+    thread.join();
+
+    // Runs again after a stop.
+    std::thread again([&] { loop.run(); });
+    loop.post([&] { loop.stop(); });
+    again.join();
+}
+
+TEST(CSICSNetTests, EventLoopUdp) {
+    EventLoop loop;
+    UDPEndpoint receiver;
+    UDPEndpoint sender;
+    ASSERT_EQ(receiver.bind(SockAddr::localhost(0)), NetStatus::Success);
+    ASSERT_EQ(sender.bind(SockAddr::localhost(0)), NetStatus::Success);
+
+    std::vector<std::string> got;
+    Port from = 0;
+    ASSERT_EQ(loop.add(receiver, IoEvent::Readable,
+                       [&](IoEvent events) {
+                           EXPECT_TRUE(any(events & IoEvent::Readable));
+                           char buffer[64];
+                           SockAddr src;
+                           for (;;) {
+                               auto r = receiver.recv(
+                                   BufferView(buffer, sizeof(buffer)), src);
+                               if (r.status != NetStatus::Success) {
+                                   return;
+                               }
+                               got.emplace_back(buffer, r.bytes_transferred);
+                               from = src.port();
+                           }
+                       }),
+              NetStatus::Success);
+    EXPECT_EQ(loop.add(receiver, IoEvent::Readable, [](IoEvent) {}),
+              NetStatus::Error);
+
+    for (std::string msg : {"a", "bb", "ccc"}) {
+        ASSERT_EQ(sender.send(view_of(msg), receiver.local_address()).status,
+                  NetStatus::Success);
+    }
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (got.size() < 3 && std::chrono::steady_clock::now() < deadline) {
+        loop.run_once(10ms);
+    }
+    EXPECT_EQ(got, (std::vector<std::string>{"a", "bb", "ccc"}));
+    EXPECT_EQ(from, sender.local_address().port());
+
+    char buffer[8];
+    SockAddr src;
+    EXPECT_EQ(receiver.recv(BufferView(buffer, sizeof(buffer)), src).status,
+              NetStatus::Empty);
+    EXPECT_EQ(loop.remove(receiver), NetStatus::Success);
+    EXPECT_EQ(loop.remove(receiver), NetStatus::Error);
+}
+
+TEST(CSICSNetTests, TCPEndpointPoll) {
+    TCPEndpoint listener;
+    ASSERT_EQ(listener.listen(SockAddr::localhost(0)), NetStatus::Success);
+    Port port = listener.local_address().port();
+    TCPEndpoint a;
+    TCPEndpoint b;
+    ASSERT_EQ(a.connect(SockAddr::localhost(port)), NetStatus::Success);
+    ASSERT_EQ(b.connect(SockAddr::localhost(port)), NetStatus::Success);
+    TCPEndpoint server_a;
+    TCPEndpoint server_b;
+    ASSERT_EQ(listener.accept(server_a), NetStatus::Success);
+    ASSERT_EQ(listener.accept(server_b), NetStatus::Success);
+
+    EXPECT_EQ(TCPEndpoint::poll(&server_a, 10), PollStatus::Timeout);
+    std::string msg = "ping";
+    ASSERT_EQ(a.send(view_of(msg)).status, NetStatus::Success);
+    EXPECT_EQ(TCPEndpoint::poll(&server_a, 1000), PollStatus::Ready);
+    EXPECT_EQ(TCPEndpoint::poll(
+                  std::vector<TCPEndpoint*>{&server_a, &server_b}, 1000),
+              (std::vector<PollStatus>{PollStatus::Ready, PollStatus::Empty}));
+    EXPECT_EQ(TCPEndpoint::poll(std::vector<TCPEndpoint*>{&server_b}, 10),
+              std::vector<PollStatus>{PollStatus::Timeout});
+    EXPECT_EQ(TCPEndpoint::poll(nullptr, 0), PollStatus::Error);
+
+    // Non-blocking reads say Empty instead of waiting.
+    EXPECT_EQ(recv_exactly(server_a, msg.size()), msg);
+    ASSERT_EQ(server_a.set_nonblocking(true), NetStatus::Success);
+    char buffer[8];
+    EXPECT_EQ(server_a.recv(BufferView(buffer, sizeof(buffer))).status,
+              NetStatus::Empty);
+    a.close();
+    EXPECT_EQ(TCPEndpoint::poll(&server_a, 1000), PollStatus::Ready);
+    EXPECT_EQ(server_a.recv(BufferView(buffer, sizeof(buffer))).status,
+              NetStatus::Disconnected);
+}
@@ -0,0 +1,201 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <csics/csics.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+namespace {
+
+constexpr IQFilter kFilters[] = {IQFilter::None, IQFilter::Shuffle,
+                                 IQFilter::BitShuffle, IQFilter::DeltaShuffle,
+                                 IQFilter::DeltaBitShuffle};
+
+// SC16 tone in noise, padded with `extra` bytes short of a sample.
+std::vector<uint8_t> make_iq(std::size_t samples, std::size_t extra = 0) {
+    std::vector<uint8_t> out(samples * 4 + extra);
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 100.0f);
+    for (std::size_t i = 0; i < samples; i++) {
+        float phase = 0.02f * static_cast<float>(i);
+        int16_t iq[2] = {
+            static_cast<int16_t>(8000.0f * std::cos(phase) + noise(rng)),
+            static_cast<int16_t>(8000.0f * std::sin(phase) + noise(rng))};
+        std::memcpy(out.data() + 4 * i, iq, sizeof(iq));
+    }
+    for (std::size_t i = 0; i < extra; i++) {
+        out[samples * 4 + i] = static_cast<uint8_t>(0xA0 + i);
+    }
+    return out;
+}
+
+// The documented layout, one value at a time.
+std::vector<uint8_t> reference_encode(IQFilter filter,
+                                      const std::vector<uint8_t>& in) {
+    if (filter == IQFilter::None) {
+        return in;
+    }
+    bool delta =
+        filter == IQFilter::DeltaShuffle || filter == IQFilter::DeltaBitShuffle;
+    bool bits =
+        filter == IQFilter::BitShuffle || filter == IQFilter::DeltaBitShuffle;
+    std::size_t values = in.size() / 4 * 2;
+    auto value = [&](std::size_t n) {
+        return static_cast<uint16_t>(in[2 * n] | in[2 * n + 1] << 8);
+    };
+
+    std::vector<uint8_t> planes(2 * values);
+    for (std::size_t n = 0; n < values; n++) {
+        uint16_t v = value(n);
+        if (delta) {
+            int16_t d = static_cast<int16_t>(v - (n >= 2 ? value(n - 2) : 0));
+            v = static_cast<uint16_t>(d >= 0 ? 2 * d : -2 * d - 1);
+        }
+        planes[n] = static_cast<uint8_t>(v);
+        planes[values + n] = static_cast<uint8_t>(v >> 8);
+    }
+
+    std::vector<uint8_t> out = planes;
+    if (bits) {
+        std::size_t groups = values / 8;
+        for (std::size_t p = 0; p < 2; p++) {
+            const uint8_t* src = planes.data() + p * values;
+            uint8_t* dst = out.data() + p * values;
+            for (std::size_t k = 0; k < 8; k++) {
+                for (std::size_t g = 0; g < groups; g++) {
+                    uint8_t byte = 0;
+                    for (std::size_t i = 0; i < 8; i++) {
+                        byte |= ((src[8 * g + i] >> k) & 1) << i;
+                    }
+                    dst[k * groups + g] = byte;
+                }
+            }
+        }
+    }
+    out.insert(out.end(), in.begin() + 2 * values, in.end());
+    return out;
+}
+
+std::vector<uint8_t> compress(CompressorType type, IQFilter filter,
+                              std::vector<uint8_t>& input) {
+    CompressionOptions options{};
+    options.filter = filter;
+    auto compressor = ICompressor::create(type, options);
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> out_buf(5000);
+    BufferView in(input);
+    // Odd input sizes, so blocks are both gathered and taken whole.
+    while (!in.empty()) {
+        BufferView piece = in(0, std::min<std::size_t>(in.size(), 100003));
+        auto r = compressor->compress_partial(piece, BufferView(out_buf));
+        EXPECT_FALSE(r.status == CompressionStatus::FatalError ||
+                     r.status == CompressionStatus::InvalidState);
+        compressed.insert(compressed.end(), out_buf.begin(),
+                          out_buf.begin() + r.compressed);
+        in += r.input_consumed;
+    }
+    // ZSTD asks for a flush when its output fills while finishing.
+    CompressionResult r{};
+    do {
+        r = compressor->finish(in, BufferView(out_buf));
+        compressed.insert(compressed.end(), out_buf.begin(),
+                          out_buf.begin() + r.compressed);
+    } while (r.status == CompressionStatus::OutputBufferFull ||
+             r.status == CompressionStatus::NeedsFlush);
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    return compressed;
+}
+
+std::vector<CompressorType> backends() {
+    return {
+#ifdef CSICS_USE_ZLIB
+        CompressorType::ZLIB,
+#endif
+#ifdef CSICS_USE_ZSTD
+        CompressorType::ZSTD,
+#endif
+#ifdef CSICS_USE_LZ4
+        CompressorType::LZ4,
+#endif
+    };
+}
+
+};  // namespace
+
+TEST(CSICSIQFilterTests, MatchesReferenceLayout) {
+    for (std::size_t samples : {0, 1, 3, 4, 5, 8, 100, 1001, 16384}) {
+        for (std::size_t extra : {0, 3}) {
+            auto input = make_iq(samples, extra);
+            for (IQFilter filter : kFilters) {
+                std::vector<uint8_t> encoded(input.size());
+                iq_filter_encode(filter, BufferView(input),
+                                 BufferView(encoded));
+                EXPECT_THAT(encoded, ::testing::ElementsAreArray(
+                                         reference_encode(filter, input)))
+                    << "samples " << samples << " filter "
+                    << static_cast<int>(filter);
+
+                std::vector<uint8_t> decoded(input.size());
+                iq_filter_decode(filter, BufferView(encoded),
+                                 BufferView(decoded));
+                EXPECT_THAT(decoded, ::testing::ElementsAreArray(input));
+            }
+        }
+    }
+}
+
+TEST(CSICSIQFilterTests, RoundTripThroughBackends) {
+    // Several blocks and a short last one.
+    auto input = make_iq(3 * kIQFilterBlockSize / 4 + 1234, 2);
+    for (CompressorType type : backends()) {
+        for (IQFilter filter : kFilters) {
+            auto compressed = compress(type, filter, input);
+
+            DecompressionOptions options{};
+            options.filter = filter;
+            auto decompressor = IDecompressor::create(type, options);
+            std::vector<uint8_t> result;
+            std::vector<uint8_t> out(777);
+            BufferView in(compressed);
+            CompressionStatus status = CompressionStatus::NeedsInput;
+            while (!in.empty() ||
+                   status == CompressionStatus::OutputBufferFull) {
+                BufferView piece =
+                    in(0, std::min<std::size_t>(in.size(), 501));
+                auto r =
+                    decompressor->decompress_partial(piece, BufferView(out));
+                ASSERT_NE(r.status, CompressionStatus::FatalError);
+                result.insert(result.end(), out.begin(),
+                              out.begin() + r.decompressed);
+                in += r.input_consumed;
+                status = r.status;
+            }
+            EXPECT_EQ(status, CompressionStatus::InputBufferFinished);
+            ASSERT_EQ(result.size(), input.size());
+            EXPECT_THAT(result, ::testing::ElementsAreArray(input));
+
+            // Decoded again in one call, straight into the output.
+            std::vector<uint8_t> whole(input.size());
+            auto r = decompressor->finish(BufferView(compressed),
+                                          BufferView(whole));
+            ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+            EXPECT_EQ(r.decompressed, input.size());
+            EXPECT_THAT(whole, ::testing::ElementsAreArray(input));
+        }
+    }
+}
+
+TEST(CSICSIQFilterTests, ImprovesRatio) {
+    auto input = make_iq(256 * 1024);
+    for (CompressorType type : backends()) {
+        auto plain = compress(type, IQFilter::None, input);
+        auto filtered = compress(type, IQFilter::DeltaShuffle, input);
+        EXPECT_LT(filtered.size(), plain.size() * 9 / 10);
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <stdexcept>
+
+using namespace csics::io::compression;
+
+namespace {
+
+LevelController::Config make_config() {
+    LevelController::Config config{};
+    config.min_level = 1;
+    config.max_level = 9;
+    config.low_water = 0.1;
+    config.high_water = 0.5;
+    config.store_water = 0.9;
+    config.hold_frames = 0;
+    return config;
+}
+
+};  // namespace
+
+TEST(CSICSCompressionTests, LevelControllerBacksOffWhenBehind) {
+    LevelController controller(make_config(), 9);
+    EXPECT_EQ(controller.update({0.6, 0.0}).level, 5);
+    EXPECT_EQ(controller.update({0.6, 0.0}).level, 3);
+    EXPECT_EQ(controller.update({0.6, 0.0}).level, 2);
+    EXPECT_EQ(controller.update({0.6, 0.0}).level, 1);
+    auto d = controller.update({0.6, 0.0});
+    EXPECT_EQ(d.level, 1);
+    EXPECT_FALSE(d.store);
+}
+
+TEST(CSICSCompressionTests, LevelControllerClimbsWhenIdle) {
+    LevelController controller(make_config(), 1);
+    for (int level = 2; level <= 9; level++) {
+        EXPECT_EQ(controller.update({0.0, 0.0}).level, level);
+    }
+    EXPECT_EQ(controller.update({0.0, 0.0}).level, 9);
+    // Between the water marks the level stays.
+    LevelController steady(make_config(), 4);
+    EXPECT_EQ(steady.update({0.3, 0.0}).level, 4);
+}
+
+TEST(CSICSCompressionTests, LevelControllerStoresUntilDrained) {
+    LevelController controller(make_config(), 6);
+    auto d = controller.update({0.95, 0.0});
+    EXPECT_TRUE(d.store);
+    EXPECT_TRUE(controller.update({0.7, 0.0}).store);
+    d = controller.update({0.4, 0.0});
+    EXPECT_FALSE(d.store);
+    EXPECT_EQ(d.level, 1);
+}
+
+TEST(CSICSCompressionTests, LevelControllerHoldsChanges) {
+    auto config = make_config();
+    config.hold_frames = 2;
+    LevelController controller(config, 1);
+    EXPECT_EQ(controller.update({0.0, 0.0}).level, 2);
+    EXPECT_EQ(controller.update({0.0, 0.0}).level, 2);
+    EXPECT_EQ(controller.update({0.0, 0.0}).level, 2);
+    EXPECT_EQ(controller.update({0.0, 0.0}).level, 3);
+    // Storing is never held back.
+    EXPECT_TRUE(controller.update({1.0, 0.0}).store);
+}
+
+TEST(CSICSCompressionTests, LevelControllerOutputBudget) {
+    auto config = make_config();
+    config.max_output_bps = 1e6;
+    LevelController controller(config, 3);
+    EXPECT_EQ(controller.update({0.3, 2e6}).level, 4);
+    EXPECT_EQ(controller.update({0.3, 5e5}).level, 4);
+    // Keeping up with the input comes first.
+    EXPECT_EQ(controller.update({0.6, 2e6}).level, 3);
+}
+
+TEST(CSICSCompressionTests, LevelControllerInvalidConfig) {
+    auto config = make_config();
+    config.min_level = 10;
+    EXPECT_THROW(LevelController(config, 1), std::invalid_argument);
+    config = make_config();
+    config.high_water = 0.95;
+    EXPECT_THROW(LevelController(config, 1), std::invalid_argument);
+    EXPECT_EQ(LevelController(make_config(), 42).current().level, 9);
+}
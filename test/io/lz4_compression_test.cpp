@@ -0,0 +1,163 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <lz4frame.h>
+
+#include <csics/csics.hpp>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "../test_utils.hpp"
+#include "compression_utils.hpp"
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+namespace {
+
+// Noise with a repeated pattern every other 4 KiB.
+std::vector<uint8_t> make_input(std::size_t size) {
+    auto data = generate_random_bytes(size);
+    for (std::size_t i = 0; i < size; i++) {
+        if ((i / 4096) % 2 == 1) {
+            data[i] = static_cast<uint8_t>(i % 53);
+        }
+    }
+    return data;
+}
+
+std::vector<uint8_t> decompress(const std::vector<uint8_t>& compressed,
+                                std::size_t size) {
+    auto decompressor = IDecompressor::create(CompressorType::LZ4);
+    std::vector<uint8_t> in = compressed;
+    std::vector<uint8_t> out(size);
+    auto r = decompressor->finish(BufferView(in), BufferView(out));
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    EXPECT_EQ(r.input_consumed, in.size());
+    out.resize(r.decompressed);
+    return out;
+}
+
+};  // namespace
+
+TEST(CSICSCompressionTests, LZ4CompressorBasic) {
+    auto compressor = ICompressor::create(CompressorType::LZ4);
+    auto input = make_input(1024 * 1024 + 77);
+    std::vector<uint8_t> compressed(
+        LZ4F_compressFrameBound(input.size(), nullptr) + 4096);
+    BufferView in(input);
+    BufferView out(compressed);
+
+    // Streamed in odd sizes, crossing block boundaries.
+    while (!in.empty()) {
+        BufferView piece = in(0, std::min<std::size_t>(in.size(), 30011));
+        auto r = compressor->compress_buffer(piece, out);
+        ASSERT_EQ(r.status, CompressionStatus::NeedsInput);
+        ASSERT_EQ(r.input_consumed, piece.size());
+        in += r.input_consumed;
+        out += r.compressed;
+    }
+    auto r = compressor->finish(in, out);
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    out += r.compressed;
+    compressed.resize(compressed.size() - out.size());
+
+    std::ofstream outfile("temp_compressed.lz4", std::ios::binary);
+    outfile.write(reinterpret_cast<char*>(compressed.data()),
+                  compressed.size());
+    outfile.close();
+
+    std::vector<char> decompressed =
+        run_cmdline("lz4 -d -f -q %s %s", "temp_compressed.lz4");
+    ASSERT_EQ(decompressed.size(), input.size());
+    EXPECT_THAT(input, ::testing::ElementsAreArray(decompressed));
+
+    std::filesystem::remove("temp_compressed.lz4");
+}
+
+TEST(CSICSCompressionTests, LZ4FrameMode) {
+    auto compressor = ICompressor::create(CompressorType::LZ4);
+    auto input = make_input(200000);
+    std::vector<uint8_t> compressed(
+        LZ4F_compressFrameBound(input.size(), nullptr) + 64);
+    auto r = compressor->finish(BufferView(input), BufferView(compressed));
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    ASSERT_EQ(r.input_consumed, input.size());
+    compressed.resize(r.compressed);
+
+    // Written in one call, so the header records the size.
+    LZ4F_dctx* dctx = nullptr;
+    LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION);
+    LZ4F_frameInfo_t info{};
+    std::size_t header_size = compressed.size();
+    ASSERT_FALSE(LZ4F_isError(LZ4F_getFrameInfo(dctx, &info, compressed.data(),
+                                                &header_size)));
+    LZ4F_freeDecompressionContext(dctx);
+    EXPECT_EQ(info.contentSize, input.size());
+
+    EXPECT_THAT(decompress(compressed, input.size()),
+                ::testing::ElementsAreArray(input));
+}
+
+TEST(CSICSCompressionTests, LZ4SmallOutput) {
+    auto input = make_input(300 * 1024);
+    for (int level : {-10, 0, 9}) {
+        CompressionOptions options{};
+        options.level = level;
+        auto compressor = ICompressor::create(CompressorType::LZ4, options);
+        std::vector<uint8_t> compressed;
+        std::vector<uint8_t> out_buf(1000);
+        BufferView in(input);
+
+        while (!in.empty()) {
+            auto r = compressor->compress_partial(in, BufferView(out_buf));
+            ASSERT_TRUE(r.status == CompressionStatus::NeedsInput ||
+                        r.status == CompressionStatus::OutputBufferFull ||
+                        r.status == CompressionStatus::Ok);
+            compressed.insert(compressed.end(), out_buf.begin(),
+                              out_buf.begin() + r.compressed);
+            in += r.input_consumed;
+        }
+        CompressionResult r{};
+        do {
+            r = compressor->finish(in, BufferView(out_buf));
+            compressed.insert(compressed.end(), out_buf.begin(),
+                              out_buf.begin() + r.compressed);
+        } while (r.status == CompressionStatus::OutputBufferFull);
+        ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        EXPECT_LT(compressed.size(), input.size());
+
+        EXPECT_THAT(decompress(compressed, input.size()),
+                    ::testing::ElementsAreArray(input));
+    }
+}
+
+TEST(CSICSCompressionTests, LZ4ReusedAcrossStreams) {
+    auto compressor = ICompressor::create(CompressorType::LZ4);
+
+    // Abandoned mid-stream, with a block staged.
+    auto discarded = make_input(100000);
+    std::vector<uint8_t> scratch(10);
+    compressor->compress_buffer(BufferView(discarded), BufferView(scratch));
+    compressor->reset();
+
+    for (std::size_t size : {0, 100, 100000}) {
+        auto input = make_input(size);
+        // Too small for the frame path, so these are streamed.
+        std::vector<uint8_t> compressed(size + 64);
+        auto r = compressor->finish(BufferView(input), BufferView(compressed));
+        ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        ASSERT_EQ(r.input_consumed, size);
+        compressed.resize(r.compressed);
+        EXPECT_THAT(decompress(compressed, size),
+                    ::testing::ElementsAreArray(input));
+    }
+}
+
+TEST(CSICSCompressionTests, LZ4InvalidOptions) {
+    CompressionOptions options{};
+    options.level = LZ4F_compressionLevel_max() + 1;
+    EXPECT_THROW(ICompressor::create(CompressorType::LZ4, options),
+                 std::invalid_argument);
+}
@@ -0,0 +1,168 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <csics/csics.hpp>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+using namespace csics;
+using namespace csics::io::compression;
+
+namespace {
+
+// Inflates a sequence of zlib streams, one per frame.
+std::vector<uint8_t> inflate_frames(const std::vector<uint8_t>& compressed,
+                                    std::size_t expected_size,
+                                    std::size_t& frames) {
+    std::vector<uint8_t> out(expected_size + 1);
+    z_stream stream{};
+    inflateInit(&stream);
+    stream.next_in = const_cast<uint8_t*>(compressed.data());
+    stream.avail_in = compressed.size();
+    stream.next_out = out.data();
+    stream.avail_out = out.size();
+    frames = 0;
+    while (stream.avail_in > 0) {
+        int ret = inflate(&stream, Z_NO_FLUSH);
+        if (ret != Z_STREAM_END) {
+            break;
+        }
+        frames++;
+        inflateReset(&stream);
+    }
+    out.resize(out.size() - stream.avail_out);
+    inflateEnd(&stream);
+    return out;
+}
+
+// Half noise, half repeated pattern so frames differ in size.
+std::vector<uint8_t> make_input(std::size_t size) {
+    auto data = generate_random_bytes(size);
+    for (std::size_t i = size / 2; i < size; i++) {
+        data[i] = static_cast<uint8_t>(i % 61);
+    }
+    return data;
+}
+
+};  // namespace
+
+TEST(CSICSCompressionTests, ParallelCompressorRoundTrip) {
+    ParallelCompressor::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.chunk_size = 64 * 1024;
+    config.workers = 3;
+    ParallelCompressor compressor(config);
+
+    auto input = make_input(1024 * 1024 + 123);
+    std::vector<uint8_t> compressed(compressBound(input.size()) + 4096);
+    BufferView in(input);
+    BufferView out(compressed);
+
+    // Fed in odd sizes to cross chunk boundaries.
+    while (!in.empty()) {
+        BufferView piece = in(0, std::min<std::size_t>(in.size(), 10007));
+        auto r = compressor.compress_buffer(piece, out);
+        ASSERT_EQ(r.status, CompressionStatus::NeedsInput);
+        ASSERT_EQ(r.input_consumed, piece.size());
+        in += r.input_consumed;
+        out += r.compressed;
+    }
+    auto r = compressor.finish(in, out);
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    out += r.compressed;
+    compressed.resize(compressed.size() - out.size());
+
+    std::size_t frames = 0;
+    auto decompressed = inflate_frames(compressed, input.size(), frames);
+    EXPECT_EQ(frames, (input.size() + config.chunk_size - 1) /
+                          config.chunk_size);
+    ASSERT_EQ(decompressed.size(), input.size());
+    EXPECT_THAT(decompressed, ::testing::ElementsAreArray(input));
+}
+
+TEST(CSICSCompressionTests, ParallelCompressorSmallOutput) {
+    ParallelCompressor::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.options.level = 1;
+    config.chunk_size = 16 * 1024;
+    config.workers = 2;
+    config.max_in_flight = 3;
+    ParallelCompressor compressor(config);
+
+    auto input = make_input(300 * 1024);
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> out_buf(1000);
+    BufferView in(input);
+
+    // Output is drained through a small buffer, which throttles the input.
+    while (!in.empty()) {
+        auto r = compressor.compress_partial(in, BufferView(out_buf));
+        ASSERT_TRUE(r.status == CompressionStatus::NeedsInput ||
+                    r.status == CompressionStatus::OutputBufferFull);
+        compressed.insert(compressed.end(), out_buf.begin(),
+                          out_buf.begin() + r.compressed);
+        in += r.input_consumed;
+    }
+    CompressionResult r{};
+    do {
+        r = compressor.finish(in, BufferView(out_buf));
+        compressed.insert(compressed.end(), out_buf.begin(),
+                          out_buf.begin() + r.compressed);
+    } while (r.status == CompressionStatus::OutputBufferFull);
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+
+    std::size_t frames = 0;
+    auto decompressed = inflate_frames(compressed, input.size(), frames);
+    ASSERT_EQ(decompressed.size(), input.size());
+    EXPECT_THAT(decompressed, ::testing::ElementsAreArray(input));
+}
+
+TEST(CSICSCompressionTests, ParallelCompressorReusedAcrossStreams) {
+    ParallelCompressor::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.chunk_size = 4096;
+    config.workers = 2;
+    ParallelCompressor compressor(config);
+
+    for (std::size_t size : {0, 100, 10000}) {
+        auto input = make_input(size);
+        std::vector<uint8_t> compressed(compressBound(size) + 4096);
+        BufferView out(compressed);
+        auto r = compressor.finish(BufferView(input), out);
+        ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        ASSERT_EQ(r.input_consumed, size);
+        compressed.resize(r.compressed);
+
+        std::size_t frames = 0;
+        auto decompressed = inflate_frames(compressed, size, frames);
+        EXPECT_EQ(frames, std::max<std::size_t>(1, (size + 4095) / 4096));
+        EXPECT_THAT(decompressed, ::testing::ElementsAreArray(input));
+    }
+}
+
+TEST(CSICSCompressionTests, ParallelCompressorReset) {
+    ParallelCompressor::Config config{};
+    config.type = CompressorType::ZLIB;
+    config.chunk_size = 8192;
+    config.workers = 2;
+    ParallelCompressor compressor(config);
+
+    // Abandoned mid-stream with frames in flight.
+    auto discarded = make_input(50000);
+    std::vector<uint8_t> scratch(10);
+    compressor.compress_buffer(BufferView(discarded), BufferView(scratch));
+    compressor.reset();
+
+    auto input = make_input(30000);
+    std::vector<uint8_t> compressed(compressBound(input.size()) + 4096);
+    auto r = compressor.finish(BufferView(input), BufferView(compressed));
+    ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    compressed.resize(r.compressed);
+
+    std::size_t frames = 0;
+    auto decompressed = inflate_frames(compressed, input.size(), frames);
+    EXPECT_EQ(frames, 4u);
+    EXPECT_THAT(decompressed, ::testing::ElementsAreArray(input));
+}
@@ -0,0 +1,180 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+namespace {
+
+std::vector<CompressorType> backends() {
+    return {
+#ifdef CSICS_USE_ZLIB
+        CompressorType::ZLIB,
+#endif
+#ifdef CSICS_USE_ZSTD
+        CompressorType::ZSTD,
+#endif
+#ifdef CSICS_USE_LZ4
+        CompressorType::LZ4,
+#endif
+    };
+}
+
+// Noise with repeated runs, so frames compress to different sizes.
+std::vector<uint8_t> make_input(std::size_t size) {
+    auto data = generate_random_bytes(size);
+    for (std::size_t i = 0; i < size; i++) {
+        if ((i / 5000) % 3 != 0) {
+            data[i] = static_cast<uint8_t>(i % 37);
+        }
+    }
+    return data;
+}
+
+// Writes `input` in odd pieces through a small output buffer, each piece
+// timestamped as a radio block would be.
+std::vector<uint8_t> write_container(SeekableWriter& writer,
+                                     std::vector<uint8_t>& input,
+                                     std::size_t piece_size) {
+    std::vector<uint8_t> container;
+    std::vector<uint8_t> out_buf(7777);
+    BufferView in(input);
+    uint64_t offset = 0;
+    while (!in.empty()) {
+        BufferView piece = in(0, std::min(in.size(), piece_size));
+        writer.set_timestamp(1000000 + offset);
+        while (!piece.empty()) {
+            auto r = writer.compress_partial(piece, BufferView(out_buf));
+            EXPECT_TRUE(r.status == CompressionStatus::NeedsInput ||
+                        r.status == CompressionStatus::OutputBufferFull);
+            container.insert(container.end(), out_buf.begin(),
+                             out_buf.begin() + r.compressed);
+            piece += r.input_consumed;
+            in += r.input_consumed;
+            offset += r.input_consumed;
+        }
+    }
+    CompressionResult r{};
+    do {
+        r = writer.finish(BufferView(), BufferView(out_buf));
+        container.insert(container.end(), out_buf.begin(),
+                         out_buf.begin() + r.compressed);
+    } while (r.status == CompressionStatus::OutputBufferFull);
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    return container;
+}
+
+};  // namespace
+
+TEST(CSICSCompressionTests, SeekableRandomReads) {
+    auto input = make_input(1300000 + 17);
+    for (CompressorType type : backends()) {
+        SeekableWriter::Config config{};
+        config.type = type;
+        config.frame_size = 100000;
+        SeekableWriter writer(config);
+        auto container = write_container(writer, input, 30011);
+
+        SeekableReader::Config reader_config{};
+        reader_config.workers = 3;
+        SeekableReader reader(BufferView(container), reader_config);
+        ASSERT_EQ(reader.size(), input.size());
+        ASSERT_EQ(reader.frame_count(), 14u);
+
+        std::vector<uint8_t> whole(input.size());
+        auto r = reader.read(0, BufferView(whole));
+        ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        ASSERT_EQ(r.decompressed, input.size());
+        EXPECT_THAT(whole, ::testing::ElementsAreArray(input));
+
+        std::mt19937 rng(3);
+        for (int i = 0; i < 200; i++) {
+            std::size_t offset = rng() % input.size();
+            std::size_t len = rng() % 350000 + 1;
+            std::vector<uint8_t> out(len);
+            r = reader.read(offset, BufferView(out));
+            ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+            std::size_t expected = std::min(len, input.size() - offset);
+            ASSERT_EQ(r.decompressed, expected);
+            ASSERT_TRUE(std::equal(out.begin(), out.begin() + expected,
+                                   input.begin() + offset))
+                << "offset " << offset << " len " << len;
+        }
+
+        std::vector<uint8_t> out(10);
+        r = reader.read(input.size(), BufferView(out));
+        EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        EXPECT_EQ(r.decompressed, 0u);
+    }
+}
+
+TEST(CSICSCompressionTests, SeekableTimestamps) {
+    auto input = make_input(100000);
+    for (CompressorType type : backends()) {
+        SeekableWriter::Config config{};
+        config.type = type;
+        config.frame_size = 16000;
+        // One sample per byte, one per nanosecond.
+        config.sample_rate = 1e9;
+        config.bytes_per_sample = 1;
+        SeekableWriter writer(config);
+        auto container = write_container(writer, input, 25000);
+
+        SeekableReader reader{BufferView(container)};
+        ASSERT_EQ(reader.frame_count(), 7u);
+        for (std::size_t i = 0; i < reader.frame_count(); i++) {
+            // Pieces are stamped with their offset, frames inside them are
+            // extrapolated from it.
+            EXPECT_EQ(reader.frame(i).timestamp_ns, 1000000 + i * 16000);
+        }
+        EXPECT_EQ(reader.offset_at(0), 0u);
+        EXPECT_EQ(reader.offset_at(1000000 + 3 * 16000), 3 * 16000u);
+        EXPECT_EQ(reader.offset_at(1000000 + 3 * 16000 + 15999),
+                  3 * 16000u);
+        EXPECT_EQ(reader.offset_at(UINT64_MAX), 6 * 16000u);
+    }
+}
+
+TEST(CSICSCompressionTests, SeekableEmptyAndCorrupt) {
+    for (CompressorType type : backends()) {
+        SeekableWriter::Config config{};
+        config.type = type;
+        config.frame_size = 4096;
+        SeekableWriter writer(config);
+
+        std::vector<uint8_t> empty_input;
+        auto empty = write_container(writer, empty_input, 1);
+        SeekableReader empty_reader{BufferView(empty)};
+        EXPECT_EQ(empty_reader.size(), 0u);
+        EXPECT_EQ(empty_reader.frame_count(), 0u);
+
+        // The writer starts a new container after finishing.
+        auto input = make_input(20000);
+        auto container = write_container(writer, input, 20000);
+        std::vector<uint8_t> truncated(container.begin(),
+                                       container.end() - 1);
+        EXPECT_THROW(SeekableReader{BufferView(truncated)},
+                     std::invalid_argument);
+
+        // Damage the header of the second frame only, not every backend
+        // checksums its payload.
+        SeekableReader reader{BufferView(container)};
+        for (std::size_t i = 0; i < 4; i++) {
+            container[reader.frame(1).compressed_offset + i] ^= 0x5A;
+        }
+        std::vector<uint8_t> out(4096);
+        auto r = reader.read(0, BufferView(out));
+        EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        EXPECT_TRUE(std::equal(out.begin(), out.end(), input.begin()));
+        r = reader.read(4096, BufferView(out));
+        EXPECT_EQ(r.status, CompressionStatus::FatalError);
+    }
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <cctype>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../test_utils.hpp"
+
+namespace {
+
+using namespace csics;
+using namespace csics::io::encdec;
+
+std::vector<Base64Isa> supported_isas() {
+    std::vector<Base64Isa> isas;
+    for (Base64Isa isa :
+         {Base64Isa::Scalar, Base64Isa::SSSE3, Base64Isa::AVX2}) {
+        if (base64_isa_supported(isa)) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+std::vector<uint8_t> to_bytes(const std::string& s) {
+    return std::vector<uint8_t>(s.begin(), s.end());
+}
+
+// Whole stream in one call, with room to spare.
+EncodingResult run(ICodec& codec, std::vector<uint8_t> in,
+                   std::vector<uint8_t>& out) {
+    out.assign(2 * in.size() + 16, 0);
+    auto r = codec.finish(BufferView(in), BufferView(out));
+    out.resize(r.output);
+    return r;
+}
+
+std::string as_string(const std::vector<uint8_t>& v) {
+    return std::string(v.begin(), v.end());
+}
+
+// Runs a whole stream through `codec` in random input and output pieces.
+std::vector<uint8_t> drive(ICodec& codec, std::vector<uint8_t> input,
+                           std::mt19937& rng) {
+    std::uniform_int_distribution<std::size_t> piece(0, 40);
+    std::vector<uint8_t> result;
+    std::size_t pos = 0;
+    bool done = false;
+    while (!done) {
+        std::size_t in_len = std::min(piece(rng), input.size() - pos);
+        std::vector<uint8_t> out(piece(rng));
+        BufferView in(input.data() + pos, in_len);
+        bool last = pos + in_len == input.size();
+        auto r = last ? codec.finish(in, BufferView(out))
+                      : codec.process(in, BufferView(out));
+        EXPECT_TRUE(r.status == EncodingStatus::Ok ||
+                    r.status == EncodingStatus::OutputBufferFull);
+        if (!(r.status == EncodingStatus::Ok ||
+              r.status == EncodingStatus::OutputBufferFull)) {
+            break;
+        }
+        pos += r.processed;
+        result.insert(result.end(), out.begin(), out.begin() + r.output);
+        done = last && r.status == EncodingStatus::Ok &&
+               r.processed == in_len;
+    }
+    return result;
+}
+
+};  // namespace
+
+TEST(CSICSEncDecTests, HexIsaKernels) {
+    for (Base64Isa isa : supported_isas()) {
+        HexEncoder lower(isa);
+        HexEncoder upper(isa, true);
+        HexDecoder decoder(isa);
+        for (std::size_t size = 0; size < 300; size++) {
+            auto input = generate_random_bytes(size);
+            std::string expected_lower;
+            std::string expected_upper;
+            for (uint8_t b : input) {
+                char digits[3];
+                std::snprintf(digits, sizeof(digits), "%02x", b);
+                expected_lower += digits;
+                std::snprintf(digits, sizeof(digits), "%02X", b);
+                expected_upper += digits;
+            }
+            std::vector<uint8_t> encoded;
+            ASSERT_EQ(run(lower, input, encoded).status, EncodingStatus::Ok);
+            ASSERT_EQ(as_string(encoded), expected_lower) << int(isa);
+            ASSERT_EQ(run(upper, input, encoded).status, EncodingStatus::Ok);
+            ASSERT_EQ(as_string(encoded), expected_upper) << int(isa);
+
+            // Decoded in place, from mixed case.
+            for (std::size_t i = 0; i < encoded.size(); i += 3) {
+                encoded[i] = static_cast<uint8_t>(std::tolower(encoded[i]));
+            }
+            BufferView view(encoded);
+            auto r = decoder.finish(view, view);
+            ASSERT_EQ(r.status, EncodingStatus::Ok);
+            ASSERT_EQ(r.output, size);
+            encoded.resize(size);
+            ASSERT_EQ(encoded, input) << int(isa);
+        }
+
+        // A non-digit anywhere, including right next to the digit ranges.
+        std::mt19937 rng(2);
+        for (int bad : std::vector<uint8_t>{'/', ':', '@', 'G', '`', 'g', ' ',
+                                            0x80, 0xC1}) {
+            std::vector<uint8_t> text(200, 'a');
+            text[rng() % text.size()] = static_cast<uint8_t>(bad);
+            std::vector<uint8_t> out;
+            EXPECT_EQ(run(decoder, text, out).status,
+                      EncodingStatus::InvalidInput)
+                << int(isa) << " " << bad;
+        }
+        std::vector<uint8_t> out;
+        EXPECT_EQ(run(decoder, to_bytes("abc"), out).status,
+                  EncodingStatus::InvalidInput);
+    }
+}
+
+TEST(CSICSEncDecTests, Base32Vectors) {
+    Base32Encoder encoder;
+    Base32Decoder decoder;
+    std::vector<uint8_t> out;
+    // RFC 4648 section 10.
+    for (auto [plain, text] : {std::pair<std::string, std::string>{"", ""},
+                               {"f", "MY======"},
+                               {"fo", "MZXQ===="},
+                               {"foo", "MZXW6==="},
+                               {"foob", "MZXW6YQ="},
+                               {"fooba", "MZXW6YTB"},
+                               {"foobar", "MZXW6YTBOI======"}}) {
+        ASSERT_EQ(run(encoder, to_bytes(plain), out).status,
+                  EncodingStatus::Ok);
+        EXPECT_EQ(as_string(out), text);
+        ASSERT_EQ(run(decoder, to_bytes(text), out).status,
+                  EncodingStatus::Ok);
+        EXPECT_EQ(as_string(out), plain);
+    }
+
+    for (std::string bad : {"MY=====", "MY=======", "M=======", "MYA=====",
+                            "my======", "MZ======", "MY======MY======",
+                            "MZXW6YT1", "MY=A===="}) {
+        EXPECT_EQ(run(decoder, to_bytes(bad), out).status,
+                  EncodingStatus::InvalidInput)
+            << bad;
+    }
+}
+
+TEST(CSICSEncDecTests, Z85Vectors) {
+    Z85Encoder encoder;
+    Z85Decoder decoder;
+    std::vector<uint8_t> out;
+    // From the ZeroMQ RFC 32 reference implementation.
+    std::vector<uint8_t> hello = {0x86, 0x4F, 0xD2, 0x6F,
+                                  0xB5, 0x59, 0xF7, 0x5B};
+    ASSERT_EQ(run(encoder, hello, out).status, EncodingStatus::Ok);
+    EXPECT_EQ(as_string(out), "HelloWorld");
+    ASSERT_EQ(run(decoder, to_bytes("HelloWorld"), out).status,
+              EncodingStatus::Ok);
+    EXPECT_EQ(out, hello);
+
+    std::vector<uint8_t> ones(4, 0xFF);
+    ASSERT_EQ(run(encoder, ones, out).status, EncodingStatus::Ok);
+    EXPECT_EQ(as_string(out), "%nSc0");
+
+    EXPECT_EQ(run(encoder, std::vector<uint8_t>(7), out).status,
+              EncodingStatus::InvalidInput);
+    for (std::string bad : {"%nSc1", "#####", "Hello~orld", "Hello\"orld",
+                            "HelloWorl"}) {
+        EXPECT_EQ(run(decoder, to_bytes(bad), out).status,
+                  EncodingStatus::InvalidInput)
+            << bad;
+    }
+}
+
+TEST(CSICSEncDecTests, TextEncodingsStreamingRoundTrip) {
+    std::mt19937 rng(4);
+    for (int iter = 0; iter < 100; iter++) {
+        auto input = generate_random_bytes(4 * (rng() % 300));
+        Base64Isa isa = supported_isas()[iter % supported_isas().size()];
+
+        HexEncoder hex_encoder(isa, iter % 2 == 1);
+        HexDecoder hex_decoder(isa);
+        auto hex = drive(hex_encoder, input, rng);
+        ASSERT_EQ(hex.size(), 2 * input.size());
+        ASSERT_EQ(drive(hex_decoder, hex, rng), input);
+
+        Base32Encoder base32_encoder;
+        Base32Decoder base32_decoder;
+        auto base32 = drive(base32_encoder, input, rng);
+        ASSERT_EQ(base32.size(), 8 * ((input.size() + 4) / 5));
+        ASSERT_EQ(drive(base32_decoder, base32, rng), input);
+
+        Z85Encoder z85_encoder;
+        Z85Decoder z85_decoder;
+        auto z85 = drive(z85_encoder, input, rng);
+        ASSERT_EQ(z85.size(), 5 * input.size() / 4);
+        ASSERT_EQ(drive(z85_decoder, z85, rng), input);
+    }
+}
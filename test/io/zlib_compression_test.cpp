@@ -63,3 +63,105 @@ TEST(CSICSCompressionTests, ZLIBCompressionTest) {
 
     inflateEnd(&stream);
 }
+
+namespace {
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+// Compresses `input` in two calls, or in one finish if `oneshot`.
+std::vector<uint8_t> zlib_compress(std::vector<uint8_t> input,
+                                   const CompressionOptions& options,
+                                   bool oneshot) {
+    auto compressor = ICompressor::create(CompressorType::ZLIB, options);
+    std::vector<uint8_t> out(compressBound(input.size()) + 64);
+    BufferView in(input);
+    BufferView dst(out);
+    if (!oneshot) {
+        auto r = compressor->compress_buffer(in(0, in.size() / 2), dst);
+        EXPECT_EQ(r.status, CompressionStatus::NeedsInput);
+        in += r.input_consumed;
+        dst += r.compressed;
+    }
+    auto r = compressor->finish(in, dst);
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    EXPECT_EQ(r.input_consumed, in.size());
+    out.resize(dst.uc() + r.compressed - out.data());
+    return out;
+}
+
+};  // namespace
+
+TEST(CSICSCompressionTests, ZLIBFormats) {
+    auto input = generate_random_bytes(256 * 1024);
+    for (std::size_t i = 0; i < input.size(); i += 3) {
+        input[i] = static_cast<uint8_t>(i % 13);
+    }
+
+    for (ZLIBFormat format :
+         {ZLIBFormat::Zlib, ZLIBFormat::Gzip, ZLIBFormat::Raw}) {
+        for (bool oneshot : {false, true}) {
+            CompressionOptions options{};
+            options.zlib_format = format;
+            auto compressed = zlib_compress(input, options, oneshot);
+            ASSERT_GT(compressed.size(), 2u);
+            if (format == ZLIBFormat::Gzip) {
+                EXPECT_EQ(compressed[0], 0x1f);
+                EXPECT_EQ(compressed[1], 0x8b);
+            }
+
+            DecompressionOptions d_options{};
+            d_options.zlib_format = format;
+            auto decompressor =
+                IDecompressor::create(CompressorType::ZLIB, d_options);
+            std::vector<uint8_t> out(input.size());
+            auto r = decompressor->finish(BufferView(compressed),
+                                          BufferView(out));
+            ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+            ASSERT_EQ(r.decompressed, input.size());
+            EXPECT_EQ(out, input);
+        }
+    }
+
+    // Raw deflate has no header to detect.
+    CompressionOptions options{};
+    options.zlib_format = ZLIBFormat::Raw;
+    auto raw = zlib_compress(input, options, true);
+    auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+    std::vector<uint8_t> out(input.size());
+    EXPECT_EQ(decompressor->finish(BufferView(raw), BufferView(out)).status,
+              CompressionStatus::FatalError);
+}
+
+TEST(CSICSCompressionTests, ZLIBStrategiesAndWindow) {
+    auto input = generate_random_bytes(64 * 1024);
+    for (std::size_t i = 0; i < input.size(); i += 2) {
+        input[i] = 0;
+    }
+    for (ZLIBStrategy strategy :
+         {ZLIBStrategy::Default, ZLIBStrategy::Filtered,
+          ZLIBStrategy::HuffmanOnly, ZLIBStrategy::RLE, ZLIBStrategy::Fixed}) {
+        CompressionOptions options{};
+        options.level = 9;
+        options.window_log = 9;
+        options.zlib_strategy = strategy;
+        auto compressed = zlib_compress(input, options, true);
+        EXPECT_LT(compressed.size(), input.size());
+
+        auto decompressor = IDecompressor::create(CompressorType::ZLIB);
+        std::vector<uint8_t> out(input.size());
+        auto r =
+            decompressor->finish(BufferView(compressed), BufferView(out));
+        ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+        EXPECT_EQ(out, input);
+    }
+
+    CompressionOptions options{};
+    options.window_log = 16;
+    EXPECT_THROW(ICompressor::create(CompressorType::ZLIB, options),
+                 std::invalid_argument);
+    options.window_log = 8;
+    EXPECT_THROW(ICompressor::create(CompressorType::ZLIB, options),
+                 std::invalid_argument);
+}
@@ -55,3 +55,83 @@ TEST(CSICSCompressionTests, ZSTDCompressorBasic) {
 
     std::filesystem::remove("temp_compressed.zst");
 }
+
+// Compresses `input` in one call and decompresses it with the reference
+// decoder, which accepts any number of concatenated frames.
+static std::vector<uint8_t> zstd_round_trip(
+    csics::io::compression::ICompressor& compressor,
+    const std::vector<uint8_t>& input) {
+    using namespace csics::io::compression;
+    std::vector<uint8_t> compressed(ZSTD_compressBound(input.size()) + 4096);
+    std::vector<uint8_t> input_copy = input;
+    auto r = compressor.finish(csics::BufferView(input_copy),
+                               csics::BufferView(compressed));
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    compressed.resize(r.compressed);
+
+    std::vector<uint8_t> decompressed(input.size() + 1);
+    std::size_t n = ZSTD_decompress(decompressed.data(), decompressed.size(),
+                                    compressed.data(), compressed.size());
+    EXPECT_FALSE(ZSTD_isError(n)) << ZSTD_getErrorName(n);
+    decompressed.resize(ZSTD_isError(n) ? 0 : n);
+    return decompressed;
+}
+
+TEST(CSICSCompressionTests, ZSTDCompressorOptions) {
+    using namespace csics::io::compression;
+
+    CompressionOptions options{};
+    options.level = 5;
+    options.window_log = 24;
+    options.long_distance_matching = true;
+    auto compressor = ICompressor::create(CompressorType::ZSTD, options);
+
+    auto input = generate_random_bytes(512 * 1024);
+    // A long-range repeat only the large window reaches.
+    input.insert(input.end(), input.begin(), input.end());
+    auto decompressed = zstd_round_trip(*compressor, input);
+    ASSERT_EQ(decompressed.size(), input.size());
+    EXPECT_THAT(decompressed, ::testing::ElementsAreArray(input));
+
+    options = {};
+    options.window_log = 100;
+    EXPECT_THROW(ICompressor::create(CompressorType::ZSTD, options),
+                 std::invalid_argument);
+}
+
+TEST(CSICSCompressionTests, ZSTDCompressorWorkers) {
+    using namespace csics::io::compression;
+
+    CompressionOptions options{};
+    options.workers = 2;
+    std::unique_ptr<ICompressor> compressor;
+    try {
+        compressor = ICompressor::create(CompressorType::ZSTD, options);
+    } catch (const std::invalid_argument&) {
+        GTEST_SKIP() << "libzstd built without multithreading";
+    }
+
+    auto input = generate_random_bytes(4 * 1024 * 1024);
+    auto decompressed = zstd_round_trip(*compressor, input);
+    ASSERT_EQ(decompressed.size(), input.size());
+    EXPECT_THAT(decompressed, ::testing::ElementsAreArray(input));
+}
+
+TEST(CSICSCompressionTests, ZSTDParallelCompressor) {
+    using namespace csics::io::compression;
+
+    ParallelCompressor::Config config{};
+    config.type = CompressorType::ZSTD;
+    config.options.level = 3;
+    config.chunk_size = 256 * 1024;
+    config.workers = 4;
+    ParallelCompressor compressor(config);
+
+    auto input = generate_random_bytes(3 * 1024 * 1024 + 77);
+    for (std::size_t i = 0; i < input.size(); i += 2) {
+        input[i] = 0;
+    }
+    auto decompressed = zstd_round_trip(compressor, input);
+    ASSERT_EQ(decompressed.size(), input.size());
+    EXPECT_THAT(decompressed, ::testing::ElementsAreArray(input));
+}
@@ -0,0 +1,146 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+#include <csics/csics.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace csics;
+using namespace csics::io::compression;
+using namespace csics::io::decompression;
+
+namespace {
+
+// Telemetry-like JSON messages of a few hundred bytes.
+std::vector<std::string> make_messages(std::size_t count, uint32_t seed,
+                                       const std::string& kind) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> value(-120, 120);
+    std::vector<std::string> msgs;
+    for (std::size_t i = 0; i < count; i++) {
+        msgs.push_back(
+            "{\"type\":\"" + kind + "\",\"sensor_id\":\"node-" +
+            std::to_string(value(rng) & 15) +
+            "\",\"timestamp_ns\":" + std::to_string(1700000000000000000ull + i * 1000003) +
+            ",\"center_freq_hz\":915000000,\"sample_rate_hz\":2000000,"
+            "\"gain_db\":" + std::to_string(value(rng) & 63) +
+            ",\"rssi_dbm\":" + std::to_string(value(rng)) +
+            ",\"noise_floor_dbm\":" + std::to_string(value(rng)) +
+            ",\"position\":{\"lat\":" + std::to_string(value(rng) * 0.7) +
+            ",\"lon\":" + std::to_string(value(rng) * 1.3) +
+            ",\"alt_m\":" + std::to_string(value(rng) + 200) + "}}");
+    }
+    return msgs;
+}
+
+std::shared_ptr<const Dictionary> train(std::vector<std::string>& msgs,
+                                        uint32_t id = 0) {
+    std::vector<BufferView> samples;
+    for (auto& m : msgs) {
+        samples.emplace_back(m.data(), m.size());
+    }
+    return Dictionary::train(samples, 4096, id);
+}
+
+std::vector<char> compress(const std::string& msg,
+                           const CompressionOptions& options) {
+    auto compressor = ICompressor::create(CompressorType::ZSTD, options);
+    std::string in = msg;
+    std::vector<char> out(ZSTD_compressBound(msg.size()));
+    auto r = compressor->finish(BufferView(in.data(), in.size()),
+                                BufferView(out));
+    EXPECT_EQ(r.status, CompressionStatus::InputBufferFinished);
+    out.resize(r.compressed);
+    return out;
+}
+
+};  // namespace
+
+TEST(CSICSDictionaryTests, TrainedDictionaryImprovesRatio) {
+    auto training = make_messages(2000, 1, "telemetry");
+    auto dict = train(training, 40000);
+    EXPECT_EQ(dict->id(), 40000u);
+    EXPECT_LE(dict->data().size(), 4096u);
+
+    auto msgs = make_messages(50, 2, "telemetry");
+    CompressionOptions with_dict{};
+    with_dict.dictionary = dict;
+    std::size_t plain = 0;
+    std::size_t trained = 0;
+    for (const auto& m : msgs) {
+        plain += compress(m, {}).size();
+        auto c = compress(m, with_dict);
+        EXPECT_EQ(ZSTD_getDictID_fromFrame(c.data(), c.size()), dict->id());
+        trained += c.size();
+    }
+    EXPECT_LT(trained * 2, plain);
+}
+
+TEST(CSICSDictionaryTests, DecompressorSelectsDictionaryById) {
+    auto a_training = make_messages(1000, 3, "telemetry");
+    auto b_training = make_messages(1000, 4, "status");
+    auto a = train(a_training, 40001);
+    // Reloaded from its serialized form, as a reader would.
+    auto b_trained = train(b_training, 40002);
+    auto b = std::make_shared<const Dictionary>(
+        BufferView(const_cast<char*>(b_trained->data().data()),
+                   b_trained->data().size()));
+    EXPECT_EQ(b->id(), 40002u);
+
+    DecompressionOptions options{};
+    options.dictionaries = {a, b};
+    auto decompressor = IDecompressor::create(CompressorType::ZSTD, options);
+
+    auto a_msgs = make_messages(10, 5, "telemetry");
+    auto b_msgs = make_messages(10, 6, "status");
+    for (std::size_t i = 0; i < a_msgs.size(); i++) {
+        for (const auto& [msg, dict] :
+             {std::pair{a_msgs[i], a}, std::pair{b_msgs[i], b}}) {
+            CompressionOptions copts{};
+            copts.dictionary = dict;
+            auto c = compress(msg, copts);
+
+            // One-shot path.
+            std::string out(msg.size(), '\0');
+            auto r = decompressor->finish(BufferView(c),
+                                          BufferView(out.data(), out.size()));
+            ASSERT_EQ(r.status, CompressionStatus::InputBufferFinished);
+            EXPECT_EQ(out, msg);
+
+            // Streaming path, output smaller than the message.
+            std::string streamed;
+            char buf[64];
+            BufferView in(c);
+            CompressionStatus status;
+            do {
+                r = decompressor->decompress_partial(in, BufferView(buf, 64));
+                ASSERT_NE(r.status, CompressionStatus::FatalError);
+                streamed.append(buf, r.decompressed);
+                in += r.input_consumed;
+                status = r.status;
+            } while (status == CompressionStatus::OutputBufferFull);
+            EXPECT_EQ(status, CompressionStatus::InputBufferFinished);
+            EXPECT_EQ(streamed, msg);
+        }
+    }
+}
+
+TEST(CSICSDictionaryTests, UnknownDictionaryFails) {
+    auto training = make_messages(1000, 7, "telemetry");
+    auto dict = train(training, 40003);
+    CompressionOptions copts{};
+    copts.dictionary = dict;
+    auto msg = make_messages(1, 8, "telemetry")[0];
+    auto c = compress(msg, copts);
+
+    auto decompressor = IDecompressor::create(CompressorType::ZSTD);
+    std::string out(msg.size(), '\0');
+    auto r = decompressor->finish(BufferView(c),
+                                  BufferView(out.data(), out.size()));
+    EXPECT_EQ(r.status, CompressionStatus::FatalError);
+
+    std::vector<char> garbage(100, 'x');
+    EXPECT_THROW(Dictionary(BufferView(garbage)), std::invalid_argument);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <csics/csics.hpp>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace csics;
+using namespace csics::pipeline;
+using BlockHeader = radio::IRadioRx::BlockHeader;
+
+namespace {
+
+struct CountingTask : WorkStealingExecutor::Task {
+    std::atomic<int>* counter;
+    WorkStealingExecutor* executor = nullptr;
+    std::vector<CountingTask>* children = nullptr;
+
+    static void execute(Task& task, std::size_t) noexcept {
+        auto& self = static_cast<CountingTask&>(task);
+        if (self.children != nullptr) {
+            for (auto& child : *self.children) {
+                if (self.executor->spawn(child) != queue::DequeError::None) {
+                    child.run(child, 0);
+                }
+            }
+        }
+        self.counter->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// Sleeps a random amount per block so workers finish out of order.
+struct JitterStage : IStage {
+    std::size_t output_block_size(std::size_t in) const noexcept override {
+        return in;
+    }
+    StageResult process(BufferView in, BufferView out) noexcept override {
+        thread_local std::minstd_rand rng(std::random_device{}());
+        std::this_thread::sleep_for(std::chrono::microseconds(rng() % 200));
+        std::memcpy(out.data(), in.data(), in.size());
+        return {in.size(), StageStatus::Ok};
+    }
+};
+
+};  // namespace
+
+TEST(CSICSExecutorTests, RunsEverySubmittedTask) {
+    WorkStealingExecutor executor(3, 64);
+    ASSERT_EQ(executor.num_workers(), 3u);
+    auto submitter = executor.make_submitter(32);
+    ASSERT_NE(submitter, nullptr);
+
+    constexpr int num_tasks = 5000;
+    std::atomic<int> counter{0};
+    std::vector<CountingTask> tasks(num_tasks);
+    for (auto& t : tasks) {
+        t.run = &CountingTask::execute;
+        t.counter = &counter;
+        while (submitter->submit(t) != queue::DequeError::None) {
+            std::this_thread::yield();
+        }
+    }
+    while (counter.load() != num_tasks) {
+        std::this_thread::yield();
+    }
+
+    uint64_t executed = 0;
+    for (std::size_t w = 0; w < executor.num_workers(); w++) {
+        executed += executor.stats(w).executed;
+    }
+    EXPECT_EQ(executed, static_cast<uint64_t>(num_tasks));
+}
+
+TEST(CSICSExecutorTests, SpawnOnlyFromWorkers) {
+    WorkStealingExecutor executor(2, 16);
+    std::atomic<int> counter{0};
+
+    CountingTask outside;
+    outside.run = &CountingTask::execute;
+    outside.counter = &counter;
+    EXPECT_EQ(executor.spawn(outside), queue::DequeError::Full);
+
+    std::vector<CountingTask> children(40);
+    for (auto& c : children) {
+        c.run = &CountingTask::execute;
+        c.counter = &counter;
+    }
+    CountingTask parent;
+    parent.run = &CountingTask::execute;
+    parent.counter = &counter;
+    parent.executor = &executor;
+    parent.children = &children;
+
+    auto submitter = executor.make_submitter(1);
+    ASSERT_EQ(submitter->submit(parent), queue::DequeError::None);
+    while (counter.load() != 41) {
+        std::this_thread::yield();
+    }
+}
+
+TEST(CSICSExecutorTests, SubmitterSlotsAreLimited) {
+    WorkStealingExecutor executor(1);
+    std::vector<std::unique_ptr<WorkStealingExecutor::Submitter>> subs;
+    for (std::size_t i = 0; i < WorkStealingExecutor::kMaxSubmitters; i++) {
+        subs.push_back(executor.make_submitter(4));
+        ASSERT_NE(subs.back(), nullptr);
+    }
+    EXPECT_EQ(executor.make_submitter(4), nullptr);
+    subs.pop_back();
+    EXPECT_NE(executor.make_submitter(4), nullptr);
+}
+
+TEST(CSICSExecutorTests, ParallelStagePreservesOrder) {
+    constexpr std::size_t num_blocks = 300;
+    WorkStealingExecutor executor(4);
+    PipelineGraph graph;
+
+    SyntheticSource::Config cfg;
+    cfg.block_len = 64;
+    cfg.num_blocks = num_blocks;
+    graph.add_source(std::make_unique<SyntheticSource>(cfg));
+    StageOptions opts;
+    opts.in_flight = 6;
+    graph.add_parallel_stage(std::make_unique<JitterStage>(), executor, opts);
+
+    std::size_t received = 0;
+    uint64_t last_ts = 0;
+    bool ordered = true;
+    auto sink = [&](BufferView in) {
+        auto* hdr = reinterpret_cast<const BlockHeader*>(in.data());
+        ordered &= received == 0 || hdr->timestamp_ns > last_ts;
+        last_ts = hdr->timestamp_ns;
+        received++;
+        return StageStatus::Ok;
+    };
+    graph.add_stage(std::make_unique<SinkStage<decltype(sink)>>(sink));
+
+    ASSERT_EQ(graph.start(), PipelineStatus::Ok);
+    graph.wait();
+
+    EXPECT_FALSE(graph.failed());
+    EXPECT_EQ(received, num_blocks);
+    EXPECT_TRUE(ordered);
+    auto mid = graph.stats(1);
+    EXPECT_EQ(mid.blocks_in, num_blocks);
+    EXPECT_EQ(mid.blocks_out, num_blocks);
+    EXPECT_EQ(mid.bytes_out, graph.stats(0).bytes_out);
+}
+
+TEST(CSICSExecutorTests, ParallelStageStopsOnEarlyFinish) {
+    WorkStealingExecutor executor(2);
+    PipelineGraph graph;
+    SyntheticSource::Config cfg;
+    cfg.block_len = 64;
+    graph.add_source(std::make_unique<SyntheticSource>(cfg));
+    graph.add_parallel_stage(std::make_unique<JitterStage>(), executor);
+
+    std::size_t received = 0;
+    auto sink = [&](BufferView) {
+        return ++received == 25 ? StageStatus::Finished : StageStatus::Ok;
+    };
+    graph.add_stage(std::make_unique<SinkStage<decltype(sink)>>(sink));
+
+    ASSERT_EQ(graph.start(), PipelineStatus::Ok);
+    graph.wait();
+    EXPECT_EQ(received, 25u);
+    EXPECT_FALSE(graph.failed());
+}
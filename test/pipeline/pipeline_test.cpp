@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <csics/csics.hpp>
+#include <cstring>
+#include <thread>
+
+using namespace csics;
+using namespace csics::pipeline;
+using BlockHeader = radio::IRadioRx::BlockHeader;
+
+static std::unique_ptr<IStage> make_source(std::size_t num_blocks,
+                                           std::size_t block_len = 256) {
+    SyntheticSource::Config cfg;
+    cfg.block_len = block_len;
+    cfg.num_blocks = num_blocks;
+    return std::make_unique<SyntheticSource>(cfg);
+}
+
+// Copies the header and halves every sample.
+static auto halve_samples = [](BufferView in, BufferView out) {
+    std::memcpy(out.data(), in.data(), sizeof(BlockHeader));
+    auto* src =
+        reinterpret_cast<const radio::SDRRawSample*>(in.data() + sizeof(BlockHeader));
+    auto* dst =
+        reinterpret_cast<radio::SDRRawSample*>(out.data() + sizeof(BlockHeader));
+    std::size_t n = (in.size() - sizeof(BlockHeader)) / sizeof(radio::SDRRawSample);
+    for (std::size_t i = 0; i < n; i++) {
+        dst[i] = radio::SDRRawSample(src[i].real() / 2, src[i].imag() / 2);
+    }
+    return StageResult{in.size(), StageStatus::Ok};
+};
+
+TEST(CSICSPipelineTests, SyntheticSourceEndToEnd) {
+    constexpr std::size_t num_blocks = 500;
+    PipelineGraph graph;
+    std::size_t received = 0;
+    uint64_t last_ts = 0;
+    bool ordered = true;
+    int16_t peak = 0;
+
+    graph.add_source(make_source(num_blocks));
+    graph.add_stage(std::make_unique<TransformStage<decltype(halve_samples)>>(
+        halve_samples));
+    auto sink = [&](BufferView in) {
+        auto* hdr = reinterpret_cast<const BlockHeader*>(in.data());
+        auto* samples = reinterpret_cast<const radio::SDRRawSample*>(
+            in.data() + sizeof(BlockHeader));
+        ordered &= received == 0 || hdr->timestamp_ns > last_ts;
+        last_ts = hdr->timestamp_ns;
+        for (std::size_t i = 0; i < hdr->num_samples; i++) {
+            peak = std::max<int16_t>(peak, samples[i].real());
+        }
+        received++;
+        return StageStatus::Ok;
+    };
+    graph.add_stage(std::make_unique<SinkStage<decltype(sink)>>(sink));
+
+    ASSERT_EQ(graph.start(), PipelineStatus::Ok);
+    ASSERT_EQ(graph.start(), PipelineStatus::AlreadyRunning);
+    graph.wait();
+
+    EXPECT_FALSE(graph.failed());
+    EXPECT_FALSE(graph.is_running());
+    EXPECT_EQ(received, num_blocks);
+    EXPECT_TRUE(ordered);
+    EXPECT_LE(peak, 8192 / 2);
+    EXPECT_GT(peak, 8192 / 4);
+
+    auto src = graph.stats(0);
+    auto mid = graph.stats(1);
+    auto end = graph.stats(2);
+    EXPECT_EQ(src.blocks_out, num_blocks);
+    EXPECT_EQ(mid.blocks_in, num_blocks);
+    EXPECT_EQ(mid.blocks_out, num_blocks);
+    EXPECT_EQ(end.blocks_in, num_blocks);
+    EXPECT_EQ(end.bytes_in, src.bytes_out);
+    EXPECT_GT(mid.busy_ns, 0u);
+    EXPECT_GE(mid.max_latency_ns, mid.mean_latency_ns());
+    EXPECT_GT(end.throughput_bps(), 0.0);
+}
+
+TEST(CSICSPipelineTests, QueuesSizedFromBlockSize) {
+    PipelineGraph graph;
+    std::size_t block = sizeof(BlockHeader) + 1024 * sizeof(radio::SDRRawSample);
+    StageOptions opts;
+    opts.queue_depth = 8;
+    graph.add_source(make_source(1, 1024), opts);
+    auto sink = [](BufferView) { return StageStatus::Ok; };
+    graph.add_stage(std::make_unique<SinkStage<decltype(sink)>>(sink));
+
+    ASSERT_EQ(graph.start(), PipelineStatus::Ok);
+    graph.wait();
+    EXPECT_GE(graph.queue_capacity(0),
+              queue::SPSCQueue::capacity_for(block, opts.queue_depth));
+    EXPECT_EQ(graph.queue_capacity(1), 0u);
+}
+
+TEST(CSICSPipelineTests, StopDrainsInFlightBlocks) {
+    using namespace std::chrono_literals;
+    PipelineGraph graph;
+    std::atomic<std::size_t> received{0};
+    graph.add_source(make_source(0));
+    auto slow_sink = [&](BufferView) {
+        std::this_thread::sleep_for(10us);
+        received++;
+        return StageStatus::Ok;
+    };
+    graph.add_stage(
+        std::make_unique<SinkStage<decltype(slow_sink)>>(slow_sink));
+
+    ASSERT_EQ(graph.start(), PipelineStatus::Ok);
+    std::this_thread::sleep_for(50ms);
+    graph.stop();
+
+    EXPECT_FALSE(graph.is_running());
+    EXPECT_GT(received.load(), 0u);
+    EXPECT_EQ(received.load(), graph.stats(0).blocks_out);
+}
+
+TEST(CSICSPipelineTests, EarlyFinishStopsUpstream) {
+    PipelineGraph graph;
+    std::size_t received = 0;
+    graph.add_source(make_source(0));
+    auto sink = [&](BufferView) {
+        return ++received == 10 ? StageStatus::Finished : StageStatus::Ok;
+    };
+    graph.add_stage(std::make_unique<SinkStage<decltype(sink)>>(sink));
+
+    ASSERT_EQ(graph.start(), PipelineStatus::Ok);
+    graph.wait();
+    EXPECT_EQ(received, 10u);
+    EXPECT_FALSE(graph.failed());
+}
+
+TEST(CSICSPipelineTests, RejectsInvalidChains) {
+    PipelineGraph empty;
+    EXPECT_THROW(empty.add_stage(make_source(1)), std::logic_error);
+    EXPECT_EQ(empty.start(), PipelineStatus::InvalidGraph);
+
+    PipelineGraph no_sink;
+    no_sink.add_source(make_source(1));
+    EXPECT_THROW(no_sink.add_source(make_source(1)), std::logic_error);
+    no_sink.add_stage(std::make_unique<TransformStage<decltype(halve_samples)>>(
+        halve_samples));
+    EXPECT_EQ(no_sink.start(), PipelineStatus::InvalidGraph);
+}
+
+TEST(CSICSPipelineTests, AppliesStageThreadPolicy) {
+    PipelineGraph graph;
+    graph.add_source(make_source(50));
+    StageOptions opts;
+    opts.thread_policy.cpus = {0};
+    opts.thread_policy.name = "csics-sink";
+    auto sink = [](BufferView) { return StageStatus::Ok; };
+    graph.add_stage(std::make_unique<SinkStage<decltype(sink)>>(sink), opts);
+
+    ASSERT_EQ(graph.start(), PipelineStatus::Ok);
+    graph.wait();
+    EXPECT_TRUE(graph.stats(0).thread_policy);
+#if defined(__linux__)
+    EXPECT_EQ(graph.stats(1).thread_policy.affinity, ThreadPolicyError::None);
+#endif
+}
@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <csics/csics.hpp>
+#include <vector>
+
+using namespace csics;
+using namespace csics::pipeline;
+using BlockHeader = radio::IRadioRx::BlockHeader;
+using BlockFlags = radio::IRadioRx::BlockFlags;
+
+constexpr double kRate = 1e6;
+constexpr uint64_t kStartNs = 1'000'000'000;
+constexpr std::size_t kBlock = 100;
+
+// Feeds blocks of a quiet stream whose samples carry their index, with
+// loud samples at chosen indices.
+class Feeder {
+   public:
+    explicit Feeder(TriggeredCapture& stage)
+        : stage_(stage),
+          in_(sizeof(BlockHeader) + kBlock * sizeof(radio::SDRRawSample)),
+          out_(stage.output_block_size(in_.size())) {}
+
+    std::vector<int64_t> loud;
+
+    // Returns the capture emitted for this block, if any.
+    const CaptureHeader* block(std::size_t n = kBlock) {
+        auto* hdr = reinterpret_cast<BlockHeader*>(in_.data());
+        auto* s = reinterpret_cast<radio::SDRRawSample*>(in_.data() +
+                                                         sizeof(BlockHeader));
+        hdr->timestamp_ns = kStartNs + index_ * 1000;
+        hdr->num_samples = n;
+        hdr->flags = BlockFlags::NONE;
+        for (std::size_t i = 0; i < n; i++) {
+            int64_t idx = index_ + static_cast<int64_t>(i);
+            bool is_loud = std::find(loud.begin(), loud.end(), idx) !=
+                           loud.end();
+            s[i] = radio::SDRRawSample(static_cast<int16_t>(idx % 1000),
+                                       is_loud ? 20000 : 0);
+        }
+        index_ += static_cast<int64_t>(n);
+        return run(sizeof(BlockHeader) + n * sizeof(radio::SDRRawSample));
+    }
+
+    const CaptureHeader* gap(uint64_t lost) {
+        auto* hdr = reinterpret_cast<BlockHeader*>(in_.data());
+        hdr->timestamp_ns = kStartNs + index_ * 1000;
+        hdr->num_samples = lost;
+        hdr->flags = BlockFlags::GAP;
+        index_ += static_cast<int64_t>(lost);
+        return run(sizeof(BlockHeader));
+    }
+
+    const radio::SDRRawSample* samples() const {
+        return reinterpret_cast<const radio::SDRRawSample*>(
+            out_.data() + sizeof(CaptureHeader));
+    }
+
+   private:
+    const CaptureHeader* run(std::size_t size) {
+        StageResult r = stage_.process(BufferView(in_.data(), size),
+                                       BufferView(out_.data(), out_.size()));
+        EXPECT_EQ(r.status, StageStatus::Ok);
+        if (r.output == 0) return nullptr;
+        auto* hdr = reinterpret_cast<const CaptureHeader*>(out_.data());
+        EXPECT_EQ(r.output, sizeof(CaptureHeader) +
+                                hdr->num_samples * sizeof(radio::SDRRawSample));
+        return hdr;
+    }
+
+    TriggeredCapture& stage_;
+    std::vector<std::byte> in_;
+    std::vector<std::byte> out_;
+    int64_t index_ = 0;
+};
+
+static TriggeredCapture::Config config(std::size_t pre, std::size_t post) {
+    TriggeredCapture::Config c;
+    c.sample_rate = kRate;
+    c.pre_trigger = pre;
+    c.post_trigger = post;
+    c.amplitude_threshold = 10000;
+    return c;
+}
+
+TEST(CSICSTriggeredCaptureTests, PowerTriggerWindowIsSampleExact) {
+    TriggeredCapture stage(config(150, 250));
+    Feeder feed(stage);
+    feed.loud = {537};
+
+    const CaptureHeader* hdr = nullptr;
+    int blocks = 0;
+    while (hdr == nullptr && blocks < 20) {
+        hdr = feed.block();
+        blocks++;
+    }
+    ASSERT_NE(hdr, nullptr);
+    // Complete once sample 786 arrived, in the block ending at 800.
+    EXPECT_EQ(blocks, 8);
+    EXPECT_EQ(hdr->source, CaptureHeader::Source::POWER);
+    EXPECT_EQ(hdr->first_index, 387u);
+    EXPECT_EQ(hdr->num_samples, 400u);
+    EXPECT_EQ(hdr->trigger_offset, 150u);
+    EXPECT_EQ(hdr->flags, BlockFlags::NONE);
+    EXPECT_EQ(static_cast<uint64_t>(hdr->timestamp_ns), kStartNs + 387'000);
+    for (uint64_t i = 0; i < hdr->num_samples; i++) {
+        EXPECT_EQ(feed.samples()[i].real(),
+                  static_cast<int16_t>((387 + i) % 1000));
+    }
+    EXPECT_EQ(feed.samples()[150].imag(), 20000);
+
+    // Nothing is forwarded without a trigger.
+    for (int i = 0; i < 20; i++) {
+        EXPECT_EQ(feed.block(), nullptr);
+    }
+    EXPECT_EQ(stage.captures(), 1u);
+}
+
+TEST(CSICSTriggeredCaptureTests, IgnoresTriggersInsideWindow) {
+    TriggeredCapture stage(config(50, 200));
+    Feeder feed(stage);
+    // The second is inside the first window, the third after it.
+    feed.loud = {300, 420, 600};
+
+    std::vector<uint64_t> triggers;
+    for (int i = 0; i < 20; i++) {
+        if (auto* hdr = feed.block()) {
+            triggers.push_back(hdr->first_index + hdr->trigger_offset);
+        }
+    }
+    EXPECT_EQ(triggers, (std::vector<uint64_t>{300, 600}));
+}
+
+TEST(CSICSTriggeredCaptureTests, ShortHistoryIsPartial) {
+    TriggeredCapture stage(config(500, 100));
+    Feeder feed(stage);
+    feed.loud = {120};
+
+    const CaptureHeader* hdr = nullptr;
+    for (int i = 0; i < 5 && hdr == nullptr; i++) {
+        hdr = feed.block();
+    }
+    ASSERT_NE(hdr, nullptr);
+    EXPECT_TRUE(hdr->flags == BlockFlags::PARTIAL);
+    EXPECT_EQ(hdr->first_index, 0u);
+    EXPECT_EQ(hdr->trigger_offset, 120u);
+    EXPECT_EQ(hdr->num_samples, 220u);
+}
+
+TEST(CSICSTriggeredCaptureTests, ExternalTriggerAndGap) {
+    auto c = config(100, 100);
+    c.amplitude_threshold = 0;
+    TriggeredCapture stage(c);
+    Feeder feed(stage);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(feed.block(), nullptr);
+    }
+    // Already received, still in the history.
+    stage.trigger_at(kStartNs + 250'000);
+    EXPECT_EQ(feed.gap(30), nullptr);
+    const CaptureHeader* hdr = feed.block();
+    ASSERT_NE(hdr, nullptr);
+    EXPECT_EQ(hdr->source, CaptureHeader::Source::EXTERNAL);
+    EXPECT_EQ(hdr->first_index, 150u);
+    EXPECT_EQ(hdr->trigger_offset, 100u);
+    // Samples 300-329 were lost and zero-filled, the stream stays aligned.
+    EXPECT_TRUE(hdr->flags == BlockFlags::ZERO_FILLED);
+    EXPECT_EQ(feed.samples()[160].real(), 0);
+    EXPECT_EQ(feed.samples()[180].real(), 330 % 1000);
+
+    // Before the end of the last window, dropped.
+    stage.trigger_at(kStartNs + 10'000);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(feed.block(), nullptr);
+    }
+    EXPECT_EQ(stage.captures(), 1u);
+}
+
+TEST(CSICSTriggeredCaptureTests, GapAcrossPendingWindow) {
+    // Gaps ending within the next ring size and well beyond it.
+    for (uint64_t lost : {472u, 567u, 5000u}) {
+        SCOPED_TRACE(lost);
+        TriggeredCapture stage(config(10, 100));
+        Feeder feed(stage);
+        feed.loud = {50, 1000 + static_cast<int64_t>(lost)};
+
+        EXPECT_EQ(feed.block(), nullptr);
+        // Samples 100-149 of the window are lost, it completes with zeros.
+        const CaptureHeader* hdr = feed.gap(lost);
+        ASSERT_NE(hdr, nullptr);
+        EXPECT_EQ(hdr->first_index, 40u);
+        EXPECT_EQ(hdr->num_samples, 110u);
+        EXPECT_EQ(hdr->trigger_offset, 10u);
+        EXPECT_TRUE(hdr->flags == BlockFlags::ZERO_FILLED);
+        EXPECT_EQ(feed.samples()[10].imag(), 20000);
+        EXPECT_EQ(feed.samples()[59].real(), 99);
+        EXPECT_EQ(feed.samples()[60], radio::SDRRawSample{});
+
+        // The rest of the gap still advances the stream.
+        const CaptureHeader* next = nullptr;
+        for (int i = 0; i < 20 && next == nullptr; i++) {
+            next = feed.block();
+        }
+        ASSERT_NE(next, nullptr);
+        EXPECT_EQ(next->first_index + next->trigger_offset, 1000u + lost);
+        EXPECT_EQ(stage.captures(), 2u);
+        EXPECT_EQ(stage.dropped(), 0u);
+    }
+}
+
+TEST(CSICSTriggeredCaptureTests, CountsWindowsThatDoNotFit) {
+    TriggeredCapture stage(config(10, 100));
+    std::vector<std::byte> in(sizeof(BlockHeader) +
+                              kBlock * sizeof(radio::SDRRawSample));
+    auto* hdr = reinterpret_cast<BlockHeader*>(in.data());
+    auto* s = reinterpret_cast<radio::SDRRawSample*>(in.data() +
+                                                     sizeof(BlockHeader));
+    std::vector<std::byte> out(sizeof(CaptureHeader));
+    for (int b = 0; b < 3; b++) {
+        hdr->timestamp_ns = kStartNs + b * kBlock * 1000;
+        hdr->num_samples = kBlock;
+        hdr->flags = BlockFlags::NONE;
+        for (std::size_t i = 0; i < kBlock; i++) {
+            s[i] = radio::SDRRawSample(0, b == 0 && i == 50 ? 20000 : 0);
+        }
+        StageResult r = stage.process(BufferView(in.data(), in.size()),
+                                      BufferView(out.data(), out.size()));
+        EXPECT_EQ(r.status, StageStatus::Ok);
+        EXPECT_EQ(r.output, 0u);
+    }
+    EXPECT_EQ(stage.captures(), 0u);
+    EXPECT_EQ(stage.dropped(), 1u);
+}
+
+TEST(CSICSTriggeredCaptureTests, RejectsEmptyPostTrigger) {
+    EXPECT_THROW(TriggeredCapture(config(10, 0)), std::invalid_argument);
+}
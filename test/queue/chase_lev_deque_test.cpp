@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <csics/csics.hpp>
+#include <thread>
+#include <vector>
+
+using namespace csics::queue;
+
+TEST(CSICSDequeTests, OwnerIsLifoThiefIsFifo) {
+    ChaseLevDeque<int> dq(8);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(dq.push(i), DequeError::None);
+    }
+    EXPECT_EQ(dq.size(), 4u);
+
+    int v = -1;
+    ASSERT_EQ(dq.steal(v), DequeError::None);
+    EXPECT_EQ(v, 0);
+    ASSERT_EQ(dq.pop(v), DequeError::None);
+    EXPECT_EQ(v, 3);
+    ASSERT_EQ(dq.pop(v), DequeError::None);
+    EXPECT_EQ(v, 2);
+    ASSERT_EQ(dq.steal(v), DequeError::None);
+    EXPECT_EQ(v, 1);
+
+    EXPECT_EQ(dq.pop(v), DequeError::Empty);
+    EXPECT_EQ(dq.steal(v), DequeError::Empty);
+    EXPECT_TRUE(dq.empty());
+}
+
+TEST(CSICSDequeTests, FullAtCapacity) {
+    ChaseLevDeque<int> dq(5);
+    ASSERT_EQ(dq.capacity(), 8u);
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(dq.push(i), DequeError::None);
+    }
+    EXPECT_EQ(dq.push(8), DequeError::Full);
+
+    // Stealing frees a slot at the top for the owner to reuse.
+    int v;
+    ASSERT_EQ(dq.steal(v), DequeError::None);
+    EXPECT_EQ(dq.push(8), DequeError::None);
+    EXPECT_EQ(dq.push(9), DequeError::Full);
+}
+
+TEST(CSICSDequeTests, ConcurrentStealsLoseNothing) {
+    constexpr int num_items = 20000;
+    constexpr int num_thieves = 3;
+    ChaseLevDeque<int> dq(256);
+    std::vector<std::atomic<int>> seen(num_items);
+    std::atomic<bool> owner_done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < num_thieves; t++) {
+        thieves.emplace_back([&] {
+            int v;
+            while (true) {
+                DequeError err = dq.steal(v);
+                if (err == DequeError::None) {
+                    seen[v]++;
+                } else if (err == DequeError::Empty &&
+                           owner_done.load(std::memory_order_acquire)) {
+                    break;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int next = 0;
+    int v;
+    while (next < num_items) {
+        if (dq.push(next) == DequeError::None) {
+            next++;
+        }
+        // Pop every few pushes so the owner races thieves for the bottom.
+        if (next % 3 == 0 && dq.pop(v) == DequeError::None) {
+            seen[v]++;
+        }
+    }
+    while (dq.pop(v) == DequeError::None) {
+        seen[v]++;
+    }
+    owner_done.store(true, std::memory_order_release);
+    for (auto& t : thieves) {
+        t.join();
+    }
+
+    for (int i = 0; i < num_items; i++) {
+        ASSERT_EQ(seen[i].load(), 1) << "item " << i;
+    }
+}
@@ -57,6 +57,29 @@ TEST(CSICSQueueTests, BasicReadWriteSmall) {
     q.commit_read(std::move(rs));
 }
 
+TEST(CSICSQueueTests, ShrunkWriteSlot) {
+    using namespace csics::queue;
+    SPSCQueue q(1024);
+    SPSCQueue::WriteSlot ws{};
+    SPSCQueue::ReadSlot rs{};
+
+    // Only the lowered size is published, and the next slot follows it.
+    for (std::size_t used : {10, 300, 0}) {
+        ASSERT_EQ(q.acquire_write(ws, 512), SPSCError::None);
+        std::memset(ws.data, static_cast<int>(used & 0xFF), used);
+        ws.size = used;
+        q.commit_write(std::move(ws));
+    }
+    for (std::size_t used : {10, 300, 0}) {
+        ASSERT_EQ(q.acquire_read(rs), SPSCError::None);
+        ASSERT_EQ(rs.size, used);
+        for (std::size_t i = 0; i < used; i++) {
+            ASSERT_EQ(rs.data[i], std::byte(used & 0xFF));
+        }
+        q.commit_read(std::move(rs));
+    }
+}
+
 TEST(CSICSQueueTests, FuzzReadWriteSingleThreaded) {
     using namespace csics::queue;
     SPSCQueue::WriteSlot ws{};
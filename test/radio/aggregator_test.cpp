@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <csics/radio/RadioAggregator.hpp>
+#include <thread>
+
+using namespace csics::radio;
+using namespace std::chrono_literals;
+
+constexpr double kRate = 1e6;
+constexpr uint64_t kEpochNs = 1'700'000'000'000'000'000ull;
+
+// Sample value carrying its global index, so alignment can be checked.
+// Offset by one to keep zero for zero-filled samples.
+static SDRRawSample encode(int64_t index) {
+    index += 1;
+    return {static_cast<int16_t>(index & 0x7fff),
+            static_cast<int16_t>((index >> 15) & 0x7fff)};
+}
+
+static int64_t decode(SDRRawSample s) {
+    return (static_cast<int64_t>(s.real()) |
+            (static_cast<int64_t>(s.imag()) << 15)) -
+           1;
+}
+
+/** Receiver producing `total` samples from global index `first`, stamped
+ * with a clock that is `skew_ns` off. Optionally loses `gap_len` samples at
+ * index `gap_at` and reports them with a gap marker.
+ */
+class SyntheticRadioRx : public IRadioRx {
+   public:
+    SyntheticRadioRx(int64_t first, int64_t total, std::size_t block_len,
+                     int64_t skew_ns = 0)
+        : first_(first),
+          total_(total),
+          block_len_(block_len),
+          skew_ns_(skew_ns),
+          queue_(csics::queue::SPSCQueue::capacity_for(
+              sizeof(BlockHeader) + block_len * sizeof(SDRRawSample), 16)) {}
+    ~SyntheticRadioRx() override { stop_stream(); }
+
+    void inject_gap(int64_t at, int64_t len) {
+        gap_at_ = at;
+        gap_len_ = len;
+    }
+
+    StartStatus start_stream(const StreamConfiguration&) noexcept override {
+        stop_ = false;
+        streaming_ = true;
+        thread_ = std::thread([this] { produce(); });
+        return {StartStatus::Code::SUCCESS, queue_.get_read_handle()};
+    }
+    void stop_stream() noexcept override {
+        stop_ = true;
+        if (thread_.joinable()) thread_.join();
+        streaming_ = false;
+    }
+    bool is_streaming() const noexcept override { return streaming_; }
+    double get_sample_rate() const noexcept override { return kRate; }
+    Timestamp set_sample_rate(double) noexcept override { return 0; }
+    double get_max_sample_rate() const noexcept override { return kRate; }
+    double get_center_frequency() const noexcept override { return 0; }
+    Timestamp set_center_frequency(double) noexcept override { return 0; }
+    double get_gain() const noexcept override { return 0; }
+    Timestamp set_gain(double) noexcept override { return 0; }
+    RadioConfiguration get_configuration() const noexcept override {
+        return {};
+    }
+    Timestamp set_configuration(const RadioConfiguration&) noexcept override {
+        return 0;
+    }
+    RadioDeviceInfo get_device_info() const noexcept override { return {}; }
+
+   private:
+    bool write(uint64_t n, BlockFlags flags, int64_t index) {
+        csics::queue::SPSCQueue::WriteSlot slot;
+        std::size_t size = sizeof(BlockHeader) +
+                           (flags == BlockFlags::GAP ? 0 : n) *
+                               sizeof(SDRRawSample);
+        while (queue_.acquire_write(slot, size) !=
+               csics::queue::SPSCError::None) {
+            if (stop_) return false;
+            std::this_thread::yield();
+        }
+        BlockHeader* hdr = nullptr;
+        SDRRawSample* samples = nullptr;
+        slot.as_block(hdr, samples);
+        hdr->timestamp_ns = kEpochNs + skew_ns_ +
+                            static_cast<uint64_t>(index * 1e9 / kRate);
+        hdr->num_samples = n;
+        hdr->flags = flags;
+        if (flags != BlockFlags::GAP) {
+            for (uint64_t i = 0; i < n; i++) {
+                samples[i] = encode(index + static_cast<int64_t>(i));
+            }
+        }
+        queue_.commit_write(std::move(slot));
+        return true;
+    }
+
+    void produce() {
+        int64_t index = first_;
+        while (index < first_ + total_) {
+            int64_t n = std::min<int64_t>(block_len_, first_ + total_ - index);
+            if (gap_len_ != 0 && index <= gap_at_ && gap_at_ < index + n) {
+                // Deliver up to the loss, then the marker.
+                if (gap_at_ > index &&
+                    !write(gap_at_ - index, BlockFlags::PARTIAL, index)) {
+                    return;
+                }
+                if (!write(gap_len_, BlockFlags::GAP, gap_at_)) return;
+                index = gap_at_ + gap_len_;
+                gap_len_ = 0;
+                continue;
+            }
+            if (!write(n, BlockFlags::NONE, index)) return;
+            index += n;
+        }
+    }
+
+    int64_t first_, total_;
+    std::size_t block_len_;
+    int64_t skew_ns_;
+    int64_t gap_at_ = 0, gap_len_ = 0;
+    csics::queue::SPSCQueue queue_;
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    std::atomic<bool> streaming_{false};
+};
+
+static RadioAggregator::Config config(std::size_t block_len) {
+    RadioAggregator::Config c;
+    c.stream.sample_length = block_len;
+    return c;
+}
+
+// Reads `blocks` merged blocks, checking each channel holds the same indices.
+static std::vector<int64_t> read_aligned(
+    csics::queue::SPSCQueue::ReadHandle& handle, std::size_t channels,
+    std::size_t blocks, uint64_t* zero_filled_blocks = nullptr) {
+    std::vector<int64_t> starts;
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (starts.size() < blocks &&
+           std::chrono::steady_clock::now() < deadline) {
+        csics::queue::SPSCQueue::ReadSlot slot;
+        if (handle.acquire(slot) != csics::queue::SPSCError::None) {
+            std::this_thread::yield();
+            continue;
+        }
+        RadioAggregator::BlockHeader* hdr = nullptr;
+        SDRRawSample* samples = nullptr;
+        slot.as_block(hdr, samples);
+        const uint64_t n = hdr->num_samples;
+        // Losses are zero-filled, never forwarded as sample-less markers.
+        EXPECT_FALSE(hdr->has(RadioAggregator::BlockFlags::GAP));
+        EXPECT_EQ(slot.size, sizeof(RadioAggregator::BlockHeader) +
+                                 n * channels * sizeof(SDRRawSample));
+        if (hdr->has(RadioAggregator::BlockFlags::ZERO_FILLED) &&
+            zero_filled_blocks) {
+            (*zero_filled_blocks)++;
+        }
+        int64_t start = -1;
+        for (uint64_t i = 0; i < n; i++) {
+            int64_t expected = -1;
+            for (std::size_t c = 0; c < channels; c++) {
+                SDRRawSample s = samples[c * n + i];
+                if (s == SDRRawSample{}) {
+                    // Zero-filled, only allowed in flagged blocks.
+                    EXPECT_TRUE(hdr->has(
+                        RadioAggregator::BlockFlags::ZERO_FILLED));
+                    continue;
+                }
+                if (expected < 0) expected = decode(s);
+                EXPECT_EQ(decode(s), expected) << "channel " << c;
+            }
+            if (i == 0) start = expected;
+        }
+        EXPECT_EQ(hdr->timestamp_ns,
+                  kEpochNs + static_cast<uint64_t>(start * 1e9 / kRate));
+        starts.push_back(start);
+        handle.commit(std::move(slot));
+    }
+    return starts;
+}
+
+TEST(CSICSRadioAggregatorTests, AlignsSkewedRadios) {
+    constexpr std::size_t kBlock = 500;
+    std::vector<std::unique_ptr<IRadioRx>> radios;
+    // Started at different times, one with odd sized blocks.
+    radios.push_back(std::make_unique<SyntheticRadioRx>(0, 40000, kBlock));
+    radios.push_back(std::make_unique<SyntheticRadioRx>(1234, 40000, 333));
+    radios.push_back(std::make_unique<SyntheticRadioRx>(77, 40000, kBlock));
+    RadioAggregator agg(std::move(radios));
+
+    auto status = agg.start(config(kBlock));
+    ASSERT_TRUE(status);
+    auto starts = read_aligned(*status.handle, 3, 20);
+    ASSERT_EQ(starts.size(), 20u);
+    // The latest radio starts the merged stream.
+    EXPECT_EQ(starts.front(), 1234);
+    for (std::size_t i = 1; i < starts.size(); i++) {
+        EXPECT_EQ(starts[i], starts[i - 1] + static_cast<int64_t>(kBlock));
+    }
+    agg.stop();
+    EXPECT_EQ(agg.stats().aligned_samples, 1234u + (1234u - 77u));
+    EXPECT_EQ(agg.stats().gap_samples, 0u);
+}
+
+TEST(CSICSRadioAggregatorTests, ToleratesTimestampJitter) {
+    constexpr std::size_t kBlock = 256;
+    std::vector<std::unique_ptr<IRadioRx>> radios;
+    // Clock offsets below half a sample (500 ns) round to the same index.
+    radios.push_back(std::make_unique<SyntheticRadioRx>(10, 20000, kBlock));
+    radios.push_back(
+        std::make_unique<SyntheticRadioRx>(10, 20000, kBlock, 300));
+    RadioAggregator agg(std::move(radios));
+
+    auto status = agg.start(config(kBlock));
+    ASSERT_TRUE(status);
+    auto starts = read_aligned(*status.handle, 2, 10);
+    ASSERT_EQ(starts.size(), 10u);
+    EXPECT_EQ(starts.front(), 10);
+    EXPECT_EQ(agg.stats().aligned_samples, 0u);
+}
+
+TEST(CSICSRadioAggregatorTests, ZeroFillsGaps) {
+    constexpr std::size_t kBlock = 400;
+    auto lossy = std::make_unique<SyntheticRadioRx>(0, 40000, kBlock);
+    lossy->inject_gap(2100, 900);
+    std::vector<std::unique_ptr<IRadioRx>> radios;
+    radios.push_back(std::make_unique<SyntheticRadioRx>(0, 40000, kBlock));
+    radios.push_back(std::move(lossy));
+    RadioAggregator agg(std::move(radios));
+
+    auto status = agg.start(config(kBlock));
+    ASSERT_TRUE(status);
+    uint64_t zero_filled_blocks = 0;
+    auto starts = read_aligned(*status.handle, 2, 30, &zero_filled_blocks);
+    ASSERT_EQ(starts.size(), 30u);
+    for (std::size_t i = 1; i < starts.size(); i++) {
+        EXPECT_EQ(starts[i], starts[i - 1] + static_cast<int64_t>(kBlock));
+    }
+    // Samples 2100-2999 fall into blocks 2000, 2400 and 2800.
+    EXPECT_EQ(zero_filled_blocks, 3u);
+    EXPECT_EQ(agg.stats().gap_samples, 900u);
+}
+
+TEST(CSICSRadioAggregatorTests, RejectsMismatchedSetup) {
+    RadioAggregator empty({});
+    auto status = empty.start(config(100));
+    EXPECT_EQ(status.code,
+              RadioAggregator::StartStatus::Code::CONFIGURATION_ERROR);
+
+    std::vector<std::unique_ptr<IRadioRx>> radios;
+    radios.push_back(std::make_unique<SyntheticRadioRx>(0, 1000, 100));
+    RadioAggregator agg(std::move(radios));
+    RadioAggregator::Config c = config(100);
+    c.time_source = TimeSource::PPS;
+    status = agg.start(c);
+    EXPECT_EQ(status.code,
+              RadioAggregator::StartStatus::Code::TIME_SYNC_FAILURE);
+    EXPECT_FALSE(agg.is_running());
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "../../src/radio/usrp/USRPArgs.hpp"
+
+using namespace csics::radio;
+using namespace std::chrono_literals;
+
+static std::string temp_cache_path(const char* name) {
+    auto dir = std::filesystem::temp_directory_path() / "csics_device_cache";
+    std::filesystem::remove_all(dir / name);
+    return (dir / name / "devices").string();
+}
+
+static DeviceProfile sample_profile() {
+    DeviceProfile p;
+    p.serial = "F5EAC0";
+    p.product = "N310";
+    p.rx_info.frequency_range = {10e6, 6e9};
+    p.rx_info.sample_rate_range = {0.1, 153.6e6 / 3};
+    p.rx_info.max_gain = 76.0;
+    p.tx_info.frequency_range = {10e6, 6e9};
+    p.tx_info.sample_rate_range = {0.2, 125e6};
+    p.tx_info.max_gain = 65.0;
+    p.master_clocks = {122.88e6, 125e6, 153.6e6};
+    return p;
+}
+
+TEST(CSICSDeviceCacheTests, ProfilesPersistAcrossInstances) {
+    std::string path = temp_cache_path("persist");
+    {
+        DeviceCache cache(path);
+        EXPECT_FALSE(cache.profile("F5EAC0").has_value());
+        EXPECT_TRUE(cache.store_profile(sample_profile()));
+    }
+
+    DeviceCache cache(path);
+    auto p = cache.profile("F5EAC0");
+    ASSERT_TRUE(p.has_value());
+    auto expected = sample_profile();
+    EXPECT_EQ(p->product, expected.product);
+    EXPECT_EQ(p->rx_info.frequency_range.max,
+              expected.rx_info.frequency_range.max);
+    // Rates round trip exactly, not only to printed precision.
+    EXPECT_EQ(p->rx_info.sample_rate_range.max,
+              expected.rx_info.sample_rate_range.max);
+    EXPECT_EQ(p->tx_info.max_gain, expected.tx_info.max_gain);
+    EXPECT_EQ(p->master_clocks, expected.master_clocks);
+}
+
+TEST(CSICSDeviceCacheTests, IgnoresUnknownOrCorruptFiles) {
+    std::string path = temp_cache_path("corrupt");
+    std::filesystem::create_directories(
+        std::filesystem::path(path).parent_path());
+    {
+        std::ofstream out(path);
+        out << "csics-device-cache 0\nF5EAC0 N310 1 2 3 4 5 6 7 8 9 10 0\n";
+    }
+    DeviceCache old_version(path);
+    EXPECT_FALSE(old_version.profile("F5EAC0").has_value());
+
+    {
+        std::ofstream out(path);
+        out << "csics-device-cache 2\nF5EAC0 N310 1 2 3\n";
+    }
+    DeviceCache truncated(path);
+    EXPECT_FALSE(truncated.profile("F5EAC0").has_value());
+    // Still usable, and rewrites the file.
+    EXPECT_TRUE(truncated.store_profile(sample_profile()));
+    EXPECT_TRUE(DeviceCache(path).profile("F5EAC0").has_value());
+}
+
+TEST(CSICSDeviceCacheTests, NamesWithSpecialCharactersRoundTrip) {
+    std::string path = temp_cache_path("escape");
+    const std::vector<std::string> serials = {"a b", "a_b", "a%20b", "-",
+                                              "tab\there"};
+    {
+        DeviceCache cache(path);
+        for (const auto& serial : serials) {
+            DeviceProfile p = sample_profile();
+            p.serial = serial;
+            p.product = serial + " product";
+            EXPECT_TRUE(cache.store_profile(p));
+        }
+    }
+
+    DeviceCache cache(path);
+    for (const auto& serial : serials) {
+        auto p = cache.profile(serial);
+        ASSERT_TRUE(p.has_value()) << serial;
+        EXPECT_EQ(p->serial, serial);
+        EXPECT_EQ(p->product, serial + " product");
+    }
+    // Only the cache itself is left behind, no temporary files.
+    std::size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(
+             std::filesystem::path(path).parent_path())) {
+        EXPECT_EQ(entry.path().string(), path);
+        files++;
+    }
+    EXPECT_EQ(files, 1u);
+}
+
+TEST(CSICSDeviceCacheTests, ConcurrentWritersKeepEachOthersProfiles) {
+    std::string path = temp_cache_path("merge");
+    // Both loaded the empty file before either stored anything.
+    DeviceCache first(path);
+    DeviceCache second(path);
+    DeviceProfile a = sample_profile();
+    DeviceProfile b = sample_profile();
+    b.serial = "31A";
+    b.product = "B210";
+    EXPECT_TRUE(first.store_profile(a));
+    EXPECT_TRUE(second.store_profile(b));
+
+    DeviceCache reloaded(path);
+    EXPECT_TRUE(reloaded.profile("F5EAC0").has_value());
+    EXPECT_TRUE(reloaded.profile("31A").has_value());
+    // The writer's own profile wins over the one in the file.
+    b.product = "B210mini";
+    EXPECT_TRUE(first.store_profile(b));
+    EXPECT_EQ(DeviceCache(path).profile("31A")->product, "B210mini");
+}
+
+TEST(CSICSDeviceCacheTests, FailedSaveLeavesNoTempFile) {
+    std::string path = temp_cache_path("blocked");
+    // A non-empty directory in place of the file makes the rename fail.
+    std::filesystem::create_directories(std::filesystem::path(path) / "x");
+    DeviceCache cache(path);
+    EXPECT_FALSE(cache.store_profile(sample_profile()));
+    EXPECT_TRUE(cache.profile("F5EAC0").has_value());
+    std::size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(
+             std::filesystem::path(path).parent_path())) {
+        EXPECT_EQ(entry.path().string(), path);
+        files++;
+    }
+    EXPECT_EQ(files, 1u);
+}
+
+TEST(CSICSDeviceCacheTests, DiscoveryExpires) {
+    DeviceCache cache("");
+    EXPECT_FALSE(cache.discovered("type=b200").has_value());
+
+    cache.store_discovery("type=b200", {"type=b200,serial=31A"});
+    auto found = cache.discovered("type=b200");
+    ASSERT_TRUE(found.has_value());
+    ASSERT_EQ(found->size(), 1u);
+    EXPECT_FALSE(cache.discovered("").has_value());
+
+    std::this_thread::sleep_for(5ms);
+    EXPECT_FALSE(cache.discovered("type=b200", 1ms).has_value());
+
+    cache.invalidate_discovery();
+    EXPECT_FALSE(cache.discovered("type=b200").has_value());
+}
+
+TEST(CSICSDeviceCacheTests, ResolvedAddressKeepsCallerArgs) {
+    const char* found = "type=usrp2,addr=192.168.10.2,name=,serial=F5EAC0";
+    EXPECT_EQ(merge_usrp_args("", found),
+              "addr=192.168.10.2,serial=F5EAC0,type=usrp2");
+    // Caller settings survive, keys the caller set are not overridden.
+    EXPECT_EQ(merge_usrp_args("type=usrp2,master_clock_rate=100e6,"
+                              "recv_frame_size=8000",
+                              found),
+              "type=usrp2,master_clock_rate=100e6,recv_frame_size=8000,"
+              "addr=192.168.10.2,serial=F5EAC0");
+    EXPECT_EQ(merge_usrp_args("addr=10.0.0.2", found),
+              "addr=10.0.0.2,serial=F5EAC0,type=usrp2");
+
+    std::string_view value;
+    EXPECT_TRUE(usrp_arg(found, "name", &value));
+    EXPECT_TRUE(value.empty());
+    EXPECT_FALSE(usrp_arg(found, "add"));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <thread>
+
+using namespace csics::radio;
+using namespace std::chrono_literals;
+
+// 1 MS/s, so a 1000 sample block plays for 1 ms.
+constexpr double kRate = 1e6;
+constexpr std::size_t kBlockLen = 1000;
+
+static std::unique_ptr<IRadioTx> make_tx(bool paced) {
+    RadioConfiguration config{};
+    config.sample_rate = kRate;
+    auto tx = IRadioTx::create_radio_tx(NullDeviceArgs{paced}, config);
+    if (tx) {
+        tx->set_configuration(config);
+    }
+    return tx;
+}
+
+static void send_block(csics::queue::SPSCQueue::WriteHandle& handle,
+                       IRadioTx::BlockFlags flags, uint64_t time_ns = 0) {
+    csics::queue::SPSCQueue::WriteSlot slot;
+    std::size_t size =
+        sizeof(IRadioTx::BlockHeader) + kBlockLen * sizeof(SDRRawSample);
+    while (handle.acquire(slot, size) != csics::queue::SPSCError::None) {
+        std::this_thread::yield();
+    }
+    IRadioTx::BlockHeader* hdr = nullptr;
+    SDRRawSample* samples = nullptr;
+    slot.as_block(hdr, samples);
+    hdr->timestamp_ns = time_ns;
+    hdr->num_samples = kBlockLen;
+    hdr->flags = flags;
+    handle.commit(std::move(slot));
+}
+
+TEST(CSICSNullTxTests, CreatedFromDeviceArgs) {
+    auto tx = make_tx(true);
+    ASSERT_NE(tx, nullptr);
+    EXPECT_DOUBLE_EQ(tx->get_sample_rate(), kRate);
+    EXPECT_FALSE(tx->is_streaming());
+}
+
+TEST(CSICSNullTxTests, CountsBlocksAndBursts) {
+    auto tx = make_tx(false);
+    ASSERT_NE(tx, nullptr);
+    auto status = tx->start_stream(StreamConfiguration{});
+    ASSERT_TRUE(status);
+    ASSERT_TRUE(status.tx_handle.has_value());
+    auto& handle = *status.tx_handle;
+
+    for (int burst = 0; burst < 3; burst++) {
+        for (int i = 0; i < 9; i++) {
+            send_block(handle, IRadioTx::BlockFlags::NONE);
+        }
+        send_block(handle, IRadioTx::BlockFlags::END_OF_BURST);
+    }
+    tx->stop_stream();
+
+    auto stats = tx->get_tx_stats();
+    EXPECT_EQ(stats.blocks, 30u);
+    EXPECT_EQ(stats.samples, 30 * kBlockLen);
+    EXPECT_EQ(stats.bursts, 3u);
+    EXPECT_EQ(stats.underflows, 0u);
+    EXPECT_EQ(stats.late_bursts, 0u);
+}
+
+TEST(CSICSNullTxTests, LateTimedBurstIsCounted) {
+    auto tx = make_tx(true);
+    ASSERT_NE(tx, nullptr);
+    auto status = tx->start_stream(StreamConfiguration{});
+    ASSERT_TRUE(status);
+    auto& handle = *status.tx_handle;
+
+    uint64_t past = static_cast<uint64_t>(Timestamp::now()) - 1'000'000'000;
+    send_block(handle, IRadioTx::BlockFlags::END_OF_BURST, past);
+    uint64_t future = static_cast<uint64_t>(Timestamp::now()) + 2'000'000;
+    send_block(handle, IRadioTx::BlockFlags::END_OF_BURST, future);
+    tx->stop_stream();
+
+    auto stats = tx->get_tx_stats();
+    EXPECT_EQ(stats.bursts, 2u);
+    EXPECT_EQ(stats.late_bursts, 1u);
+}
+
+TEST(CSICSNullTxTests, StarvedBurstUnderflows) {
+    auto tx = make_tx(true);
+    ASSERT_NE(tx, nullptr);
+    auto status = tx->start_stream(StreamConfiguration{});
+    ASSERT_TRUE(status);
+    auto& handle = *status.tx_handle;
+
+    send_block(handle, IRadioTx::BlockFlags::NONE);
+    // Far longer than the 1 ms block, the device runs dry mid burst.
+    std::this_thread::sleep_for(20ms);
+    send_block(handle, IRadioTx::BlockFlags::END_OF_BURST);
+    tx->stop_stream();
+
+    auto stats = tx->get_tx_stats();
+    EXPECT_EQ(stats.bursts, 1u);
+    EXPECT_EQ(stats.underflows, 1u);
+}
+
+TEST(CSICSNullTxTests, SyncsOnlyToHost) {
+    auto tx = make_tx(false);
+    ASSERT_NE(tx, nullptr);
+    // Burst times are host epoch already, there is no device clock.
+    EXPECT_TRUE(tx->sync_time(TimeSource::HOST));
+    EXPECT_FALSE(tx->sync_time(TimeSource::PPS));
+}
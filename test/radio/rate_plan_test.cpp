@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <csics/radio/RatePlan.hpp>
+#include <vector>
+
+#include "../../src/radio/usrp/USRPConfigs.hpp"
+
+using namespace csics::radio;
+
+// The shipped device tables, so the limits cannot drift from the tests.
+constexpr std::span<const double> kN210Clocks{n210_config.master_clocks,
+                                              n210_config.num_master_clocks};
+constexpr std::span<const double> kN310Clocks{n310_config.master_clocks,
+                                              n310_config.num_master_clocks};
+constexpr RateLimits kN210Limits = n210_config.rate_limits;
+constexpr RateLimits kN310Limits = n310_config.rate_limits;
+
+struct PlanCase {
+    const char* name;
+    std::span<const double> clocks;
+    RateLimits limits;
+    double sample_rate;
+    double expected_clock;
+    uint32_t expected_decimation;
+    bool expected_exact;
+};
+
+TEST(CSICSRatePlanTests, PicksMasterClock) {
+    const PlanCase cases[] = {
+        {"n210 exact", kN210Clocks, kN210Limits, 1e6, 100e6, 100, true},
+        {"n210 odd exact", kN210Clocks, kN210Limits, 20e6, 100e6, 5, true},
+        {"n210 nearest", kN210Clocks, kN210Limits, 3e6, 100e6, 33, false},
+        {"n210 fastest", kN210Clocks, kN210Limits, 50e6, 100e6, 2, true},
+        {"n210 above limit", kN210Clocks, kN210Limits, 100e6, 0, 0, false},
+        {"n210 below limit", kN210Clocks, kN210Limits, 100e3, 0, 0, false},
+        // Exact as 153.6e6 / 5 too, the even decimation wins.
+        {"n310 lte", kN310Clocks, kN310Limits, 30.72e6, 122.88e6, 4, true},
+        {"n310 round", kN310Clocks, kN310Limits, 25e6, 125e6, 5, true},
+        // 153.6e6 / 6 and 125e6 / 5 are both off, 122.88e6 / 5 is closest.
+        {"n310 nearest", kN310Clocks, kN310Limits, 24.5e6, 122.88e6, 5, false},
+        // Only 153.6e6 divides evenly.
+        {"n310 fractional", kN310Clocks, kN310Limits, 19.2e6, 153.6e6, 8,
+         true},
+        // Both even and exact, the higher clock wins.
+        {"n310 higher", kN310Clocks, kN310Limits, 7.68e6, 153.6e6, 20, true},
+        {"no clocks", {}, kN310Limits, 1e6, 0, 0, false},
+    };
+    for (const auto& c : cases) {
+        SCOPED_TRACE(c.name);
+        RatePlan plan = plan_sample_rate(c.clocks, c.sample_rate, c.limits);
+        EXPECT_EQ(plan.decimation, c.expected_decimation);
+        EXPECT_EQ(plan.exact, c.expected_exact);
+        if (c.expected_decimation != 0) {
+            EXPECT_DOUBLE_EQ(plan.master_clock, c.expected_clock);
+            EXPECT_DOUBLE_EQ(plan.sample_rate,
+                             c.expected_clock / c.expected_decimation);
+        }
+    }
+}
+
+TEST(CSICSRatePlanTests, PicksOtwFormat) {
+    struct OtwCase {
+        OtwFormat requested;
+        double sample_rate;
+        double link;
+        OtwFormat expected;
+    } cases[] = {
+        {OtwFormat::AUTO, 25e6, 100e6, OtwFormat::SC16},
+        {OtwFormat::AUTO, 33.3e6, 100e6, OtwFormat::SC8},
+        {OtwFormat::AUTO, 153.6e6, 1.2e9, OtwFormat::SC16},
+        {OtwFormat::AUTO, 200e6, 0, OtwFormat::SC16},
+        {OtwFormat::SC8, 1e6, 100e6, OtwFormat::SC8},
+        {OtwFormat::SC16, 50e6, 100e6, OtwFormat::SC16},
+    };
+    for (const auto& c : cases) {
+        EXPECT_EQ(select_otw_format(c.requested, c.sample_rate, c.link),
+                  c.expected)
+            << c.sample_rate;
+    }
+    EXPECT_STREQ(otw_name(OtwFormat::SC16), "sc16");
+    EXPECT_STREQ(otw_name(OtwFormat::SC8), "sc8");
+}
+
+TEST(CSICSRatePlanTests, PicksOtwFormatOnDeviceTables) {
+    struct DeviceCase {
+        const char* name;
+        const USRPConfiguration& config;
+        double sample_rate;
+        OtwFormat expected;
+    } cases[] = {
+        {"n210 sc16", n210_config, 25e6, OtwFormat::SC16},
+        // Only reachable at the N210's lowest decimation.
+        {"n210 sc8", n210_config, 50e6, OtwFormat::SC8},
+        {"n310 sc16", n310_config, 153.6e6, OtwFormat::SC16},
+    };
+    for (const auto& c : cases) {
+        SCOPED_TRACE(c.name);
+        std::span<const double> clocks(c.config.master_clocks,
+                                       c.config.num_master_clocks);
+        RatePlan plan =
+            plan_sample_rate(clocks, c.sample_rate, c.config.rate_limits);
+        ASSERT_NE(plan.decimation, 0u);
+        EXPECT_EQ(select_otw_format(OtwFormat::AUTO, plan.sample_rate,
+                                    c.config.rate_limits.link_bytes_per_sec),
+                  c.expected);
+    }
+}
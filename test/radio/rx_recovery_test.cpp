@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <csics/csics.hpp>
+#include <csics/radio/RxRecovery.hpp>
+
+using namespace csics::radio;
+using namespace std::chrono_literals;
+
+// 1 MS/s, so one sample is 1000 ns.
+constexpr double kRate = 1e6;
+
+TEST(CSICSRxRecoveryTests, ContinuousSamplesHaveNoGap) {
+    RxRecovery rec(kRate, RxRecoveryConfig{});
+    uint64_t t = 5'000'000;
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(rec.on_samples(100, t), 0u);
+        EXPECT_EQ(rec.on_event(RxEvent::NONE), RxAction::CONTINUE);
+        t += 100'000;
+    }
+    // Without a loss event, clock jitter is never reported as a gap.
+    EXPECT_EQ(rec.on_samples(100, t + 50'000), 0u);
+    auto s = rec.stats();
+    EXPECT_EQ(s.samples, 1100u);
+    EXPECT_EQ(s.gaps, 0u);
+    EXPECT_FALSE(s.failed);
+}
+
+TEST(CSICSRxRecoveryTests, OverflowReportsLostSamples) {
+    RxRecovery rec(kRate, RxRecoveryConfig{});
+    EXPECT_EQ(rec.on_samples(100, 0), 0u);
+    EXPECT_EQ(rec.on_event(RxEvent::OVERFLOW), RxAction::RESYNC);
+    // Next samples start 250 samples after the expected time.
+    EXPECT_EQ(rec.on_samples(100, (100 + 250) * 1000), 250u);
+    // The gap is only reported once.
+    EXPECT_EQ(rec.on_samples(100, (200 + 250) * 1000 + 7000), 0u);
+
+    auto s = rec.stats();
+    EXPECT_EQ(s.overflows, 1u);
+    EXPECT_EQ(s.gaps, 1u);
+    EXPECT_EQ(s.lost_samples, 250u);
+    EXPECT_EQ(s.restarts, 0u);
+}
+
+TEST(CSICSRxRecoveryTests, StreamErrorsRestartWithBackoff) {
+    RxRecoveryConfig cfg;
+    cfg.restart_delay = 1ms;
+    cfg.max_restart_delay = 5ms;
+    cfg.max_restarts = 5;
+    RxRecovery rec(kRate, cfg);
+
+    const std::chrono::microseconds expected[] = {1ms, 2ms, 4ms, 5ms, 5ms};
+    for (auto delay : expected) {
+        ASSERT_EQ(rec.on_event(RxEvent::BROKEN_CHAIN), RxAction::RESTART);
+        EXPECT_EQ(rec.restart_delay(), delay);
+    }
+    EXPECT_EQ(rec.on_event(RxEvent::BAD_PACKET), RxAction::STOP);
+
+    auto s = rec.stats();
+    EXPECT_EQ(s.restarts, 5u);
+    EXPECT_EQ(s.stream_errors, 6u);
+    EXPECT_TRUE(s.failed);
+}
+
+TEST(CSICSRxRecoveryTests, SamplesResetBackoff) {
+    RxRecoveryConfig cfg;
+    cfg.restart_delay = 1ms;
+    cfg.max_restarts = 2;
+    RxRecovery rec(kRate, cfg);
+
+    rec.on_samples(10, 0);
+    ASSERT_EQ(rec.on_event(RxEvent::LATE_COMMAND), RxAction::RESTART);
+    ASSERT_EQ(rec.on_event(RxEvent::ALIGNMENT), RxAction::RESTART);
+    EXPECT_EQ(rec.restart_delay(), 2ms);
+    // The restart succeeded, the 1 ms of downtime is accounted as a gap.
+    EXPECT_EQ(rec.on_samples(10, 10'000 + 1'000'000), 1000u);
+    ASSERT_EQ(rec.on_event(RxEvent::ALIGNMENT), RxAction::RESTART);
+    EXPECT_EQ(rec.restart_delay(), 1ms);
+    EXPECT_FALSE(rec.stats().failed);
+}
+
+TEST(CSICSRxRecoveryTests, RepeatedTimeoutsRestart) {
+    RxRecoveryConfig cfg;
+    cfg.max_timeouts = 3;
+    RxRecovery rec(kRate, cfg);
+    EXPECT_EQ(rec.on_event(RxEvent::TIMEOUT), RxAction::CONTINUE);
+    EXPECT_EQ(rec.on_event(RxEvent::TIMEOUT), RxAction::CONTINUE);
+    EXPECT_EQ(rec.on_event(RxEvent::TIMEOUT), RxAction::RESTART);
+    EXPECT_EQ(rec.on_event(RxEvent::TIMEOUT), RxAction::CONTINUE);
+    EXPECT_EQ(rec.stats().timeouts, 4u);
+}
+
+TEST(CSICSRxRecoveryTests, FatalStops) {
+    RxRecovery rec(kRate, RxRecoveryConfig{});
+    EXPECT_EQ(rec.on_event(RxEvent::FATAL), RxAction::STOP);
+    EXPECT_TRUE(rec.stats().failed);
+}
+
+TEST(CSICSRxRecoveryTests, ResetStartsANewStream) {
+    RxRecovery rec(kRate, RxRecoveryConfig{});
+    EXPECT_EQ(rec.on_samples(100, 0), 0u);
+    EXPECT_EQ(rec.on_event(RxEvent::OVERFLOW), RxAction::RESYNC);
+    EXPECT_EQ(rec.on_event(RxEvent::FATAL), RxAction::STOP);
+
+    rec.reset(2 * kRate, RxRecoveryConfig{});
+    auto s = rec.stats();
+    EXPECT_EQ(s.samples, 0u);
+    EXPECT_EQ(s.overflows, 0u);
+    EXPECT_FALSE(s.failed);
+    // The old stream's timeline and pending gap are forgotten.
+    EXPECT_EQ(rec.on_samples(100, 1'000'000), 0u);
+    EXPECT_EQ(rec.on_event(RxEvent::OVERFLOW), RxAction::RESYNC);
+    // 250 us at 2 MS/s.
+    EXPECT_EQ(rec.on_samples(100, 1'300'000), 500u);
+}